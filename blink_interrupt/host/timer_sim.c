@@ -0,0 +1,447 @@
+#include <stdio.h>         // 標準入出力ライブラリ
+#include <stdlib.h>        // qsort, strtoul
+#include <unistd.h>        // getopt
+#include "host_util.h"     // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "timer_service.h" // タイマーサービス (rp2350/ の共通のソース)
+
+// タイマーサービスをホストの仮想時刻で動かす
+//
+// 使い方: timer_sim [-j block_ns] [-s seconds]
+//   -j  他の割り込みなどで割り込みの開始が遅れる時間の最大値 [ns] (既定 2000。0〜block_ns の一様乱数)
+//   -s  ジッタを測るシミュレーションの時間 [秒] (既定 2)
+//
+// アラームは実機と同じく時刻の下位 32 ビットが一致したときに 1 回だけ割り込み、時刻を過ぎて設定したものは
+// 次に一致するまで (約 71 分) 起きない。割り込みの処理時間は下の値で進める (150MHz の Cortex-M33 の見積もり)。
+//
+// 1. 数千個の周期タイマーと単発タイマー (コールバックから次を設定する) を動かし、途中で一部を止めて、
+//    コールバックが期限より早く呼ばれないこと、期限の順に呼ばれること、周期タイマーの期限が開始時刻 + 周期の
+//    倍数からずれないこと、止めたタイマーが呼ばれないことを確かめる。
+// 2. 2^33 us (約 2.4 時間) 先の単発タイマーが、アラームの 32 ビットを超えても期限どおりに呼ばれることを確かめる。
+// 3. タイマーの数ごとに、割り込みの回数・負荷と、期限からコールバックまでの遅れ (平均・99%・最大) を表示する。
+// 4. 250ms の点滅を 1 時間続けたときのずれを、以前の reload_alarm0() (今の時刻 + 250ms) と比べる。
+// 5. ホストの CPU で、タイマーの数ごとに 1 回の追加と 1 回の期限の処理 (取り出して次の周期に入れ直す) の時間を測る。
+
+#define IRQ_ENTRY_NS 100   // 割り込みに入るまで
+#define IRQ_EXIT_NS 70     // 割り込みから戻るまで
+#define TIMER_READ_NS 60   // 64 ビットの時刻の読み出し
+#define ALARM_WRITE_NS 30  // アラームの設定
+#define EVENT_NS 80        // 1 つのタイマーの処理 (ヒープの先頭を取り出す・統計)
+#define HEAP_LEVEL_NS 25   // ヒープの 1 段の比較と移動
+#define CALLBACK_NS 200    // コールバックの処理
+#define MAX_TIMERS 8192
+#define MAX_LATENCIES 2000000
+
+// ホストのハードウェア (仮想時刻)
+typedef struct
+{
+    unsigned long long clock_ns; // 仮想時刻
+    unsigned long long fire_us;  // アラームが割り込む時刻
+    int armed;                   // アラームが設定されている
+    int forced;                  // trigger() で割り込みを強制した
+} host_hw;
+
+static host_hw hw;
+static timer_service ts;
+static timer_event *heap[MAX_TIMERS];
+
+static unsigned long long host_now_us(void *ctx)
+{
+    host_hw *h = ctx;
+    h->clock_ns += TIMER_READ_NS;
+    return h->clock_ns / 1000;
+}
+
+static void host_set_alarm(void *ctx, unsigned long long time_us)
+{
+    host_hw *h = ctx;
+    h->clock_ns += ALARM_WRITE_NS;
+    // 下位 32 ビットが次に一致する時刻 (過ぎていれば 2^32 us 後)
+    unsigned long long now_us = h->clock_ns / 1000;
+    unsigned long long fire = (now_us & ~0xffffffffull) | (time_us & 0xffffffffull);
+    if (fire < now_us)
+    {
+        fire += 1ull << 32;
+    }
+    h->fire_us = fire;
+    h->armed = 1;
+}
+
+static void host_trigger(void *ctx)
+{
+    host_hw *h = ctx;
+    h->forced = 1;
+}
+
+static void host_clear_irq(void *ctx)
+{
+    host_hw *h = ctx;
+    h->forced = 0;
+}
+
+static const timer_service_hw host = {
+    .now_us = host_now_us,
+    .set_alarm = host_set_alarm,
+    .trigger = host_trigger,
+    .clear_irq = host_clear_irq,
+    .ctx = &hw,
+};
+
+static unsigned long block_ns = 2000;     // 割り込みの開始の遅れの最大値
+static unsigned long long isr_ns;         // 割り込みの処理時間の合計
+static unsigned long long last_deadline;  // 最後に呼んだコールバックの期限
+static unsigned long errors;              // 見つけた誤り
+static unsigned long latency_count;       // 記録した遅れの数
+static unsigned long latencies[MAX_LATENCIES]; // 期限からコールバックまでの遅れ [ns]
+
+// 仮想時刻が end_ns になるまで割り込みを実行する
+static void run_until(unsigned long long end_ns)
+{
+    while (1)
+    {
+        unsigned long long next_ns = hw.forced ? hw.clock_ns : hw.armed ? hw.fire_us * 1000 : ~0ull;
+        if (next_ns >= end_ns)
+        {
+            hw.clock_ns = hw.clock_ns > end_ns ? hw.clock_ns : end_ns;
+            return;
+        }
+        unsigned long long start_ns = hw.clock_ns > next_ns ? hw.clock_ns : next_ns;
+        if (block_ns)
+        {
+            start_ns += rng() % block_ns;
+        }
+        if (!hw.forced)
+        {
+            hw.armed = 0; // アラームは 1 回割り込むと止まる
+        }
+        hw.clock_ns = start_ns + IRQ_ENTRY_NS;
+        timer_service_handle(&ts);
+        hw.clock_ns += IRQ_EXIT_NS;
+        isr_ns += hw.clock_ns - start_ns;
+    }
+}
+
+// ヒープの高さ (1 つのタイマーを並べ直すときの最大の段数)
+static int heap_levels(int count)
+{
+    int levels = 0;
+    while (count > 1)
+    {
+        count >>= 1;
+        levels++;
+    }
+    return levels;
+}
+
+// コールバックが呼ばれた期限 fired を確かめて遅れを記録し、処理時間だけ時刻を進める
+static void on_fire(unsigned long long fired)
+{
+    unsigned long long fired_ns = fired * 1000;
+    errors += fired_ns > hw.clock_ns;    // 期限より早い
+    errors += fired < last_deadline;     // 期限の順になっていない
+    last_deadline = fired;
+    if (latency_count < MAX_LATENCIES)
+    {
+        latencies[latency_count++] = (unsigned long)(hw.clock_ns - fired_ns);
+    }
+    hw.clock_ns += EVENT_NS + HEAP_LEVEL_NS * heap_levels(ts.count + 1) + CALLBACK_NS;
+}
+
+// シミュレーションのタイマー
+typedef struct
+{
+    timer_event ev;              // タイマー
+    unsigned long long start_us; // 最初の期限 (周期タイマー)
+    unsigned long fired;         // 呼ばれた回数
+    int cancelled;               // 止めた
+} sim_timer;
+
+static sim_timer timers[MAX_TIMERS];
+
+// 周期タイマーのコールバック
+static void periodic_callback(timer_event *ev, void *arg)
+{
+    sim_timer *t = arg;
+    // 期限は開始時刻 + 周期の倍数のまま (ev->deadline_us はもう次の期限になっている)
+    errors += (ev->deadline_us - t->start_us) % ev->period_us != 0;
+    errors += t->cancelled;
+    t->fired++;
+    on_fire(ev->deadline_us - ev->period_us);
+}
+
+// 単発タイマーのコールバック: 0.1〜500ms 後の次の期限を設定する
+static void oneshot_callback(timer_event *ev, void *arg)
+{
+    sim_timer *t = arg;
+    errors += t->cancelled;
+    t->fired++;
+    on_fire(ev->deadline_us);
+    timer_service_start_at(&ts, ev, ev->deadline_us + 100 + rng() % 500000, 0);
+}
+
+// 期限の順を確かめず、呼ばれた回数だけ数えるコールバック
+static void count_callback(timer_event *ev, void *arg)
+{
+    sim_timer *t = arg;
+    t->fired++;
+    unsigned long long fired = ev->period_us ? ev->deadline_us - ev->period_us : ev->deadline_us;
+    latencies[0] = (unsigned long)(hw.clock_ns - fired * 1000);
+}
+
+// 状態を初期化する
+static void reset(void)
+{
+    hw = (host_hw){0};
+    hw.clock_ns = 1000000; // 1ms から始める
+    isr_ns = 0;
+    last_deadline = 0;
+    latency_count = 0;
+    timer_service_init(&ts, &host, heap, MAX_TIMERS);
+}
+
+// periodic 個の周期タイマー (1〜1000ms) と oneshot 個の単発タイマーを動かす
+static void start_timers(int periodic, int oneshot)
+{
+    unsigned long long now = hw.clock_ns / 1000;
+    for (int i = 0; i < periodic + oneshot; i++)
+    {
+        sim_timer *t = &timers[i];
+        *t = (sim_timer){0};
+        if (i < periodic)
+        {
+            unsigned long period = 1000 + rng() % 999000;
+            timer_event_init(&t->ev, periodic_callback, t);
+            t->start_us = now + 1 + rng() % period;
+            timer_service_start_at(&ts, &t->ev, t->start_us, period);
+        }
+        else
+        {
+            timer_event_init(&t->ev, oneshot_callback, t);
+            timer_service_start_at(&ts, &t->ev, now + 100 + rng() % 500000, 0);
+        }
+    }
+}
+
+static int compare_ulong(const void *a, const void *b)
+{
+    unsigned long x = *(const unsigned long *)a, y = *(const unsigned long *)b;
+    return x < y ? -1 : x > y;
+}
+
+// 数千個のタイマーを動かして、期限の順序・周期・取り消しを確かめる。失敗の数を返す
+static int check_order(void)
+{
+    const int periodic = 4000, oneshot = 1000;
+    reset();
+    start_timers(periodic, oneshot);
+    run_until(hw.clock_ns + 1000000000ull);
+
+    // 周期タイマーの 1 割と単発タイマーの 1 割を止めて、さらに 1 秒動かす
+    unsigned long before[MAX_TIMERS];
+    for (int i = 0; i < periodic + oneshot; i++)
+    {
+        if (i % 10 == 0)
+        {
+            timer_service_cancel(&ts, &timers[i].ev);
+            timers[i].cancelled = 1;
+            errors += timer_event_active(&timers[i].ev);
+        }
+        before[i] = timers[i].fired;
+    }
+    run_until(hw.clock_ns + 1000000000ull);
+
+    unsigned long callbacks = 0;
+    int silent = 0; // 止めていないのに呼ばれなかったタイマー (周期 1 秒未満なので必ず呼ばれる)
+    for (int i = 0; i < periodic + oneshot; i++)
+    {
+        callbacks += timers[i].fired;
+        silent += !timers[i].cancelled && timers[i].fired == before[i];
+    }
+    const timer_service_stats *s = timer_service_get_stats(&ts);
+    int ok = errors == 0 && silent == 0 && s->overruns == 0 && ts.count == (periodic + oneshot) * 9 / 10;
+    printf("%d periodic + %d one-shot timers, 10%% cancelled after 1 s: %lu callbacks in %lu IRQs, "
+           "order/period/cancel errors %lu, silent %d, overruns %lu: %s\n",
+           periodic, oneshot, callbacks, s->interrupts, errors, silent, s->overruns, ok ? "ok" : "FAIL");
+    errors = 0;
+    return !ok;
+}
+
+// 32 ビットのアラームを超える期限を確かめる。失敗の数を返す
+static int check_far_deadline(void)
+{
+    reset();
+    sim_timer *t = &timers[0];
+    *t = (sim_timer){0};
+    timer_event_init(&t->ev, count_callback, t);
+    unsigned long long deadline = hw.clock_ns / 1000 + (1ull << 33);
+    timer_service_start_at(&ts, &t->ev, deadline, 0);
+    run_until((deadline + 1000000) * 1000);
+    int ok = t->fired == 1 && latencies[0] < 10000;
+    printf("one-shot 2^33 us ahead: fired %lu time(s), %lu ns late, %lu wake-ups on the way: %s\n", t->fired,
+           latencies[0], timer_service_get_stats(&ts)->interrupts, ok ? "ok" : "FAIL");
+    return !ok;
+}
+
+// タイマーの数ごとに割り込みの負荷と遅れを測る
+static void measure_jitter(int periodic, double seconds)
+{
+    reset();
+    start_timers(periodic, periodic / 4);
+    unsigned long long t0 = hw.clock_ns;
+    run_until(t0 + (unsigned long long)(seconds * 1e9));
+    double elapsed = (hw.clock_ns - t0) * 1e-9;
+
+    qsort(latencies, latency_count, sizeof latencies[0], compare_ulong);
+    double mean = 0;
+    for (unsigned long i = 0; i < latency_count; i++)
+    {
+        mean += latencies[i];
+    }
+    mean = latency_count ? mean / latency_count : 0;
+    const timer_service_stats *s = timer_service_get_stats(&ts);
+    printf("%7d %10.0f %9.0f %8.2f %8.3f%% %9.0f %9lu %9lu %8lu %5lu\n", periodic + periodic / 4, latency_count / elapsed,
+           s->interrupts / elapsed, (double)latency_count / s->interrupts, 100.0 * isr_ns / (hw.clock_ns - t0), mean,
+           latency_count ? latencies[latency_count * 99 / 100] : 0, latency_count ? latencies[latency_count - 1] : 0,
+           s->max_latency_us, s->overruns);
+    errors = 0;
+}
+
+// 250ms の点滅を 1 時間続けたときのずれ
+static void measure_drift(void)
+{
+    const unsigned long period_us = 250000;
+    const unsigned long cycles = 3600ul * 1000000 / period_us;
+
+    // 以前: 割り込みに入ってから get_time() + 250ms をアラームに設定する (遅れの分だけ次の割り込みが遅れる)
+    unsigned long long t_ns = 0, alarm_us = period_us;
+    for (unsigned long i = 0; i < cycles; i++)
+    {
+        t_ns = alarm_us * 1000 + (block_ns ? rng() % block_ns : 0) + IRQ_ENTRY_NS + TIMER_READ_NS;
+        alarm_us = t_ns / 1000 + period_us;
+    }
+    double old_drift_ms = (t_ns - (unsigned long long)cycles * period_us * 1000) * 1e-6;
+
+    // タイマーサービス: 前の期限 + 250ms
+    reset();
+    sim_timer *t = &timers[0];
+    *t = (sim_timer){0};
+    timer_event_init(&t->ev, count_callback, t);
+    unsigned long long start_us = hw.clock_ns / 1000 + period_us;
+    timer_service_start_at(&ts, &t->ev, start_us, period_us);
+    run_until((start_us + (cycles - 1) * (unsigned long long)period_us) * 1000 + 100000);
+    double new_drift_ms = latencies[0] * 1e-6; // 最後のコールバックの期限からの遅れ
+    printf("250 ms blink after 1 hour (%lu toggles, IRQ blocking up to %lu ns): reload from now %+.3f ms, "
+           "timer service %+.6f ms (%lu toggles)\n",
+           cycles, block_ns, old_drift_ms, new_drift_ms, t->fired);
+}
+
+static unsigned long long bench_now; // ホストの処理時間を測るときの時刻
+
+static unsigned long long bench_now_us(void *ctx)
+{
+    (void)ctx;
+    return bench_now;
+}
+
+static void bench_set_alarm(void *ctx, unsigned long long time_us)
+{
+    (void)ctx;
+    (void)time_us;
+}
+
+static void bench_nop(void *ctx)
+{
+    (void)ctx;
+}
+
+static void bench_callback(timer_event *ev, void *arg)
+{
+    (void)ev;
+    (void)arg;
+}
+
+// ホストの CPU で追加と期限の処理の時間を測る
+static void bench(int count)
+{
+    static const timer_service_hw bench_hw = {
+        .now_us = bench_now_us, .set_alarm = bench_set_alarm, .trigger = bench_nop, .clear_irq = bench_nop, .ctx = 0};
+    const int rounds = 20;
+    double insert_s = 0, event_s = 0;
+    unsigned long events = 0;
+    for (int r = 0; r < rounds; r++)
+    {
+        bench_now = 0;
+        timer_service_init(&ts, &bench_hw, heap, MAX_TIMERS);
+        for (int i = 0; i < count; i++)
+        {
+            timer_event_init(&timers[i].ev, bench_callback, 0);
+        }
+        double t0 = now_sec();
+        for (int i = 0; i < count; i++)
+        {
+            timer_service_start_at(&ts, &timers[i].ev, 1 + rng() % 1000000, 1 + rng() % 1000000);
+        }
+        double t1 = now_sec();
+        for (int i = 0; i < 20 * count; i++)
+        {
+            bench_now = ts.heap[0]->deadline_us; // 先頭の期限の割り込み
+            timer_service_handle(&ts);
+        }
+        double t2 = now_sec();
+        insert_s += t1 - t0;
+        event_s += t2 - t1;
+        events += ts.stats.callbacks;
+    }
+    int levels = heap_levels(count);
+    double insert_ns = insert_s * 1e9 / ((double)rounds * count), event_ns = event_s * 1e9 / events;
+    printf("%7d %6d %10.1f %10.1f %12.1f\n", count, levels, insert_ns, event_ns, levels ? event_ns / levels : 0);
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 2;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:s:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'j':
+            block_ns = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            seconds = strtod(optarg, NULL);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-j block_ns] [-s seconds]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds <= 0)
+    {
+        fprintf(stderr, "usage: %s [-j block_ns] [-s seconds]\n", argv[0]);
+        return 2;
+    }
+
+    int failures = check_order();
+    failures += check_far_deadline();
+
+    printf("periodic (1-1000 ms) + one-shot timers for %.1f s, IRQ blocking up to %lu ns (latency in ns):\n", seconds,
+           block_ns);
+    printf("%7s %10s %9s %8s %9s %9s %9s %9s %8s %5s\n", "timers", "events/s", "IRQ/s", "ev/IRQ", "ISR load", "mean",
+           "p99", "max", "max us", "over");
+    static const int sizes[] = {8, 80, 800, 4000, 6400};
+    for (size_t i = 0; i < sizeof sizes / sizeof sizes[0]; i++)
+    {
+        measure_jitter(sizes[i], seconds);
+    }
+
+    measure_drift();
+
+    printf("host CPU per operation (ns):\n%7s %6s %10s %10s %12s\n", "timers", "levels", "insert", "event",
+           "event/level");
+    static const int bench_sizes[] = {16, 256, 4096, 8192};
+    for (size_t i = 0; i < sizeof bench_sizes / sizeof bench_sizes[0]; i++)
+    {
+        bench(bench_sizes[i]);
+    }
+    return failures != 0;
+}
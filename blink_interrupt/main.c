@@ -1,16 +1,45 @@
-#include "reg.h"          // レジスタ定義のヘッダーファイル
-#include "hardware/irq.h" // 割り込み関連のヘッダーファイル
+#include "reg.h"                // レジスタ定義のヘッダーファイル
+#include "hardware/irq.h"       // 割り込み関連のヘッダーファイル
+#include "timer_service.h"      // タイマーサービス (複数のタイマーを 1 つのアラームで動かす)
+#include "timer_service_pico.h" // レジスタを直接操作する timer_service_hw
+#include "idle.h"               // アイドル処理 (割り込みを待つ間 CPU を眠らせる)
+#include "idle_pico.h"          // レジスタを直接操作する idle_hw
+#include "trace.h"              // トレースポイント (処理の時間を測る)
+
+#define TIMER_ALARM 0               // タイマーサービスが使う TIMER0 のアラーム (割り込み番号も同じ)
+#define BLINK_PERIOD_US 250000      // GPIO10 の LED の点滅の間隔 [us]
+#define HEARTBEAT_PIN 11            // 一瞬だけ光らせる LED の GPIO
+#define HEARTBEAT_PERIOD_US 1000000 // GPIO11 の LED を光らせる間隔 [us]
+#define HEARTBEAT_ON_US 50000       // GPIO11 の LED を光らせておく時間 [us]
+#define NUM_TIMERS 4                // 同時に動かせるタイマーの数
+#define TRACE_TIMER_BEGIN 0         // トレースポイントの番号: タイマー割り込みの始まり
+#define TRACE_TIMER_END 1           // トレースポイントの番号: タイマー割り込みの終わり
+#define TRACE_READ_COUNT 16         // 1 回に取り出す記録の数
+
+static timer_service Timers;                 // タイマーサービス
+static timer_event *TimerHeap[NUM_TIMERS];   // タイマーサービスのヒープ
+static timer_event BlinkTimer;               // GPIO10 の点滅 (周期)
+static timer_event HeartbeatTimer;           // GPIO11 を光らせる (周期)
+static timer_event HeartbeatOffTimer;        // GPIO11 を消す (単発)
+static idle Idle;                            // アイドル処理 (眠っていた時間・起きていた時間を数える)
+static trace_buffer Trace;                   // トレースのリングバッファ
+static trace_span TimerSpan;                 // タイマー割り込みのサイクル数の統計 (デバッガで見る)
+static volatile unsigned long TraceOverhead; // TRACE_POINT() 1 回のサイクル数 (TimerSpan から引いて見る)
 
 // LEDの初期化を行う関数
 static void init_led(void);
-// 現在の時間を取得する関数
-static unsigned long long get_time(void);
-// タイマー0のアラーム0を再設定する関数
-static void reload_alarm0(void);
+// GPIO10 の LED を反転させる関数 (BlinkTimer のコールバック)
+static void blink(timer_event *ev, void *arg);
+// GPIO11 の LED を点灯させる関数 (HeartbeatTimer のコールバック)
+static void heartbeat_on(timer_event *ev, void *arg);
+// GPIO11 の LED を消灯する関数 (HeartbeatOffTimer のコールバック)
+static void heartbeat_off(timer_event *ev, void *arg);
 // タイマー割り込みが発生した際に実行される関数
 static void timer_interrupt(void);
 // タイマー関連の初期化を行う関数
 static void init_timer(void);
+// トレースの記録を取り出して、タイマー割り込みのサイクル数の統計に加える関数
+static void update_trace(void);
 
 // LEDの初期化を行う関数
 static void init_led(void)
@@ -23,40 +52,28 @@ static void init_led(void)
 
     /* GPIOとして使う為の設定 */
     // IOバンク0のGPIO10番ピンをGPIO機能として設定 (値5はGPIOモードを示す)
-    IO_BANK0_GPIO10_CTRL_RW = 5;
+    IO_BANK0_GPIO_CTRL_RW(10) = 5;
     // IOバンク0のGPIO10番ピンのプルアップ/プルダウン抵抗などをクリア (デフォルト設定にする)
-    PADS_BANK0_BASE_GPIO10_CLR = 1 << 8;
+    PADS_BANK0_GPIO_CLR(10) = 1 << 8;
 
     // GPIO10番ピンの出力機能を有効にする (ここで初めて出力が可能になる)
     SIO_GPIO_OE_SET = 1 << 10;
-}
 
-// 現在の時間を取得する関数 (64ビットのunsigned long long型で返す)
-static unsigned long long get_time(void)
-{
-    // タイマー0の下位32ビットの値を読み込む (volatile指定で最適化を防ぐ)
-    volatile unsigned long time_l = (TIMER0_TIMELR);
-    // タイマー0の上位32ビットの値を読み込む (volatile指定で最適化を防ぐ)
-    volatile unsigned long time_h = (TIMER0_TIMEHR);
-    // 上位32ビットを左に32ビットシフトし、下位32ビットと論理和を取ることで64ビットの値を合成する
-    return ((unsigned long long)time_h << 32u) | time_l;
-}
-
-// タイマー0のアラーム0を再設定する関数
-static void reload_alarm0(void)
-{
-    // 現在の時間に250000マイクロ秒 (250ミリ秒) を加えた値を、アラーム0に設定する
-    TIMER0_ALARM0 = (unsigned long)(get_time() + 250000);
+    // GPIO11番ピンも同じように設定する (番号で指定できるレジスタを使う)
+    SIO_GPIO_OE_CLR = 1 << HEARTBEAT_PIN;
+    SIO_GPIO_OUT_CLR = 1 << HEARTBEAT_PIN;
+    IO_BANK0_GPIO_CTRL_RW(HEARTBEAT_PIN) = 5;
+    PADS_BANK0_GPIO_CLR(HEARTBEAT_PIN) = 1 << 8;
+    SIO_GPIO_OE_SET = 1 << HEARTBEAT_PIN;
 }
 
-// タイマー割り込みが発生した際に実行される関数
-static void timer_interrupt(void)
+// GPIO10 の LED を反転させる関数 (BlinkTimer のコールバック)
+static void blink(timer_event *ev, void *arg)
 {
-    reload_alarm0();      // 次の割り込みタイミングを設定する
-    TIMER0_INTR = 1 << 0; // タイマー0の割り込みフラグをクリアする (これを行わないと、割り込みが止まらない)
-
+    (void)ev;
+    (void)arg;
     // GPIO10番ピンの出力状態をチェックする
-    if ((SIO_GPIO_OUT_RW >> 10) & 1)
+    if ((SIO_GPIO_OUT >> 10) & 1)
     {
         // GPIO10番ピンの10ビット目が1 (HIGH、LEDが点灯している) 場合
         SIO_GPIO_OUT_CLR = 1 << 10; // GPIO10番ピンをクリア (LOW、LEDを消灯する)
@@ -68,17 +85,62 @@ static void timer_interrupt(void)
     }
 }
 
+// GPIO11 の LED を点灯させる関数 (HeartbeatTimer のコールバック)
+static void heartbeat_on(timer_event *ev, void *arg)
+{
+    (void)arg;
+    SIO_GPIO_OUT_SET = 1 << HEARTBEAT_PIN;
+    // 消灯の単発タイマーは、点灯した期限から数える (割り込みが遅れても光っている時間は変わらない)
+    timer_service_start_at(&Timers, &HeartbeatOffTimer, ev->deadline_us - ev->period_us + HEARTBEAT_ON_US, 0);
+}
+
+// GPIO11 の LED を消灯する関数 (HeartbeatOffTimer のコールバック)
+static void heartbeat_off(timer_event *ev, void *arg)
+{
+    (void)ev;
+    (void)arg;
+    SIO_GPIO_OUT_CLR = 1 << HEARTBEAT_PIN;
+}
+
+// タイマー割り込みが発生した際に実行される関数
+static void timer_interrupt(void)
+{
+    // 割り込みフラグをクリアし、期限が来たタイマーのコールバックを呼んで、次の期限にアラームを設定する
+    // (次の期限は前の期限に周期を足して決めるので、割り込みの遅れで点滅の間隔がずれていかない)
+    TRACE_POINT(&Trace, TRACE_TIMER_BEGIN);
+    timer_service_handle(&Timers);
+    TRACE_POINT(&Trace, TRACE_TIMER_END);
+}
+
 // タイマー関連の初期化を行う関数
 static void init_timer(void)
 {
+    // アラーム0でタイマーサービスを初期化し、タイマーを登録する
+    timer_service_init(&Timers, timer_service_pico_hw(TIMER_ALARM), TimerHeap, NUM_TIMERS);
+    timer_event_init(&BlinkTimer, blink, 0);
+    timer_event_init(&HeartbeatTimer, heartbeat_on, 0);
+    timer_event_init(&HeartbeatOffTimer, heartbeat_off, 0);
+
     // 割り込み番号0に、タイマー割り込みハンドラ (timer_interrupt関数) を設定する
-    irq_set_exclusive_handler(0, timer_interrupt);
+    irq_set_exclusive_handler(TIMER_ALARM, timer_interrupt);
     // 割り込み番号0を有効にする
-    irq_set_enabled(0, 1);
-    // 最初の割り込みタイミングを設定する
-    reload_alarm0();
+    irq_set_enabled(TIMER_ALARM, 1);
+    // タイマーを動かす (最初の期限にアラームが設定される)。割り込みを有効にする前なので、割り込みと重ならない
+    timer_service_start(&Timers, &BlinkTimer, BLINK_PERIOD_US, BLINK_PERIOD_US);
+    timer_service_start(&Timers, &HeartbeatTimer, HEARTBEAT_PERIOD_US, HEARTBEAT_PERIOD_US);
     // タイマー0のアラーム0割り込みを有効にする
-    TIMER0_INTE = 1 << 0;
+    TIMER0_INTE_SET = 1 << TIMER_ALARM;
+}
+
+// トレースの記録を取り出して、タイマー割り込みのサイクル数の統計に加える関数
+static void update_trace(void)
+{
+    trace_event events[TRACE_READ_COUNT];
+    unsigned long n;
+    while ((n = trace_read(&Trace, events, TRACE_READ_COUNT)) != 0)
+    {
+        trace_span_add(&TimerSpan, events, n);
+    }
 }
 
 // メイン関数 (プログラムのエントリーポイント)
@@ -86,6 +148,22 @@ void main(void)
 {
     // LEDの初期化
     init_led();
+    // 使わないブロック (PIO・SPI・I2C・UART・ADC・USB・PWM など) のクロックを止めてリセットしたままにする
+    idle_pico_gate(CLK_EN0_ADC | CLK_EN0_SYS_ADC | CLK_EN0_HSTX | CLK_EN0_SYS_HSTX | CLK_EN0_SYS_I2C0 |
+                       CLK_EN0_SYS_I2C1 | CLK_EN0_SYS_PIO0 | CLK_EN0_SYS_PIO1 | CLK_EN0_SYS_PIO2 | CLK_EN0_SYS_PWM |
+                       CLK_EN0_SYS_SHA256,
+                   CLK_EN1_PERI_SPI0 | CLK_EN1_SYS_SPI0 | CLK_EN1_PERI_SPI1 | CLK_EN1_SYS_SPI1 | CLK_EN1_SYS_TRNG |
+                       CLK_EN1_PERI_UART0 | CLK_EN1_SYS_UART0 | CLK_EN1_PERI_UART1 | CLK_EN1_SYS_UART1 |
+                       CLK_EN1_SYS_USBCTRL | CLK_EN1_USB,
+                   RESETS_ADC | RESETS_HSTX | RESETS_I2C0 | RESETS_I2C1 | RESETS_PIO0 | RESETS_PIO1 | RESETS_PIO2 |
+                       RESETS_PWM | RESETS_SHA256 | RESETS_SPI0 | RESETS_SPI1 | RESETS_TRNG | RESETS_UART0 |
+                       RESETS_UART1 | RESETS_USBCTRL);
+    idle_init(&Idle, idle_pico_hw());
+    // サイクルカウンタを動かし、トレースを初期化する
+    timebase_init();
+    TraceOverhead = trace_overhead_cycles(&Trace);
+    trace_init(&Trace);
+    trace_span_init(&TimerSpan, TRACE_TIMER_BEGIN, TRACE_TIMER_END);
     // タイマーの初期化 (割り込み設定を含む)
     init_timer();
 
@@ -94,5 +172,9 @@ void main(void)
     {
         // 割り込みが発生していない間は、ここで別の処理を実行できる
         // 例: 他のセンサーの値を読む、通信を行う、など
+        // することがなければ次の割り込みまで眠る (割り込みの処理は起きていた時間として Idle.stats に数える)
+        idle_sleep(&Idle);
+        // 割り込みで記録したトレースを統計に加える
+        update_trace();
     }
 }
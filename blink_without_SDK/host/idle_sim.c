@@ -0,0 +1,364 @@
+#include <stdio.h>     // 標準入出力ライブラリ
+#include <stdlib.h>    // strtoul, exit
+#include <unistd.h>    // getopt
+#include "host_util.h" // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "idle.h"      // アイドル処理 (blink_without_SDK と同じソース)
+
+// アイドル処理をホストの仮想時刻で動かす
+//
+// 使い方: idle_sim [-w wake_us] [-s seconds]
+//   -w  アラーム以外で WFE が起きる (他の割り込みなどのイベント) 平均の間隔 [us] (既定 0 = 起きない)
+//   -s  割り込みで動くプログラムを動かす時間 [秒] (既定 10)
+//
+// アラームは実機と同じく時刻の下位 32 ビットが一致したときに 1 回だけ保留になり (SEVONPEND でイベントになる)、
+// 時刻を過ぎて設定したものは次に一致するまで (約 71 分) 起きない。レジスタの操作や起きるまでの時間は
+// 下の値で進める (150MHz の Cortex-M33 の見積もり)。
+//
+// 1. 乱数の期限 (過ぎたもの・数 us 先のものを含む) と、頻繁に起きる余計なイベントで idle_wait_until() を
+//    繰り返し、期限より早く戻らないこと、期限から WAKE_NS 程度で戻ること、止まったままにならないこと、
+//    眠っていた時間 + 起きていた時間が経過時間に一致することを確かめる。
+// 2. main.c の 250ms 点滅 1 回あたりの、起きていた割合・起きた回数・エネルギーを、以前の時刻を読み続ける
+//    wait_ms() と比べる (使わないクロックを止めた場合と止めない場合)。
+// 3. 割り込みで動くプログラム (blink_interrupt・software_pwm) のメインループを idle_sleep() にしたときの、
+//    起きていた割合・平均電流を、何もしないループ (ずっと起きている) と比べる。
+
+#define TIMER_READ_NS 60   // 64 ビットの時刻の読み出し
+#define ALARM_WRITE_NS 150 // アラームの設定・取り消し (レジスタ 5 回)
+#define IRQ_MASK_NS 10     // cpsid / cpsie
+#define WAKE_NS 400        // WFE / WFI で眠ってから起きるまで (SLEEPDEEP でクロックを止めた分)
+#define IRQ_ENTRY_NS 100   // 割り込みに入るまで
+#define IRQ_EXIT_NS 70     // 割り込みから戻るまで
+#define LOOP_NS 20         // 時刻を読み続ける wait_ms() の 1 周 (比較・分岐)
+#define SLEEP_UNGATED_UA 6000 // クロックを止めない場合の眠っている間の電流 [uA] (見積もり)
+#define MAX_WAIT_NS 1000000000ull // 1 回の WFE / WFI でこれより長く眠ったら止まったままとみなす
+#define MAX_LATE_NS 2000          // 期限からこれより遅れて戻ったら誤りとする
+
+// ホストのハードウェア (仮想時刻)
+typedef struct
+{
+    unsigned long long clock_ns;     // 仮想時刻
+    unsigned long long fire_us;      // アラームが保留になる時刻
+    int armed;                       // アラームが設定されていて、まだ保留になっていない
+    int event;                       // イベントレジスタ (WFE をすぐに戻す)
+    unsigned long wake_us;           // 余計なイベントの平均の間隔 [us] (0 なら起きない)
+    unsigned long long next_wake_ns; // 次の余計なイベントの時刻
+    unsigned long irq_period_ns;     // 割り込みの間隔 [ns] (0 なら起きない)
+    unsigned long isr_ns;            // 割り込みの処理時間 [ns]
+    unsigned long long next_irq_ns;  // 次の割り込みの時刻
+    int irq_pending;                 // 割り込みが保留になっている
+    int irq_masked;                  // 割り込みが禁止されている
+    unsigned long long slept_ns;     // 実際に眠っていた時間
+} host_hw;
+
+static host_hw hw;
+
+// 次の余計なイベントの時刻を決める (平均 wake_us の一様乱数の間隔)
+static void schedule_wake(host_hw *h)
+{
+    h->next_wake_ns = h->wake_us ? h->clock_ns + rng() % (2000ull * h->wake_us) + 1 : ~0ull;
+}
+
+static void run_isr(host_hw *h);
+
+// 仮想時刻までに起きたことを反映する
+static void update(host_hw *h)
+{
+    if (h->armed && h->clock_ns >= h->fire_us * 1000)
+    {
+        h->armed = 0;
+        h->event = 1; // 保留になったときに 1 回だけイベントになる
+    }
+    if (h->clock_ns >= h->next_wake_ns)
+    {
+        h->event = 1;
+        schedule_wake(h);
+    }
+    if (h->irq_period_ns && h->clock_ns >= h->next_irq_ns)
+    {
+        h->irq_pending = 1;
+        h->event = 1;
+    }
+    if (h->irq_pending && !h->irq_masked)
+    {
+        run_isr(h);
+    }
+}
+
+// 保留になった割り込みを処理する
+static void run_isr(host_hw *h)
+{
+    h->irq_pending = 0;
+    h->clock_ns += IRQ_ENTRY_NS + h->isr_ns + IRQ_EXIT_NS;
+    h->next_irq_ns += h->irq_period_ns;
+    update(h);
+}
+
+// 次に起きる時刻まで眠る
+static void sleep_until(host_hw *h, unsigned long long wake_ns)
+{
+    if (wake_ns == ~0ull || wake_ns - h->clock_ns > MAX_WAIT_NS)
+    {
+        fprintf(stderr, "stuck in sleep at %llu ns\n", h->clock_ns);
+        exit(1);
+    }
+    h->slept_ns += wake_ns - h->clock_ns;
+    h->clock_ns = wake_ns;
+    update(h);
+    h->clock_ns += WAKE_NS;
+}
+
+static unsigned long long host_now_us(void *ctx)
+{
+    host_hw *h = ctx;
+    h->clock_ns += TIMER_READ_NS;
+    update(h);
+    return h->clock_ns / 1000;
+}
+
+static void host_cancel_alarm(void *ctx)
+{
+    host_hw *h = ctx;
+    h->clock_ns += ALARM_WRITE_NS;
+    h->armed = 0;
+    update(h);
+}
+
+static void host_set_alarm(void *ctx, unsigned long long time_us)
+{
+    host_hw *h = ctx;
+    host_cancel_alarm(ctx);
+    // 下位 32 ビットが次に一致する時刻 (過ぎていれば 2^32 us 後)
+    unsigned long long now_us = h->clock_ns / 1000;
+    unsigned long long fire = (now_us & ~0xffffffffull) | (time_us & 0xffffffffull);
+    if (fire < now_us)
+    {
+        fire += 1ull << 32;
+    }
+    h->fire_us = fire;
+    h->armed = 1;
+    update(h);
+}
+
+static void host_wait_event(void *ctx)
+{
+    host_hw *h = ctx;
+    update(h);
+    if (h->event)
+    {
+        h->event = 0; // イベントがあればクリアしてすぐに戻る
+        return;
+    }
+    unsigned long long wake = h->next_wake_ns;
+    if (h->armed && h->fire_us * 1000 < wake)
+    {
+        wake = h->fire_us * 1000;
+    }
+    if (h->irq_period_ns && h->next_irq_ns < wake)
+    {
+        wake = h->next_irq_ns;
+    }
+    sleep_until(h, wake);
+    h->event = 0;
+}
+
+static void host_irq_disable(void *ctx)
+{
+    host_hw *h = ctx;
+    h->clock_ns += IRQ_MASK_NS;
+    update(h);
+    h->irq_masked = 1;
+}
+
+static void host_irq_enable(void *ctx)
+{
+    host_hw *h = ctx;
+    h->clock_ns += IRQ_MASK_NS;
+    h->irq_masked = 0;
+    update(h);
+}
+
+static void host_wait_interrupt(void *ctx)
+{
+    host_hw *h = ctx;
+    update(h);
+    if (!h->irq_pending)
+    {
+        sleep_until(h, h->next_irq_ns);
+    }
+}
+
+static const idle_hw host = {
+    .now_us = host_now_us,
+    .set_alarm = host_set_alarm,
+    .cancel_alarm = host_cancel_alarm,
+    .wait_event = host_wait_event,
+    .irq_disable = host_irq_disable,
+    .irq_enable = host_irq_enable,
+    .wait_interrupt = host_wait_interrupt,
+    .ctx = &hw,
+};
+
+// ハードウェアを初期状態にする
+static void reset_hw(unsigned long wake_us, unsigned long irq_per_s, unsigned long isr_ns)
+{
+    hw = (host_hw){0};
+    hw.clock_ns = 0xfffff000ull * 1000; // 下位 32 ビットの桁上がりの少し前から始める
+    hw.wake_us = wake_us;
+    schedule_wake(&hw);
+    hw.irq_period_ns = irq_per_s ? 1000000000ul / irq_per_s : 0;
+    hw.isr_ns = isr_ns;
+    hw.next_irq_ns = hw.clock_ns + hw.irq_period_ns;
+}
+
+// 1. 乱数の期限で idle_wait_until() を繰り返して確かめる
+static int check_wait(void)
+{
+    idle id;
+    unsigned long early = 0, late = 0;
+    unsigned long long max_late_ns = 0;
+    const int rounds = 200000;
+    reset_hw(50, 0, 0);
+    unsigned long long start_ns = hw.clock_ns;
+    idle_init(&id, &host);
+    for (int i = 0; i < rounds; i++)
+    {
+        // 期限: 過ぎたもの・数 us 先のもの (アラームの設定と競合する)・数 ms 先のもの
+        unsigned long r = rng();
+        unsigned long long now = hw.clock_ns / 1000;
+        unsigned long long deadline = r % 4 == 0 ? now - r % 100 : r % 4 == 1 ? now + r % 4 : now + r % 3000;
+        hw.clock_ns += rng() % 2000; // 起きている間の処理
+        unsigned long long call_ns = hw.clock_ns;
+        idle_wait_until(&id, deadline);
+        if (hw.clock_ns / 1000 < deadline)
+        {
+            early++;
+            continue;
+        }
+        // 期限を過ぎてから戻るまで (期限を過ぎて呼んだ場合は呼んでから戻るまで)
+        unsigned long long from_ns = deadline * 1000 > call_ns ? deadline * 1000 : call_ns;
+        unsigned long long late_ns = hw.clock_ns - from_ns;
+        if (late_ns > max_late_ns)
+        {
+            max_late_ns = late_ns;
+        }
+        if (late_ns > MAX_LATE_NS)
+        {
+            late++;
+        }
+    }
+    const idle_stats *st = idle_get_stats(&id);
+    unsigned long long elapsed_us = id.mark_us - start_ns / 1000;
+    int ok = early == 0 && late == 0 && st->idle_us + st->busy_us == elapsed_us;
+    printf("%d waits (deadlines past / 0-3 us / 0-3 ms ahead, extra event every ~50 us): %lu early, %lu late "
+           "(max %llu ns after the deadline), idle + busy = %llu / %llu us, idle %llu us counted vs %llu us asleep, "
+           "%lu sleeps, %lu wake-ups: %s\n",
+           rounds, early, late, max_late_ns, st->idle_us + st->busy_us, elapsed_us, st->idle_us,
+           hw.slept_ns / 1000, st->sleeps, st->wakeups, ok ? "OK" : "NG");
+    return !ok;
+}
+
+// 2. 250ms 点滅 1 回あたりの起きていた割合・起きた回数・エネルギーを比べる
+static void measure_blink(unsigned long wake_us)
+{
+    idle id;
+    const int blinks = 1000;
+    reset_hw(wake_us, 0, 0);
+    unsigned long long start_ns = hw.clock_ns;
+    idle_init(&id, &host);
+    for (int i = 0; i < blinks * 2; i++)
+    {
+        hw.clock_ns += 20; // GPIO の出力の切り替え
+        idle_wait_us(&id, 250000);
+    }
+    const idle_stats *st = idle_get_stats(&id);
+    // idle_stats は us 単位で、1 回の点滅で起きている時間は数 us なので、仮想時刻で実際に眠っていた時間から求める
+    unsigned long long elapsed_ns = hw.clock_ns - start_ns;
+    idle_stats actual = {st->sleeps, st->wakeups, hw.slept_ns / 1000, (elapsed_ns - hw.slept_ns) / 1000};
+    double busy_us = (double)(elapsed_ns - hw.slept_ns) / 1000 / blinks;
+    double busy = (double)(elapsed_ns - hw.slept_ns) * 100 / elapsed_ns;
+
+    // 以前の wait_ms(): 時刻を読み続けるので、ずっと起きている
+    idle_stats poll = {0, 0, 0, elapsed_ns / 1000};
+    unsigned long long polls = elapsed_ns / blinks / (TIMER_READ_NS * 2 + LOOP_NS);
+
+    if (wake_us)
+    {
+        printf("250 ms blink, extra event every ~%lu us", wake_us);
+    }
+    else
+    {
+        printf("250 ms blink, no other events");
+    }
+    printf(", per blink (estimated %u uA awake, %u uA asleep gated, %u uA ungated, %u mV):\n", IDLE_ACTIVE_UA,
+           IDLE_SLEEP_UA, SLEEP_UNGATED_UA, IDLE_SUPPLY_MV);
+    printf("%-24s %10s %9s %9s %12s %10s\n", "wait_ms()", "awake us", "busy", "wake-ups", "timer reads", "energy uJ");
+    printf("%-24s %10.2f %8.4f%% %9s %12llu %10.1f\n", "poll TIMELR/TIMEHR", (double)elapsed_ns / 1000 / blinks,
+           100.0, "-", polls * 2, idle_energy_nj(&poll, IDLE_ACTIVE_UA, IDLE_SLEEP_UA, IDLE_SUPPLY_MV) / 1000.0 / blinks);
+    printf("%-24s %10.2f %8.4f%% %9.1f %12s %10.1f\n", "WFE, clocks running", busy_us, busy,
+           (double)st->wakeups / blinks, "-",
+           idle_energy_nj(&actual, IDLE_ACTIVE_UA, SLEEP_UNGATED_UA, IDLE_SUPPLY_MV) / 1000.0 / blinks);
+    printf("%-24s %10.2f %8.4f%% %9.1f %12s %10.1f\n", "WFE, unused clocks gated", busy_us, busy,
+           (double)st->wakeups / blinks, "-",
+           idle_energy_nj(&actual, IDLE_ACTIVE_UA, IDLE_SLEEP_UA, IDLE_SUPPLY_MV) / 1000.0 / blinks);
+}
+
+// 3. 割り込みで動くプログラムのメインループを idle_sleep() にしたときを比べる
+static void measure_irq(const char *name, unsigned long irq_per_s, unsigned long isr_ns, double seconds)
+{
+    idle id;
+    reset_hw(0, irq_per_s, isr_ns);
+    unsigned long long end_ns = hw.clock_ns + (unsigned long long)(seconds * 1e9);
+    idle_init(&id, &host);
+    while (hw.clock_ns < end_ns)
+    {
+        idle_sleep(&id);
+    }
+    const idle_stats *st = idle_get_stats(&id);
+    double total_us = (double)(st->busy_us + st->idle_us);
+    // nJ / mV = uC、uC / us = A
+    double avg_ma = idle_energy_nj(st, IDLE_ACTIVE_UA, IDLE_SLEEP_UA, IDLE_SUPPLY_MV) * 1000.0 / IDLE_SUPPLY_MV /
+                    total_us;
+    printf("%-30s %8lu %7lu %9.3f%% %10.0f %10.2f %10.2f\n", name, irq_per_s, isr_ns,
+           (double)st->busy_us * 100 / total_us, st->wakeups / (total_us / 1e6), avg_ma,
+           IDLE_ACTIVE_UA / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long wake_us = 0;
+    double seconds = 10;
+    int opt;
+    while ((opt = getopt(argc, argv, "w:s:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'w':
+            wake_us = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            seconds = strtod(optarg, NULL);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-w wake_us] [-s seconds]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds <= 0)
+    {
+        fprintf(stderr, "usage: %s [-w wake_us] [-s seconds]\n", argv[0]);
+        return 2;
+    }
+
+    int failures = check_wait();
+
+    measure_blink(wake_us);
+
+    printf("interrupt-driven main loop with idle_sleep() for %.1f s (estimated ISR bodies):\n", seconds);
+    printf("%-30s %8s %7s %10s %10s %10s %10s\n", "program", "IRQ/s", "ISR ns", "busy", "wake-ups/s", "avg mA",
+           "while(1) mA");
+    measure_irq("blink_interrupt (2 timers)", 6, 1500, seconds);
+    measure_irq("software_pwm PWM slices + IRQ", 198, 700, seconds);
+    measure_irq("software_pwm BCM 10 bit / 4 us", 2210, 2000, seconds);
+    measure_irq("software_pwm old 100 us tick", 10000, 1730, seconds);
+    return failures != 0;
+}
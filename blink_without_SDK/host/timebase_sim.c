@@ -0,0 +1,445 @@
+#include <pthread.h>    // pthread_create
+#include <sched.h>      // sched_yield
+#include <stdio.h>      // 標準入出力ライブラリ
+#include <stdlib.h>     // strtoul
+#include <unistd.h>     // getopt
+#include "host_util.h"  // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "timebase.h"   // 時刻とサイクル数の読み出し (rp2350/host/timebase_host.c)
+#include "trace.h"      // トレースポイント (rp2350/ の共通のソース)
+#include "trace_host.h" // バリアの位置で割り込みを模擬する
+
+// 時刻の読み方とトレースポイントをホストで確かめる
+//
+// 使い方: timebase_sim [-t threads] [-n records]
+//   -t  同時に記録するスレッドの数 (既定 3。TRACE_CHECK_LAP=0 の timebase_sim_nolap では 1 だけ)
+//   -n  1 つのスレッドが記録する数 (既定 500000)
+//
+// 1. TIMER0 のレジスタを模擬し、時刻を読む途中に割り込みが時刻を読む場合に、以前の get_time() (TIMELR → TIMEHR の
+//    ラッチ) と timebase_now_us() (TIMERAWH → TIMERAWL → TIMERAWH) が、読み始めから読み終わりまでの間の時刻を
+//    返すかを数える。
+// 2. 1 つのスレッドで、上書き・読めなかった数・書いている途中の記録の扱いと、区間の統計を確かめる。
+// 3. 記録や読み出しの途中のバリアの位置 (trace_host.h) に、1 周分より少ない・多い数の記録をする割り込みを入れ、
+//    壊れた記録を読まないこと、順序が保たれること、読んだ数 + 読めなかった数が記録した数に一致することを確かめる。
+// 4. 複数のスレッドで記録しながら別のスレッドで読み、同じことを確かめる。
+// 5. ホストの CPU で、1 回の記録の時間を測る。
+
+// ---- 1. 64 ビットの時刻の読み方 ----
+
+// TIMER0 の模擬
+typedef struct
+{
+    unsigned long long time_us; // 時刻
+    unsigned long latched_hi;   // TIMELR を読んだときにラッチした上位
+} timer_model;
+
+static timer_model timer;
+
+#define ISR_PERMILLE 300 // レジスタを読むごとに割り込みが入る確率 [‰]
+
+static int isr_armed; // 割り込みが入ってよい (1 回の読み出しの間に 1 回だけ入れる)
+
+// レジスタを読む間に時間が進み、ときどき割り込みが入って時刻を読む (以前の get_time() と同じ読み方)
+static void tick(void);
+
+static unsigned long read_timelr(void)
+{
+    tick();
+    timer.latched_hi = (unsigned long)(timer.time_us >> 32);
+    return (unsigned long)(timer.time_us & 0xffffffff);
+}
+
+static unsigned long read_timehr(void)
+{
+    tick();
+    return timer.latched_hi;
+}
+
+static unsigned long read_timerawl(void)
+{
+    tick();
+    return (unsigned long)(timer.time_us & 0xffffffff);
+}
+
+static unsigned long read_timerawh(void)
+{
+    tick();
+    return (unsigned long)(timer.time_us >> 32);
+}
+
+static void tick(void)
+{
+    timer.time_us += rng() % 2; // 1 回の読み出しで 0〜1 us 進む
+    if (isr_armed && rng() % 1000 < ISR_PERMILLE)
+    {
+        isr_armed = 0;
+        read_timelr(); // 割り込みの中で以前の get_time() と同じく TIMELR → TIMEHR を読む
+        read_timehr();
+    }
+}
+
+// 以前の get_time()
+static unsigned long long latched_read(void)
+{
+    unsigned long lo = read_timelr();
+    unsigned long hi = read_timehr();
+    return (unsigned long long)hi << 32 | lo;
+}
+
+// timebase_now_us() と同じ読み方
+static unsigned long long raw_read(void)
+{
+    unsigned long hi, lo;
+    do
+    {
+        hi = read_timerawh();
+        lo = read_timerawl();
+    } while (hi != read_timerawh());
+    return (unsigned long long)hi << 32 | lo;
+}
+
+// 下位 32 ビットの桁上がりの前後で何度も読み、間違った時刻を返した回数を数える
+static unsigned long count_bad_reads(unsigned long long (*read)(void), int rounds)
+{
+    unsigned long bad = 0;
+    for (int i = 0; i < rounds; i++)
+    {
+        timer.time_us = (1ull << 32) * (1 + rng() % 4) - rng() % 4;
+        isr_armed = 1; // 割り込みがどこに入るかは tick() で決める
+        unsigned long long start = timer.time_us;
+        unsigned long long t = read();
+        unsigned long long end = timer.time_us;
+        if (t < start || t > end)
+        {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+static int check_time_read(void)
+{
+    const int rounds = 100000;
+    unsigned long latched = count_bad_reads(latched_read, rounds);
+    unsigned long raw = count_bad_reads(raw_read, rounds);
+    int ok = raw == 0;
+    printf("64-bit time read across a 32-bit carry, IRQ reading the timer mid-read: TIMELR/TIMEHR latch %lu/%d wrong "
+           "(off by 2^32 us), TIMERAWH/L retry %lu/%d wrong: %s\n",
+           latched, rounds, raw, rounds, ok ? "OK" : "NG");
+    return !ok;
+}
+
+// ---- 2. 1 つのスレッドでの動作 ----
+
+static trace_buffer trace;
+static trace_event events[TRACE_SIZE * 4];
+
+static int check_single(void)
+{
+    int errors = 0;
+    trace_init(&trace);
+
+    // 1 周半記録すると、古い分は読めずに数える
+    const unsigned long total = TRACE_SIZE * 3 / 2;
+    for (unsigned long i = 0; i < total; i++)
+    {
+        trace_record(&trace, (unsigned char)(i % 255), i * 7);
+    }
+    unsigned long n = trace_read(&trace, events, TRACE_SIZE * 4);
+    errors += n != TRACE_SIZE || trace_lost(&trace) != total - TRACE_SIZE;
+    for (unsigned long i = 0; i < n; i++)
+    {
+        unsigned long seq = total - TRACE_SIZE + i;
+        errors += events[i].seq != seq || events[i].id != seq % 255 || events[i].cycles != seq * 7;
+    }
+
+    // 少しずつ読む
+    for (unsigned long i = 0; i < 10; i++)
+    {
+        trace_record(&trace, 1, i);
+    }
+    errors += trace_read(&trace, events, 4) != 4 || events[0].cycles != 0 || events[3].cycles != 3;
+    errors += trace_read(&trace, events, 100) != 6 || events[0].cycles != 4 || events[5].cycles != 9;
+    errors += trace_read(&trace, events, 100) != 0;
+
+    // 通し番号を取ったが書き終えていない記録 (割り込みが記録の途中に入った状態) では止まり、書き終えたら読める
+    unsigned long claimed = atomic_fetch_add(&trace.head, 1);
+    trace_record(&trace, 2, 100); // 途中に入った割り込みの記録
+    errors += trace_read(&trace, events, 100) != 0;
+    trace_entry *e = &trace.entries[claimed & (TRACE_SIZE - 1)];
+    atomic_store(&e->cycles, 99);
+    atomic_store(&e->tag, claimed << TRACE_ID_BITS | 3);
+    n = trace_read(&trace, events, 100);
+    errors += n != 2 || events[0].id != 3 || events[0].cycles != 99 || events[1].id != 2 || events[1].cycles != 100;
+
+    // 通し番号の下位 24 ビットが一周しても読める
+    trace_init(&trace);
+    atomic_store(&trace.head, TRACE_SEQ_MASK - 10);
+    trace.tail = TRACE_SEQ_MASK - 10;
+    for (unsigned long i = 0; i < 20; i++)
+    {
+        trace_record(&trace, 4, i);
+    }
+    errors += trace_read(&trace, events, 100) != 20 || events[19].cycles != 19 || trace_lost(&trace) != 0;
+
+    // 区間の統計: サイクル数の一周をまたぐ区間を数え、読めなかった記録をまたぐ区間は数えない
+    trace_span span;
+    trace_span_init(&span, 10, 11);
+    trace_init(&trace);
+    trace_record(&trace, 10, 100);
+    trace_record(&trace, 12, 110);
+    trace_record(&trace, 11, 130);
+    trace_record(&trace, 10, 0xfffffff0);
+    trace_record(&trace, 11, 0x10);
+    trace_record(&trace, 10, 500);
+    n = trace_read(&trace, events, 100);
+    trace_span_add(&span, events, n);
+    for (unsigned long i = 0; i < TRACE_SIZE + 1; i++)
+    {
+        trace_record(&trace, 12, 600);
+    }
+    trace_record(&trace, 11, 700);
+    n = trace_read(&trace, events, TRACE_SIZE * 4);
+    trace_span_add(&span, events, n);
+    errors += span.count != 2 || span.max_cycles != 0x20 || span.total_cycles != 0x20 + 30 || span.last_cycles != 0x20;
+
+    printf("single thread (%d entries): overwrite, lost count, partial reads, unfinished record, sequence wrap, spans: "
+           "%s\n",
+           TRACE_SIZE, errors ? "NG" : "OK");
+    return errors != 0;
+}
+
+// ---- 3. 記録や読み出しの途中の割り込み ----
+
+static unsigned long next_value;     // 次に記録する値 (通し番号と同じになる)
+static unsigned long burst;          // 割り込みで記録する数
+static unsigned long expected_seq;   // 次に読む通し番号の最小値
+static unsigned long received_count; // 読んだ数
+
+// 次の値を記録する (値を決めてから通し番号を取る、TRACE_POINT() と同じ順序)
+static void record_next(void)
+{
+    unsigned long value = next_value++;
+    trace_record(&trace, (unsigned char)(value % 255), value);
+}
+
+// 割り込み: burst 個記録する
+static void interrupt_burst(void)
+{
+    for (unsigned long i = 0; i < burst; i++)
+    {
+        record_next();
+    }
+}
+
+// 読んだ記録を確かめ、誤りの数を返す
+static int check_events(unsigned long n)
+{
+    int errors = 0;
+    for (unsigned long i = 0; i < n; i++)
+    {
+        errors += events[i].seq != events[i].cycles || events[i].id != events[i].cycles % 255 ||
+                  events[i].seq < expected_seq;
+        expected_seq = events[i].seq + 1;
+    }
+    received_count += n;
+    return errors;
+}
+
+static int check_interrupts(void)
+{
+#if TRACE_CHECK_LAP
+    static const unsigned long bursts[] = {1, TRACE_SIZE - 1, TRACE_SIZE, TRACE_SIZE + 1, TRACE_SIZE * 2};
+    const unsigned long fences = 12; // 割り込みを入れるバリアの位置の数 (1 つの記録に 3 つ、1 つの読み出しに 2 つ)
+#else
+    // 追い越しの確認を省いた場合は、1 周より少なく記録する割り込みだけを入れる
+    static const unsigned long bursts[] = {1, TRACE_SIZE / 2, TRACE_SIZE - 1};
+    const unsigned long fences = 8; // 割り込みを入れるバリアの位置の数 (1 つの記録に 2 つ、1 つの読み出しに 2 つ)
+#endif
+    const unsigned long max_burst = bursts[sizeof bursts / sizeof bursts[0] - 1];
+    int errors = 0, cases = 0;
+    for (size_t b = 0; b < sizeof bursts / sizeof bursts[0]; b++)
+    {
+        for (unsigned long fence = 0; fence < fences; fence++)
+        {
+            for (int reading = 0; reading < 2; reading++)
+            {
+                trace_init(&trace);
+                next_value = expected_seq = received_count = 0;
+                for (unsigned long i = 0; i < TRACE_SIZE - 2; i++)
+                {
+                    record_next();
+                }
+                burst = bursts[b];
+                trace_host_interrupt_at(fence, interrupt_burst);
+                if (reading)
+                {
+                    errors += check_events(trace_read(&trace, events, TRACE_SIZE * 4));
+                }
+                else
+                {
+                    for (int i = 0; i < 4; i++)
+                    {
+                        record_next();
+                    }
+                }
+                trace_host_interrupt_at(0, 0);
+                unsigned long n;
+                while ((n = trace_read(&trace, events, TRACE_SIZE * 4)) != 0)
+                {
+                    errors += check_events(n);
+                }
+                errors += received_count + trace_lost(&trace) != next_value;
+                cases++;
+            }
+        }
+    }
+    printf("interrupt at each barrier while recording / reading (%d cases, bursts of 1 to %lu records): %s\n", cases,
+           max_burst, errors ? "NG" : "OK");
+    return errors != 0;
+}
+
+// ---- 4. 複数のスレッド ----
+
+static unsigned long records_per_thread = 500000;
+static atomic_int running; // 記録しているスレッドの数
+
+// 記録するスレッド: cycles にスレッドの番号と自分の通し番号を入れる
+static void *producer(void *arg)
+{
+    unsigned long thread = (unsigned long)arg;
+    for (unsigned long i = 0; i < records_per_thread; i++)
+    {
+        trace_record(&trace, (unsigned char)thread, i << 8 | thread);
+        // 読み出しが追いつくときと追いつかないときの両方が起きるよう、ときどき他のスレッドに譲る
+        if (i % 200 == thread)
+        {
+            sched_yield();
+        }
+    }
+    atomic_fetch_sub(&running, 1);
+    return NULL;
+}
+
+static int check_threads(int threads)
+{
+    pthread_t tid[16];
+    unsigned long next[16] = {0}; // スレッドごとに次に期待する通し番号の最小値
+    unsigned long received = 0, torn = 0, disorder = 0;
+    trace_init(&trace);
+    atomic_store(&running, threads);
+    for (int t = 0; t < threads; t++)
+    {
+        pthread_create(&tid[t], NULL, producer, (void *)(unsigned long)t);
+    }
+    while (1)
+    {
+        int done = atomic_load(&running) == 0;
+        unsigned long n = trace_read(&trace, events, TRACE_SIZE * 4);
+        for (unsigned long i = 0; i < n; i++)
+        {
+            unsigned long thread = events[i].cycles & 0xff, count = events[i].cycles >> 8;
+            if (events[i].id != thread || thread >= (unsigned long)threads)
+            {
+                torn++;
+                continue;
+            }
+            if (count < next[thread])
+            {
+                disorder++;
+            }
+            next[thread] = count + 1;
+        }
+        received += n;
+        if (done && n == 0)
+        {
+            break;
+        }
+    }
+    for (int t = 0; t < threads; t++)
+    {
+        pthread_join(tid[t], NULL);
+    }
+    unsigned long total = records_per_thread * threads;
+    int ok = torn == 0 && disorder == 0 && received + trace_lost(&trace) == total;
+    printf("%d threads x %lu records, reader running alongside: %lu read + %lu lost = %lu / %lu, %lu torn, "
+           "%lu out of order: %s\n",
+           threads, records_per_thread, received, trace_lost(&trace), received + trace_lost(&trace), total, torn,
+           disorder, ok ? "OK" : "NG");
+    return !ok;
+}
+
+// ---- 5. 1 回の記録の時間 ----
+
+static void bench(void)
+{
+    const unsigned long rounds = 20000000;
+    trace_init(&trace);
+    double start = now_sec();
+    for (unsigned long i = 0; i < rounds; i++)
+    {
+        trace_record(&trace, (unsigned char)(i % 255), i);
+    }
+    double record_ns = (now_sec() - start) * 1e9 / rounds;
+
+    trace_init(&trace);
+    start = now_sec();
+    for (unsigned long i = 0; i < rounds; i++)
+    {
+        TRACE_POINT(&trace, (unsigned char)(i % 255));
+    }
+    double point_ns = (now_sec() - start) * 1e9 / rounds;
+
+    start = now_sec();
+    unsigned long long sum = 0;
+    for (unsigned long i = 0; i < rounds; i++)
+    {
+        sum += timebase_now_us();
+    }
+    double now_ns = (now_sec() - start) * 1e9 / rounds;
+
+    trace_init(&trace);
+    unsigned long overhead = trace_overhead_cycles(&trace);
+    printf("host CPU (TRACE_CHECK_LAP=%d, barriers are calls to trace_host_fence()): trace_record() %.1f ns, "
+           "TRACE_POINT() with the host cycle counter %.1f ns, trace_overhead_cycles() %lu (%.0f ns), timebase_now_us() %.1f ns (%llu)\n",
+           TRACE_CHECK_LAP, record_ns, point_ns, overhead, (double)timebase_cycles_to_ns(overhead), now_ns, sum & 1);
+}
+
+int main(int argc, char **argv)
+{
+#if TRACE_CHECK_LAP
+    int threads = 3;
+    const int max_threads = 16;
+#else
+    int threads = 1; // 追い越しの確認を省いた場合は、記録するスレッドが 1 つ (他のスレッドに追い越されない)
+    const int max_threads = 1;
+#endif
+    int opt;
+    while ((opt = getopt(argc, argv, "t:n:")) != -1)
+    {
+        switch (opt)
+        {
+        case 't':
+            threads = atoi(optarg);
+            break;
+        case 'n':
+            records_per_thread = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-t threads] [-n records]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (threads < 1 || threads > max_threads)
+    {
+        fprintf(stderr, "usage: %s [-t threads] [-n records]\n", argv[0]);
+        return 2;
+    }
+
+    timebase_init();
+    int failures = check_time_read();
+    failures += check_single();
+    failures += check_interrupts();
+    failures += check_threads(threads);
+    bench();
+    return failures != 0;
+}
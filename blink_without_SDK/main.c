@@ -1,12 +1,27 @@
 #include "reg.h"
+#include "idle.h"      // アイドル処理 (待っている間 CPU を眠らせる)
+#include "idle_pico.h" // レジスタを直接操作する idle_hw
+#include "timebase.h"  // 時刻の読み出し
+
+// 1 回の点滅 (点灯と消灯) の統計 (デバッガで見る)
+typedef struct
+{
+    unsigned long blinks;         // 点滅した回数
+    unsigned long busy_permille;  // 起きていた時間の割合 [‰] (最初から)
+    unsigned long long energy_nj; // 直前の 1 回の点滅のエネルギー [nJ] (idle.h の電流の見積もりから)
+    unsigned long period_us;      // 直前の 1 回の点滅にかかった時間 [us] (500000 からのずれが待ち時間の誤差)
+} blink_stats;
+
+static idle Idle;                 // アイドル処理
+static volatile blink_stats Blink; // 点滅の統計
 
 // LEDの初期化を行う関数
 static void
 init_led(void);
-// 現在の時間を取得する関数
-static unsigned long long get_time(void);
 // 指定したミリ秒だけ待機する関数
 static void wait_ms(unsigned long time_ms);
+// 点滅の統計を更新する関数
+static void update_blink_stats(void);
 
 // LEDの初期化を行う関数
 static void init_led(void)
@@ -19,43 +34,41 @@ static void init_led(void)
 
     /* GPIOとして使う為の設定 */
     // IOバンク0のGPIO10番ピンをGPIO機能として設定 (値5はGPIOモードを示す)
-    IO_BANK0_GPIO10_CTRL_RW = 5;
+    IO_BANK0_GPIO_CTRL_RW(10) = 5;
     // IOバンク0のGPIO10番ピンのプルアップ/プルダウン抵抗などをクリア (デフォルト設定にする)
-    PADS_BANK0_BASE_GPIO10_CLR = 1 << 8;
+    PADS_BANK0_GPIO_CLR(10) = 1 << 8;
 
     // GPIO10番ピンの出力機能を有効にする (ここで初めて出力が可能になる)
     SIO_GPIO_OE_SET = 1 << 10;
 }
 
-// 現在の時間を取得する関数 (64ビットのunsigned long long型で返す)
-static unsigned long long get_time(void)
-{
-    // タイマー0の下位32ビットの値を読み込む (volatile指定で最適化を防ぐ)
-    volatile unsigned long time_l = (TIMER0_TIMELR);
-    // タイマー0の上位32ビットの値を読み込む (volatile指定で最適化を防ぐ)
-    volatile unsigned long time_h = (TIMER0_TIMEHR);
-    // 上位32ビットを左に32ビットシフトし、下位32ビットと論理和を取ることで64ビットの値を合成する
-    return ((unsigned long long)time_h << 32u) | time_l;
-}
-
 // 指定したミリ秒だけ待機する関数
 static void wait_ms(unsigned long time_ms)
 {
-    unsigned long long target_time;  // 目標時間
-    unsigned long long current_time; // 現在の時間
+    // 時間を読み続ける代わりに、目標時間にアラームを設定して眠る (WFE)
+    idle_wait_us(&Idle, time_ms * 1000);
+}
 
-    // 現在の時間を取得
-    current_time = get_time();
-    // 目標時間を計算 (現在の時間に、待ちたいミリ秒をマイクロ秒に変換して加える)
-    target_time = current_time + (time_ms * 1000);
+// 点滅の統計を更新する関数
+static void update_blink_stats(void)
+{
+    static idle_stats last;        // 前の点滅のときの統計
+    static unsigned long long mark; // 前の点滅のときの時刻 [us]
+    unsigned long long time = timebase_now_us();
+    const idle_stats *now = idle_get_stats(&Idle);
+    idle_stats blink = {0};
+    blink.busy_us = now->busy_us - last.busy_us;
+    blink.idle_us = now->idle_us - last.idle_us;
+    last = *now;
 
-    // 現在時間が目標時間に達するまでループ
-    while (target_time > current_time)
+    if (Blink.blinks)
     {
-        // ループごとに現在の時間を再取得
-        current_time = get_time();
+        Blink.period_us = (unsigned long)(time - mark);
     }
-    return; // 待ち時間終了
+    mark = time;
+    Blink.blinks++;
+    Blink.busy_permille = idle_busy_permille(now);
+    Blink.energy_nj = idle_energy_nj(&blink, IDLE_ACTIVE_UA, IDLE_SLEEP_UA, IDLE_SUPPLY_MV);
 }
 
 // メイン関数 (プログラムのエントリーポイント)
@@ -63,6 +76,19 @@ void main(void)
 {
     // LEDの初期化
     init_led();
+    // 使わないブロック (PIO・SPI・I2C・ADC・USB など) のクロックを止めてリセットしたままにし、
+    // アイドル処理を初期化する (stdio で使う UART0 は止めない)
+    idle_pico_gate(CLK_EN0_ADC | CLK_EN0_SYS_ADC | CLK_EN0_HSTX | CLK_EN0_SYS_HSTX | CLK_EN0_SYS_I2C0 |
+                       CLK_EN0_SYS_I2C1 | CLK_EN0_SYS_PIO0 | CLK_EN0_SYS_PIO1 | CLK_EN0_SYS_PIO2 | CLK_EN0_SYS_PWM |
+                       CLK_EN0_SYS_SHA256,
+                   CLK_EN1_PERI_SPI0 | CLK_EN1_SYS_SPI0 | CLK_EN1_PERI_SPI1 | CLK_EN1_SYS_SPI1 | CLK_EN1_SYS_TRNG |
+                       CLK_EN1_PERI_UART1 | CLK_EN1_SYS_UART1 | CLK_EN1_SYS_USBCTRL | CLK_EN1_USB,
+                   RESETS_ADC | RESETS_HSTX | RESETS_I2C0 | RESETS_I2C1 | RESETS_PIO0 | RESETS_PIO1 | RESETS_PIO2 |
+                       RESETS_PWM | RESETS_SHA256 | RESETS_SPI0 | RESETS_SPI1 | RESETS_TRNG | RESETS_UART1 |
+                       RESETS_USBCTRL);
+    idle_init(&Idle, idle_pico_hw());
+    // サイクルカウンタを動かす
+    timebase_init();
 
     // 無限ループ (プログラムを永遠に繰り返す)
     while (1)
@@ -75,5 +101,7 @@ void main(void)
         SIO_GPIO_OUT_CLR = 1 << 10;
         // 250ミリ秒待機
         wait_ms(250);
+        // 点滅の統計を更新
+        update_blink_stats();
     }
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef HOST_UTIL_H
+#define HOST_UTIL_H
+
+#include <stdint.h> // 固定幅整数型
+#include <time.h>   // clock_gettime
+
+// ホスト向けのシミュレーション・ベンチマークで共通に使う小さな関数
+//
+// どのプログラムも 1 つのソースファイルから使うので、定義ごとヘッダーに置く。
+// 乱数の状態はファイルごとに持ち、同じ種から始まるので、実行のたびに同じ系列になる。
+
+static uint32_t rng_state = 12345; // 疑似乱数の状態
+
+// xorshift32 の疑似乱数
+static inline uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// 現在時刻 (CLOCK_MONOTONIC) を秒で返す
+static inline double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// 現在時刻 (CLOCK_MONOTONIC) を us で返す
+static inline uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include "face.h" // 顔の表情の描画
+
+void draw_face(framebuffer *fb, int eye_type, int mouth_type)
+{
+    int left_eye_x = 30, left_eye_y = 40;
+    // 左目の中心 X, Y 座標
+    int right_eye_x = 90, right_eye_y = 40; // 右目の中心 X, Y 座標
+    int eye_size = 10;
+    // 目のサイズ (直径)
+
+    // 目を描画
+    if (eye_type == 0)
+    {
+        // 丸い目: 目の範囲を塗りつぶす
+        fill_rect(fb, left_eye_x, left_eye_y, eye_size, eye_size, 15);
+        fill_rect(fb, right_eye_x, right_eye_y, eye_size, eye_size, 15);
+    }
+    else if (eye_type == 1)
+    {
+        // 横長の線: 目の中心の高さに水平線を引く
+        draw_hline(fb, left_eye_x, left_eye_y + eye_size / 2, eye_size, 15);
+        draw_hline(fb, right_eye_x, right_eye_y + eye_size / 2, eye_size, 15);
+    }
+
+    int mouth_x = 50, mouth_y = 90;
+    // 口の中心座標
+    int mouth_width = 30, mouth_height = 5; // 口の幅と高さ
+
+    // 口を描画
+    if (mouth_type == 0)
+    {
+        // ニコニコ: 口の範囲を塗りつぶす
+        fill_rect(fb, mouth_x, mouth_y, mouth_width, mouth_height, 15);
+    }
+    else if (mouth_type == 1)
+    {
+        // 真一文字: 口の一番下のラインだけ引く
+        draw_hline(fb, mouth_x, mouth_y + mouth_height - 1, mouth_width, 15);
+    }
+
+    // 目と口の組み合わせに応じて、OLED ディスプレイにメッセージを表示
+    if (eye_type == 0 && mouth_type == 0) // 丸い目とニコニコ口
+    {
+        draw_string(fb, "HAPPY", 10, 110, 15);
+    }
+    else if (eye_type == 1 && mouth_type == 1) // 横長の目と真一文字の口
+    {
+        draw_string(fb, "ZZZZ", 10, 110, 15);
+    }
+    else if (eye_type == 0 && mouth_type == 1) // 丸い目と真一文字の口
+    {
+        draw_string(fb, "HEY", 10, 110, 15);
+    }
+    else if (eye_type == 1 && mouth_type == 0) // 横長の目と丸い口
+    {
+        draw_string(fb, "HUNGRY", 10, 110, 15);
+    }
+}
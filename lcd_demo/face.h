@@ -0,0 +1,10 @@
+#ifndef FACE_H
+#define FACE_H
+
+#include "framebuffer.h" // 表示バッファと描画関数
+
+// 顔の表情を描画する (eye_type 0: 丸い目, 1: 横長の線 / mouth_type 0: ニコニコ, 1: 真一文字)
+// 目と口の組み合わせに応じたメッセージも画面下部に描く
+void draw_face(framebuffer *fb, int eye_type, int mouth_type);
+
+#endif // FACE_H
@@ -0,0 +1,201 @@
+#include <stdbool.h> // bool 型
+#include <string.h>  // memcpy
+#include "font.h"    // フォントと文字列の描画
+#include "font8x8.h" // 8x8 ドットフォントのデータ
+
+#define FONT_CACHE_WORDS ((1 + FONT_MAX_ADVANCE + 1) / 2) // 1 行の要素数の最大値 (奇数 x から始まる場合を含む)
+#define FONT_CACHE_WAYS 4                                  // 1 つの組の項目数
+#define FONT_CACHE_SETS (FONT_CACHE_SIZE / FONT_CACHE_WAYS) // 組の数
+
+const font font_fixed = {font_8x8, NULL, NULL, 0};
+const font font_proportional = {font_8x8, font_8x8_left, font_8x8_width, 1};
+
+// キャッシュの 1 項目: 1 文字を背景ごと表示バッファと同じ形式に展開したもの
+typedef struct
+{
+    const font *f;     // フォント (NULL なら空き)
+    uint32_t key;      // 文字・明るさ・背景の明るさ・x の偶奇
+    uint32_t used;     // 最後に使った順番 (組の中で最も小さい項目を置き換える)
+    uint8_t words;     // 1 行の要素数
+    uint16_t keep[FONT_CACHE_WORDS];              // 各要素のうち残す部分 (文字の外側のニブルは F。すべて文字なら 0)
+    uint16_t rows[FONT_HEIGHT][FONT_CACHE_WORDS]; // 各行の要素 (文字の外側のニブルは 0)
+} glyph_cache_entry;
+
+static glyph_cache_entry cache[FONT_CACHE_SIZE]; // 4 ウェイのセットアソシアティブ方式のキャッシュ
+static uint32_t use_count;                       // 項目を使うたびに増やす
+static font_cache_stats stats;                   // キャッシュの統計
+
+// 文字 c のフォント配列のインデックス (フォントにない文字は '?')
+static int glyph_index(char c)
+{
+    unsigned char u = (unsigned char)c;
+    if (u < FONT_FIRST_CHAR || u > FONT_LAST_CHAR)
+    {
+        u = '?';
+    }
+    return u - FONT_FIRST_CHAR;
+}
+
+const uint8_t *font_glyph(const font *f, char c)
+{
+    return f->glyphs[glyph_index(c)];
+}
+
+int font_advance(const font *f, char c)
+{
+    return f->width ? f->width[glyph_index(c)] + f->spacing : 8;
+}
+
+int font_text_width(const font *f, const char *str)
+{
+    int width = 0;
+    while (*str)
+    {
+        width += font_advance(f, *str++);
+    }
+    return width;
+}
+
+// 文字 c の送り幅の範囲のうち、左から i 列目・r 行目が点灯するなら true (間隔の列は点灯しない)
+static bool glyph_bit(const font *f, int index, int i, int r)
+{
+    int left = f->left ? f->left[index] : 0;
+    int width = f->width ? f->width[index] : 8;
+    return i < width && (f->glyphs[index][r] & (0x80 >> (left + i)));
+}
+
+// キャッシュから文字を探し、なければ組の中で最も長く使っていない項目に展開して入れる
+static const glyph_cache_entry *cache_lookup(const font *f, char c, uint8_t fg, uint8_t bg, int parity)
+{
+    int index = glyph_index(c);
+    uint32_t key = index | fg << 8 | bg << 12 | parity << 16;
+    uint32_t hash = (key | (f->width != NULL) << 17) * 2654435761u; // フィボナッチハッシュ (等幅とプロポーショナルで組を分ける)
+    glyph_cache_entry *set = &cache[(hash >> 24 & (FONT_CACHE_SETS - 1)) * FONT_CACHE_WAYS];
+    glyph_cache_entry *e = &set[0];
+    for (int i = 0; i < FONT_CACHE_WAYS; i++)
+    {
+        if (set[i].f == f && set[i].key == key)
+        {
+            stats.hits++;
+            set[i].used = ++use_count;
+            return &set[i];
+        }
+        e = set[i].used < e->used ? &set[i] : e;
+    }
+    stats.misses++;
+
+    // 送り幅の範囲 (間隔を含む) を、偶奇に合わせたニブルの位置に展開する
+    int advance = font_advance(f, c);
+    e->f = f;
+    e->key = key;
+    e->used = ++use_count;
+    e->words = (parity + advance + 1) / 2;
+    memset(e->rows, 0, sizeof e->rows);
+    for (int k = 0; k < FONT_CACHE_WORDS; k++)
+    {
+        e->keep[k] = 0x00FF; // 上位 8 ビットは常に 0
+    }
+    for (int i = 0; i < advance; i++)
+    {
+        int n = parity + i; // 要素の先頭からのニブルの位置
+        e->keep[n / 2] &= (n & 1) ? 0x00F0 : 0x000F;
+        for (int r = 0; r < FONT_HEIGHT; r++)
+        {
+            uint8_t value = glyph_bit(f, index, i, r) ? fg : bg;
+            e->rows[r][n / 2] |= (n & 1) ? value : value << 4;
+        }
+    }
+    return e;
+}
+
+// キャッシュの項目を (x, y) に写す (x の偶奇は項目と同じで、画面内に収まっていること)
+static void blit_entry(framebuffer *fb, const glyph_cache_entry *e, int x, int y)
+{
+    int column = (x & ~1) / 2; // 先頭の要素の列
+    uint16_t *dst = &fb->pixels[y * DISPLAY_WIDTH / 2 + column];
+    if (column + 4 <= DISPLAY_WIDTH / 2)
+    {
+        // 先頭の 4 要素 (8 バイト) をまとめて書き込む。文字の外側の部分を残す必要がなければそのまま写す
+        uint64_t keep;
+        memcpy(&keep, e->keep, sizeof keep);
+        for (int r = 0; r < FONT_HEIGHT; r++, dst += DISPLAY_WIDTH / 2)
+        {
+            if (keep == 0)
+            {
+                memcpy(dst, e->rows[r], 4 * sizeof(uint16_t));
+            }
+            else
+            {
+                uint64_t d, v;
+                memcpy(&d, dst, sizeof d);
+                memcpy(&v, e->rows[r], sizeof v);
+                d = (d & keep) | v;
+                memcpy(dst, &d, sizeof d);
+            }
+            if (e->words > 4)
+            {
+                dst[4] = (dst[4] & e->keep[4]) | e->rows[r][4];
+            }
+        }
+    }
+    else
+    {
+        // 右端: 行をまたがないように 1 要素ずつ書き込む
+        for (int r = 0; r < FONT_HEIGHT; r++, dst += DISPLAY_WIDTH / 2)
+        {
+            for (int k = 0; k < e->words; k++)
+            {
+                dst[k] = (dst[k] & e->keep[k]) | e->rows[r][k];
+            }
+        }
+    }
+}
+
+int draw_text(framebuffer *fb, const font *f, const char *str, int x, int y, uint8_t fg, uint8_t bg)
+{
+    fg &= 0x0F;
+    bg &= 0x0F;
+    int width = font_text_width(f, str);
+    if (width == 0)
+    {
+        return x;
+    }
+    framebuffer_mark(fb, x, y, x + width - 1, y + FONT_HEIGHT - 1); // 文字列全体をまとめて記録する
+
+    for (; *str; str++)
+    {
+        int advance = font_advance(f, *str);
+        if (x >= 0 && x + advance <= DISPLAY_WIDTH && y >= 0 && y + FONT_HEIGHT <= DISPLAY_HEIGHT)
+        {
+            blit_entry(fb, cache_lookup(f, *str, fg, bg, x & 1), x, y);
+        }
+        else
+        {
+            // 画面の端にかかる文字は 1 ピクセルずつ描く
+            int index = glyph_index(*str);
+            for (int r = 0; r < FONT_HEIGHT; r++)
+            {
+                for (int i = 0; i < advance; i++)
+                {
+                    if (x + i >= 0 && x + i < DISPLAY_WIDTH && y + r >= 0 && y + r < DISPLAY_HEIGHT)
+                    {
+                        set_pixel(fb, x + i, y + r, glyph_bit(f, index, i, r) ? fg : bg);
+                    }
+                }
+            }
+        }
+        x += advance;
+    }
+    return x;
+}
+
+void font_cache_clear(void)
+{
+    memset(cache, 0, sizeof cache);
+    use_count = 0;
+}
+
+font_cache_stats font_get_cache_stats(void)
+{
+    return stats;
+}
@@ -0,0 +1,59 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <stdint.h>      // 固定幅整数型
+#include "framebuffer.h" // 表示バッファ
+
+// フォントと文字列の描画
+//
+// 印字可能な ASCII 文字 (0x20〜0x7E) をすべて持つ 8x8 のフォントを、等幅とプロポーショナルの 2 通りで使える。
+// フォントにない文字は '?' として描画する。
+//
+// draw_text() は文字を背景ごと描画する。文字・明るさ・背景の明るさ・x の偶奇ごとに、
+// 表示バッファと同じ形式 (1 要素に横 2 ピクセル) に展開した文字をキャッシュしておき、
+// 2 回目以降はキャッシュから各行を memcpy するだけで描ける (センサーの値のように同じ文字を繰り返し描く用途向け)。
+
+#define FONT_FIRST_CHAR 0x20  // フォントの最初の文字 (空白)
+#define FONT_LAST_CHAR 0x7E   // フォントの最後の文字 ('~')
+#define FONT_HEIGHT 8         // 文字の高さ
+#define FONT_MAX_ADVANCE 9    // 1 文字の送り幅の最大値 (プロポーショナルで幅 8 + 間隔 1)
+#define FONT_CACHE_SIZE 64    // キャッシュの項目数 (2 のべき乗)
+
+// フォント
+typedef struct
+{
+    const uint8_t (*glyphs)[FONT_HEIGHT]; // 文字 c のビットマップは glyphs[c - FONT_FIRST_CHAR] (1 行 1 バイト、MSB が左端)
+    const uint8_t *left;                  // 各文字の左側の空き列の数 (NULL なら等幅)
+    const uint8_t *width;                 // 各文字の幅 (NULL なら等幅で 8)
+    uint8_t spacing;                      // プロポーショナルの場合の文字の間隔
+} font;
+
+extern const font font_fixed;        // 8x8 の等幅フォント
+extern const font font_proportional; // 8x8 のビットマップの空き列を詰めたプロポーショナルフォント
+
+// キャッシュの統計
+typedef struct
+{
+    uint32_t hits;   // キャッシュから描いた文字の数
+    uint32_t misses; // キャッシュになく、展開した文字の数
+} font_cache_stats;
+
+// 文字 c のビットマップを返す (フォントにない文字は '?')
+const uint8_t *font_glyph(const font *f, char c);
+
+// 文字 c の送り幅を返す
+int font_advance(const font *f, char c);
+
+// 文字列の幅を返す
+int font_text_width(const font *f, const char *str);
+
+// 文字列を明るさ fg、背景を明るさ bg で (x, y) に描画し、次の文字の x 座標を返す
+int draw_text(framebuffer *fb, const font *f, const char *str, int x, int y, uint8_t fg, uint8_t bg);
+
+// キャッシュを空にする
+void font_cache_clear(void);
+
+// キャッシュの統計を返す
+font_cache_stats font_get_cache_stats(void);
+
+#endif // FONT_H
@@ -1,4 +1,38 @@
-const uint8_t font_8x8[36][8] = {
+// 8x8 ドットフォント (印字可能な ASCII 文字 0x20〜0x7E の 95 文字。1 行 1 バイトで MSB が左端)
+// 文字 c のデータは font_8x8[c - 0x20]。描画関数からは font.h の font_glyph() / font_fixed / font_proportional を通して使う
+static const uint8_t font_8x8[95][8] = {
+    // ' '
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    // '!'
+    {0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x18, 0x18},
+    // '"'
+    {0x66, 0x66, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00},
+    // '#'
+    {0x24, 0x24, 0xFF, 0x24, 0x24, 0xFF, 0x24, 0x24},
+    // '$'
+    {0x10, 0x3E, 0x50, 0x38, 0x14, 0x14, 0x78, 0x10},
+    // '%'
+    {0x61, 0x62, 0x04, 0x08, 0x10, 0x20, 0x46, 0x86},
+    // '&'
+    {0x38, 0x44, 0x44, 0x38, 0x51, 0x8A, 0x84, 0x7B},
+    // '\''
+    {0x18, 0x18, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00},
+    // '('
+    {0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x08, 0x04},
+    // ')'
+    {0x20, 0x10, 0x08, 0x08, 0x08, 0x08, 0x10, 0x20},
+    // '*'
+    {0x00, 0x10, 0x92, 0x54, 0x38, 0x54, 0x92, 0x10},
+    // '+'
+    {0x00, 0x10, 0x10, 0x10, 0xFE, 0x10, 0x10, 0x10},
+    // ','
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x20},
+    // '-'
+    {0x00, 0x00, 0x00, 0x00, 0xFE, 0x00, 0x00, 0x00},
+    // '.'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18},
+    // '/'
+    {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80},
     // '0'
     {0x3C, 0x42, 0x81, 0x81, 0x81, 0x81, 0x42, 0x3C},
     // '1'
@@ -19,6 +53,20 @@ const uint8_t font_8x8[36][8] = {
     {0x3C, 0x42, 0x81, 0x42, 0x3C, 0x42, 0x81, 0x3C},
     // '9'
     {0x3C, 0x42, 0x81, 0x43, 0x3D, 0x01, 0x42, 0x3C},
+    // ':'
+    {0x00, 0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x00},
+    // ';'
+    {0x00, 0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x20},
+    // '<'
+    {0x04, 0x08, 0x10, 0x20, 0x20, 0x10, 0x08, 0x04},
+    // '='
+    {0x00, 0x00, 0xFE, 0x00, 0x00, 0xFE, 0x00, 0x00},
+    // '>'
+    {0x20, 0x10, 0x08, 0x04, 0x04, 0x08, 0x10, 0x20},
+    // '?'
+    {0x3C, 0x42, 0x02, 0x04, 0x08, 0x08, 0x00, 0x08},
+    // '@'
+    {0x3C, 0x42, 0x9D, 0xA5, 0xA5, 0x9E, 0x40, 0x3E},
     // 'A'
     {0x3C, 0x42, 0x81, 0x81, 0xFF, 0x81, 0x81, 0x81},
     // 'B'
@@ -70,5 +118,97 @@ const uint8_t font_8x8[36][8] = {
     // 'Y'
     {0x81, 0x42, 0x24, 0x18, 0x10, 0x10, 0x10, 0x10},
     // 'Z'
-    {0xFF, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0xFF}
-};
\ No newline at end of file
+    {0xFF, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0xFF},
+    // '['
+    {0x1C, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1C},
+    // '\\'
+    {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01},
+    // ']'
+    {0x38, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x38},
+    // '^'
+    {0x10, 0x28, 0x44, 0x82, 0x00, 0x00, 0x00, 0x00},
+    // '_'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF},
+    // '`'
+    {0x30, 0x30, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00},
+    // 'a'
+    {0x00, 0x00, 0x00, 0x7C, 0x02, 0x7E, 0x82, 0x7E},
+    // 'b'
+    {0x80, 0x80, 0x80, 0xBC, 0xC2, 0x82, 0xC2, 0xBC},
+    // 'c'
+    {0x00, 0x00, 0x00, 0x7C, 0x82, 0x80, 0x82, 0x7C},
+    // 'd'
+    {0x02, 0x02, 0x02, 0x7A, 0x86, 0x82, 0x86, 0x7A},
+    // 'e'
+    {0x00, 0x00, 0x00, 0x7C, 0x82, 0xFE, 0x80, 0x7E},
+    // 'f'
+    {0x1C, 0x20, 0x20, 0xFC, 0x20, 0x20, 0x20, 0x20},
+    // 'g'
+    {0x00, 0x7A, 0x86, 0x82, 0x86, 0x7A, 0x02, 0x7C},
+    // 'h'
+    {0x80, 0x80, 0x80, 0xBC, 0xC2, 0x82, 0x82, 0x82},
+    // 'i'
+    {0x10, 0x00, 0x00, 0x30, 0x10, 0x10, 0x10, 0x38},
+    // 'j'
+    {0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x44, 0x38},
+    // 'k'
+    {0x80, 0x80, 0x80, 0x84, 0x88, 0xF0, 0x88, 0x84},
+    // 'l'
+    {0x30, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x38},
+    // 'm'
+    {0x00, 0x00, 0x00, 0xEC, 0x92, 0x92, 0x92, 0x92},
+    // 'n'
+    {0x00, 0x00, 0x00, 0xBC, 0xC2, 0x82, 0x82, 0x82},
+    // 'o'
+    {0x00, 0x00, 0x00, 0x7C, 0x82, 0x82, 0x82, 0x7C},
+    // 'p'
+    {0x00, 0xBC, 0xC2, 0x82, 0xC2, 0xBC, 0x80, 0x80},
+    // 'q'
+    {0x00, 0x7A, 0x86, 0x82, 0x86, 0x7A, 0x02, 0x02},
+    // 'r'
+    {0x00, 0x00, 0x00, 0xBC, 0xC2, 0x80, 0x80, 0x80},
+    // 's'
+    {0x00, 0x00, 0x00, 0x7E, 0x80, 0x7C, 0x02, 0xFC},
+    // 't'
+    {0x00, 0x20, 0x20, 0xFC, 0x20, 0x20, 0x22, 0x1C},
+    // 'u'
+    {0x00, 0x00, 0x00, 0x82, 0x82, 0x82, 0x86, 0x7A},
+    // 'v'
+    {0x00, 0x00, 0x00, 0x82, 0x82, 0x44, 0x28, 0x10},
+    // 'w'
+    {0x00, 0x00, 0x00, 0x92, 0x92, 0x92, 0x92, 0x6C},
+    // 'x'
+    {0x00, 0x00, 0x00, 0x82, 0x44, 0x38, 0x44, 0x82},
+    // 'y'
+    {0x00, 0x82, 0x82, 0x82, 0x86, 0x7A, 0x02, 0x7C},
+    // 'z'
+    {0x00, 0x00, 0x00, 0xFE, 0x04, 0x18, 0x60, 0xFE},
+    // '{'
+    {0x0C, 0x10, 0x10, 0x20, 0x20, 0x10, 0x10, 0x0C},
+    // '|'
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10},
+    // '}'
+    {0x30, 0x08, 0x08, 0x04, 0x04, 0x08, 0x08, 0x30},
+    // '~'
+    {0x00, 0x00, 0x60, 0x92, 0x06, 0x00, 0x00, 0x00},
+};
+
+// プロポーショナル表示用: 各文字の左側の空き列の数 (font_8x8 から求めた値)
+static const uint8_t font_8x8_left[95] = {
+    0, 3, 1, 0, 1, 0, 0, 3, 3, 2, 0, 0, 2, 0, 3, 0,
+    0, 1, 1, 1, 1, 1, 0, 1, 0, 0, 3, 2, 2, 0, 2, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 2, 0, 0,
+    2, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0, 2, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 3, 2, 0,
+};
+
+// プロポーショナル表示用: 各文字の点灯する列の幅 (空白は 3)
+static const uint8_t font_8x8_width[95] = {
+    3, 2, 6, 8, 6, 8, 8, 2, 3, 3, 7, 7, 3, 7, 2, 8,
+    8, 5, 7, 7, 7, 7, 8, 7, 8, 8, 2, 3, 4, 7, 4, 6,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 6, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 3, 8, 3, 7, 8,
+    2, 7, 7, 7, 7, 7, 6, 7, 7, 3, 5, 6, 3, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 4, 1, 4, 7,
+};
@@ -0,0 +1,82 @@
+#include "frame_scheduler.h" // ダブルバッファと一定のフレームレートでの描画
+
+void frame_scheduler_init(frame_scheduler *s, const frame_scheduler_transport *transport, uint32_t fps)
+{
+    s->transport = transport;
+    framebuffer_init(&s->buffers[0]);
+    framebuffer_init(&s->buffers[1]);
+
+    // 画面全体は最初のフレームで送るので、もう一方のバッファの全体の範囲は捨てる
+    framebuffer_rect rects[FRAMEBUFFER_MAX_RECTS];
+    framebuffer_take_dirty(&s->buffers[1], rects);
+
+    s->back = 0;
+    s->transferring = false;
+    s->period_us = 1000000 / fps;
+    s->next_us = transport->now_us(transport->ctx);
+    s->render_start_us = s->next_us;
+    s->stats = (frame_stats){0};
+}
+
+framebuffer *frame_scheduler_begin(frame_scheduler *s)
+{
+    const frame_scheduler_transport *t = s->transport;
+    uint64_t now = t->now_us(t->ctx);
+
+    if (now >= s->next_us + s->period_us)
+    {
+        // 前のフレームが周期に収まらなかった: 過ぎた開始時刻は飛ばし、その数を数える
+        uint64_t missed = (now - s->next_us) / s->period_us;
+        s->stats.dropped += (uint32_t)missed;
+        s->next_us += missed * s->period_us;
+    }
+    if (now < s->next_us)
+    {
+        t->sleep_until(t->ctx, s->next_us);
+    }
+    s->next_us += s->period_us;
+
+    // 裏のバッファは前回の転送が終わっているので書き換えてよい。前回このバッファに描いた範囲を消す
+    framebuffer *fb = &s->buffers[s->back];
+    s->render_start_us = t->now_us(t->ctx);
+    framebuffer_clear(fb);
+    return fb;
+}
+
+void frame_scheduler_end(frame_scheduler *s)
+{
+    const frame_scheduler_transport *t = s->transport;
+    framebuffer *back = &s->buffers[s->back];
+    framebuffer *front = &s->buffers[s->back ^ 1];
+
+    uint64_t now = t->now_us(t->ctx);
+    s->stats.render_us = (uint32_t)(now - s->render_start_us);
+    s->stats.render_max_us = s->stats.render_us > s->stats.render_max_us ? s->stats.render_us : s->stats.render_max_us;
+    s->stats.render_total_us += s->stats.render_us;
+
+    // 表のバッファの転送が終わるまで待つ (描画が転送より速ければここで待つ)
+    if (s->transferring)
+    {
+        t->wait(t->ctx);
+        s->stats.wait_us = (uint32_t)(t->now_us(t->ctx) - now);
+        s->stats.transfer_us = t->last_transfer_us(t->ctx);
+        s->stats.transfer_max_us = s->stats.transfer_us > s->stats.transfer_max_us ? s->stats.transfer_us : s->stats.transfer_max_us;
+        s->stats.transfer_total_us += s->stats.transfer_us;
+    }
+
+    // パネルに表示されているのは表のバッファなので、表に描いた範囲も書き換える
+    framebuffer_add_dirty(back, &front->drawn);
+    s->transferring = t->start_frame(t->ctx, back);
+    s->stats.frames++;
+    s->back ^= 1;
+}
+
+const framebuffer *frame_scheduler_front(const frame_scheduler *s)
+{
+    return &s->buffers[s->back ^ 1];
+}
+
+const frame_stats *frame_scheduler_get_stats(const frame_scheduler *s)
+{
+    return &s->stats;
+}
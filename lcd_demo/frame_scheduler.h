@@ -0,0 +1,78 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <stdint.h>      // 固定幅整数型
+#include <stdbool.h>     // bool 型
+#include "framebuffer.h" // 表示バッファ
+
+// ダブルバッファと一定のフレームレートでの描画
+//
+// 表示バッファを 2 つ持ち、一方 (表) をパネルに転送している間にもう一方 (裏) へ次のフレームを描く。
+// frame_scheduler_begin() は次のフレームの開始時刻 (1 / fps ごと) まで待ってから裏のバッファを返し、
+// frame_scheduler_end() は表の転送が終わるのを待ってから裏のバッファの転送を開始し、表と裏を入れ替える。
+// 描画と転送が 1 周期に収まらなかった場合は、飛ばした周期の数を落としたフレームとして数える。
+//
+// パネルには直前のフレーム (もう一方のバッファ) が表示されているので、転送する範囲には
+// 今回描画した範囲に加えて、直前のフレームで描画した範囲も含める (消す必要がある)。
+//
+// パネルへの転送と待ちは frame_scheduler_transport の関数で行う。host/frame_scheduler_sim は sleep_until を
+// 仮想時刻を進めるだけの関数にして、落としたフレームの数と転送後のパネルの内容を実時間を待たずに調べる。
+
+// 表示の転送と時計へのアクセス手段
+typedef struct
+{
+    // fb のうち送信が必要な範囲の転送を開始する (ssd1327_start_frame() と同じ)
+    bool (*start_frame)(void *ctx, framebuffer *fb);
+    // 転送が終わるまで待つ
+    void (*wait)(void *ctx);
+    // 最後に終わった転送の時間 [us]
+    uint32_t (*last_transfer_us)(void *ctx);
+    // 現在時刻 [us]
+    uint64_t (*now_us)(void *ctx);
+    // 指定した時刻まで待つ
+    void (*sleep_until)(void *ctx, uint64_t time_us);
+    void *ctx; // 上記関数に渡すコンテキスト
+} frame_scheduler_transport;
+
+// フレームの統計
+typedef struct
+{
+    uint32_t frames;            // 転送を開始したフレーム数
+    uint32_t dropped;           // 描画と転送が間に合わずに飛ばした周期の数
+    uint32_t render_us;         // 最後のフレームの描画時間 [us]
+    uint32_t render_max_us;     // 描画時間の最大値 [us]
+    uint32_t transfer_us;       // 最後に終わった転送の時間 [us]
+    uint32_t transfer_max_us;   // 転送時間の最大値 [us]
+    uint32_t wait_us;           // 最後のフレームで前の転送の完了を待った時間 [us]
+    uint64_t render_total_us;   // 描画時間の合計 [us] (平均 = render_total_us / frames)
+    uint64_t transfer_total_us; // 転送時間の合計 [us]
+} frame_stats;
+
+typedef struct
+{
+    const frame_scheduler_transport *transport; // 転送と時計
+    framebuffer buffers[2];                     // 表示バッファ
+    int back;                                   // 描画中のバッファ (もう一方は表示中)
+    bool transferring;                          // 表のバッファを転送中なら true
+    uint32_t period_us;                         // フレームの周期 [us]
+    uint64_t next_us;                           // 次のフレームの開始時刻 [us]
+    uint64_t render_start_us;                   // 描画を始めた時刻 [us]
+    frame_stats stats;                          // 統計
+} frame_scheduler;
+
+// 2 つのバッファを黒でクリアし、fps フレーム/秒で描画する準備をする (最初のフレームで画面全体を送る)
+void frame_scheduler_init(frame_scheduler *s, const frame_scheduler_transport *transport, uint32_t fps);
+
+// 次のフレームの開始時刻まで待ち、前回このバッファに描いた範囲を消した裏のバッファを返す
+framebuffer *frame_scheduler_begin(frame_scheduler *s);
+
+// 前のフレームの転送が終わるのを待ってから裏のバッファの転送を開始し、表と裏を入れ替える
+void frame_scheduler_end(frame_scheduler *s);
+
+// 表示中 (最後に転送を開始した) のバッファを返す
+const framebuffer *frame_scheduler_front(const frame_scheduler *s);
+
+// 統計を返す
+const frame_stats *frame_scheduler_get_stats(const frame_scheduler *s);
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,319 @@
+#include <stdbool.h>       // bool 型
+#include <string.h>        // memset, memcpy
+#include "framebuffer.h"   // 表示バッファ
+#include "font.h"          // 8x8 ドットフォント
+
+// 2 つの矩形を含む最小の矩形
+static framebuffer_rect rect_union(framebuffer_rect a, framebuffer_rect b)
+{
+    framebuffer_rect r = {
+        a.x0 < b.x0 ? a.x0 : b.x0,
+        a.y0 < b.y0 ? a.y0 : b.y0,
+        a.x1 > b.x1 ? a.x1 : b.x1,
+        a.y1 > b.y1 ? a.y1 : b.y1,
+    };
+    return r;
+}
+
+// 矩形の面積 [ピクセル]
+static int rect_area(framebuffer_rect r)
+{
+    return (r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1);
+}
+
+// 重なっているか接していれば true (結合しても送信量が増えない)
+static bool rect_touches(framebuffer_rect a, framebuffer_rect b)
+{
+    return a.x0 <= b.x1 + 1 && b.x0 <= a.x1 + 1 && a.y0 <= b.y1 + 1 && b.y0 <= a.y1 + 1;
+}
+
+// 一覧に矩形を加える。重なる (接する) 矩形があれば結合し、一覧がいっぱいなら面積の増加が最も小さい矩形と結合する
+static void rect_list_add(framebuffer_rect_list *list, framebuffer_rect r)
+{
+    for (int i = 0; i < list->count; i++)
+    {
+        framebuffer_rect *e = &list->rects[i];
+        if (e->x0 <= r.x0 && e->y0 <= r.y0 && r.x1 <= e->x1 && r.y1 <= e->y1)
+        {
+            return; // すでに含まれている (1 ピクセルずつ描くときはほとんどこれ)
+        }
+    }
+
+    while (true)
+    {
+        // 重なる矩形を取り除いて r に結合し、結合後の r でもう一度調べる
+        for (int i = 0; i < list->count;)
+        {
+            if (rect_touches(list->rects[i], r))
+            {
+                r = rect_union(r, list->rects[i]);
+                list->rects[i] = list->rects[--list->count];
+                i = 0;
+            }
+            else
+            {
+                i++;
+            }
+        }
+        if (list->count < FRAMEBUFFER_MAX_RECTS)
+        {
+            list->rects[list->count++] = r;
+            return;
+        }
+
+        // いっぱいなら、結合したときの面積の増加が最も小さい矩形と結合する
+        int best = 0;
+        int best_growth = DISPLAY_WIDTH * DISPLAY_HEIGHT + 1;
+        for (int i = 0; i < list->count; i++)
+        {
+            framebuffer_rect u = rect_union(r, list->rects[i]);
+            int growth = rect_area(u) - rect_area(list->rects[i]) - rect_area(r);
+            if (growth < best_growth)
+            {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        r = rect_union(r, list->rects[best]);
+        list->rects[best] = list->rects[--list->count];
+    }
+}
+
+void framebuffer_init(framebuffer *fb)
+{
+    memset(fb->pixels, 0, sizeof(fb->pixels)); // 4 ビットグレースケールで 0 は最も暗い状態
+    fb->drawn.count = 0;
+    fb->dirty.count = 0;
+    framebuffer_mark(fb, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1); // 最初は全体を送信する
+    fb->drawn.count = 0;
+}
+
+void framebuffer_clear(framebuffer *fb)
+{
+    for (int i = 0; i < fb->drawn.count; i++)
+    {
+        framebuffer_rect r = fb->drawn.rects[i];
+        for (int y = r.y0; y <= r.y1; y++)
+        {
+            memset(&fb->pixels[(y * DISPLAY_WIDTH + r.x0) / 2], 0, (r.x1 - r.x0 + 1) / 2 * sizeof(uint16_t));
+        }
+        rect_list_add(&fb->dirty, r); // 消した範囲も送信が必要
+    }
+    fb->drawn.count = 0;
+}
+
+void framebuffer_mark(framebuffer *fb, int x0, int y0, int x1, int y1)
+{
+    // 画面内に切り詰める
+    x0 = x0 < 0 ? 0 : x0;
+    y0 = y0 < 0 ? 0 : y0;
+    x1 = x1 >= DISPLAY_WIDTH ? DISPLAY_WIDTH - 1 : x1;
+    y1 = y1 >= DISPLAY_HEIGHT ? DISPLAY_HEIGHT - 1 : y1;
+    if (x0 > x1 || y0 > y1)
+    {
+        return; // 画面外
+    }
+
+    framebuffer_rect r = {x0 & ~1, y0, x1 | 1, y1}; // 2 ピクセル (1 バイト) 単位に広げる
+    rect_list_add(&fb->drawn, r);
+    rect_list_add(&fb->dirty, r);
+}
+
+int framebuffer_take_dirty(framebuffer *fb, framebuffer_rect *rects)
+{
+    int count = fb->dirty.count;
+    memcpy(rects, fb->dirty.rects, count * sizeof(framebuffer_rect));
+    fb->dirty.count = 0;
+    return count;
+}
+
+void framebuffer_add_dirty(framebuffer *fb, const framebuffer_rect_list *rects)
+{
+    for (int i = 0; i < rects->count; i++)
+    {
+        rect_list_add(&fb->dirty, rects->rects[i]);
+    }
+}
+
+// ピクセルを書き換える (範囲の記録はしない)
+static void put_pixel(framebuffer *fb, int x, int y, uint8_t brightness)
+{
+    int index = (y * DISPLAY_WIDTH + x) / 2; // 指定された x, y 座標に対応するバッファ内のインデックスを計算
+                                             // SSD1327 は横方向に 2 ピクセルで 1 バイトを扱うため、インデックスを 2 で割る
+    if (x % 2 == 0)
+    {
+        // x が偶数の場合、そのピクセルはバイトの上位 4 ビットに対応
+        fb->pixels[index] = (fb->pixels[index] & 0x0F) | ((brightness & 0x0F) << 4); // 元の下位 4 ビットを保持し、上位 4 ビットを新しい明るさで更新
+    }
+    else
+    {
+        // x が奇数の場合、そのピクセルはバイトの下位 4 ビットに対応
+        fb->pixels[index] = (fb->pixels[index] & 0xF0) | (brightness & 0x0F); // 元の上位 4 ビットを保持し、下位 4 ビットを新しい明るさで更新
+    }
+}
+
+void set_pixel(framebuffer *fb, int x, int y, uint8_t brightness)
+{
+    if (x < 0 || x >= DISPLAY_WIDTH || y < 0 || y >= DISPLAY_HEIGHT)
+    {
+        return; // 画面外のピクセルは無視
+    }
+    framebuffer_mark(fb, x, y, x, y);
+    put_pixel(fb, x, y, brightness);
+}
+
+// フォントの 1 行 (8 ピクセル、MSB が左) を、表示バッファ 4 要素分 (横 2 ピクセルずつ) のマスクに展開した表
+// 要素 i (ビット 16i〜16i+15) は左から 2i, 2i+1 番目のピクセルで、点灯するピクセルのニブルが F になる
+#define NIBBLE_PAIR(b) ((((b) & 2) ? 0xF0u : 0) | (((b) & 1) ? 0x0Fu : 0))
+#define NIBBLE_ROW(r) ((uint64_t)NIBBLE_PAIR((r) >> 6) | (uint64_t)NIBBLE_PAIR((r) >> 4) << 16 | \
+                       (uint64_t)NIBBLE_PAIR((r) >> 2) << 32 | (uint64_t)NIBBLE_PAIR(r) << 48)
+#define NIBBLE_ROW4(r) NIBBLE_ROW(r), NIBBLE_ROW((r) + 1), NIBBLE_ROW((r) + 2), NIBBLE_ROW((r) + 3)
+#define NIBBLE_ROW16(r) NIBBLE_ROW4(r), NIBBLE_ROW4((r) + 4), NIBBLE_ROW4((r) + 8), NIBBLE_ROW4((r) + 12)
+#define NIBBLE_ROW64(r) NIBBLE_ROW16(r), NIBBLE_ROW16((r) + 16), NIBBLE_ROW16((r) + 32), NIBBLE_ROW16((r) + 48)
+
+static const uint64_t nibble_masks[256] = {
+    NIBBLE_ROW64(0), NIBBLE_ROW64(64), NIBBLE_ROW64(128), NIBBLE_ROW64(192),
+};
+
+// 表示バッファの 4 要素 (8 バイト) を読み書きする (アラインメントを問わない)
+static inline uint64_t load4(const uint16_t *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof v);
+    return v;
+}
+
+static inline void store4(uint16_t *p, uint64_t v)
+{
+    memcpy(p, &v, sizeof v);
+}
+
+// 8x8 のビットマップ (1 行 1 バイト、MSB が左) を、点灯するピクセルだけ描画する (範囲の記録はしない)
+static void blit_8x8(framebuffer *fb, const uint8_t *rows, int x, int y, uint8_t brightness)
+{
+    if (x < 0 || x > DISPLAY_WIDTH - 8 || y < 0 || y > DISPLAY_HEIGHT - 8)
+    {
+        // 画面の端にかかる場合は 1 ピクセルずつ描く
+        for (int row = 0; row < 8; row++)
+        {
+            for (int col = 0; col < 8; col++)
+            {
+                if ((rows[row] & (0x80 >> col)) && x + col >= 0 && x + col < DISPLAY_WIDTH && y + row >= 0 && y + row < DISPLAY_HEIGHT)
+                {
+                    put_pixel(fb, x + col, y + row, brightness);
+                }
+            }
+        }
+        return;
+    }
+
+    uint64_t fill = (uint64_t)(brightness & 0x0F) * 0x0011001100110011ull; // 4 要素すべてのニブルを明るさで埋めた値
+    uint16_t *dst = &fb->pixels[(y * DISPLAY_WIDTH + (x & ~1)) / 2];
+    if ((x & 1) == 0)
+    {
+        // x が偶数: 1 行がちょうど 4 要素に収まるので、表で展開したマスクで 4 要素をまとめて書き換える
+        for (int row = 0; row < 8; row++, dst += DISPLAY_WIDTH / 2)
+        {
+            uint64_t mask = nibble_masks[rows[row]];
+            if (mask)
+            {
+                store4(dst, (load4(dst) & ~mask) | (fill & mask));
+            }
+        }
+    }
+    else
+    {
+        // x が奇数: 1 行が 5 要素にまたがる。1 ピクセル右にずらした行 (左端は空き) の先頭 8 ピクセルを 4 要素、
+        // 残りの 1 ピクセルを 5 要素目の上位ニブルとして書き換える
+        for (int row = 0; row < 8; row++, dst += DISPLAY_WIDTH / 2)
+        {
+            uint8_t line = rows[row];
+            uint64_t mask = nibble_masks[line >> 1];
+            if (mask)
+            {
+                store4(dst, (load4(dst) & ~mask) | (fill & mask));
+            }
+            if (line & 1)
+            {
+                dst[4] = (dst[4] & 0x0F) | ((brightness & 0x0F) << 4);
+            }
+        }
+    }
+}
+
+void draw_char(framebuffer *fb, char c, int x, int y, uint8_t brightness)
+{
+    // 文字の範囲をまとめて記録し、フォントの各行を表引きで展開して書き込む (フォントにない文字は '?')
+    framebuffer_mark(fb, x, y, x + 7, y + 7);
+    blit_8x8(fb, font_glyph(&font_fixed, c), x, y, brightness);
+}
+
+void draw_string(framebuffer *fb, const char *str, int x, int y, uint8_t brightness)
+{
+    while (*str) // 文字列の終端 ('\0') まで繰り返す
+    {
+        draw_char(fb, *str, x, y, brightness); // 現在の文字を描画
+        x += 8;                                // 次の文字を描画する X 座標を 8 ピクセル右に移動 (8x8 フォントの幅)
+        str++;                                 // 文字列の次の文字を指すようにポインタをインクリメント
+    }
+}
+
+void fill_rect(framebuffer *fb, int x, int y, int w, int h, uint8_t brightness)
+{
+    // 画面内に切り詰める
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + w - 1 >= DISPLAY_WIDTH ? DISPLAY_WIDTH - 1 : x + w - 1;
+    int y1 = y + h - 1 >= DISPLAY_HEIGHT ? DISPLAY_HEIGHT - 1 : y + h - 1;
+    if (x0 > x1 || y0 > y1)
+    {
+        return; // 画面外
+    }
+    framebuffer_mark(fb, x0, y0, x1, y1);
+
+    brightness &= 0x0F;
+    uint16_t pair = brightness * 0x11;    // 2 ピクセルとも明るさ brightness の要素
+    uint32_t pair2 = pair * 0x00010001u; // その 2 要素分
+    for (int row = y0; row <= y1; row++)
+    {
+        uint16_t *line = &fb->pixels[row * DISPLAY_WIDTH / 2];
+        int xs = x0;
+        int xe = x1;
+        if (xs & 1)
+        {
+            line[xs / 2] = (line[xs / 2] & 0xF0) | brightness; // 左端が奇数 x なら下位ニブルだけ
+            xs++;
+        }
+        if ((xe & 1) == 0 && xe >= xs)
+        {
+            line[xe / 2] = (line[xe / 2] & 0x0F) | (brightness << 4); // 右端が偶数 x なら上位ニブルだけ
+            xe--;
+        }
+
+        // 残りは要素単位。4 バイト境界に揃えてから 2 要素ずつ書き込む
+        uint16_t *p = &line[xs / 2];
+        uint16_t *end = &line[(xe + 1) / 2];
+        if (p < end && ((uintptr_t)p & 2))
+        {
+            *p++ = pair;
+        }
+        for (; p + 2 <= end; p += 2)
+        {
+            memcpy(p, &pair2, sizeof pair2);
+        }
+        if (p < end)
+        {
+            *p = pair;
+        }
+    }
+}
+
+void draw_hline(framebuffer *fb, int x, int y, int w, uint8_t brightness)
+{
+    fill_rect(fb, x, y, w, 1, brightness);
+}
+
+void draw_vline(framebuffer *fb, int x, int y, int h, uint8_t brightness)
+{
+    fill_rect(fb, x, y, 1, h, brightness);
+}
@@ -0,0 +1,78 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdint.h> // 固定幅整数型
+
+/* 定義 (マクロ) */
+#define DISPLAY_WIDTH 128                                      // OLED ディスプレイの幅を 128 ピクセルに定義
+#define DISPLAY_HEIGHT 128                                     // OLED ディスプレイの高さを 128 ピクセルに定義
+#define DISPLAY_DATA_SIZE (DISPLAY_WIDTH * DISPLAY_HEIGHT / 2) // ディスプレイに必要なデータ量。SSD1327 は 1 ピクセルあたり 4 ビットなので、バイト数は総ピクセル数の半分
+#define FRAMEBUFFER_CONTROL_DATA 0x40                          // 以降がデータであることを示す SSD1327 の制御バイト
+#define FRAMEBUFFER_MAX_RECTS 8                                // 記録する矩形の最大数 (あふれたら近いものどうしを結合する)
+
+// 矩形 (両端の座標を含む)
+// SSD1327 は横 2 ピクセル単位でアドレスを指定するので、x0 は偶数、x1 は奇数に揃えて記録する
+typedef struct
+{
+    uint8_t x0, y0; // 左上
+    uint8_t x1, y1; // 右下
+} framebuffer_rect;
+
+// 重ならないように結合した矩形の一覧
+typedef struct
+{
+    framebuffer_rect rects[FRAMEBUFFER_MAX_RECTS];
+    int count;
+} framebuffer_rect_list;
+
+// 表示バッファ
+//
+// I2C の送信 FIFO (IC_DATA_CMD レジスタ) へ DMA でそのまま書き込めるように、1 バイトを 16 ビットの要素に入れておく。
+// IC_DATA_CMD の bit 8 以上は READ / STOP / RESTART の指定なので、8 ビット幅の DMA では正しく送れない
+// (RP2350 は周辺レジスタへの 8 ビット書き込みを 32 ビット全体に複製するため)。
+//
+// 描画関数は書き換えた範囲を dirty に記録する。ssd1327_start_frame() は dirty の範囲だけを送信する。
+// また、前回のクリア以降に描画した範囲を drawn に記録しておき、framebuffer_clear() はその範囲だけを消す。
+typedef struct
+{
+    uint16_t pixels[DISPLAY_DATA_SIZE]; // 下位 8 ビットに横 2 ピクセル分 (上位 4 ビットが偶数 x)。上位 8 ビットは常に 0
+    framebuffer_rect_list dirty;        // 書き換えたがまだ送信していない範囲
+    framebuffer_rect_list drawn;        // 前回のクリア以降に描画した範囲
+} framebuffer;
+
+// 全体を黒でクリアし、全体を送信が必要な範囲にする
+void framebuffer_init(framebuffer *fb);
+
+// 前回のクリア以降に描画した範囲を黒 (明るさ 0) に戻す
+// 描画関数を通さずに pixels を書き換えた場合は、framebuffer_mark() でその範囲を記録しておくこと
+void framebuffer_clear(framebuffer *fb);
+
+// 指定した範囲を「描画した範囲」と「送信が必要な範囲」に加える (画面外は切り捨てる)
+void framebuffer_mark(framebuffer *fb, int x0, int y0, int x1, int y1);
+
+// 送信が必要な範囲を rects に取り出して空にする。矩形の数を返す
+int framebuffer_take_dirty(framebuffer *fb, framebuffer_rect *rects);
+
+// rects の範囲を送信が必要な範囲に加える (描画した範囲には加えない)
+// ダブルバッファで、もう一方のバッファに描画した範囲もパネル上では書き換える必要がある場合に使う
+void framebuffer_add_dirty(framebuffer *fb, const framebuffer_rect_list *rects);
+
+// 指定した座標のピクセルの明るさを設定する (4ビットグレースケール：0〜15 の値で明るさを指定)
+void set_pixel(framebuffer *fb, int x, int y, uint8_t brightness);
+
+// 指定した座標に 1 文字を描画する (等幅フォント、背景はそのまま)
+void draw_char(framebuffer *fb, char c, int x, int y, uint8_t brightness);
+
+// 指定した座標に文字列を描画する (等幅フォント、背景はそのまま。背景ごと描く場合やプロポーショナルは font.h の draw_text())
+void draw_string(framebuffer *fb, const char *str, int x, int y, uint8_t brightness);
+
+// 左上 (x, y)、幅 w、高さ h の矩形を塗りつぶす (画面外は切り捨てる)
+void fill_rect(framebuffer *fb, int x, int y, int w, int h, uint8_t brightness);
+
+// (x, y) から右へ長さ w の水平線を描く
+void draw_hline(framebuffer *fb, int x, int y, int w, uint8_t brightness);
+
+// (x, y) から下へ長さ h の垂直線を描く
+void draw_vline(framebuffer *fb, int x, int y, int h, uint8_t brightness);
+
+#endif // FRAMEBUFFER_H
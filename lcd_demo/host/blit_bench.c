@@ -0,0 +1,174 @@
+#include <stdio.h>       // 標準入出力ライブラリ
+#include <string.h>      // memcmp
+#include "host_util.h"   // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "framebuffer.h" // 表示バッファと描画関数
+#include "font8x8.h"     // 基準の実装で使うフォント
+
+// 表引きで 1 行をまとめて書き込む draw_char() / fill_rect() を、1 ピクセルずつ書き込む以前の実装と比べる
+//
+// 画面の端にかかる位置・奇数 x・さまざまな明るさで両方を描き、表示バッファがピクセル単位で一致することを
+// 確かめてから、1 秒あたりの文字数・矩形数を計測する。
+
+#define CHECK_COUNT (200000) // 一致を確かめる描画回数
+#define BENCH_COUNT (4096)   // ベンチマークで 1 回に描く文字・矩形の数
+#define BENCH_REPEAT (200)   // ベンチマークの繰り返し回数
+
+// 基準: 以前の put_pixel() (1 ピクセルずつニブルを読み書きする)
+static void ref_put_pixel(framebuffer *fb, int x, int y, uint8_t brightness)
+{
+    int index = (y * DISPLAY_WIDTH + x) / 2;
+    if (x % 2 == 0)
+    {
+        fb->pixels[index] = (fb->pixels[index] & 0x0F) | ((brightness & 0x0F) << 4);
+    }
+    else
+    {
+        fb->pixels[index] = (fb->pixels[index] & 0xF0) | (brightness & 0x0F);
+    }
+}
+
+// 基準: 以前の draw_char() (範囲を 1 回記録し、フォントのビットごとに書き込む)。文字の対応は現在のフォントに合わせる
+static void ref_draw_char(framebuffer *fb, char c, int x, int y, uint8_t brightness)
+{
+    unsigned char u = (unsigned char)c;
+    int font_index = (u >= 0x20 && u <= 0x7E ? u : '?') - 0x20; // フォントにない文字は '?'
+
+    framebuffer_mark(fb, x, y, x + 7, y + 7);
+    for (int row = 0; row < 8; row++)
+    {
+        for (int col = 0; col < 8; col++)
+        {
+            if ((font_8x8[font_index][row] & (0x80 >> col)) && x + col >= 0 && x + col < DISPLAY_WIDTH && y + row >= 0 && y + row < DISPLAY_HEIGHT)
+            {
+                ref_put_pixel(fb, x + col, y + row, brightness);
+            }
+        }
+    }
+}
+
+// 基準: 以前の draw_face() と同じく set_pixel() を並べて矩形を塗る
+static void ref_fill_rect(framebuffer *fb, int x, int y, int w, int h, uint8_t brightness)
+{
+    for (int yy = y; yy < y + h; yy++)
+    {
+        for (int xx = x; xx < x + w; xx++)
+        {
+            set_pixel(fb, xx, yy, brightness);
+        }
+    }
+}
+
+// 描画の引数 1 回分
+typedef struct
+{
+    char c;
+    int x, y, w, h;
+    uint8_t brightness;
+} draw_op;
+
+// 文字を 1 つ選ぶ (フォントにない文字も混ぜる)
+static char random_char(void)
+{
+    static const char chars[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZaz #~\n\x7f\x80";
+    return chars[rng() % (sizeof chars - 1)];
+}
+
+// 新旧の実装で同じ描画を重ね、表示バッファが一致するか確かめる。不一致の数を返す
+static int check(void)
+{
+    static framebuffer a, b;
+    int mismatch = 0;
+
+    framebuffer_init(&a);
+    framebuffer_init(&b);
+    for (int i = 0; i < CHECK_COUNT; i++)
+    {
+        uint8_t brightness = rng() & 0x0F;
+        int x = (int)(rng() % (DISPLAY_WIDTH + 24)) - 12; // 画面の外や端にかかる位置も含める
+        int y = (int)(rng() % (DISPLAY_HEIGHT + 24)) - 12;
+        if (i & 1)
+        {
+            char c = random_char();
+            draw_char(&a, c, x, y, brightness);
+            ref_draw_char(&b, c, x, y, brightness);
+        }
+        else
+        {
+            int w = (int)(rng() % 40) - 2; // 幅・高さ 0 以下も含める
+            int h = (int)(rng() % 40) - 2;
+            fill_rect(&a, x, y, w, h, brightness);
+            ref_fill_rect(&b, x, y, w, h, brightness);
+        }
+        if (memcmp(a.pixels, b.pixels, sizeof a.pixels) != 0)
+        {
+            if (mismatch++ == 0)
+            {
+                printf("first mismatch at op %d (x=%d y=%d)\n", i, x, y);
+            }
+            memcpy(b.pixels, a.pixels, sizeof a.pixels); // 以降の比較を続けられるように揃える
+        }
+    }
+    printf("check: %d draws (chars and rects, clipped and odd x), %d mismatches\n", CHECK_COUNT, mismatch);
+    return mismatch;
+}
+
+// 描画の列を BENCH_REPEAT 回繰り返し、1 秒あたりの回数を返す
+static double bench(void (*draw)(framebuffer *, const draw_op *), const draw_op *ops)
+{
+    static framebuffer fb;
+    framebuffer_init(&fb);
+    double start = now_sec();
+    for (int r = 0; r < BENCH_REPEAT; r++)
+    {
+        for (int i = 0; i < BENCH_COUNT; i++)
+        {
+            draw(&fb, &ops[i]);
+        }
+    }
+    double elapsed = now_sec() - start;
+    volatile uint16_t sink = fb.pixels[rng() % DISPLAY_DATA_SIZE]; // 描画が最適化で消えないようにする
+    (void)sink;
+    return (double)BENCH_COUNT * BENCH_REPEAT / elapsed;
+}
+
+static void op_char_new(framebuffer *fb, const draw_op *op) { draw_char(fb, op->c, op->x, op->y, op->brightness); }
+static void op_char_ref(framebuffer *fb, const draw_op *op) { ref_draw_char(fb, op->c, op->x, op->y, op->brightness); }
+static void op_rect_new(framebuffer *fb, const draw_op *op) { fill_rect(fb, op->x, op->y, op->w, op->h, op->brightness); }
+static void op_rect_ref(framebuffer *fb, const draw_op *op) { ref_fill_rect(fb, op->x, op->y, op->w, op->h, op->brightness); }
+
+int main(void)
+{
+    if (check() != 0)
+    {
+        return 1;
+    }
+
+    // 画面内に収まる文字 (数字と大文字) と、lcd_demo の目・口程度の大きさの矩形
+    static draw_op chars[BENCH_COUNT], rects[BENCH_COUNT];
+    for (int i = 0; i < BENCH_COUNT; i++)
+    {
+        chars[i] = (draw_op){
+            .c = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"[rng() % 36],
+            .x = rng() % (DISPLAY_WIDTH - 7),
+            .y = rng() % (DISPLAY_HEIGHT - 7),
+            .brightness = 1 + rng() % 15,
+        };
+        rects[i] = (draw_op){
+            .w = 4 + rng() % 28,
+            .h = 1 + rng() % 10,
+            .brightness = 1 + rng() % 15,
+        };
+        rects[i].x = rng() % (DISPLAY_WIDTH - rects[i].w + 1);
+        rects[i].y = rng() % (DISPLAY_HEIGHT - rects[i].h + 1);
+    }
+
+    double char_ref = bench(op_char_ref, chars);
+    double char_new = bench(op_char_new, chars);
+    double rect_ref = bench(op_rect_ref, rects);
+    double rect_new = bench(op_rect_new, rects);
+    printf("draw_char: per-pixel %8.2f M glyphs/s, table blit %8.2f M glyphs/s (%.1fx)\n",
+           char_ref * 1e-6, char_new * 1e-6, char_new / char_ref);
+    printf("fill_rect: set_pixel %8.2f M rects/s,  row fill   %8.2f M rects/s  (%.1fx)\n",
+           rect_ref * 1e-6, rect_new * 1e-6, rect_new / rect_ref);
+    return 0;
+}
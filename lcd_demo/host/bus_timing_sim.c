@@ -0,0 +1,235 @@
+#include <stdio.h>            // 標準入出力ライブラリ
+#include <stdlib.h>           // strtod
+#include <string.h>           // memcmp
+#include <unistd.h>           // getopt
+#include "framebuffer.h"      // 表示バッファの大きさ
+#include "ssd1327_commands.h" // lcd_demo と同じコマンド列
+
+// I2C バスのタイミングを数え、SSD1327 のコマンドを 1 バイトずつ送る場合とコマンド列をまとめて送る場合を比べる
+//
+// 使い方: bus_timing_sim [-s scl_hz] [-o call_us]
+//   -s  SCL の周波数 (既定 1000000 = main.c と同じ 1MHz)
+//   -o  i2c_write_blocking() 1 回あたりのソフトウェアのオーバーヘッド [us] (既定 0 = バスの時間だけ)
+//
+// バスは START・STOP・再スタートを 1 クロック、1 バイトを 9 クロック (8 ビット + ACK) とし、
+// 転送と転送の間にバスの空き時間 (Fast-mode Plus の tBUF = 0.5us) を入れる。
+// パネル側は受け取ったバイト列を制御バイトに従ってコマンドと表示データに分け、
+// どちらの送り方でも同じコマンドが同じ順に届くことを確かめる。
+
+#define BUS_FREE_US 0.5        // STOP から次の START までの最小時間 (tBUF)
+#define MAX_COMMANDS 256       // パネル側で記録するコマンドの最大数
+#define FACE_RECTS 4           // lcd_demo の顔のアニメーションで 1 フレームに送る矩形の数 (dirty_rect_bench)
+#define FACE_PIXEL_BYTES 288   // そのうち表示データのバイト数 (328 バイトから矩形ごとの 10 バイトを引いた値)
+
+// バスとパネルの状態
+typedef struct
+{
+    double scl_hz;   // SCL の周波数
+    double call_us;  // 転送 1 回あたりのソフトウェアのオーバーヘッド
+    double clocks;   // これまでの SCL クロック数
+    double extra_us; // クロック以外の時間 (バスの空き時間とソフトウェアのオーバーヘッド)
+    long transactions; // START から STOP までの転送の数
+    long bytes;        // アドレスを含めて送ったバイト数
+
+    // パネル側
+    int first;        // 次のバイトが制御バイトなら 1
+    int data_mode;    // 制御バイトの D/C# (1 なら表示データ)
+    uint8_t commands[MAX_COMMANDS]; // 受け取ったコマンド
+    int command_count;
+    long data_bytes;  // 受け取った表示データのバイト数
+} bus;
+
+static void bus_reset(bus *b, double scl_hz, double call_us)
+{
+    memset(b, 0, sizeof *b);
+    b->scl_hz = scl_hz;
+    b->call_us = call_us;
+}
+
+// これまでの時間 [us]
+static double bus_time_us(const bus *b)
+{
+    return b->clocks * 1e6 / b->scl_hz + b->extra_us;
+}
+
+// 1 バイト送る (ACK を含めて 9 クロック)。パネル側は制御バイトに従って受け取る
+static void bus_byte(bus *b, uint8_t value)
+{
+    b->clocks += 9;
+    b->bytes++;
+    if (b->first)
+    {
+        b->first = 0;
+        b->data_mode = (value & 0x40) != 0;
+    }
+    else if (b->data_mode)
+    {
+        b->data_bytes++;
+    }
+    else if (b->command_count < MAX_COMMANDS)
+    {
+        b->commands[b->command_count++] = value;
+    }
+}
+
+// START (または再スタート) とアドレス
+static void bus_start(bus *b)
+{
+    b->clocks += 1 + 9;
+    b->bytes++;
+    b->first = 1; // アドレスの次が制御バイト
+}
+
+static void bus_stop(bus *b)
+{
+    b->clocks += 1;
+    b->extra_us += BUS_FREE_US;
+    b->transactions++;
+}
+
+// i2c_write_blocking() 1 回分 (START + アドレス + len バイト + STOP)
+static void write_blocking(bus *b, const uint8_t *buf, size_t len)
+{
+    b->extra_us += b->call_us;
+    bus_start(b);
+    for (size_t i = 0; i < len; i++)
+    {
+        bus_byte(b, buf[i]);
+    }
+    bus_stop(b);
+}
+
+// 以前の ssd1327_send_command(): コマンド 1 バイトごとに制御バイト付きで 1 回転送する
+static void send_one_by_one(bus *b, const uint8_t *commands, size_t len)
+{
+    for (size_t i = 1; i < len; i++)
+    {
+        uint8_t buffer[2] = {SSD1327_CONTROL_COMMAND, commands[i]};
+        write_blocking(b, buffer, 2);
+    }
+}
+
+// ssd1327_start_frame() の DMA 転送: 矩形ごとに (再スタート) ウィンドウ設定 + 再スタート + 表示データ、最後に STOP
+static void dma_frame(bus *b, int rects, long pixel_bytes)
+{
+    uint8_t window[SSD1327_WINDOW_COMMANDS];
+    for (int r = 0; r < rects; r++)
+    {
+        ssd1327_window_commands(window, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1); // 時間は座標によらない
+        bus_start(b);
+        for (int i = 0; i < SSD1327_WINDOW_COMMANDS; i++)
+        {
+            bus_byte(b, window[i]);
+        }
+        bus_start(b);
+        bus_byte(b, FRAMEBUFFER_CONTROL_DATA);
+        for (long i = 0; i < pixel_bytes / rects; i++)
+        {
+            bus_byte(b, 0);
+        }
+    }
+    bus_stop(b);
+}
+
+// 従来方式の 1 フレーム: ウィンドウ設定 + 表示データを i2c_write_blocking() で送る
+static void blocking_frame(bus *b, int batched)
+{
+    uint8_t window[SSD1327_WINDOW_COMMANDS];
+    ssd1327_window_commands(window, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+    if (batched)
+    {
+        write_blocking(b, window, sizeof window);
+    }
+    else
+    {
+        send_one_by_one(b, window, sizeof window);
+    }
+
+    static uint8_t data[DISPLAY_DATA_SIZE + 1];
+    data[0] = FRAMEBUFFER_CONTROL_DATA;
+    write_blocking(b, data, sizeof data);
+}
+
+int main(int argc, char **argv)
+{
+    double scl_hz = 1000000;
+    double call_us = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:o:")) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            scl_hz = strtod(optarg, NULL);
+            break;
+        case 'o':
+            call_us = strtod(optarg, NULL);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-s scl_hz] [-o call_us]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (scl_hz <= 0 || call_us < 0)
+    {
+        fprintf(stderr, "usage: %s [-s scl_hz] [-o call_us]\n", argv[0]);
+        return 2;
+    }
+
+    static bus old_bus, new_bus;
+    size_t init_len = sizeof(ssd1327_init_commands);
+    printf("bus model: SCL %.0f kHz, 9 clocks/byte, tBUF %.1f us, %.1f us per i2c_write_blocking()\n",
+           scl_hz / 1000, BUS_FREE_US, call_us);
+
+    // 起動: 初期化シーケンス → 全画面の最初のフレーム (DMA)
+    bus_reset(&old_bus, scl_hz, call_us);
+    bus_reset(&new_bus, scl_hz, call_us);
+    send_one_by_one(&old_bus, ssd1327_init_commands, init_len);
+    write_blocking(&new_bus, ssd1327_init_commands, init_len);
+    int same = old_bus.command_count == new_bus.command_count &&
+               memcmp(old_bus.commands, new_bus.commands, old_bus.command_count) == 0 &&
+               new_bus.command_count == (int)init_len - 1;
+    double old_init = bus_time_us(&old_bus);
+    double new_init = bus_time_us(&new_bus);
+    long old_init_bytes = old_bus.bytes;
+    long new_init_bytes = new_bus.bytes;
+    long old_init_tr = old_bus.transactions;
+    int init_commands = new_bus.command_count;
+    dma_frame(&old_bus, 1, DISPLAY_DATA_SIZE);
+    dma_frame(&new_bus, 1, DISPLAY_DATA_SIZE);
+
+    printf("init sequence: %d commands, %s\n", init_commands,
+           same ? "panel received identical command stream" : "COMMAND STREAM MISMATCH");
+    printf("  one command per transaction: %3ld transactions, %4ld bytes, %8.1f us\n",
+           old_init_tr, old_init_bytes, old_init);
+    printf("  batched command list:        %3d transactions, %4ld bytes, %8.1f us (%.1fx faster)\n",
+           1, new_init_bytes, new_init, old_init / new_init);
+    printf("startup to first frame (init + full-screen DMA frame):\n");
+    printf("  one command per transaction: %8.1f us\n", bus_time_us(&old_bus));
+    printf("  batched command list:        %8.1f us (%.1f us saved)\n",
+           bus_time_us(&new_bus), bus_time_us(&old_bus) - bus_time_us(&new_bus));
+
+    // 1 フレームあたりのオーバーヘッド (表示データ以外にかかる時間)
+    double pixel_us = (double)DISPLAY_DATA_SIZE * 9 * 1e6 / scl_hz;
+    bus_reset(&old_bus, scl_hz, call_us);
+    bus_reset(&new_bus, scl_hz, call_us);
+    blocking_frame(&old_bus, 0);
+    blocking_frame(&new_bus, 1);
+    printf("per-frame overhead beyond %d pixel bytes (%.1f us):\n", DISPLAY_DATA_SIZE, pixel_us);
+    printf("  blocking full frame, window one command per transaction: %3ld transactions, %6.1f us\n",
+           old_bus.transactions, bus_time_us(&old_bus) - pixel_us);
+    printf("  blocking full frame, window as one command list:         %3ld transactions, %6.1f us\n",
+           new_bus.transactions, bus_time_us(&new_bus) - pixel_us);
+
+    bus_reset(&new_bus, scl_hz, call_us);
+    dma_frame(&new_bus, 1, DISPLAY_DATA_SIZE);
+    printf("  DMA full frame (window in the same stream):               %3ld transactions, %6.1f us\n",
+           new_bus.transactions, bus_time_us(&new_bus) - pixel_us);
+
+    bus_reset(&new_bus, scl_hz, call_us);
+    dma_frame(&new_bus, FACE_RECTS, FACE_PIXEL_BYTES);
+    double face_pixel_us = (double)FACE_PIXEL_BYTES * 9 * 1e6 / scl_hz;
+    printf("  DMA face frame, %d dirty rects (%d pixel bytes):          %3ld transactions, %6.1f us\n",
+           FACE_RECTS, FACE_PIXEL_BYTES, new_bus.transactions, bus_time_us(&new_bus) - face_pixel_us);
+    return same ? 0 : 1;
+}
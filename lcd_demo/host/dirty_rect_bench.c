@@ -0,0 +1,120 @@
+#include <stdio.h>       // 標準入出力ライブラリ
+#include <stdlib.h>      // strtol
+#include <string.h>      // memcmp
+#include "framebuffer.h" // 表示バッファと描画関数
+#include "face.h"        // 顔の表情の描画
+
+// 書き換えた矩形だけを送る場合と、毎フレーム全体を送る場合の I2C 転送量を比べる
+//
+// 使い方: dirty_rect_bench [frames]
+// 2 つのアニメーションを描き、フレームごとに framebuffer_take_dirty() が返す矩形から転送バイト数を数える。
+// 同時に、矩形の内容だけを反映した「パネル」の内容が表示バッファと一致することを確かめる
+// (書き換えた範囲の記録漏れがあれば一致しない)。
+
+#define I2C_SPEED 1000000     // I2C の通信速度 (main.c と同じ 1MHz)
+#define CLOCKS_PER_BYTE 9     // 1 バイト = 8 ビット + ACK
+#define DEFAULT_FRAMES 1000   // 既定のフレーム数
+
+// 毎フレーム全体を送る場合のバイト数 (ssd1327_set_window() のコマンド 6 回 + 表示データ 1 回)
+// コマンド 1 回 = アドレス + 制御バイト + コマンド、表示データ = アドレス + 制御バイト + 8192
+#define FULL_FRAME_BYTES (6 * 3 + 2 + DISPLAY_DATA_SIZE)
+
+// 矩形 1 つのバイト数 (ssd1327.c の送信内容)
+// 再スタート + アドレス、制御バイト 0x00 + コマンド 6 バイト、再スタート + アドレス、制御バイト 0x40、表示データ
+static long rect_bytes(framebuffer_rect r)
+{
+    return 1 + 7 + 1 + 1 + (long)(r.x1 - r.x0 + 1) / 2 * (r.y1 - r.y0 + 1);
+}
+
+// 矩形の範囲だけを表示バッファからパネルに写す
+static void apply_rect(uint16_t *panel, const framebuffer *fb, framebuffer_rect r)
+{
+    for (int y = r.y0; y <= r.y1; y++)
+    {
+        int i = (y * DISPLAY_WIDTH + r.x0) / 2;
+        memcpy(&panel[i], &fb->pixels[i], (r.x1 - r.x0 + 1) / 2 * sizeof(uint16_t));
+    }
+}
+
+// アニメーション 1: lcd_demo と同じ顔 (目・口・メッセージだけが変わる)
+static void scene_face(framebuffer *fb, int frame)
+{
+    unsigned seed = frame * 2654435761u; // フレーム番号から決まる疑似乱数
+    draw_face(fb, (seed >> 16) & 1, (seed >> 17) & 1);
+}
+
+// アニメーション 2: 跳ね回る文字とフレーム番号のカウンタ
+static void scene_bounce(framebuffer *fb, int frame)
+{
+    int x = frame % 240;
+    int y = (frame * 3) % 240;
+    x = x < 120 ? x : 239 - x; // 0..119 を往復
+    y = y < 120 ? y : 239 - y;
+    draw_char(fb, 'A' + frame % 26, x, y, 15);
+
+    char text[12];
+    snprintf(text, sizeof text, "%d", frame);
+    draw_string(fb, text, 0, 0, 8);
+}
+
+// 1 つのアニメーションを frames フレーム描き、結果を表示する。不一致があれば 1 を返す
+static int run(const char *name, void (*scene)(framebuffer *, int), int frames)
+{
+    static framebuffer fb;
+    static uint16_t panel[DISPLAY_DATA_SIZE]; // パネル側の表示メモリ
+    framebuffer_rect rects[FRAMEBUFFER_MAX_RECTS];
+    long total = 0;
+    int rect_total = 0;
+    int rect_max = 0;
+    int mismatch = 0;
+
+    framebuffer_init(&fb);
+    memset(panel, 0xFF, sizeof panel); // 電源投入直後のパネルの内容は不定
+    for (int f = 0; f <= frames; f++)
+    {
+        if (f > 0) // フレーム 0 は初期化直後の全画面送信 (平均には含めない)
+        {
+            framebuffer_clear(&fb);
+            scene(&fb, f);
+        }
+
+        int count = framebuffer_take_dirty(&fb, rects);
+        for (int i = 0; i < count; i++)
+        {
+            total += f > 0 ? rect_bytes(rects[i]) : 0;
+            apply_rect(panel, &fb, rects[i]);
+        }
+        if (f > 0)
+        {
+            rect_total += count;
+            rect_max = count > rect_max ? count : rect_max;
+        }
+        mismatch += memcmp(panel, fb.pixels, sizeof panel) != 0;
+    }
+
+    double full_ms = (double)FULL_FRAME_BYTES * CLOCKS_PER_BYTE * 1000 / I2C_SPEED;
+    double dirty_bytes = (double)total / frames;
+    double dirty_ms = dirty_bytes * CLOCKS_PER_BYTE * 1000 / I2C_SPEED;
+    printf("%-7s: %d frames, rects avg %.2f max %d, %s\n", name, frames,
+           (double)rect_total / frames, rect_max, mismatch ? "PANEL MISMATCH" : "panel matches");
+    printf("         full frame  %6d bytes/frame, %6.2f ms/frame at %d kHz\n",
+           FULL_FRAME_BYTES, full_ms, I2C_SPEED / 1000);
+    printf("         dirty rects %6.0f bytes/frame, %6.2f ms/frame (%.1fx less bus time)\n",
+           dirty_bytes, dirty_ms, full_ms / dirty_ms);
+    return mismatch != 0;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? (int)strtol(argv[1], NULL, 0) : DEFAULT_FRAMES;
+    if (frames <= 0)
+    {
+        fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+        return 2;
+    }
+
+    int failed = 0;
+    failed |= run("face", scene_face, frames);
+    failed |= run("bounce", scene_bounce, frames);
+    return failed;
+}
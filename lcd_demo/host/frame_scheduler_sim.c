@@ -0,0 +1,244 @@
+#include <stdio.h>             // 標準入出力ライブラリ
+#include <stdlib.h>            // strtol
+#include <string.h>            // memcmp
+#include <unistd.h>            // getopt
+#include "host_util.h"         // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "framebuffer.h"       // 表示バッファと描画関数
+#include "font.h"              // 文字列の描画
+#include "face.h"              // 顔の表情の描画
+#include "frame_scheduler.h"   // ダブルバッファと一定のフレームレートでの描画
+
+// frame_scheduler をホストで動かし、転送が終わるたびにパネルの内容を確かめて PGM ファイルに書き出す
+//
+// 使い方: frame_scheduler_sim [-f fps] [-n frames] [-l load_us] [-o dir] [-k every]
+//   -f  フレームレート (既定 30 = main.c と同じ)
+//   -n  描画するフレーム数 (既定 300)
+//   -l  1 フレームの描画に追加でかかる時間 [us] (既定 0。周期より長くするとフレームを落とす)
+//   -o  パネルの内容を dir/frame_NNNN.pgm に書き出す (既定は書き出さない)
+//   -k  every フレームごとに書き出す (既定 1)
+//
+// 時計は仮想時刻で、描画にかかった実時間 (と -l の時間) だけ進み、待ち (sleep_until) は待たずに時刻を進める。
+// 転送は ssd1327.c と同じバイト数を 1MHz・1 バイト 9 クロックで送る時間がかかるものとし、
+// 転送が終わった時点で、送った矩形の範囲を表示バッファからパネルに写す。
+// このときパネルの内容が送ったバッファの内容と一致しなければ、ダブルバッファの範囲の管理に誤りがある。
+
+#define I2C_SPEED 1000000   // I2C の通信速度 (main.c と同じ 1MHz)
+#define CLOCKS_PER_BYTE 9   // 1 バイト = 8 ビット + ACK
+
+// ホストの表示とパネル
+typedef struct
+{
+    uint64_t clock_us;        // 仮想時刻
+    double synced_sec;        // 仮想時刻に実時間を反映した時点
+    uint32_t load_us;         // 1 フレームの描画に追加でかかる時間
+    uint64_t busy_until_us;   // 転送が終わる時刻
+    uint32_t last_transfer_us; // 最後に終わった転送の時間
+    const framebuffer *sending;                   // 転送中のバッファ (NULL なら転送していない)
+    framebuffer_rect rects[FRAMEBUFFER_MAX_RECTS]; // 転送中の矩形
+    int count;
+    uint32_t transfer_us;     // 転送中のフレームの転送時間
+    uint16_t panel[DISPLAY_DATA_SIZE]; // パネルの表示メモリ
+    int mismatches;           // 転送後にパネルと送ったバッファが一致しなかった回数
+    int transfers;            // 終わった転送の数
+    const char *dir;          // PGM の出力先 (NULL なら書き出さない)
+    int every;                // 書き出す間隔
+    int written;              // 書き出したファイル数
+} host_display;
+
+// パネルの内容を PGM (8 ビット、最大値 15) で書き出す
+static void write_pgm(host_display *d, int index)
+{
+    char path[512];
+    snprintf(path, sizeof path, "%s/frame_%04d.pgm", d->dir, index);
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL)
+    {
+        perror(path);
+        return;
+    }
+    fprintf(fp, "P5\n%d %d\n15\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    for (int i = 0; i < DISPLAY_DATA_SIZE; i++)
+    {
+        uint8_t pair[2] = {d->panel[i] >> 4 & 0x0F, d->panel[i] & 0x0F}; // 上位 4 ビットが偶数 x
+        fwrite(pair, 1, 2, fp);
+    }
+    fclose(fp);
+    d->written++;
+}
+
+// 転送を終わらせ、矩形の範囲をパネルに写して確かめる
+static void finish_transfer(host_display *d)
+{
+    if (d->sending == NULL)
+    {
+        return;
+    }
+    for (int i = 0; i < d->count; i++)
+    {
+        framebuffer_rect r = d->rects[i];
+        for (int y = r.y0; y <= r.y1; y++)
+        {
+            int index = (y * DISPLAY_WIDTH + r.x0) / 2;
+            memcpy(&d->panel[index], &d->sending->pixels[index], (r.x1 - r.x0 + 1) / 2 * sizeof(uint16_t));
+        }
+    }
+    d->mismatches += memcmp(d->panel, d->sending->pixels, sizeof d->panel) != 0;
+    if (d->dir && d->transfers % d->every == 0)
+    {
+        write_pgm(d, d->transfers);
+    }
+    d->transfers++;
+    d->last_transfer_us = d->transfer_us;
+    d->sending = NULL;
+}
+
+static uint64_t host_now_us(void *ctx)
+{
+    host_display *d = ctx;
+    double now = now_sec();
+    d->clock_us += (uint64_t)((now - d->synced_sec) * 1e6);
+    d->synced_sec = now;
+    return d->clock_us;
+}
+
+static void host_sleep_until(void *ctx, uint64_t time_us)
+{
+    host_display *d = ctx;
+    if (host_now_us(d) < time_us)
+    {
+        d->clock_us = time_us;
+    }
+}
+
+static void host_wait(void *ctx)
+{
+    host_display *d = ctx;
+    host_sleep_until(d, d->busy_until_us);
+    finish_transfer(d);
+}
+
+static uint32_t host_last_transfer_us(void *ctx)
+{
+    host_display *d = ctx;
+    return d->last_transfer_us;
+}
+
+// ssd1327_start_frame() と同じく送信が必要な範囲を取り出し、そのバイト数ぶんの転送時間を見積もる
+static bool host_start_frame(void *ctx, framebuffer *fb)
+{
+    host_display *d = ctx;
+    if (d->sending)
+    {
+        return false; // 前のフレームを送信中
+    }
+    d->count = framebuffer_take_dirty(fb, d->rects);
+    long bytes = 1; // アドレス
+    for (int i = 0; i < d->count; i++)
+    {
+        framebuffer_rect r = d->rects[i];
+        bytes += 1 + 7 + 1 + 1 + (long)(r.x1 - r.x0 + 1) / 2 * (r.y1 - r.y0 + 1);
+    }
+    d->sending = fb;
+    d->transfer_us = d->count ? (uint32_t)(bytes * CLOCKS_PER_BYTE * 1000000LL / I2C_SPEED) : 0;
+    d->busy_until_us = host_now_us(d) + d->transfer_us;
+    return true;
+}
+
+// アニメーション: 1 秒ごとに変わる顔、跳ね回る文字、フレーム番号
+static void scene(framebuffer *fb, int frame, int fps)
+{
+    unsigned seed = (frame / fps + 1) * 2654435761u; // 1 秒ごとに変わる疑似乱数
+    draw_face(fb, (seed >> 16) & 1, (seed >> 17) & 1);
+
+    int x = frame * 3 % 240;
+    int y = frame * 2 % 200;
+    x = x < 120 ? x : 239 - x; // 0..119 を往復
+    y = y < 100 ? y : 199 - y;
+    draw_char(fb, 'A' + frame % 26, x, y, 10);
+
+    char text[16];
+    snprintf(text, sizeof text, "F%d", frame);
+    draw_text(fb, &font_proportional, text, 0, 0, 15, 2);
+}
+
+int main(int argc, char **argv)
+{
+    static host_display display;
+    int fps = 30;
+    int frames = 300;
+    display.every = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:n:l:o:k:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+            fps = (int)strtol(optarg, NULL, 0);
+            break;
+        case 'n':
+            frames = (int)strtol(optarg, NULL, 0);
+            break;
+        case 'l':
+            display.load_us = (uint32_t)strtol(optarg, NULL, 0);
+            break;
+        case 'o':
+            display.dir = optarg;
+            break;
+        case 'k':
+            display.every = (int)strtol(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-f fps] [-n frames] [-l load_us] [-o dir] [-k every]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (fps <= 0 || frames <= 0 || display.every <= 0)
+    {
+        fprintf(stderr, "usage: %s [-f fps] [-n frames] [-l load_us] [-o dir] [-k every]\n", argv[0]);
+        return 2;
+    }
+
+    const frame_scheduler_transport transport = {
+        .start_frame = host_start_frame,
+        .wait = host_wait,
+        .last_transfer_us = host_last_transfer_us,
+        .now_us = host_now_us,
+        .sleep_until = host_sleep_until,
+        .ctx = &display,
+    };
+    static frame_scheduler scheduler;
+    memset(display.panel, 0xFF, sizeof display.panel); // 電源投入直後のパネルの内容は不定
+    display.synced_sec = now_sec();
+    frame_scheduler_init(&scheduler, &transport, fps);
+    uint64_t start_us = host_now_us(&display);
+
+    for (int frame = 0; frame < frames; frame++)
+    {
+        framebuffer *fb = frame_scheduler_begin(&scheduler);
+        scene(fb, frame, fps);
+        display.clock_us += display.load_us; // 実機での描画時間の代わり
+        frame_scheduler_end(&scheduler);
+    }
+    host_wait(&display);
+    double elapsed = (host_now_us(&display) - start_us) * 1e-6;
+
+    const frame_stats *st = frame_scheduler_get_stats(&scheduler);
+    printf("%d frames at %d fps target: %.1f s virtual, %.2f fps achieved, %lu dropped\n",
+           frames, fps, elapsed, st->frames / elapsed, (unsigned long)st->dropped);
+    printf("render   avg %6.0f us, max %6lu us (host CPU + %lu us load)\n",
+           (double)st->render_total_us / st->frames, (unsigned long)st->render_max_us, (unsigned long)display.load_us);
+    printf("transfer avg %6.0f us, max %6lu us (1 MHz bus model)\n",
+           (double)st->transfer_total_us / (st->frames - 1), (unsigned long)st->transfer_max_us);
+    printf("panel: %d transfers, %s", display.transfers,
+           display.mismatches ? "" : "matches the sent buffer after every transfer");
+    if (display.mismatches)
+    {
+        printf("%d MISMATCHES", display.mismatches);
+    }
+    if (display.dir)
+    {
+        printf(", %d PGM files in %s", display.written, display.dir);
+    }
+    printf("\n");
+    return display.mismatches != 0;
+}
@@ -0,0 +1,245 @@
+#include <stdio.h>             // 標準入出力ライブラリ
+#include <stdlib.h>            // strtol, strtoul
+#include <unistd.h>            // getopt
+#include "framebuffer.h"       // 表示バッファと描画関数
+#include "font.h"              // 文字列の描画
+#include "face.h"              // 顔の表情の描画
+#include "frame_scheduler.h"   // ダブルバッファと一定のフレームレートでの描画
+#include "ssd1327.h"           // SSD1327 ドライバ (lcd_demo と同じソース)
+#include "ssd1327_panel.h"     // SSD1327 とパネルのモデル
+
+// lcd_demo の表示の流れ (ssd1327_init() → frame_scheduler → ssd1327_start_frame()) をそのままホストで動かし、
+// I2C に送られたバイト列をパネルのモデルに解釈させて、パネルに見える画像を確かめる
+//
+// 使い方: panel_sim [-f fps] [-n frames] [-s scl_hz] [-o dir] [-k every] [-g] [-r remap] [-c hash]
+//   -f  フレームレート (既定 30 = main.c と同じ)
+//   -n  描画するフレーム数 (既定 300)
+//   -s  I2C の通信速度 (既定 1000000 = main.c と同じ 1MHz)
+//   -o  パネルの画像を dir/panel_NNNN.png に書き出す (既定は書き出さない)
+//   -k  every フレームごとに書き出す (既定 1)
+//   -g  PNG の代わりに PGM (dir/panel_NNNN.pgm) で書き出す
+//   -r  初期化の後にリマップ (0xA0) をこの値に変える (画像の向きを見るため。0x51 以外では照合しない)
+//   -c  最後のフレームの画像のハッシュがこの値と一致しなければ失敗にする
+//
+// 時計は I2C バスのモデルの仮想時刻で、転送にかかる時間と待ち (sleep_until) だけ進む (描画の時間は 0)。
+// 各フレームの送信後に、パネルに見える画像が送った表示バッファと一致することを確かめる。
+
+#define I2C_SPEED 1000000 // I2C の通信速度 (main.c と同じ 1MHz)
+
+// シミュレーションの状態
+typedef struct
+{
+    ssd1327_panel panel;  // パネル
+    ssd1327_panel_bus bus; // I2C バス
+    bool check;           // 送信後にパネルと表示バッファを照合する
+    int mismatches;       // 一致しなかったフレーム数
+    int sent;             // 送信したフレーム数
+    const char *dir;      // 画像の出力先 (NULL なら書き出さない)
+    int every;            // 書き出す間隔
+    bool pgm;             // PGM で書き出す
+    int written;          // 書き出したファイル数
+} panel_sim;
+
+// 表示バッファを送信し、送信後のパネルを確かめる (frame_scheduler_transport 用)
+static bool sim_start_frame(void *ctx, framebuffer *fb)
+{
+    panel_sim *s = ctx;
+    bool started = ssd1327_start_frame(fb, NULL, NULL); // パネルのモデルへの転送はすぐに終わる
+    if (s->check && !ssd1327_panel_matches(&s->panel, fb))
+    {
+        s->mismatches++;
+    }
+    if (s->dir && s->sent % s->every == 0)
+    {
+        char path[512];
+        snprintf(path, sizeof path, "%s/panel_%04d.%s", s->dir, s->sent, s->pgm ? "pgm" : "png");
+        bool ok = s->pgm ? ssd1327_panel_write_pgm(&s->panel, path) : ssd1327_panel_write_png(&s->panel, path);
+        if (ok)
+        {
+            s->written++;
+        }
+        else
+        {
+            perror(path);
+        }
+    }
+    s->sent++;
+    return started;
+}
+
+static void sim_wait(void *ctx)
+{
+    (void)ctx;
+    ssd1327_wait();
+}
+
+static uint32_t sim_last_transfer_us(void *ctx)
+{
+    (void)ctx;
+    return ssd1327_get_stats()->last_transfer_us;
+}
+
+static uint64_t sim_now_us(void *ctx)
+{
+    panel_sim *s = ctx;
+    return s->bus.clock_ns / 1000;
+}
+
+static void sim_sleep_until(void *ctx, uint64_t time_us)
+{
+    panel_sim *s = ctx;
+    if (s->bus.clock_ns < time_us * 1000)
+    {
+        s->bus.clock_ns = time_us * 1000;
+    }
+}
+
+// アニメーション: 1 秒ごとに変わる顔、跳ね回る文字、フレーム番号 (frame_scheduler_sim と同じ)
+static void scene(framebuffer *fb, int frame, int fps)
+{
+    unsigned seed = (frame / fps + 1) * 2654435761u; // 1 秒ごとに変わる疑似乱数
+    draw_face(fb, (seed >> 16) & 1, (seed >> 17) & 1);
+
+    int x = frame * 3 % 240;
+    int y = frame * 2 % 200;
+    x = x < 120 ? x : 239 - x; // 0..119 を往復
+    y = y < 100 ? y : 199 - y;
+    draw_char(fb, 'A' + frame % 26, x, y, 10);
+
+    char text[16];
+    snprintf(text, sizeof text, "F%d", frame);
+    draw_text(fb, &font_proportional, text, 0, 0, 15, 2);
+}
+
+// パネルに見える画像の FNV-1a ハッシュ
+static uint32_t image_hash(const ssd1327_panel *p)
+{
+    static uint8_t image[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+    ssd1327_panel_snapshot(p, image);
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++)
+    {
+        h = (h ^ image[i]) * 16777619u;
+    }
+    return h;
+}
+
+static int usage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [-f fps] [-n frames] [-s scl_hz] [-o dir] [-k every] [-g] [-r remap] [-c hash]\n", argv0);
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    static panel_sim sim;
+    static frame_scheduler scheduler;
+    int fps = 30;
+    int frames = 300;
+    uint32_t scl_hz = I2C_SPEED;
+    int remap = -1;
+    bool check_hash = false;
+    uint32_t expected_hash = 0;
+    sim.every = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:n:s:o:k:gr:c:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+            fps = (int)strtol(optarg, NULL, 0);
+            break;
+        case 'n':
+            frames = (int)strtol(optarg, NULL, 0);
+            break;
+        case 's':
+            scl_hz = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        case 'o':
+            sim.dir = optarg;
+            break;
+        case 'k':
+            sim.every = (int)strtol(optarg, NULL, 0);
+            break;
+        case 'g':
+            sim.pgm = true;
+            break;
+        case 'r':
+            remap = (int)strtol(optarg, NULL, 0);
+            break;
+        case 'c':
+            check_hash = true;
+            expected_hash = (uint32_t)strtoul(optarg, NULL, 0);
+            break;
+        default:
+            return usage(argv[0]);
+        }
+    }
+    if (fps <= 0 || frames <= 0 || scl_hz == 0 || sim.every <= 0 || remap > 0xff)
+    {
+        return usage(argv[0]);
+    }
+
+    // lcd_demo と同じ初期化 (電源投入直後のパネルの表示メモリは不定なので明るさ 15 で埋めておく)
+    ssd1327_panel_reset(&sim.panel, 0xff);
+    ssd1327_init(ssd1327_panel_bus_init(&sim.bus, &sim.panel, scl_hz));
+    uint32_t init_us = (uint32_t)(sim.bus.clock_ns / 1000);
+    uint32_t init_commands = sim.panel.commands;
+    uint32_t init_transactions = sim.panel.transactions;
+    if (remap >= 0)
+    {
+        const uint8_t commands[] = {0x00, 0xa0, (uint8_t)remap};
+        ssd1327_send_commands(commands, sizeof commands);
+    }
+    sim.check = sim.panel.remap == 0x51;
+
+    const frame_scheduler_transport transport = {
+        .start_frame = sim_start_frame,
+        .wait = sim_wait,
+        .last_transfer_us = sim_last_transfer_us,
+        .now_us = sim_now_us,
+        .sleep_until = sim_sleep_until,
+        .ctx = &sim,
+    };
+    frame_scheduler_init(&scheduler, &transport, fps);
+    for (int frame = 0; frame < frames; frame++)
+    {
+        framebuffer *fb = frame_scheduler_begin(&scheduler);
+        scene(fb, frame, fps);
+        frame_scheduler_end(&scheduler);
+    }
+
+    const frame_stats *st = frame_scheduler_get_stats(&scheduler);
+    const ssd1327_stats *ds = ssd1327_get_stats();
+    uint32_t hash = image_hash(&sim.panel);
+    printf("init: %lu commands in %lu transaction(s), %lu us; remap 0x%02x, display %s\n",
+           (unsigned long)init_commands, (unsigned long)init_transactions, (unsigned long)init_us,
+           sim.panel.remap, sim.panel.on ? "on" : "off");
+    printf("%d frames at %d fps: %lu transfers (%lu errors), %lu data bytes decoded, %lu unknown commands\n",
+           frames, fps, (unsigned long)ds->frames, (unsigned long)ds->errors,
+           (unsigned long)sim.panel.data_bytes, (unsigned long)sim.panel.unknown);
+    printf("bus: %.1f ms busy of %.1f ms, transfer avg %.0f us, max %lu us, %lu dropped\n",
+           sim.bus.bus_ns * 1e-6, sim.bus.clock_ns * 1e-6,
+           (double)st->transfer_total_us / (st->frames > 1 ? st->frames - 1 : 1),
+           (unsigned long)st->transfer_max_us, (unsigned long)st->dropped);
+    if (sim.check)
+    {
+        printf("panel: %s", sim.mismatches ? "" : "matches the sent buffer after every frame");
+        if (sim.mismatches)
+        {
+            printf("%d MISMATCHES", sim.mismatches);
+        }
+    }
+    else
+    {
+        printf("panel: not compared (remap 0x%02x)", sim.panel.remap);
+    }
+    if (sim.dir)
+    {
+        printf(", %d %s files in %s", sim.written, sim.pgm ? "PGM" : "PNG", sim.dir);
+    }
+    printf("\nimage hash: 0x%08lx", (unsigned long)hash);
+    bool hash_ok = !check_hash || hash == expected_hash;
+    printf("%s\n", check_hash ? (hash_ok ? " (expected)" : " (UNEXPECTED)") : "");
+    return sim.mismatches != 0 || sim.panel.unknown != 0 || ds->errors != 0 || !hash_ok;
+}
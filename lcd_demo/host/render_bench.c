@@ -0,0 +1,163 @@
+#include <stdio.h>         // 標準入出力ライブラリ
+#include <string.h>        // strlen
+#include "host_util.h"     // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "framebuffer.h"   // 表示バッファと描画関数
+#include "font.h"          // 文字列の描画
+#include "face.h"          // 顔の表情の描画
+#include "ssd1327.h"       // SSD1327 ドライバ (lcd_demo と同じソース)
+#include "ssd1327_panel.h" // SSD1327 とパネルのモデル
+
+// 描画と送信の処理ごとの速さを計測する
+//
+// 描画関数 (矩形・線・文字・文字列・顔・クリア) をそれぞれ一定時間繰り返し、1 回あたりの時間を出す。
+// 送信は ssd1327_start_frame() がブロックの一覧を作ってパネルのモデルが解釈し終えるまでの CPU 時間と、
+// I2C バスのモデルでの転送時間 (1MHz) を、画面全体と顔のアニメーション (書き換えた範囲だけ) で出す。
+// 値はホストの CPU でのものなので、処理どうしの比や変更前後の比として使う。
+
+#define BENCH_SEC 0.2     // 1 つの処理を繰り返す時間 [s]
+#define I2C_SPEED 1000000 // I2C の通信速度 (main.c と同じ 1MHz)
+
+static framebuffer fb;       // 描画先
+static ssd1327_panel panel;  // 送信先
+static ssd1327_panel_bus bus; // I2C バス
+// 送信が必要な範囲を捨てる (描画だけを計測するため)
+static void discard_dirty(void)
+{
+    framebuffer_rect rects[FRAMEBUFFER_MAX_RECTS];
+    framebuffer_take_dirty(&fb, rects);
+}
+
+static void op_fill_rect(int i)
+{
+    fill_rect(&fb, rng() % 112, rng() % 112, 16, 16, i & 15);
+}
+
+static void op_hline(int i)
+{
+    draw_hline(&fb, rng() % 64, rng() % 128, 64, i & 15);
+}
+
+static void op_vline(int i)
+{
+    draw_vline(&fb, rng() % 128, rng() % 64, 64, i & 15);
+}
+
+static void op_char(int i)
+{
+    draw_char(&fb, 'A' + i % 26, rng() % 120, rng() % 120, 15);
+}
+
+static void op_string(int i)
+{
+    (void)i;
+    draw_string(&fb, "HELLO WORLD", rng() % 40, rng() % 120, 15);
+}
+
+static void op_text_fixed(int i)
+{
+    (void)i;
+    draw_text(&fb, &font_fixed, "temp 23.5 C", rng() % 40, rng() % 120, 15, 0);
+}
+
+static void op_text_proportional(int i)
+{
+    (void)i;
+    draw_text(&fb, &font_proportional, "temp 23.5 C", rng() % 60, rng() % 120, 15, 0);
+}
+
+static void op_face(int i)
+{
+    framebuffer_clear(&fb);
+    draw_face(&fb, i & 1, (i >> 1) & 1);
+}
+
+static void op_clear_full(int i)
+{
+    (void)i;
+    framebuffer_mark(&fb, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1); // 画面全体を描いたことにする
+    framebuffer_clear(&fb);
+}
+
+// 画面全体を送信する
+static void op_send_full(int i)
+{
+    (void)i;
+    framebuffer_mark(&fb, 0, 0, DISPLAY_WIDTH - 1, DISPLAY_HEIGHT - 1);
+    ssd1327_start_frame(&fb, NULL, NULL);
+}
+
+// 顔のアニメーション 1 フレーム (消して描き、書き換えた範囲だけを送信する)
+static void op_send_face(int i)
+{
+    framebuffer_clear(&fb);
+    draw_face(&fb, i & 1, (i >> 1) & 1);
+    ssd1327_start_frame(&fb, NULL, NULL);
+}
+
+typedef struct
+{
+    const char *name;   // 表示する名前
+    void (*op)(int i);  // 1 回分の処理
+    bool sends;         // 送信する処理なら true (バスの時間も出す)
+} bench_case;
+
+static const bench_case cases[] = {
+    {"fill_rect 16x16", op_fill_rect, false},
+    {"draw_hline 64", op_hline, false},
+    {"draw_vline 64", op_vline, false},
+    {"draw_char", op_char, false},
+    {"draw_string 11 chars", op_string, false},
+    {"draw_text fixed 11 chars", op_text_fixed, false},
+    {"draw_text proportional 11 chars", op_text_proportional, false},
+    {"clear + draw_face", op_face, false},
+    {"framebuffer_clear full screen", op_clear_full, false},
+    {"send full screen", op_send_full, true},
+    {"clear + draw_face + send dirty", op_send_face, true},
+};
+
+int main(void)
+{
+    ssd1327_panel_reset(&panel, 0);
+    ssd1327_init(ssd1327_panel_bus_init(&bus, &panel, I2C_SPEED));
+    framebuffer_init(&fb);
+
+    printf("%-34s %12s %12s %10s\n", "operation", "host ns/op", "bus us/op", "max fps");
+    for (size_t c = 0; c < sizeof cases / sizeof cases[0]; c++)
+    {
+        const bench_case *b = &cases[c];
+        discard_dirty();
+        uint64_t bus_before = bus.bus_ns;
+        long count = 0;
+        double start = now_sec();
+        double elapsed;
+        do
+        {
+            for (int i = 0; i < 256; i++, count++)
+            {
+                b->op((int)count);
+            }
+            if (!b->sends)
+            {
+                discard_dirty();
+            }
+            elapsed = now_sec() - start;
+        } while (elapsed < BENCH_SEC);
+
+        printf("%-34s %12.1f", b->name, elapsed * 1e9 / count);
+        if (b->sends)
+        {
+            double bus_us = (bus.bus_ns - bus_before) * 1e-3 / count;
+            printf(" %12.1f %10.1f", bus_us, 1e6 / bus_us);
+        }
+        printf("\n");
+    }
+
+    volatile uint16_t sink = fb.pixels[rng() % DISPLAY_DATA_SIZE]; // 描画が最適化で消えないようにする
+    (void)sink;
+    if (!ssd1327_panel_matches(&panel, &fb) || panel.unknown != 0)
+    {
+        printf("panel does not match the last frame\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,451 @@
+#include <stdio.h>         // fopen, fwrite
+#include <string.h>        // memset
+#include "ssd1327_panel.h" // SSD1327 とパネルのモデル
+
+#define BUS_FREE_NS 500 // STOP から次の START までの最小時間 (Fast-mode Plus の tBUF)
+
+// コマンドの引数の数 (-1 は知らないコマンド)
+static int command_args(uint8_t command)
+{
+    switch (command)
+    {
+    case 0x15: // コラムアドレス
+    case 0x75: // ロウアドレス
+        return 2;
+    case 0x26: // 右スクロールの設定
+    case 0x27: // 左スクロールの設定
+        return 7;
+    case 0xb8: // グレースケールの表
+        return 15;
+    case 0x81: // コントラスト
+    case 0xa0: // リマップ
+    case 0xa1: // スタートライン
+    case 0xa2: // 表示オフセット
+    case 0xa8: // マルチプレックス比
+    case 0xab: // 機能選択
+    case 0xad: // マスターコンフィグレーション
+    case 0xb0: // 電源制御
+    case 0xb1: // 位相長
+    case 0xb3: // 表示クロック
+    case 0xb5: // GPIO
+    case 0xb6: // 第 2 プリチャージ期間
+    case 0xbc: // プリチャージ電圧
+    case 0xbe: // VCOMH
+    case 0xd5: // 機能選択 B
+    case 0xfd: // コマンドロック
+    case 0x87: // データシートにないが、ssd1327_init_commands は引数を 1 つ付けて送っている
+        return 1;
+    case 0x2e: // スクロール停止
+    case 0x2f: // スクロール開始
+    case 0xa4: // 通常表示
+    case 0xa5: // 全点灯
+    case 0xa6: // 全消灯
+    case 0xa7: // 反転表示
+    case 0xae: // 表示オフ
+    case 0xaf: // 表示オン
+    case 0xb9: // 線形のグレースケール
+    case 0xe3: // NOP
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+void ssd1327_panel_reset(ssd1327_panel *p, uint8_t fill)
+{
+    memset(p, 0, sizeof *p);
+    memset(p->gddram, fill, sizeof p->gddram);
+    p->column_end = SSD1327_PANEL_COLUMNS - 1;
+    p->row_end = SSD1327_PANEL_ROWS - 1;
+    p->mux = SSD1327_PANEL_ROWS - 1;
+    p->contrast = 0x7f;
+    p->mode = 0xa4;
+}
+
+// 引数が揃ったコマンドを実行する
+static void execute(ssd1327_panel *p)
+{
+    const uint8_t *a = p->args;
+    p->commands++;
+    switch (p->command)
+    {
+    case 0x15:
+        p->column_start = a[0] & 0x3f;
+        p->column_end = a[1] & 0x3f;
+        p->column = p->column_start;
+        break;
+    case 0x75:
+        p->row_start = a[0] & 0x7f;
+        p->row_end = a[1] & 0x7f;
+        p->row = p->row_start;
+        break;
+    case 0x81:
+        p->contrast = a[0];
+        break;
+    case 0xa0:
+        p->remap = a[0];
+        break;
+    case 0xa1:
+        p->start_line = a[0] & 0x7f;
+        break;
+    case 0xa2:
+        p->offset = a[0] & 0x7f;
+        break;
+    case 0xa8:
+        p->mux = a[0] < 15 ? p->mux : (a[0] & 0x7f); // 15 未満は無効
+        break;
+    case 0xa4:
+    case 0xa5:
+    case 0xa6:
+    case 0xa7:
+        p->mode = p->command;
+        break;
+    case 0xae:
+        p->on = false;
+        break;
+    case 0xaf:
+        p->on = true;
+        break;
+    default:
+        break; // 画面の見え方に関係しないコマンド
+    }
+}
+
+static void command_byte(ssd1327_panel *p, uint8_t byte)
+{
+    if (p->arg_count < p->arg_needed)
+    {
+        p->args[p->arg_count++] = byte;
+    }
+    else
+    {
+        int n = command_args(byte);
+        if (n < 0)
+        {
+            p->unknown++;
+            return;
+        }
+        p->command = byte;
+        p->arg_count = 0;
+        p->arg_needed = n;
+    }
+    if (p->arg_count == p->arg_needed)
+    {
+        execute(p);
+        p->arg_needed = p->arg_count = 0;
+    }
+}
+
+// 表示データを書き込み、ウィンドウ内で書き込み位置を進める
+static void data_byte(ssd1327_panel *p, uint8_t byte)
+{
+    p->gddram[p->row][p->column] = byte;
+    p->data_bytes++;
+    if (p->remap & 0x04)
+    {
+        // 垂直方向: ロウを進め、ウィンドウの下端を越えたら次のコラム
+        if (p->row++ >= p->row_end)
+        {
+            p->row = p->row_start;
+            p->column = p->column >= p->column_end ? p->column_start : p->column + 1;
+        }
+    }
+    else
+    {
+        // 水平方向: コラムを進め、ウィンドウの右端を越えたら次のロウ
+        if (p->column++ >= p->column_end)
+        {
+            p->column = p->column_start;
+            p->row = p->row >= p->row_end ? p->row_start : p->row + 1;
+        }
+    }
+}
+
+void ssd1327_panel_start(ssd1327_panel *p, uint8_t addr)
+{
+    p->addressed = addr == SSD1327_ADDR;
+    p->control = true;
+    p->stream = false;
+}
+
+void ssd1327_panel_write(ssd1327_panel *p, uint8_t byte)
+{
+    if (!p->addressed)
+    {
+        return;
+    }
+    if (p->control)
+    {
+        // 制御バイト: bit 7 が Co、bit 6 が D/C#
+        p->is_data = (byte & 0x40) != 0;
+        p->stream = (byte & 0x80) == 0;
+        p->control = false;
+        return;
+    }
+    if (p->is_data)
+    {
+        data_byte(p, byte);
+    }
+    else
+    {
+        command_byte(p, byte);
+    }
+    p->control = !p->stream; // Co = 1 なら次は再び制御バイト
+}
+
+void ssd1327_panel_stop(ssd1327_panel *p)
+{
+    if (p->addressed)
+    {
+        p->transactions++;
+    }
+    p->addressed = false;
+}
+
+void ssd1327_panel_snapshot(const ssd1327_panel *p, uint8_t out[DISPLAY_WIDTH * DISPLAY_HEIGHT])
+{
+    for (int y = 0; y < DISPLAY_HEIGHT; y++)
+    {
+        // 画面の行 → COM → GDDRAM のロウ
+        int com = (p->remap & 0x10) ? y : SSD1327_PANEL_ROWS - 1 - y;
+        if (!(p->remap & 0x40))
+        {
+            com = com < SSD1327_PANEL_ROWS / 2 ? com * 2 : (com - SSD1327_PANEL_ROWS / 2) * 2 + 1; // 1 行おきに並ぶ
+        }
+        bool lit = p->on && com <= p->mux;
+        int row = (com + p->start_line + p->offset) % SSD1327_PANEL_ROWS;
+
+        for (int x = 0; x < DISPLAY_WIDTH; x++)
+        {
+            int sx = (p->remap & 0x01) ? x : DISPLAY_WIDTH - 1 - x;
+            sx ^= (p->remap & 0x02) ? 1 : 0;
+            uint8_t byte = p->gddram[row][sx / 2];
+            uint8_t v = (sx & 1) ? byte & 0x0f : byte >> 4;
+            switch (p->mode)
+            {
+            case 0xa5:
+                v = 15;
+                break;
+            case 0xa6:
+                v = 0;
+                break;
+            case 0xa7:
+                v = 15 - v;
+                break;
+            }
+            out[y * DISPLAY_WIDTH + x] = lit ? v : 0;
+        }
+    }
+}
+
+bool ssd1327_panel_matches(const ssd1327_panel *p, const framebuffer *fb)
+{
+    static uint8_t image[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+    ssd1327_panel_snapshot(p, image);
+    for (int i = 0; i < DISPLAY_WIDTH * DISPLAY_HEIGHT; i++)
+    {
+        uint16_t pair = fb->pixels[i / 2];
+        if (image[i] != ((i & 1) ? pair & 0x0f : pair >> 4 & 0x0f))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ssd1327_panel_write_pgm(const ssd1327_panel *p, const char *path)
+{
+    static uint8_t image[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+    ssd1327_panel_snapshot(p, image);
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+    fprintf(fp, "P5\n%d %d\n15\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    bool ok = fwrite(image, 1, sizeof image, fp) == sizeof image;
+    return fclose(fp) == 0 && ok;
+}
+
+// PNG のチャンクの CRC-32
+static uint32_t crc32_update(uint32_t crc, const uint8_t *buf, size_t len)
+{
+    static uint32_t table[256];
+    if (table[1] == 0)
+    {
+        for (uint32_t n = 0; n < 256; n++)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++)
+            {
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+    }
+    for (size_t i = 0; i < len; i++)
+    {
+        crc = table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static void put_be32(uint8_t *out, uint32_t v)
+{
+    out[0] = v >> 24;
+    out[1] = v >> 16;
+    out[2] = v >> 8;
+    out[3] = v;
+}
+
+// 長さ・種類・内容・CRC の順にチャンクを書き出す
+static bool write_chunk(FILE *fp, const char *type, const uint8_t *data, uint32_t len)
+{
+    uint8_t header[8];
+    put_be32(header, len);
+    memcpy(header + 4, type, 4);
+    uint32_t crc = crc32_update(0xffffffffu, header + 4, 4);
+    crc = crc32_update(crc, data, len) ^ 0xffffffffu;
+    uint8_t trailer[4];
+    put_be32(trailer, crc);
+    return fwrite(header, 1, 8, fp) == 8 && fwrite(data, 1, len, fp) == len && fwrite(trailer, 1, 4, fp) == 4;
+}
+
+bool ssd1327_panel_write_png(const ssd1327_panel *p, const char *path)
+{
+    static uint8_t image[DISPLAY_WIDTH * DISPLAY_HEIGHT];
+    ssd1327_panel_snapshot(p, image);
+
+    // 画像データ: 各行の先頭にフィルタの種類 (0 = なし) を置き、zlib の無圧縮ブロック 1 つに入れる
+    enum
+    {
+        RAW_SIZE = (1 + DISPLAY_WIDTH) * DISPLAY_HEIGHT, // 65535 バイト以下なので 1 ブロックに収まる
+        IDAT_SIZE = 2 + 5 + RAW_SIZE + 4,                // zlib ヘッダ + ブロックヘッダ + データ + Adler-32
+    };
+    static uint8_t idat[IDAT_SIZE];
+    uint8_t *raw = idat + 7;
+    for (int y = 0; y < DISPLAY_HEIGHT; y++)
+    {
+        raw[y * (1 + DISPLAY_WIDTH)] = 0;
+        for (int x = 0; x < DISPLAY_WIDTH; x++)
+        {
+            raw[y * (1 + DISPLAY_WIDTH) + 1 + x] = image[y * DISPLAY_WIDTH + x] * 17; // 0〜15 → 0〜255
+        }
+    }
+    uint32_t a = 1, b = 0;
+    for (int i = 0; i < RAW_SIZE; i++)
+    {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    idat[0] = 0x78; // zlib: deflate、32KB の窓
+    idat[1] = 0x01;
+    idat[2] = 0x01; // 最後のブロック、無圧縮
+    idat[3] = RAW_SIZE & 0xff;
+    idat[4] = RAW_SIZE >> 8;
+    idat[5] = ~RAW_SIZE & 0xff;
+    idat[6] = (~RAW_SIZE >> 8) & 0xff;
+    put_be32(idat + 7 + RAW_SIZE, b << 16 | a);
+
+    uint8_t ihdr[13];
+    put_be32(ihdr, DISPLAY_WIDTH);
+    put_be32(ihdr + 4, DISPLAY_HEIGHT);
+    ihdr[8] = 8;  // ビット深度
+    ihdr[9] = 0;  // グレースケール
+    ihdr[10] = 0; // 圧縮方式
+    ihdr[11] = 0; // フィルタ方式
+    ihdr[12] = 0; // インターレースなし
+
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    bool ok = fwrite(signature, 1, sizeof signature, fp) == sizeof signature &&
+              write_chunk(fp, "IHDR", ihdr, sizeof ihdr) &&
+              write_chunk(fp, "IDAT", idat, sizeof idat) &&
+              write_chunk(fp, "IEND", NULL, 0);
+    return fclose(fp) == 0 && ok;
+}
+
+// SCL のクロック数をバスの時間として加える
+static void bus_clocks(ssd1327_panel_bus *bus, uint64_t clocks, uint64_t extra_ns)
+{
+    uint64_t ns = clocks * 1000000000u / bus->scl_hz + extra_ns;
+    bus->clock_ns += ns;
+    bus->bus_ns += ns;
+}
+
+static int bus_write(void *ctx, uint8_t addr, const uint8_t *src, size_t len)
+{
+    ssd1327_panel_bus *bus = ctx;
+    ssd1327_panel_start(bus->panel, addr);
+    for (size_t i = 0; i < len; i++)
+    {
+        ssd1327_panel_write(bus->panel, src[i]);
+    }
+    ssd1327_panel_stop(bus->panel);
+    bus->bytes += 1 + len;
+    bus_clocks(bus, 1 + 9 + 9 * (uint64_t)len + 1, BUS_FREE_NS); // START + アドレス + データ + STOP
+    return (int)len;
+}
+
+// ブロックの要素を IC_DATA_CMD と同じように解釈する: RESTART → 再スタートとアドレス、下位 8 ビットを送る、STOP → STOP
+static void bus_start_blocks(void *ctx, uint8_t addr, const ssd1327_block *blocks)
+{
+    ssd1327_panel_bus *bus = ctx;
+    uint64_t clocks = 0;
+    bool started = false;
+    for (const ssd1327_block *b = blocks; b->read_addr != NULL; b++)
+    {
+        const volatile uint16_t *words = b->read_addr;
+        for (uint32_t i = 0; i < b->count; i++)
+        {
+            uint16_t w = words[i];
+            if (!started || (w & SSD1327_WORD_RESTART))
+            {
+                ssd1327_panel_start(bus->panel, addr);
+                clocks += 1 + 9;
+                bus->bytes++;
+                started = true;
+            }
+            ssd1327_panel_write(bus->panel, w & 0xff);
+            clocks += 9;
+            bus->bytes++;
+            if (w & SSD1327_WORD_STOP)
+            {
+                ssd1327_panel_stop(bus->panel);
+                clocks += 1;
+                started = false;
+            }
+        }
+    }
+    bool ok = !started; // 最後の要素に STOP が付いていなければ転送は終わらない
+    if (started)
+    {
+        ssd1327_panel_stop(bus->panel);
+    }
+    bus_clocks(bus, clocks, BUS_FREE_NS);
+    ssd1327_transfer_done(ok);
+}
+
+static uint64_t bus_now_us(void *ctx)
+{
+    ssd1327_panel_bus *bus = ctx;
+    return bus->clock_ns / 1000;
+}
+
+const ssd1327_transport *ssd1327_panel_bus_init(ssd1327_panel_bus *bus, ssd1327_panel *panel, uint32_t scl_hz)
+{
+    memset(bus, 0, sizeof *bus);
+    bus->panel = panel;
+    bus->scl_hz = scl_hz;
+    bus->transport = (ssd1327_transport){
+        .write = bus_write,
+        .start_blocks = bus_start_blocks,
+        .now_us = bus_now_us,
+        .ctx = bus,
+    };
+    return &bus->transport;
+}
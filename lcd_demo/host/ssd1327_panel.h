@@ -0,0 +1,93 @@
+#ifndef SSD1327_PANEL_H
+#define SSD1327_PANEL_H
+
+#include <stdint.h>   // 固定幅整数型
+#include <stdbool.h>  // bool 型
+#include "ssd1327.h"  // SSD1327 ドライバ (ssd1327_transport)
+
+// SSD1327 と 128x128 の OLED パネルのモデル (ホスト環境用)
+//
+// I2C で受け取ったバイト列を SSD1327 と同じように解釈し、表示メモリ (GDDRAM) に書き込む。
+// - 制御バイト: Co = 0 ならそのトランザクションの残りすべて、Co = 1 なら次の 1 バイトだけが D/C# の種類
+// - コラム・ロウアドレス (0x15, 0x75) のウィンドウ内で書き込み位置を進める (リマップの A[2] で水平・垂直を選ぶ)
+// - リマップ (0xA0)、スタートライン (0xA1)、表示オフセット (0xA2)、表示モード (0xA4〜0xA7)、
+//   マルチプレックス比 (0xA8)、表示オン・オフ (0xAE, 0xAF) を画面の見え方に反映する
+// パネルの配線はリマップ 0x51 (ssd1327_init_commands と同じ) で正立し、表示バッファと同じ並び
+// (1 バイトの上位 4 ビットが偶数 x) になるものとする。そこからリマップのビットが変わると、
+// A[0] で左右反転、A[1] で 2 ピクセルの組の中の左右が入れ替わり、A[4] で上下反転、A[6] で行が 1 行おきに並ぶ。
+
+#define SSD1327_PANEL_COLUMNS (DISPLAY_WIDTH / 2) // GDDRAM のコラム数 (1 コラム = 2 ピクセル)
+#define SSD1327_PANEL_ROWS DISPLAY_HEIGHT         // GDDRAM のロウ数
+
+typedef struct
+{
+    uint8_t gddram[SSD1327_PANEL_ROWS][SSD1327_PANEL_COLUMNS]; // 表示メモリ
+    uint8_t column_start, column_end, row_start, row_end;      // ウィンドウ
+    uint8_t column, row;                                       // 次に書き込む位置
+    uint8_t remap;                                             // リマップ (0xA0 の引数)
+    uint8_t start_line;                                        // スタートライン
+    uint8_t offset;                                            // 表示オフセット
+    uint8_t mux;                                               // マルチプレックス比 (表示する行数 - 1)
+    uint8_t contrast;                                          // コントラスト
+    uint8_t mode;                                              // 表示モード (0xA4〜0xA7)
+    bool on;                                                   // 表示オンなら true
+
+    // 受信の状態
+    bool addressed;   // START の後でアドレスが一致した
+    bool control;     // 次のバイトは制御バイト
+    bool stream;      // Co = 0 を受け取った (以降はすべて is_data の種類)
+    bool is_data;     // D/C#: true ならデータ、false ならコマンド
+    uint8_t command;  // 引数を集めているコマンド
+    uint8_t args[8];  // コマンドの引数
+    int arg_count;    // 集めた引数の数
+    int arg_needed;   // コマンドの引数の数
+
+    // 統計
+    uint32_t transactions; // START から STOP までの回数
+    uint32_t commands;     // 実行したコマンドの数
+    uint32_t data_bytes;   // 受け取った表示データのバイト数
+    uint32_t unknown;      // 知らないコマンドの数
+} ssd1327_panel;
+
+// リセット直後の状態にする (表示メモリは fill で埋める。実機の内容は不定)
+void ssd1327_panel_reset(ssd1327_panel *p, uint8_t fill);
+
+// START (または再スタート) とアドレスバイト。アドレスが SSD1327_ADDR でなければ STOP まで無視する
+void ssd1327_panel_start(ssd1327_panel *p, uint8_t addr);
+
+// 1 バイト受け取る
+void ssd1327_panel_write(ssd1327_panel *p, uint8_t byte);
+
+// STOP
+void ssd1327_panel_stop(ssd1327_panel *p);
+
+// パネルに見えている画像を out (1 ピクセル 1 バイト、明るさ 0〜15、左上から横に並ぶ) に書き出す
+void ssd1327_panel_snapshot(const ssd1327_panel *p, uint8_t out[DISPLAY_WIDTH * DISPLAY_HEIGHT]);
+
+// パネルに見えている画像が表示バッファの内容と一致すれば true
+bool ssd1327_panel_matches(const ssd1327_panel *p, const framebuffer *fb);
+
+// パネルに見えている画像を PGM (8 ビット、最大値 15) で書き出す。失敗したら false
+bool ssd1327_panel_write_pgm(const ssd1327_panel *p, const char *path);
+
+// パネルに見えている画像を PNG (8 ビットグレースケール、明るさを 0〜255 に広げる) で書き出す。失敗したら false
+bool ssd1327_panel_write_png(const ssd1327_panel *p, const char *path);
+
+// パネルと I2C バスのモデルを ssd1327_transport としてつなぐ
+//
+// 転送はすぐにパネルへ書き込み、送ったバイト数から I2C バスの時間 (1 バイト 9 クロック + START・STOP) を
+// 計算して仮想時刻を進め、ssd1327_transfer_done() を呼ぶ。
+typedef struct
+{
+    ssd1327_panel *panel;  // 送信先のパネル
+    uint32_t scl_hz;       // I2C の通信速度
+    uint64_t clock_ns;     // 仮想時刻 [ns] (転送にかかる時間だけ進む。呼び出し側が進めてもよい)
+    uint64_t bus_ns;       // I2C バスを使った時間の合計 [ns]
+    uint64_t bytes;        // 送ったバイト数の合計 (アドレスバイトを含む)
+    ssd1327_transport transport; // ssd1327_init() に渡す
+} ssd1327_panel_bus;
+
+// bus を初期化し、panel につないだ ssd1327_transport を返す
+const ssd1327_transport *ssd1327_panel_bus_init(ssd1327_panel_bus *bus, ssd1327_panel *panel, uint32_t scl_hz);
+
+#endif // SSD1327_PANEL_H
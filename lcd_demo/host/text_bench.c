@@ -0,0 +1,184 @@
+#include <stdio.h>       // 標準入出力ライブラリ
+#include <string.h>      // memcmp
+#include "host_util.h"   // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "framebuffer.h" // 表示バッファと描画関数
+#include "font.h"        // フォントと文字列の描画
+
+// 画面いっぱいの文字列を描く速さを、描画の方法ごとに比べる
+//
+// まず、draw_text() (キャッシュあり) の結果が、1 ピクセルずつ描く基準の実装とピクセル単位で一致することを、
+// 等幅・プロポーショナル、画面の端にかかる位置・奇数 x・さまざまな明るさで確かめる。
+// 次に、センサーの値のような文字列 16 行 (8x8 の等幅で画面いっぱい) を毎フレーム描き直す速さを計測する。
+
+#define CHECK_COUNT (50000) // 一致を確かめる描画回数
+#define BENCH_FRAMES (5000) // ベンチマークで描くフレーム数
+#define LINES (DISPLAY_HEIGHT / FONT_HEIGHT) // 1 画面の行数
+
+// 基準: 1 ピクセルずつ set_pixel() で文字列を背景ごと描く
+static int ref_draw_text(framebuffer *fb, const font *f, const char *str, int x, int y, uint8_t fg, uint8_t bg)
+{
+    for (; *str; str++)
+    {
+        const uint8_t *glyph = font_glyph(f, *str);
+        int advance = font_advance(f, *str);
+        unsigned char u = (unsigned char)*str;
+        int index = (u >= FONT_FIRST_CHAR && u <= FONT_LAST_CHAR ? u : '?') - FONT_FIRST_CHAR;
+        int left = f->left ? f->left[index] : 0;
+        int width = f->width ? f->width[index] : 8;
+        for (int r = 0; r < FONT_HEIGHT; r++)
+        {
+            for (int i = 0; i < advance; i++)
+            {
+                int on = i < width && (glyph[r] & (0x80 >> (left + i)));
+                if (x + i >= 0 && x + i < DISPLAY_WIDTH && y + r >= 0 && y + r < DISPLAY_HEIGHT)
+                {
+                    set_pixel(fb, x + i, y + r, on ? fg & 0x0F : bg & 0x0F);
+                }
+            }
+        }
+        x += advance;
+    }
+    return x;
+}
+
+// 印字可能な文字とそれ以外を混ぜた文字列を作る
+static void random_text(char *text, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        uint32_t v = rng();
+        text[i] = (v & 31) == 0 ? (char)(0x80 + (v >> 8) % 0x80) : (char)(FONT_FIRST_CHAR + (v >> 8) % 95);
+    }
+    text[len] = '\0';
+}
+
+// draw_text() と基準の実装で同じ文字列を重ね、表示バッファが一致するか確かめる。不一致の数を返す
+static int check(void)
+{
+    static framebuffer a, b;
+    int mismatch = 0;
+
+    framebuffer_init(&a);
+    framebuffer_init(&b);
+    for (int i = 0; i < CHECK_COUNT; i++)
+    {
+        const font *f = (i & 1) ? &font_proportional : &font_fixed;
+        char text[12];
+        random_text(text, 1 + rng() % 10);
+        int x = (int)(rng() % (DISPLAY_WIDTH + 40)) - 40; // 画面の外や端にかかる位置も含める
+        int y = (int)(rng() % (DISPLAY_HEIGHT + 16)) - 8;
+        uint8_t fg = rng() & 0x0F;
+        uint8_t bg = (rng() & 3) == 0 ? rng() & 0x0F : 0; // 背景は 0 が多い (キャッシュに当たるように)
+        int end_a = draw_text(&a, f, text, x, y, fg, bg);
+        int end_b = ref_draw_text(&b, f, text, x, y, fg, bg);
+        if (end_a != end_b || memcmp(a.pixels, b.pixels, sizeof a.pixels) != 0)
+        {
+            if (mismatch++ == 0)
+            {
+                printf("first mismatch at op %d (\"%s\" x=%d y=%d)\n", i, text, x, y);
+            }
+            memcpy(b.pixels, a.pixels, sizeof a.pixels); // 以降の比較を続けられるように揃える
+        }
+        if (i % 1000 == 999)
+        {
+            font_cache_clear(); // キャッシュになかった場合の展開も繰り返し確かめる
+        }
+    }
+    font_cache_stats s = font_get_cache_stats();
+    printf("check: %d strings (fixed and proportional, clipped and odd x), %d mismatches, cache %lu hits / %lu misses\n",
+           CHECK_COUNT, mismatch, (unsigned long)s.hits, (unsigned long)s.misses);
+    return mismatch;
+}
+
+// 画面いっぱいの文字列 (フレームごとに値が変わる)
+static void make_screen(char lines[LINES][DISPLAY_WIDTH / 8 + 1], int frame)
+{
+    for (int i = 0; i < LINES; i++)
+    {
+        int value = (frame * 7 + i * 131) % 10000;
+        snprintf(lines[i], DISPLAY_WIDTH / 8 + 1, "T%02d %2d.%02dC %3d%%", i, value / 100 % 40, value % 100, value % 101);
+    }
+}
+
+typedef enum
+{
+    METHOD_PIXEL,   // 1 ピクセルずつ (背景ごと)
+    METHOD_BLIT,    // 背景を fill_rect() で塗ってから draw_string() (表引きで透過描画)
+    METHOD_CACHED,  // draw_text() (キャッシュから memcpy)
+    METHOD_PROP,    // draw_text() のプロポーショナル
+} method;
+
+// BENCH_FRAMES フレーム描き、1 秒あたりのフレーム数を返す
+static double bench(method m, long *glyphs)
+{
+    static framebuffer fb;
+    static char lines[LINES][DISPLAY_WIDTH / 8 + 1];
+    framebuffer_init(&fb);
+    *glyphs = 0;
+    double start = now_sec();
+    for (int frame = 0; frame < BENCH_FRAMES; frame++)
+    {
+        make_screen(lines, frame);
+        for (int i = 0; i < LINES; i++)
+        {
+            int y = i * FONT_HEIGHT;
+            switch (m)
+            {
+            case METHOD_PIXEL:
+                ref_draw_text(&fb, &font_fixed, lines[i], 0, y, 15, 0);
+                break;
+            case METHOD_BLIT:
+                fill_rect(&fb, 0, y, (int)strlen(lines[i]) * 8, FONT_HEIGHT, 0);
+                draw_string(&fb, lines[i], 0, y, 15);
+                break;
+            case METHOD_CACHED:
+                draw_text(&fb, &font_fixed, lines[i], 0, y, 15, 0);
+                break;
+            case METHOD_PROP:
+                draw_text(&fb, &font_proportional, lines[i], 0, y, 15, 0);
+                break;
+            }
+            *glyphs += (long)strlen(lines[i]);
+        }
+        framebuffer_rect rects[FRAMEBUFFER_MAX_RECTS];
+        framebuffer_take_dirty(&fb, rects); // 送信したことにする
+    }
+    double elapsed = now_sec() - start;
+    volatile uint16_t sink = fb.pixels[rng() % DISPLAY_DATA_SIZE]; // 描画が最適化で消えないようにする
+    (void)sink;
+    return BENCH_FRAMES / elapsed;
+}
+
+int main(void)
+{
+    if (check() != 0)
+    {
+        return 1;
+    }
+
+    static const char *names[] = {
+        "per-pixel set_pixel (opaque)",
+        "fill_rect + draw_string blit",
+        "draw_text cached, fixed",
+        "draw_text cached, proportional",
+    };
+    printf("full screen of text: %d lines x %d chars, %d frames\n", LINES, DISPLAY_WIDTH / 8, BENCH_FRAMES);
+    double base = 0;
+    for (int m = METHOD_PIXEL; m <= METHOD_PROP; m++)
+    {
+        font_cache_stats before = font_get_cache_stats();
+        long glyphs;
+        double fps = bench((method)m, &glyphs);
+        font_cache_stats after = font_get_cache_stats();
+        base = m == METHOD_PIXEL ? fps : base;
+        printf("  %-31s %9.0f frames/s, %6.2f M glyphs/s (%.1fx)", names[m], fps,
+               fps * glyphs / BENCH_FRAMES * 1e-6, fps / base);
+        uint32_t lookups = (after.hits - before.hits) + (after.misses - before.misses);
+        if (lookups)
+        {
+            printf(", cache hit rate %.2f %%", 100.0 * (after.hits - before.hits) / lookups);
+        }
+        printf("\n");
+    }
+    return 0;
+}
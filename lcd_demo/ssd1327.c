@@ -0,0 +1,164 @@
+#include <stddef.h>        // NULL
+#include "ssd1327.h"       // SSD1327 ドライバ
+#include "ssd1327_commands.h" // 初期化・ウィンドウ設定のコマンド列
+
+static const ssd1327_transport *transport; // I2C と DMA へのアクセス手段
+static uint16_t tail_word;          // 最後の 1 バイト + STOP ビット
+static volatile bool busy;          // 転送中なら true
+static ssd1327_callback done_cb;    // 転送完了時に呼ぶ関数
+static void *done_arg;              // done_cb の引数
+static uint64_t start_us;           // 転送を開始した時刻
+static volatile ssd1327_stats stats; // 転送の統計
+
+// 1 つの矩形につき、ウィンドウ設定 1 ブロック + 各行 1 ブロック。最後に STOP 付きの 1 バイトと終了の 2 ブロック
+#define SSD1327_MAX_BLOCKS (FRAMEBUFFER_MAX_RECTS * (1 + DISPLAY_HEIGHT) + 2)
+#define SSD1327_WINDOW_WORDS (SSD1327_WINDOW_COMMANDS + 1) // ウィンドウ設定の要素数 (コマンド列 + データの制御バイト)
+
+static ssd1327_block blocks[SSD1327_MAX_BLOCKS];                                 // ssd1327_transport に渡すブロックの一覧
+static uint16_t window_words[FRAMEBUFFER_MAX_RECTS][SSD1327_WINDOW_WORDS];      // 矩形ごとのウィンドウ設定
+static framebuffer_rect rects[FRAMEBUFFER_MAX_RECTS];                            // 送信中の矩形
+
+void ssd1327_send_commands(const uint8_t *commands, size_t len)
+{
+    // 先頭の制御バイト 0x00 (Co = 0) に続くバイトはすべてコマンドなので、列全体を 1 回の転送で送る
+    transport->write(transport->ctx, SSD1327_ADDR, commands, len);
+}
+
+void ssd1327_transfer_done(bool ok)
+{
+    if (ok)
+    {
+        stats.frames++;
+    }
+    else
+    {
+        stats.errors++; // NACK などで中断した
+    }
+    stats.last_transfer_us = (uint32_t)(transport->now_us(transport->ctx) - start_us);
+    busy = false;
+    if (done_cb)
+    {
+        done_cb(done_arg);
+    }
+}
+
+void ssd1327_init(const ssd1327_transport *t)
+{
+    transport = t;
+
+    // SSD1327 の初期化シーケンス (35 バイトのコマンド列を 1 回の転送で送る)
+    ssd1327_send_commands(ssd1327_init_commands, sizeof(ssd1327_init_commands));
+}
+
+void ssd1327_set_window(uint16_t X_start, uint16_t Y_start, uint16_t X_end, uint16_t Y_end)
+{
+    // 引数として渡された座標がディスプレイの範囲を超えていないかチェック
+    if (X_start >= DISPLAY_WIDTH || Y_start >= DISPLAY_HEIGHT ||
+        X_end >= DISPLAY_WIDTH || Y_end >= DISPLAY_HEIGHT)
+    {
+        return; // 範囲外の場合は何もせずに関数を終了
+    }
+
+    // コラム (X軸)・ロウ (Y軸) アドレスの設定を 1 回の転送で送る
+    uint8_t commands[SSD1327_WINDOW_COMMANDS];
+    ssd1327_window_commands(commands, X_start, Y_start, X_end, Y_end);
+    ssd1327_send_commands(commands, sizeof(commands));
+}
+
+// 矩形 1 つ分のブロック (ウィンドウ設定 + 各行) を blocks[n] 以降に作る。次の位置を返す
+static int ssd1327_add_rect(const framebuffer *fb, int n, int index)
+{
+    framebuffer_rect r = rects[index];
+    uint16_t *w = window_words[index];
+
+    // 再スタートしてコマンド列 (制御バイト 0x00 + ウィンドウ設定) を送り、もう一度再スタートしてデータ (0x40) を送る
+    uint8_t commands[SSD1327_WINDOW_COMMANDS];
+    ssd1327_window_commands(commands, r.x0, r.y0, r.x1, r.y1);
+    w[0] = SSD1327_WORD_RESTART | commands[0];
+    for (int i = 1; i < SSD1327_WINDOW_COMMANDS; i++)
+    {
+        w[i] = commands[i];
+    }
+    w[SSD1327_WINDOW_COMMANDS] = SSD1327_WORD_RESTART | FRAMEBUFFER_CONTROL_DATA; // 制御バイト (以降はデータ)
+    blocks[n++] = (ssd1327_block){SSD1327_WINDOW_WORDS, w};
+
+    int columns = (r.x1 - r.x0 + 1) / 2;
+    const uint16_t *row = &fb->pixels[(r.y0 * DISPLAY_WIDTH + r.x0) / 2];
+    if (columns == DISPLAY_WIDTH / 2)
+    {
+        // 横幅いっぱいなら各行はメモリ上で連続しているので 1 ブロックで送る
+        blocks[n++] = (ssd1327_block){columns * (r.y1 - r.y0 + 1), row};
+    }
+    else
+    {
+        for (int y = r.y0; y <= r.y1; y++, row += DISPLAY_WIDTH / 2)
+        {
+            blocks[n++] = (ssd1327_block){columns, row};
+        }
+    }
+    stats.bytes += SSD1327_WINDOW_WORDS + columns * (r.y1 - r.y0 + 1);
+    return n;
+}
+
+bool ssd1327_start_frame(framebuffer *fb, ssd1327_callback done, void *arg)
+{
+    if (busy)
+    {
+        return false; // 前のフレームを送信中
+    }
+
+    int count = framebuffer_take_dirty(fb, rects);
+    if (count == 0)
+    {
+        // 変化がなければ何も送らない (転送時間は 0 にして、前のフレームの値を残さない)
+        stats.last_transfer_us = 0;
+        if (done)
+        {
+            done(arg);
+        }
+        return true;
+    }
+
+    // 書き換えた矩形ごとに、ウィンドウ設定と表示データのブロックを並べる
+    int n = 0;
+    for (int i = 0; i < count; i++)
+    {
+        n = ssd1327_add_rect(fb, n, i);
+    }
+
+    // 最後の 1 要素は STOP ビットを付けたコピーから送る
+    ssd1327_block *last = &blocks[n - 1];
+    const volatile uint16_t *last_word = (const volatile uint16_t *)last->read_addr + last->count - 1;
+    tail_word = *last_word | SSD1327_WORD_STOP;
+    if (--last->count == 0)
+    {
+        n--;
+    }
+    blocks[n++] = (ssd1327_block){1, &tail_word};
+    blocks[n++] = (ssd1327_block){0, NULL}; // 終了
+
+    busy = true;
+    done_cb = done;
+    done_arg = arg;
+    start_us = transport->now_us(transport->ctx);
+    transport->start_blocks(transport->ctx, SSD1327_ADDR, blocks);
+    return true;
+}
+
+bool ssd1327_is_busy(void)
+{
+    return busy;
+}
+
+void ssd1327_wait(void)
+{
+    while (busy)
+    {
+        // 転送完了の割り込みを待つ
+    }
+}
+
+const ssd1327_stats *ssd1327_get_stats(void)
+{
+    return (const ssd1327_stats *)&stats;
+}
@@ -0,0 +1,85 @@
+#ifndef SSD1327_H
+#define SSD1327_H
+
+#include <stdint.h>        // 固定幅整数型
+#include <stdbool.h>       // bool 型
+#include <stddef.h>        // size_t
+#include "framebuffer.h"   // 表示バッファ
+
+// SSD1327 OLED ディスプレイのドライバ
+//
+// 初期化コマンドは制御バイト 0x00 に続けたコマンド列として 1 回の I2C 転送で送るが、表示の更新は
+// 「ブロック」(16 ビットの要素の列) の一覧として ssd1327_transport に渡し、バックグラウンドで送らせる。
+// 表示バッファのうち書き換えた矩形だけを、矩形ごとに「ウィンドウ設定コマンド → 表示データ」の順で送る。
+// 転送中 CPU は空いているので、次のフレームの準備など他の処理ができる。
+// 転送が終わると ssd1327_transport が ssd1327_transfer_done() を呼び、登録したコールバックが呼ばれる。
+//
+// I2C と DMA は ssd1327_transport 経由で使うので、ホスト環境ではパネルのモデルに送信内容を解釈させられる。
+// 実機では ssd1327_pico.h の ssd1327_pico_transport_init() が I2C と DMA を使う実装を返す。
+
+#define SSD1327_ADDR 0x3D // SSD1327 OLED ディスプレイの I2C アドレス
+
+// ブロックの要素の形式: 下位 8 ビットが送るバイト。RP2350 の I2C の IC_DATA_CMD レジスタと同じビット位置なので、
+// DMA でそのまま送信 FIFO に書き込める
+#define SSD1327_WORD_STOP 0x200    // このバイトの後に STOP を出す
+#define SSD1327_WORD_RESTART 0x400 // このバイトの前に再スタート (とアドレス) を出す
+
+// 転送完了時に呼ばれる関数 (割り込みコンテキストで実行される)
+typedef void (*ssd1327_callback)(void *arg);
+
+// ブロック: 要素を count 個、read_addr から順に送る。read_addr が NULL のブロックで終わる
+// (DMA の制御チャンネルが転送先チャンネルの al3_transfer_count, al3_read_addr_trig にそのまま書き込む形式)
+typedef struct
+{
+    uint32_t count;                 // 要素数
+    const volatile void *read_addr; // 要素 (uint16_t) の先頭
+} ssd1327_block;
+
+// I2C と DMA へのアクセス手段
+typedef struct
+{
+    // 1 回の I2C 転送で書き込む (STOP まで)。戻り値は転送バイト数、失敗時は負の値 (i2c_write_blocking と同じ)
+    int (*write)(void *ctx, uint8_t addr, const uint8_t *src, size_t len);
+    // blocks の要素を順に送り始めてすぐに戻る。送り終えたら (または中断したら) ssd1327_transfer_done() を呼ぶ
+    void (*start_blocks)(void *ctx, uint8_t addr, const ssd1327_block *blocks);
+    // 現在時刻 [us]
+    uint64_t (*now_us)(void *ctx);
+    void *ctx; // 上記関数に渡すコンテキスト
+} ssd1327_transport;
+
+// 転送の統計
+typedef struct
+{
+    uint32_t frames;           // 送信を完了したフレーム数
+    uint32_t errors;           // NACK などで中断したフレーム数
+    uint32_t last_transfer_us; // 最後のフレームの転送時間 [us]
+    uint32_t bytes;            // 送信を開始したバイト数の合計 (アドレスバイトを除く)
+} ssd1327_stats;
+
+// SSD1327 を初期化する (初期化コマンドを送る)
+void ssd1327_init(const ssd1327_transport *transport);
+
+// コマンド列を 1 回の I2C 転送で送る (転送中でないこと)
+// commands の先頭は制御バイト SSD1327_CONTROL_COMMAND (ssd1327_commands.h) で、以降はすべてコマンドとして扱われる
+void ssd1327_send_commands(const uint8_t *commands, size_t len);
+
+// 描画範囲 (ウィンドウ) を設定する (コマンド 6 バイトを 1 回の転送で送る)
+void ssd1327_set_window(uint16_t X_start, uint16_t Y_start, uint16_t X_end, uint16_t Y_end);
+
+// 表示バッファのうち前回の送信以降に書き換えた範囲の送信を開始し、すぐに戻る。前の転送が終わっていなければ false
+// 送信した範囲は fb->dirty から取り除かれる。転送が終わるまで fb の内容を書き換えてはいけない
+bool ssd1327_start_frame(framebuffer *fb, ssd1327_callback done, void *arg);
+
+// ssd1327_transport から呼ぶ: 転送が終わった (ok が false なら NACK などで中断した)
+void ssd1327_transfer_done(bool ok);
+
+// 転送中なら true
+bool ssd1327_is_busy(void);
+
+// 転送が終わるまで待つ
+void ssd1327_wait(void);
+
+// 転送の統計を返す
+const ssd1327_stats *ssd1327_get_stats(void);
+
+#endif // SSD1327_H
@@ -0,0 +1,52 @@
+#ifndef SSD1327_COMMANDS_H
+#define SSD1327_COMMANDS_H
+
+#include <stdint.h> // 固定幅整数型
+
+// SSD1327 に送るコマンド列
+//
+// 制御バイト 0x00 (Co = 0, D/C# = 0) の後ろのバイトは、STOP までずっとコマンドとして扱われる。
+// 先頭に制御バイトを置いたコマンド列を 1 回の I2C 転送で送れば、コマンドごとに
+// START・アドレス・制御バイト・STOP を繰り返さずに済む。
+// ssd1327.c と host/ のシミュレータが同じ表を使う (表はフラッシュに置かれる)。
+
+#define SSD1327_CONTROL_COMMAND 0x00 // 制御バイト: 以降のバイトはすべてコマンド
+#define SSD1327_WINDOW_COMMANDS 7    // ウィンドウ設定のコマンド列の長さ (制御バイトを含む)
+
+// 初期化シーケンス (データシートに記載されている初期設定)
+static const uint8_t ssd1327_init_commands[] = {
+    SSD1327_CONTROL_COMMAND,
+    0xae,             // ディスプレイをオフにする (スリープモード ON)
+    0x15, 0x00, 0x7f, // コラムアドレス設定 (0〜127)
+    0x75, 0x00, 0x7f, // ロウアドレス設定 (0〜127)
+    0x81, 0x80,       // コントラスト設定 (0x80 は中間的な明るさ)
+    0xa0, 0x51,       // セグメントリマップ (0x51 で左右反転。必要に応じて変更)
+    0xa1, 0x00,       // スタートライン (通常は 0)
+    0xa2, 0x00,       // 表示オフセット (通常は 0)
+    0xa4,             // 全画面表示オフ (通常表示モード)
+    0xa8, 0x7f,       // マルチプレックス比 (0x7F = 128 ライン)
+    0xad, 0x02,       // マスターコンフィグレーション
+    0xb0, 0x0b,       // 電源制御
+    0xb1, 0xf1,       // 位相長設定
+    0xab, 0x01,       // 表示イネーブル (リセット)
+    0xbc, 0x3f,       // プリチャージ電流設定
+    0xbe, 0x0f,       // VCOMH レベル設定
+    0xd5, 0x62,       // 表示クロック制御
+    0x87, 0x0f,       // コントラスト微調整
+    0xaf,             // ディスプレイをオンにする (スリープモード OFF)
+};
+
+// (x0, y0)〜(x1, y1) のウィンドウを設定するコマンド列を out に作る (x はピクセル単位、2 ピクセル単位に切り捨てる)
+static inline void ssd1327_window_commands(uint8_t out[SSD1327_WINDOW_COMMANDS],
+                                           uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+    out[0] = SSD1327_CONTROL_COMMAND;
+    out[1] = 0x15;   // コラムアドレス設定コマンド
+    out[2] = x0 / 2; // 開始コラム (SSD1327 は 2 ピクセル単位でアドレスを指定する)
+    out[3] = x1 / 2; // 終了コラム
+    out[4] = 0x75;   // ロウアドレス設定コマンド
+    out[5] = y0;     // 開始ロウ
+    out[6] = y1;     // 終了ロウ
+}
+
+#endif // SSD1327_COMMANDS_H
@@ -0,0 +1,119 @@
+#include "pico/stdlib.h"   // Pico SDK の標準関数
+#include "hardware/dma.h"  // DMA (ダイレクトメモリアクセス)
+#include "hardware/irq.h"  // 割り込み
+#include "ssd1327_pico.h"  // 実機向けの ssd1327_transport
+
+static i2c_inst_t *i2c; // 使用する I2C インスタンス
+static int dma_data;    // I2C の送信 FIFO に書き込む DMA チャンネル
+static int dma_ctrl;    // dma_data に次の転送元と長さを設定する DMA チャンネル
+
+// ssd1327_block は dma_ctrl が書き込む 2 つのレジスタ (al3_transfer_count, al3_read_addr_trig) と同じ並びで、
+// 要素の STOP・再スタートのビット (SSD1327_WORD_STOP, SSD1327_WORD_RESTART) は IC_DATA_CMD と同じ位置にある。
+// そのためドライバが作ったブロックの一覧をそのまま DMA に渡せる
+
+// I2C 割り込み: STOP コンディションを検出したら転送完了
+static void ssd1327_i2c_irq(void)
+{
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    uint32_t status = hw->intr_stat;
+    bool ok;
+
+    if (status & I2C_IC_INTR_STAT_R_TX_ABRT_BITS)
+    {
+        // NACK などで中断した (ハードウェアが STOP を出し、送信 FIFO は破棄される)
+        // dma_data と dma_ctrl は互いを起動し合うので、1 つずつ止めると、その間にまだ動いている方が
+        // 止めた方を起動し直すことがある。ABORT レジスタへの 1 回の書き込みで 2 つを同時に止める
+        uint32_t mask = (1u << dma_ctrl) | (1u << dma_data);
+        dma_hw->abort = mask;
+        while (dma_hw->abort & mask)
+        {
+            tight_loop_contents();
+        }
+        (void)hw->clr_tx_abrt;
+        ok = false;
+    }
+    else if (status & I2C_IC_INTR_STAT_R_STOP_DET_BITS)
+    {
+        ok = true;
+    }
+    else
+    {
+        return;
+    }
+
+    (void)hw->clr_stop_det;
+    hw->intr_mask = 0; // コマンド送信 (i2c_write_blocking) 中は割り込みを使わない
+    ssd1327_transfer_done(ok);
+}
+
+static int pico_write(void *ctx, uint8_t addr, const uint8_t *src, size_t len)
+{
+    (void)ctx;
+    return i2c_write_blocking(i2c, addr, src, len, false);
+}
+
+static void pico_start_blocks(void *ctx, uint8_t addr, const ssd1327_block *blocks)
+{
+    (void)ctx;
+    // 送信先アドレスを設定 (i2c_write_blocking() と同じ手順)
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    hw->enable = 0;
+    hw->tar = addr;
+    hw->enable = 1;
+
+    // STOP 検出と中断で割り込みを起こす
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+
+    // 最初のブロックを読み込ませて開始する
+    dma_channel_set_read_addr(dma_ctrl, blocks, true);
+}
+
+static uint64_t pico_now_us(void *ctx)
+{
+    (void)ctx;
+    return time_us_64();
+}
+
+static const ssd1327_transport pico_transport = {
+    .write = pico_write,
+    .start_blocks = pico_start_blocks,
+    .now_us = pico_now_us,
+    .ctx = NULL,
+};
+
+const ssd1327_transport *ssd1327_pico_transport_init(i2c_inst_t *i2c_inst)
+{
+    i2c = i2c_inst;
+
+    // 表示データ用の DMA (制御ブロック方式)
+    // dma_data は 16 ビット単位で I2C の送信 FIFO に書き込む (FIFO に空きができるたびに 1 要素)。
+    // 1 ブロック送り終えると dma_ctrl を起動し、dma_ctrl がブロックの一覧の次の 1 ブロック (長さと転送元) を
+    // dma_data のレジスタに書き込んで再起動する。転送元が NULL のブロックで止まる。
+    dma_data = dma_claim_unused_channel(true);
+    dma_ctrl = dma_claim_unused_channel(true);
+
+    dma_channel_config c = dma_channel_get_default_config(dma_ctrl);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, 3); // 書き込み先は al3_transfer_count, al3_read_addr_trig の 8 バイトを繰り返す
+    dma_channel_configure(dma_ctrl, &c, &dma_hw->ch[dma_data].al3_transfer_count, NULL, 2, false);
+
+    c = dma_channel_get_default_config(dma_data);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    channel_config_set_chain_to(&c, dma_ctrl); // 1 ブロック終わったら次のブロックを読み込む
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(dma_data, &c, &i2c_get_hw(i2c)->data_cmd, NULL, 0, false);
+
+    // 転送完了は I2C の STOP 検出割り込みで知る
+    i2c_get_hw(i2c)->intr_mask = 0;
+    irq_set_exclusive_handler(I2C0_IRQ + i2c_hw_index(i2c), ssd1327_i2c_irq);
+    irq_set_enabled(I2C0_IRQ + i2c_hw_index(i2c), true);
+
+    return &pico_transport;
+}
@@ -0,0 +1,15 @@
+#ifndef SSD1327_PICO_H
+#define SSD1327_PICO_H
+
+#include "hardware/i2c.h" // I2C
+#include "ssd1327.h"      // SSD1327 ドライバ
+
+// SSD1327 ドライバの実機 (RP2350) 向けの ssd1327_transport
+//
+// コマンドは i2c_write_blocking() で送り、表示データのブロックは 2 つの DMA チャンネル (制御ブロック方式) で
+// I2C の送信 FIFO に書き込む。転送の完了は I2C の STOP 検出割り込みで知り、ssd1327_transfer_done() を呼ぶ。
+
+// I2C インスタンス i2c (i2c_init() 済み) を使う ssd1327_transport を用意して返す (DMA チャンネル 2 つと I2C 割り込みを使う)
+const ssd1327_transport *ssd1327_pico_transport_init(i2c_inst_t *i2c);
+
+#endif // SSD1327_PICO_H
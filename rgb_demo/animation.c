@@ -0,0 +1,170 @@
+#include "animation.h"    // ストリップのアニメーション
+#include "ws2812_strip.h" // ws2812_pack()
+
+// 呼吸の明るさの表 (1 周期を 256 段階)。三角波を smoothstep で滑らかにし、ガンマ補正した値
+static uint8_t breathe_levels[256];
+
+// ws2812_pack() の形式の色の R, G, B をそれぞれ level / 255 倍する
+// G と B (16 ビット離れている) をまとめて 1 回の乗算で計算する
+static inline uint32_t scale_word(uint32_t word, uint8_t level)
+{
+    uint32_t scale = level + 1u;                               // 1〜256 (255 でそのまま)
+    uint32_t gb = (((word >> 8) & 0x00ff00ffu) * scale) >> 8; // G << 16 | B
+    uint32_t r = (((word >> 16) & 0xffu) * scale) >> 8;
+    return (gb & 0x00ff0000u) << 8 | r << 16 | (gb & 0xffu) << 8;
+}
+
+void anim_palette_build(anim_palette *p, const anim_keyframe *keys, int count)
+{
+    for (int i = 0; i < ANIM_PALETTE_SIZE; i++)
+    {
+        // i の手前 (pos が i 以下) の最後のキーフレーム。なければ最後のキーフレーム (先頭へ戻る区間)
+        int k = count - 1;
+        for (int j = 0; j < count && keys[j].pos <= i; j++)
+        {
+            k = j;
+        }
+        const anim_keyframe *from = &keys[k];
+        const anim_keyframe *to = &keys[(k + 1) % count];
+
+        // 区間の長さと区間内の位置 (256 で一周する。キーフレームが 1 個なら区間は一周全体)
+        int span = (to->pos - from->pos) & 0xff;
+        span = span ? span : ANIM_PALETTE_SIZE;
+        int offset = (i - from->pos) & 0xff;
+
+        // 色相は近い方向に回る
+        int dh = ((int)to->color.h - from->color.h) % HSV_HUE_MAX;
+        if (dh > HSV_HUE_MAX / 2)
+        {
+            dh -= HSV_HUE_MAX;
+        }
+        else if (dh < -HSV_HUE_MAX / 2)
+        {
+            dh += HSV_HUE_MAX;
+        }
+        int h = (from->color.h + dh * offset / span + HSV_HUE_MAX) % HSV_HUE_MAX;
+        int s = from->color.s + (to->color.s - from->color.s) * offset / span;
+        int v = from->color.v + (to->color.v - from->color.v) * offset / span;
+
+        uint8_t r, g, b;
+        hsv_to_rgb8((uint16_t)h, (uint8_t)s, (uint8_t)v, &r, &g, &b);
+        p->words[i] = ws2812_pack(hsv_gamma8[r], hsv_gamma8[g], hsv_gamma8[b]);
+    }
+}
+
+void animation_init(animation *a, uint64_t (*now_us)(void))
+{
+    for (int i = 0; i < 256; i++)
+    {
+        // 三角波 (0〜255〜0) を smoothstep (3x² - 2x³) で滑らかにする
+        uint32_t x = i < 128 ? i * 2 : (255 - i) * 2 + 1;
+        uint32_t smooth = x * x * (3 * 255 - 2 * x) / (255 * 255);
+        breathe_levels[i] = hsv_gamma8[smooth];
+    }
+
+    a->count = 0;
+    a->now_us = now_us;
+    a->rendered = false;
+    a->last_frame = 0;
+    a->stats = (anim_stats){0};
+}
+
+bool animation_add(animation *a, const anim_effect *effect)
+{
+    if (a->count >= ANIM_MAX_EFFECTS)
+    {
+        return false;
+    }
+    a->effects[a->count++] = *effect;
+    return true;
+}
+
+// グラデーション: 区間の j 番目の LED はパレットの位置 frame × speed + j × spread
+static void render_gradient(const anim_effect *e, uint32_t *pixels, int begin, int end, uint32_t frame)
+{
+    const uint32_t *words = e->palette->words;
+    uint32_t pos = frame * e->speed + (uint32_t)(begin - e->first) * e->spread; // 2^32 はパレット 1 周の倍数なので桁あふれしても続く
+    for (int i = begin; i < end; i++)
+    {
+        pixels[i] = words[(pos >> 8) & 0xff];
+        pos += e->spread;
+    }
+}
+
+// 呼吸: 区間の j 番目の LED はパレットの位置 j × spread の色を、周期の位置 frame × speed の明るさにする
+static void render_breathe(const anim_effect *e, uint32_t *pixels, int begin, int end, uint32_t frame)
+{
+    const uint32_t *words = e->palette->words;
+    uint8_t level = breathe_levels[((frame * e->speed) >> 8) & 0xff];
+    uint32_t pos = (uint32_t)(begin - e->first) * e->spread;
+    for (int i = begin; i < end; i++)
+    {
+        pixels[i] = scale_word(words[(pos >> 8) & 0xff], level);
+        pos += e->spread;
+    }
+}
+
+// チェイス: 先頭は区間の (frame × speed) mod count 番目。後ろの length 個を先頭から暗くしていく
+static void render_chase(const anim_effect *e, uint32_t *pixels, int begin, int end, uint32_t frame)
+{
+    const uint32_t *words = e->palette->words;
+    int head = (int)((((uint64_t)frame * e->speed) >> 8) % (uint32_t)e->count);
+    int length = e->length < e->count ? e->length : e->count;
+    for (int d = 0; d < length; d++)
+    {
+        int j = head - d < 0 ? head - d + e->count : head - d; // 区間内の位置 (区間の先頭へ回り込む)
+        int i = e->first + j;
+        if (i < begin || i >= end)
+        {
+            continue;
+        }
+        uint8_t level = hsv_gamma8[255 * (length - d) / length];
+        pixels[i] = scale_word(words[((uint32_t)j * e->spread >> 8) & 0xff], level);
+    }
+}
+
+void animation_render(animation *a, uint32_t *pixels, int count, uint32_t frame)
+{
+    uint64_t start_us = a->now_us();
+    if (a->rendered && frame - a->last_frame > 1)
+    {
+        a->stats.skipped += frame - a->last_frame - 1;
+    }
+
+    for (int k = 0; k < a->count; k++)
+    {
+        const anim_effect *e = &a->effects[k];
+        // 区間のうちストリップの中にある部分
+        int begin = e->first > 0 ? e->first : 0;
+        int end = e->first + e->count < count ? e->first + e->count : count;
+        if (begin >= end)
+        {
+            continue;
+        }
+        switch (e->type)
+        {
+        case ANIM_GRADIENT:
+            render_gradient(e, pixels, begin, end, frame);
+            break;
+        case ANIM_BREATHE:
+            render_breathe(e, pixels, begin, end, frame);
+            break;
+        case ANIM_CHASE:
+            render_chase(e, pixels, begin, end, frame);
+            break;
+        }
+    }
+
+    uint32_t elapsed = (uint32_t)(a->now_us() - start_us);
+    a->stats.frames++;
+    a->stats.render_us = elapsed;
+    a->stats.render_max_us = elapsed > a->stats.render_max_us ? elapsed : a->stats.render_max_us;
+    a->stats.render_total_us += elapsed;
+    a->rendered = true;
+    a->last_frame = frame;
+}
+
+const anim_stats *animation_get_stats(const animation *a)
+{
+    return &a->stats;
+}
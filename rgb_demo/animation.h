@@ -0,0 +1,91 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <stdint.h>  // 固定幅整数型
+#include <stdbool.h> // bool 型
+#include "hsv.h"     // HSV 色
+
+// ストリップのアニメーション
+//
+// 色はあらかじめパレット (256 色の表) に展開しておく。パレットはいくつかのキーフレーム (位置と HSV 色) の間を
+// 補間して作り、ガンマ補正した ws2812_pack() の形式で持つので、毎フレームの描画は表を引くだけになる。
+//
+// エフェクト (グラデーション・呼吸・チェイス) はストリップの区間ごとに複数同時に動かせ、追加した順に描く。
+// 各エフェクトの状態はフレーム番号だけで決まる (前のフレームの状態を持たない) ので、
+// フレーム番号を時刻から求めれば、描画が遅れてフレームを飛ばしてもアニメーションの速さは変わらない。
+
+#define ANIM_PALETTE_SIZE 256 // パレットの色数
+#define ANIM_MAX_EFFECTS 4    // 同時に動かせるエフェクトの数
+
+// キーフレーム: パレットの位置 pos に置く色
+typedef struct
+{
+    uint8_t pos; // パレットの位置 (0〜255。昇順に並べる)
+    hsv color;   // 色
+} anim_keyframe;
+
+// パレット: キーフレームの間を補間した 256 色 (ガンマ補正した ws2812_pack() の形式)
+typedef struct
+{
+    uint32_t words[ANIM_PALETTE_SIZE];
+} anim_palette;
+
+// エフェクトの種類
+typedef enum
+{
+    ANIM_GRADIENT, // パレットの色を LED ごとにずらして並べ、流す
+    ANIM_BREATHE,  // パレットの色を LED ごとにずらして並べ (止めたまま)、全体の明るさをゆっくり上下させる
+    ANIM_CHASE,    // 明るい点が尾を引いて区間を回る (尾の外側の LED は書き換えないので、前のエフェクトに重ねられる)
+} anim_effect_type;
+
+// エフェクト
+// speed と spread は 8 ビットの小数部を持つ固定小数点 (256 = 1)
+typedef struct
+{
+    anim_effect_type type;       // 種類
+    int first;                   // 区間の最初の LED
+    int count;                   // 区間の LED の数
+    const anim_palette *palette; // 色
+    uint16_t speed;              // 1 フレームに進む量 (グラデーション: パレットの位置、呼吸: 明るさの周期の 1/256 単位、チェイス: LED の数)
+    uint16_t spread;             // LED 1 個あたりのパレットの位置のずれ
+    uint8_t length;              // チェイスの尾の長さ [LED]
+} anim_effect;
+
+// フレームごとの描画時間の統計
+typedef struct
+{
+    uint32_t frames;          // 描画したフレーム数
+    uint32_t skipped;         // 描画が間に合わずに飛ばしたフレーム数
+    uint32_t render_us;       // 最後のフレームの描画時間 [us]
+    uint32_t render_max_us;   // 描画時間の最大値 [us]
+    uint64_t render_total_us; // 描画時間の合計 [us] (平均 = render_total_us / frames)
+} anim_stats;
+
+typedef struct
+{
+    anim_effect effects[ANIM_MAX_EFFECTS]; // エフェクト (追加した順に描く)
+    int count;                             // エフェクトの数
+    uint64_t (*now_us)(void);              // 描画時間を計る時計
+    bool rendered;                         // 1 フレーム以上描画した
+    uint32_t last_frame;                   // 最後に描画したフレーム番号
+    anim_stats stats;                      // 統計
+} animation;
+
+// キーフレーム (pos の昇順、1 個以上) の間を補間してパレットを作る
+// 最後のキーフレームから先は最初のキーフレームへ戻るように補間する。色相は近い方向に回る
+void anim_palette_build(anim_palette *p, const anim_keyframe *keys, int count);
+
+// エフェクトのない状態にする。now_us は描画時間を計る時計 (time_us_64 など)
+void animation_init(animation *a, uint64_t (*now_us)(void));
+
+// エフェクトを追加する。いっぱいなら false
+bool animation_add(animation *a, const anim_effect *effect);
+
+// フレーム番号 frame の画像を pixels (count 個の LED) に描く。描画時間と飛ばしたフレーム数を記録する
+// 区間のうちストリップの外にある部分は描かない
+void animation_render(animation *a, uint32_t *pixels, int count, uint32_t frame);
+
+// 統計を返す
+const anim_stats *animation_get_stats(const animation *a);
+
+#endif // ANIMATION_H
@@ -0,0 +1,246 @@
+#include <stdio.h>        // 標準入出力ライブラリ
+#include <stdlib.h>       // strtol
+#include <string.h>       // memcmp
+#include <unistd.h>       // getopt
+#include "host_util.h"    // 疑似乱数 rng() と現在時刻 now_us() (ホスト共通)
+#include "animation.h"    // パレットを使うアニメーション (rgb_demo と同じソース)
+#include "ws2812_strip.h" // ws2812_pack()
+
+// rgb_demo のアニメーションをホストで動かし、パレット・フレームの時刻・描画時間を確かめる
+//
+// 使い方: animation_sim [-t seconds] [-c compute_us]
+//   -t  時刻のシミュレーションの長さ [s] (既定 3600)
+//   -c  以前のループで 1 ステップの色の計算と送信の開始にかかる時間 [us] (既定 300)
+//
+// 1. パレットのキーフレームの位置の色が、hsv_to_rgb8() + ガンマ補正で直接計算した色と一致することを確かめる。
+// 2. フレーム N の画像が、0〜N-1 を描いた後でも、いきなり N を描いても同じになる (状態を持たない) ことを確かめる。
+// 3. 仮想時刻で、以前のループ (計算 + sleep_ms(5) の繰り返し) と、タイマーの時刻からフレーム番号を求める方式を比べる。
+//    以前のループは 1 ステップごとに計算時間だけ遅れが積み重なる。新しい方式は描画時間がときどき周期を超えても
+//    フレームを飛ばして追いつき、描いているフレームの時刻が現在時刻から 1 周期以上遅れない。
+// 4. ストリップの長さごとに 1 フレームの描画時間 (平均・最大) を計り、以前の hsv_rainbow_n() と比べる。
+
+#define FRAME_US 20000  // main.c と同じ
+#define OLD_DELAY_US 5000 // 以前のループの sleep_ms(gradient_delay)
+#define MAX_LEDS 1000
+#define BENCH_FRAMES 2000 // 描画時間を計るフレーム数
+
+static uint64_t virtual_us; // 仮想時刻
+
+static uint64_t virtual_now_us(void)
+{
+    return virtual_us;
+}
+
+static const anim_keyframe rainbow_keys[] = { // main.c と同じ
+    {0, {HSV_HUE_DEGREES(0), 255, 255}},
+    {43, {HSV_HUE_DEGREES(60), 255, 255}},
+    {85, {HSV_HUE_DEGREES(120), 255, 255}},
+    {128, {HSV_HUE_DEGREES(180), 255, 255}},
+    {171, {HSV_HUE_DEGREES(240), 255, 255}},
+    {213, {HSV_HUE_DEGREES(300), 255, 255}},
+};
+static const anim_keyframe warm_keys[] = {
+    {0, {HSV_HUE_DEGREES(0), 255, 255}},
+    {96, {HSV_HUE_DEGREES(25), 255, 255}},
+    {176, {HSV_HUE_DEGREES(50), 200, 255}},
+};
+static anim_palette rainbow, warm;
+
+// main.c と同じ 3 つのエフェクトを count 個の LED に合わせて登録する
+static void add_effects(animation *a, int count)
+{
+    int split = count * 2 / 3;
+    animation_add(a, &(anim_effect){
+        .type = ANIM_GRADIENT, .first = 0, .count = split, .palette = &rainbow,
+        .speed = 65536 * FRAME_US / 3000000, .spread = 65536 / (split ? split : 1),
+    });
+    animation_add(a, &(anim_effect){
+        .type = ANIM_BREATHE, .first = split, .count = count - split, .palette = &warm,
+        .speed = 65536 * FRAME_US / 4000000, .spread = 65536 / (count - split),
+    });
+    animation_add(a, &(anim_effect){
+        .type = ANIM_CHASE, .first = 0, .count = count, .palette = &rainbow,
+        .speed = 128, .spread = 65536 / count, .length = 8,
+    });
+}
+
+// キーフレームの位置の色を直接計算した色と比べる。一致しない数を返す
+static int check_palette(const anim_palette *p, const anim_keyframe *keys, int count, const char *name)
+{
+    int errors = 0;
+    for (int k = 0; k < count; k++)
+    {
+        uint8_t r, g, b;
+        hsv_to_rgb8(keys[k].color.h, keys[k].color.s, keys[k].color.v, &r, &g, &b);
+        errors += p->words[keys[k].pos] != ws2812_pack(hsv_gamma8[r], hsv_gamma8[g], hsv_gamma8[b]);
+    }
+
+    // 隣り合う色の差 (ガンマ補正後の 0〜255 の単位) の最大値
+    int max_step = 0;
+    for (int i = 0; i < ANIM_PALETTE_SIZE; i++)
+    {
+        uint32_t a = p->words[i], b = p->words[(i + 1) % ANIM_PALETTE_SIZE];
+        for (int shift = 8; shift < 32; shift += 8)
+        {
+            int d = abs((int)((a >> shift) & 0xff) - (int)((b >> shift) & 0xff));
+            max_step = d > max_step ? d : max_step;
+        }
+    }
+    printf("palette %-7s: keyframes %s, max step between neighbours %d\n", name,
+           errors ? "MISMATCH" : "match hsv_to_rgb8() + gamma", max_step);
+    return errors;
+}
+
+// フレーム番号だけで画像が決まることを確かめる。一致しないフレーム数を返す
+static int check_stateless(int count)
+{
+    static uint32_t sequential[MAX_LEDS], direct[MAX_LEDS];
+    animation a, b;
+    animation_init(&a, virtual_now_us);
+    animation_init(&b, virtual_now_us);
+    add_effects(&a, count);
+    add_effects(&b, count);
+
+    int errors = 0;
+    for (uint32_t frame = 0; frame < 3000; frame++)
+    {
+        animation_render(&a, sequential, count, frame);
+        if (frame % 97 == 0)
+        {
+            memset(direct, 0, sizeof direct);
+            memset(sequential, 0, sizeof sequential); // 前のフレームの画像が残っていても結果は同じはず
+            animation_render(&a, sequential, count, frame);
+            animation_render(&b, direct, count, frame);
+            errors += memcmp(sequential, direct, count * sizeof direct[0]) != 0;
+        }
+    }
+    printf("frame N rendered after 0..N-1 vs directly: %s\n", errors ? "MISMATCH" : "identical");
+    return errors;
+}
+
+// 仮想時刻で以前のループと新しい方式を比べる。フレーム番号が時刻から 1 周期以上遅れたら 1 を返す
+static int simulate_timing(uint64_t duration_us, uint32_t compute_us)
+{
+    // 以前のループ: (計算 + 送信の開始) → sleep_ms(5) を 1 ステップとし、ステップ数でアニメーションが進む
+    uint64_t old_steps = duration_us / (compute_us + OLD_DELAY_US);
+    uint64_t old_expected = duration_us / OLD_DELAY_US; // sleep だけならこのステップ数になるはず
+    double old_lag_s = (old_expected - old_steps) * OLD_DELAY_US * 1e-6;
+
+    // 新しい方式: タイマーは start + k × FRAME_US に発火し、フレーム番号は (発火を受け付けた時刻 - start) / FRAME_US。
+    // 描画時間は普段は compute_us 前後で、ときどき周期を超える (その間に来た発火はまとめて 1 回になり、描画が終わるとすぐ次を描く)
+    static animation a;
+    static uint32_t pixels[MAX_LEDS];
+    animation_init(&a, virtual_now_us);
+    add_effects(&a, 60);
+    virtual_us = 0;
+    uint64_t ticks = duration_us / FRAME_US;
+    uint32_t frame = 0;
+    uint32_t late = 0;
+    uint64_t max_lag_us = 0; // 描画を始めた時刻とフレームの時刻の差の最大値
+    uint64_t tick = 0; // 次に発火するタイマーの回数
+    while (tick <= ticks)
+    {
+        // フラグが立つまで待つ (描画中に発火していれば待たない)。発火が何回あってもフラグは 1 つ
+        if (tick * FRAME_US > virtual_us)
+        {
+            virtual_us = tick * FRAME_US;
+        }
+        while (tick * FRAME_US <= virtual_us)
+        {
+            tick++;
+        }
+        frame = (uint32_t)(virtual_us / FRAME_US);
+        uint64_t lag_us = virtual_us - (uint64_t)frame * FRAME_US;
+        max_lag_us = lag_us > max_lag_us ? lag_us : max_lag_us;
+        animation_render(&a, pixels, 60, frame);
+        uint32_t render_us = compute_us / 2 + rng() % compute_us;
+        if (rng() % 500 == 0)
+        {
+            render_us = FRAME_US * (1 + rng() % 3) + rng() % compute_us; // まれに周期を超える
+            late++;
+        }
+        virtual_us += render_us;
+    }
+    const anim_stats *st = animation_get_stats(&a);
+
+    printf("timing over %.0f s (compute %lu us per step):\n", duration_us * 1e-6, (unsigned long)compute_us);
+    printf("  old loop : %llu steps instead of %llu, animation %.1f s behind the clock\n",
+           (unsigned long long)old_steps, (unsigned long long)old_expected, old_lag_s);
+    printf("  timer    : last frame %lu at %.3f s, rendered %lu, skipped %lu after %lu late frames, max lag %llu us\n",
+           (unsigned long)frame, (uint64_t)frame * FRAME_US * 1e-6, (unsigned long)st->frames,
+           (unsigned long)st->skipped, (unsigned long)late, (unsigned long long)max_lag_us);
+    bool ok = frame >= ticks && max_lag_us < FRAME_US && st->frames + st->skipped == frame + 1;
+    printf("  %s\n", ok ? "frame index follows the clock" : "FAIL: frame index drifted");
+    return !ok;
+}
+
+// count 個の LED の描画時間を計る
+static void bench(int count)
+{
+    static uint32_t pixels[MAX_LEDS];
+    static animation a;
+    animation_init(&a, now_us);
+    add_effects(&a, count);
+    for (uint32_t frame = 0; frame < BENCH_FRAMES; frame++)
+    {
+        animation_render(&a, pixels, count, frame);
+    }
+    const anim_stats *st = animation_get_stats(&a);
+
+    // 以前のループと同じく、毎フレーム hsv_rainbow_n() で色を計算する
+    uint64_t start = now_us();
+    for (uint32_t frame = 0; frame < BENCH_FRAMES; frame++)
+    {
+        hsv_rainbow_n(pixels, count, (uint16_t)(frame * 7 % HSV_HUE_MAX), HSV_HUE_MAX, 255, 255);
+    }
+    double rainbow_us = (double)(now_us() - start) / BENCH_FRAMES;
+    volatile uint32_t sink = pixels[count - 1]; // 計算が最適化で消えないようにする
+    (void)sink;
+
+    printf("%6d %12.2f %12lu %14.2f %9.3f%%\n", count, (double)st->render_total_us / st->frames,
+           (unsigned long)st->render_max_us, rainbow_us, 100.0 * st->render_total_us / st->frames / FRAME_US);
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 3600;
+    uint32_t compute_us = 300;
+    int opt;
+    while ((opt = getopt(argc, argv, "t:c:")) != -1)
+    {
+        switch (opt)
+        {
+        case 't':
+            seconds = strtod(optarg, NULL);
+            break;
+        case 'c':
+            compute_us = (uint32_t)strtol(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-t seconds] [-c compute_us]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds <= 0 || compute_us == 0)
+    {
+        fprintf(stderr, "usage: %s [-t seconds] [-c compute_us]\n", argv[0]);
+        return 2;
+    }
+
+    anim_palette_build(&rainbow, rainbow_keys, sizeof rainbow_keys / sizeof rainbow_keys[0]);
+    anim_palette_build(&warm, warm_keys, sizeof warm_keys / sizeof warm_keys[0]);
+    int failures = check_palette(&rainbow, rainbow_keys, sizeof rainbow_keys / sizeof rainbow_keys[0], "rainbow");
+    failures += check_palette(&warm, warm_keys, sizeof warm_keys / sizeof warm_keys[0], "warm");
+    failures += check_stateless(60);
+    failures += check_stateless(301);
+    failures += simulate_timing((uint64_t)(seconds * 1e6), compute_us);
+
+    printf("render time per frame (%d frames, gradient + breathe + chase):\n", BENCH_FRAMES);
+    printf("%6s %12s %12s %14s %10s\n", "LEDs", "avg us", "max us", "rainbow_n us", "of frame");
+    static const int lengths[] = {60, 144, 300, 1000};
+    for (size_t k = 0; k < sizeof lengths / sizeof lengths[0]; k++)
+    {
+        bench(lengths[k]);
+    }
+    return failures != 0;
+}
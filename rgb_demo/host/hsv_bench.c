@@ -0,0 +1,180 @@
+#include <stdio.h>        // 標準入出力ライブラリ
+#include <stdlib.h>       // abs
+#include <math.h>         // pow
+#include "host_util.h"    // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "hsv.h"          // HSV から RGB への変換 (rgb_demo と同じソース)
+#include "ws2812_strip.h" // ws2812_pack()
+
+// HSV から RGB への変換を、浮動小数点版と整数版で比べる
+//
+// 1. ガンマ補正の表 hsv_gamma8 が round(255 × (i / 255) ^ HSV_GAMMA) と一致することを確かめる。
+// 2. 色相 1536 段階すべてと、彩度・明度の組み合わせについて、整数版と浮動小数点版の差 (0〜255 の単位) を数える。
+// 3. hsv_to_rgb_n() / hsv_rainbow_n() の結果が、1 個ずつ変換してガンマ補正した値と一致することを確かめる。
+// 4. 1 秒あたりに変換できる LED の数を比べる (浮動小数点版は rgb_demo の以前のループと同じく 1 個ずつ変換して詰める)。
+
+#define STRIP_LEDS 300     // ベンチマークのストリップの長さ
+#define BENCH_SEC 0.3      // 1 つの方法を繰り返す時間 [s]
+#define SV_STEP 3          // 誤差を調べる彩度・明度の間隔
+
+static uint32_t pixels[STRIP_LEDS]; // 変換先 (ws2812_pack() の形式)
+static hsv colors[STRIP_LEDS];      // hsv_to_rgb_n() の入力
+
+static int check_gamma(void)
+{
+    int errors = 0;
+    for (int i = 0; i < 256; i++)
+    {
+        errors += hsv_gamma8[i] != (uint8_t)lround(255.0 * pow(i / 255.0, HSV_GAMMA));
+    }
+    printf("hsv_gamma8: %s\n", errors ? "MISMATCH with pow()" : "matches round(255 * (i / 255) ^ 2.8)");
+    return errors;
+}
+
+// 整数版と浮動小数点版の差を数える
+static void compare_float(void)
+{
+    long count = 0, exact = 0;
+    long histogram[4] = {0}; // 差 0, 1, 2, 3 以上
+    int max_error = 0;
+    double sum = 0;
+    for (int h = 0; h < HSV_HUE_MAX; h++)
+    {
+        for (int s = 0; s <= 255; s += SV_STEP)
+        {
+            for (int v = 0; v <= 255; v += SV_STEP)
+            {
+                uint8_t fr, fg, fb, ir, ig, ib;
+                hsv_to_rgb(h * 360.0f / HSV_HUE_MAX, s / 255.0f, v / 255.0f, &fr, &fg, &fb);
+                hsv_to_rgb8(h, s, v, &ir, &ig, &ib);
+                int e[3] = {abs(fr - ir), abs(fg - ig), abs(fb - ib)};
+                int worst = 0;
+                for (int c = 0; c < 3; c++)
+                {
+                    worst = e[c] > worst ? e[c] : worst;
+                    sum += e[c];
+                }
+                max_error = worst > max_error ? worst : max_error;
+                histogram[worst < 3 ? worst : 3]++;
+                exact += worst == 0;
+                count++;
+            }
+        }
+    }
+    printf("integer vs float (%ld colors, all hues, s/v step %d):\n", count, SV_STEP);
+    printf("  identical %.3f %%, off by 1: %.3f %%, off by 2: %.3f %%, more: %.3f %%\n",
+           100.0 * histogram[0] / count, 100.0 * histogram[1] / count, 100.0 * histogram[2] / count,
+           100.0 * histogram[3] / count);
+    printf("  max error %d, mean error %.4f per channel\n", max_error, sum / (count * 3));
+}
+
+// 一括変換の結果を 1 個ずつの変換と比べる。一致しない数を返す
+static int check_batch(void)
+{
+    int errors = 0;
+    for (int i = 0; i < STRIP_LEDS; i++)
+    {
+        colors[i] = (hsv){(uint16_t)(i * 37 % (HSV_HUE_MAX + 100)), (uint8_t)(i * 11), (uint8_t)(255 - i)};
+    }
+    hsv_to_rgb_n(colors, pixels, STRIP_LEDS);
+    for (int i = 0; i < STRIP_LEDS; i++)
+    {
+        uint8_t r, g, b;
+        hsv_to_rgb8(colors[i].h, colors[i].s, colors[i].v, &r, &g, &b);
+        errors += pixels[i] != ws2812_pack(hsv_gamma8[r], hsv_gamma8[g], hsv_gamma8[b]);
+    }
+
+    // 虹色: i 番目の色相は hue + span × i / count (固定小数点の丸めで 1 ずれるのは許す)
+    const uint16_t hue = 1000, span = HSV_HUE_MAX;
+    hsv_rainbow_n(pixels, STRIP_LEDS, hue, span, 255, 128);
+    for (int i = 0; i < STRIP_LEDS; i++)
+    {
+        int h = (hue + span * i / STRIP_LEDS) % HSV_HUE_MAX;
+        bool ok = false;
+        for (int d = -1; d <= 0 && !ok; d++)
+        {
+            uint8_t r, g, b;
+            hsv_to_rgb8((h + d + HSV_HUE_MAX) % HSV_HUE_MAX, 255, 128, &r, &g, &b);
+            ok = pixels[i] == ws2812_pack(hsv_gamma8[r], hsv_gamma8[g], hsv_gamma8[b]);
+        }
+        errors += !ok;
+    }
+    printf("hsv_to_rgb_n / hsv_rainbow_n: %s\n", errors ? "MISMATCH with per-pixel conversion" : "match per-pixel conversion + gamma");
+    return errors;
+}
+
+typedef enum
+{
+    METHOD_FLOAT,   // 浮動小数点版を 1 個ずつ (以前の rgb_demo)
+    METHOD_INT,     // 整数版を 1 個ずつ + ガンマ補正
+    METHOD_BATCH,   // hsv_to_rgb_n()
+    METHOD_RAINBOW, // hsv_rainbow_n()
+} method;
+
+// 1 秒あたりに変換できる LED の数
+static double bench(method m)
+{
+    for (int i = 0; i < STRIP_LEDS; i++)
+    {
+        colors[i] = (hsv){(uint16_t)(i * HSV_HUE_MAX / STRIP_LEDS), 255, 255};
+    }
+    long frames = 0;
+    double start = now_sec(), elapsed;
+    do
+    {
+        uint16_t hue = (uint16_t)(frames * 7 % HSV_HUE_MAX);
+        switch (m)
+        {
+        case METHOD_FLOAT:
+            for (int i = 0; i < STRIP_LEDS; i++)
+            {
+                uint8_t r, g, b;
+                hsv_to_rgb(hue * (360.0f / HSV_HUE_MAX) + 360.0f * i / STRIP_LEDS, 1.0f, 1.0f, &r, &g, &b);
+                pixels[i] = ws2812_pack(r, g, b);
+            }
+            break;
+        case METHOD_INT:
+            for (int i = 0; i < STRIP_LEDS; i++)
+            {
+                uint8_t r, g, b;
+                hsv_to_rgb8(hue + i * HSV_HUE_MAX / STRIP_LEDS, 255, 255, &r, &g, &b);
+                pixels[i] = ws2812_pack(hsv_gamma8[r], hsv_gamma8[g], hsv_gamma8[b]);
+            }
+            break;
+        case METHOD_BATCH:
+            colors[frames % STRIP_LEDS].h = hue; // 入力が毎回同じにならないようにする
+            hsv_to_rgb_n(colors, pixels, STRIP_LEDS);
+            break;
+        case METHOD_RAINBOW:
+            hsv_rainbow_n(pixels, STRIP_LEDS, hue, HSV_HUE_MAX, 255, 255);
+            break;
+        }
+        frames++;
+        elapsed = now_sec() - start;
+    } while (elapsed < BENCH_SEC);
+    volatile uint32_t sink = pixels[frames % STRIP_LEDS]; // 変換が最適化で消えないようにする
+    (void)sink;
+    return frames * STRIP_LEDS / elapsed;
+}
+
+int main(void)
+{
+    int errors = check_gamma();
+    compare_float();
+    errors += check_batch();
+
+    static const char *names[] = {
+        "float hsv_to_rgb() per LED",
+        "integer hsv_to_rgb8() + gamma",
+        "hsv_to_rgb_n() batch",
+        "hsv_rainbow_n() batch",
+    };
+    printf("conversion speed (%d-LED strip):\n", STRIP_LEDS);
+    double base = 0;
+    for (int m = METHOD_FLOAT; m <= METHOD_RAINBOW; m++)
+    {
+        double rate = bench((method)m);
+        base = m == METHOD_FLOAT ? rate : base;
+        printf("  %-31s %8.1f M LEDs/s (%.1fx), %9.0f strips/s\n", names[m], rate * 1e-6, rate / base, rate / STRIP_LEDS);
+    }
+    return errors != 0;
+}
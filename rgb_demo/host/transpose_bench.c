@@ -0,0 +1,231 @@
+#include <stdio.h>           // 標準入出力ライブラリ
+#include <string.h>          // memset
+#include "host_util.h"       // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "ws2812_parallel.h" // 複数の WS2812 ストリップへの同時送信 (rgb_demo と同じソース)
+
+// 並列出力のビットプレーンへの並べ替え (ws2812_transpose) と、ws2812_parallel のドライバを確かめる
+//
+// 1. ws2812_parallel.pio のとおりに、32 ビットの要素を上位のバイトから 1 ビットの時間ずつ取り出し、
+//    バイトのビット n をストリップ n の線に出す。各ストリップの LED は先頭から 24 ビットずつ受け取るので、
+//    受け取った色が表示バッファの色 (下位 8 ビットは送られない) と一致し、使わないピンが常に Low であることを確かめる。
+//    ストリップの数 1〜8 と長さの組み合わせで、下位 8 ビットに値が入った色も使う。
+// 2. 仮想時刻で ws2812_parallel_show() を繰り返し、最後のフレームの色と、1 秒あたりに送れる LED の数を確かめる。
+// 3. 1 秒あたりに並べ替えられる LED の数を、1 ビットずつ並べ替える素朴な方法と比べる。
+
+#define MAX_LENGTH 1000
+#define BENCH_SEC 0.3 // 1 つの方法を繰り返す時間 [s]
+
+static uint32_t pixels[WS2812_PARALLEL_MAX_LANES * MAX_LENGTH];
+static uint32_t planes[WS2812_PARALLEL_PLANE_WORDS(MAX_LENGTH)];
+static uint32_t received[WS2812_PARALLEL_MAX_LANES][MAX_LENGTH]; // 各ストリップの LED が受け取った 24 ビット
+
+// words を PIO と同じ順に送り、各ストリップの LED が受け取った色を received に入れる
+// lanes 本目以降のピンが High になったビットの数を返す
+static int receive(const uint32_t *words, int count, int lanes)
+{
+    int stray = 0;
+    int bit = 0; // 送ったビット位置 (すべてのストリップで共通)
+    memset(received, 0, sizeof received);
+    for (int w = 0; w < count; w++)
+    {
+        for (int shift = 24; shift >= 0; shift -= 8) // 上位のバイトから
+        {
+            uint8_t pins = words[w] >> shift;
+            for (int lane = 0; lane < WS2812_PARALLEL_MAX_LANES; lane++)
+            {
+                int value = (pins >> lane) & 1;
+                if (lane >= lanes)
+                {
+                    stray += value;
+                    continue;
+                }
+                uint32_t *led = &received[lane][bit / WS2812_BITS_PER_PIXEL];
+                *led = *led << 1 | value;
+            }
+            bit++;
+        }
+    }
+    return stray;
+}
+
+// received を表示バッファと比べる。一致しない LED の数を返す
+static int compare(int lanes, int length)
+{
+    int errors = 0;
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        for (int i = 0; i < length; i++)
+        {
+            errors += received[lane][i] != pixels[lane * length + i] >> 8;
+        }
+    }
+    return errors;
+}
+
+// ストリップの数と長さの組み合わせで並べ替えを確かめる。失敗した組み合わせの数を返す
+static int check_transpose(void)
+{
+    static const int lengths[] = {1, 2, 7, 60, 300, MAX_LENGTH};
+    int failures = 0, cases = 0;
+    for (int lanes = 1; lanes <= WS2812_PARALLEL_MAX_LANES; lanes++)
+    {
+        for (size_t k = 0; k < sizeof lengths / sizeof lengths[0]; k++)
+        {
+            int length = lengths[k];
+            for (int i = 0; i < lanes * length; i++)
+            {
+                pixels[i] = rng(); // 下位 8 ビットにも値を入れる (送られないはず)
+            }
+            ws2812_transpose(pixels, length, lanes, length, planes);
+            int stray = receive(planes, length * WS2812_PARALLEL_WORDS_PER_PIXEL, lanes);
+            int errors = compare(lanes, length);
+            if (stray || errors)
+            {
+                printf("  lanes %d length %d: %d wrong LEDs, %d stray bits on unused pins\n", lanes, length, errors, stray);
+                failures++;
+            }
+            cases++;
+        }
+    }
+    printf("ws2812_transpose: %s (%d lane/length combinations)\n",
+           failures ? "MISMATCH with the pixels" : "every lane receives its pixels, unused pins stay low", cases);
+    return failures;
+}
+
+// ホストの DMA と時計 (仮想時刻)
+typedef struct
+{
+    uint64_t clock_us;     // 仮想時刻
+    uint64_t dma_done_us;  // DMA 転送が終わる時刻
+    const uint32_t *words; // 最後に送り始めた要素
+    int count;             // その数
+} host_dma;
+
+static void host_start(void *ctx, const uint32_t *words, int count)
+{
+    host_dma *h = ctx;
+    h->words = words;
+    h->count = count;
+    // 1 要素は 4 ビットの時間 (FIFO の 8 段分早く終わる)
+    int bits = count > 8 ? (count - 8) * 4 : 0;
+    h->dma_done_us = h->clock_us + (uint64_t)bits * 1000000 / WS2812_FREQ;
+}
+
+static void host_wait(void *ctx)
+{
+    host_dma *h = ctx;
+    h->clock_us = h->clock_us > h->dma_done_us ? h->clock_us : h->dma_done_us;
+}
+
+static uint64_t host_now_us(void *ctx)
+{
+    host_dma *h = ctx;
+    return h->clock_us;
+}
+
+static void host_sleep_until(void *ctx, uint64_t time_us)
+{
+    host_dma *h = ctx;
+    h->clock_us = h->clock_us > time_us ? h->clock_us : time_us;
+}
+
+// ドライバで frames フレームを送り、1 秒あたりの LED の数を返す (最後のフレームの色が違えば負)
+static double run_driver(int lanes, int length, int frames)
+{
+    static uint32_t plane_words[WS2812_PARALLEL_PLANE_WORDS(MAX_LENGTH)];
+    host_dma h = {0};
+    const ws2812_transport transport = {
+        .start = host_start,
+        .wait = host_wait,
+        .now_us = host_now_us,
+        .sleep_until = host_sleep_until,
+        .ctx = &h,
+    };
+    ws2812_parallel p;
+    ws2812_parallel_init(&p, &transport, pixels, plane_words, lanes, length);
+    int errors = 0;
+    for (int f = 0; f < frames; f++)
+    {
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            for (int i = 0; i < length; i++)
+            {
+                ws2812_parallel_set_pixel(&p, lane, i, rng(), rng(), rng());
+            }
+        }
+        ws2812_parallel_show(&p);
+        receive(h.words, h.count, lanes);
+        errors += compare(lanes, length);
+    }
+    ws2812_parallel_wait(&p);
+    return errors ? -1.0 : (double)lanes * length * frames * 1e6 / h.clock_us;
+}
+
+// 1 ビットずつ並べ替える素朴な方法 (比較用)
+static void transpose_naive(const uint32_t *src, int stride, int lanes, int count, uint32_t *dst)
+{
+    for (int i = 0; i < count; i++)
+    {
+        for (int w = 0; w < WS2812_PARALLEL_WORDS_PER_PIXEL; w++)
+        {
+            uint32_t word = 0;
+            for (int k = 0; k < 4; k++)
+            {
+                int bit = 31 - (w * 4 + k); // 送るビット (G7 = 31 から)
+                uint32_t pins = 0;
+                for (int lane = 0; lane < lanes; lane++)
+                {
+                    pins |= ((src[lane * stride + i] >> bit) & 1) << lane;
+                }
+                word = word << 8 | pins;
+            }
+            dst[i * WS2812_PARALLEL_WORDS_PER_PIXEL + w] = word;
+        }
+    }
+}
+
+// 1 秒あたりに並べ替えられる LED の数
+static double bench(void (*transpose)(const uint32_t *, int, int, int, uint32_t *), int lanes, int length)
+{
+    long frames = 0;
+    double start = now_sec(), elapsed;
+    do
+    {
+        pixels[frames % (lanes * length)] = (uint32_t)frames; // 入力が毎回同じにならないようにする
+        transpose(pixels, length, lanes, length, planes);
+        frames++;
+        elapsed = now_sec() - start;
+    } while (elapsed < BENCH_SEC);
+    volatile uint32_t sink = planes[frames % length]; // 並べ替えが最適化で消えないようにする
+    (void)sink;
+    return (double)frames * lanes * length / elapsed;
+}
+
+int main(void)
+{
+    int failures = check_transpose();
+
+    const int length = 300;
+    printf("driver, %d LEDs per strip (virtual time):\n", length);
+    printf("%6s %10s %14s %12s %7s\n", "lanes", "frame us", "LEDs/s", "vs 1 lane", "check");
+    double single = 0;
+    for (int lanes = 1; lanes <= WS2812_PARALLEL_MAX_LANES; lanes *= 2)
+    {
+        double rate = run_driver(lanes, length, 20);
+        single = lanes == 1 ? rate : single;
+        printf("%6d %10lu %14.0f %11.1fx %7s\n", lanes, (unsigned long)ws2812_frame_us(length), rate,
+               rate / single, rate > 0 ? "ok" : "FAIL");
+        failures += rate <= 0;
+    }
+
+    printf("transpose speed (%d LEDs per strip):\n", length);
+    printf("%6s %16s %16s %8s %18s\n", "lanes", "kernel LEDs/s", "naive LEDs/s", "speedup", "frame time used");
+    for (int lanes = 1; lanes <= WS2812_PARALLEL_MAX_LANES; lanes *= 2)
+    {
+        double fast = bench(ws2812_transpose, lanes, length);
+        double naive = bench(transpose_naive, lanes, length);
+        double used = 100.0 * lanes * length / fast / (ws2812_frame_us(length) * 1e-6); // 1 フレームの送信時間に対する並べ替えの時間
+        printf("%6d %14.1f M %14.1f M %7.1fx %17.2f%%\n", lanes, fast * 1e-6, naive * 1e-6, fast / naive, used);
+    }
+    return failures != 0;
+}
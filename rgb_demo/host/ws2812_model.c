@@ -0,0 +1,222 @@
+#include <stdio.h>        // 標準入出力ライブラリ
+#include <stdlib.h>       // strtol
+#include <unistd.h>       // getopt
+#include "host_util.h"    // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "ws2812_strip.h" // WS2812 ストリップのドライバ (rgb_demo と同じソース)
+
+// WS2812 ストリップのドライバをホストで動かし、LED が受け取る色と達成できるフレームレートを確かめる
+//
+// 使い方: ws2812_model [-n frames] [-r render_ns]
+//   -n  ストリップの長さごとに送るフレーム数 (既定 50)
+//   -r  1 個の LED の色を計算する時間 [ns] (既定 1000。実機の hsv_to_rgb() の目安)
+//
+// 1. ws2812_pack() の値が以前の ws2812_send_pixel() の形式 ((G << 16 | R << 8 | B) << 8) と一致することを確かめる。
+// 2. 送信は ws2812.pio のとおりに波形を作る: 32 ビットの要素の上位から 24 ビット (autopull) を 1 ビットずつ、
+//    Low T3 → High T1 → (1 なら High、0 なら Low) T2 のサイクルで出す (1 サイクル = 1 / (800kHz × 10))。
+//    LED 側は High の幅で 0 と 1 を判定し (データシートの T0H・T1H の範囲)、先頭から 24 ビットずつ受け取る。
+//    前のフレームのビットの送出から RESET 時間が過ぎないうちに次のフレームが始まると、ラッチできなかったと数える。
+// 3. 仮想時刻で「色の計算 → ws2812_strip_show()」を繰り返し、LED の色が設定した色と一致すること、
+//    ラッチの失敗がないことを確かめ、フレームレートを以前の方式 (1 個ずつ pio_sm_put_blocking()) と比べる。
+
+#define T1 3 // ws2812.pio と同じ
+#define T2 3
+#define T3 4
+#define CYCLE_NS (1000000000u / (WS2812_FREQ * (T1 + T2 + T3))) // PIO の 1 サイクル [ns]
+#define FIFO_WORDS 8       // 結合した送信 FIFO の段数 (DMA はこの分だけ早く終わる)
+#define DATASHEET_RESET_US 280 // WS2812B-V5 のラッチに必要な Low の時間 [us]
+#define MAX_LEDS 1000
+
+// ホストの PIO・DMA と LED の列
+typedef struct
+{
+    uint64_t clock_ns;        // 仮想時刻
+    uint64_t line_free_ns;    // 前のフレームのビットの送出が終わる時刻
+    uint64_t dma_done_ns;     // 前のフレームの DMA 転送が終わる時刻
+    bool started;             // 1 フレーム以上送った
+    uint8_t shown[MAX_LEDS][3]; // LED が受け取った色 (R, G, B)
+    int received;             // 最後のフレームで色を受け取った LED の数
+    int latch_failures;       // RESET 時間が足りずにラッチできなかったフレーム数
+    int pulse_errors;         // High の幅がデータシートの範囲外だったビットの数
+} host_strip;
+
+// 1 ビット分の波形を出し、LED 側が判定した値を返す (範囲外なら -1)
+static int send_bit(int bit)
+{
+    uint32_t high_ns = (T1 + (bit ? T2 : 0)) * CYCLE_NS;
+    uint32_t period_ns = (T1 + T2 + T3) * CYCLE_NS;
+    if (period_ns < 650 || period_ns > 1850) // 1 ビットの周期 1.25us ± 600ns
+    {
+        return -1;
+    }
+    if (high_ns >= 250 && high_ns <= 550) // T0H 0.4us ± 150ns
+    {
+        return 0;
+    }
+    if (high_ns >= 650 && high_ns <= 950) // T1H 0.8us ± 150ns
+    {
+        return 1;
+    }
+    return -1;
+}
+
+static void host_start(void *ctx, const uint32_t *words, int count)
+{
+    host_strip *h = ctx;
+    if (h->started && h->clock_ns < h->line_free_ns + DATASHEET_RESET_US * 1000ull)
+    {
+        h->latch_failures++; // 前のフレームの続きとして受け取られてしまう
+    }
+
+    // LED は先頭から順に 24 ビットずつ受け取り、残りを次の LED に送る
+    h->received = 0;
+    for (int i = 0; i < count && i < MAX_LEDS; i++)
+    {
+        uint32_t value = 0;
+        for (int b = 31; b >= 32 - WS2812_BITS_PER_PIXEL; b--) // 左シフトで上位から出す
+        {
+            int bit = send_bit((words[i] >> b) & 1);
+            if (bit < 0)
+            {
+                h->pulse_errors++;
+                bit = 0;
+            }
+            value = value << 1 | bit;
+        }
+        h->shown[i][0] = value >> 8;  // R
+        h->shown[i][1] = value >> 16; // G
+        h->shown[i][2] = value;       // B
+        h->received++;
+    }
+
+    uint64_t bits_ns = (uint64_t)count * WS2812_PIXEL_NS;
+    h->line_free_ns = h->clock_ns + bits_ns;
+    h->dma_done_ns = h->clock_ns + (count > FIFO_WORDS ? (uint64_t)(count - FIFO_WORDS) * WS2812_PIXEL_NS : 0);
+    h->started = true;
+}
+
+static void host_wait(void *ctx)
+{
+    host_strip *h = ctx;
+    h->clock_ns = h->clock_ns > h->dma_done_ns ? h->clock_ns : h->dma_done_ns;
+}
+
+static uint64_t host_now_us(void *ctx)
+{
+    host_strip *h = ctx;
+    return h->clock_ns / 1000;
+}
+
+static void host_sleep_until(void *ctx, uint64_t time_us)
+{
+    host_strip *h = ctx;
+    if (h->clock_ns < time_us * 1000)
+    {
+        h->clock_ns = time_us * 1000;
+    }
+}
+
+// ws2812_pack() を以前の ws2812_send_pixel() の形式と比べる。一致しない数を返す
+static int check_pack(void)
+{
+    int errors = 0;
+    for (int i = 0; i < 100000; i++)
+    {
+        uint8_t r = rng(), g = rng(), b = rng();
+        uint32_t legacy = ((uint32_t)g << 16 | (uint32_t)r << 8 | b) << 8u;
+        errors += ws2812_pack(r, g, b) != legacy;
+    }
+    return errors;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = 50;
+    uint32_t render_ns = 1000;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            frames = (int)strtol(optarg, NULL, 0);
+            break;
+        case 'r':
+            render_ns = (uint32_t)strtol(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n frames] [-r render_ns]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (frames <= 0)
+    {
+        fprintf(stderr, "usage: %s [-n frames] [-r render_ns]\n", argv[0]);
+        return 2;
+    }
+
+    int pack_errors = check_pack();
+    printf("ws2812_pack: %s\n", pack_errors ? "MISMATCH with the legacy GRB << 8 format" : "matches the legacy GRB << 8 format");
+
+    static const int lengths[] = {1, 8, 30, 60, 144, 300, 600, 1000};
+    static uint32_t words[WS2812_STRIP_WORDS(MAX_LEDS)];
+    static uint8_t expected[MAX_LEDS][3];
+    int failures = pack_errors;
+
+    printf("render %lu ns/LED, %d frames per length, reset %d us\n", (unsigned long)render_ns, frames, WS2812_RESET_US);
+    printf("%6s %10s %9s %14s %14s %9s %7s\n", "LEDs", "frame us", "max fps", "DMA fps", "blocking fps", "CPU free", "check");
+    for (size_t k = 0; k < sizeof lengths / sizeof lengths[0]; k++)
+    {
+        int count = lengths[k];
+        static host_strip h;
+        h = (host_strip){0};
+        const ws2812_transport transport = {
+            .start = host_start,
+            .wait = host_wait,
+            .now_us = host_now_us,
+            .sleep_until = host_sleep_until,
+            .ctx = &h,
+        };
+        ws2812_strip strip;
+        ws2812_strip_init(&strip, &transport, words, count);
+
+        int mismatches = 0;
+        uint64_t start_ns = h.clock_ns;
+        for (int f = 0; f < frames; f++)
+        {
+            // 色の計算 (送信中の前のフレームと並行して、もう一方のバッファに書き込む)
+            for (int i = 0; i < count; i++)
+            {
+                expected[i][0] = rng();
+                expected[i][1] = rng();
+                expected[i][2] = rng();
+                ws2812_strip_set_pixel(&strip, i, expected[i][0], expected[i][1], expected[i][2]);
+            }
+            h.clock_ns += (uint64_t)count * render_ns;
+            ws2812_strip_show(&strip);
+
+            mismatches += h.received != count;
+            for (int i = 0; i < h.received; i++)
+            {
+                mismatches += expected[i][0] != h.shown[i][0] || expected[i][1] != h.shown[i][1] || expected[i][2] != h.shown[i][2];
+            }
+        }
+        ws2812_strip_wait(&strip);
+        double elapsed_us = (h.clock_ns - start_ns) * 1e-3;
+
+        uint32_t frame_us = ws2812_frame_us(count);
+        double render_us = count * render_ns * 1e-3;
+        double dma_fps = frames * 1e6 / elapsed_us;
+        double blocking_fps = 1e6 / (render_us + frame_us); // 送信中は CPU が pio_sm_put_blocking() で待つ
+        double cpu_free = 100.0 * (1.0 - render_us * dma_fps * 1e-6);
+        bool ok = mismatches == 0 && h.latch_failures == 0 && h.pulse_errors == 0;
+        printf("%6d %10lu %9.1f %14.1f %14.1f %8.1f%% %7s\n", count, (unsigned long)frame_us, 1e6 / frame_us,
+               dma_fps, blocking_fps, cpu_free, ok ? "ok" : "FAIL");
+        if (!ok)
+        {
+            printf("       %d color mismatches, %d latch failures, %d pulse errors\n",
+                   mismatches, h.latch_failures, h.pulse_errors);
+            failures++;
+        }
+    }
+    return failures != 0;
+}
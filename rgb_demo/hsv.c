@@ -0,0 +1,174 @@
+#include <math.h>         // fmodf, floorf (浮動小数点版のみ)
+#include "hsv.h"          // HSV から RGB への変換
+#include "ws2812_strip.h" // ws2812_pack()
+
+// round(255 × (i / 255) ^ 2.8) (host/hsv_bench で pow() の値と照合している)
+const uint8_t hsv_gamma8[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      2,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   5,   5,   5,
+      5,   6,   6,   6,   6,   7,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,
+     10,  10,  11,  11,  11,  12,  12,  13,  13,  13,  14,  14,  15,  15,  16,  16,
+     17,  17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  22,  23,  24,  24,  25,
+     25,  26,  27,  27,  28,  29,  29,  30,  31,  32,  32,  33,  34,  35,  35,  36,
+     37,  38,  39,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  50,
+     51,  52,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  66,  67,  68,
+     69,  70,  72,  73,  74,  75,  77,  78,  79,  81,  82,  83,  85,  86,  87,  89,
+     90,  92,  93,  95,  96,  98,  99, 101, 102, 104, 105, 107, 109, 110, 112, 114,
+    115, 117, 119, 120, 122, 124, 126, 127, 129, 131, 133, 135, 137, 138, 140, 142,
+    144, 146, 148, 150, 152, 154, 156, 158, 160, 162, 164, 167, 169, 171, 173, 175,
+    177, 180, 182, 184, 186, 189, 191, 193, 196, 198, 200, 203, 205, 208, 210, 213,
+    215, 218, 220, 223, 225, 228, 231, 233, 236, 239, 241, 244, 247, 249, 252, 255,
+};
+
+// 関数: HSV (Hue:色相, Saturation:彩度, Value:明度) カラーモデルを RGB (Red:赤, Green:緑, Blue:青) カラーモデルに変換します
+// h: 色相 (0-360度の範囲)
+// s: 彩度 (0.0-1.0 の範囲)
+// v: 明度 (0.0-1.0 の範囲)
+// *r, *g, *b: 変換された赤、緑、青の値を格納するポインタ (0-255 の範囲)
+void hsv_to_rgb(float h, float s, float v, uint8_t *r, uint8_t *g, uint8_t *b)
+{
+    // 彩度が 0 の場合、色はグレーになります
+    if (s == 0.0f)
+    {
+        *r = *g = *b = (uint8_t)(v * 255.0f); // 明度をスケールして RGB 全てに同じ値を設定
+    }
+    else
+    {
+        // 色相を 0-360度の範囲に調整
+        float hue = fmodf(h, 360.0f);
+        if (hue < 0)
+        {
+            hue += 360.0f;
+        }
+        // 色相を 6 つのセクターに分割 (各 60 度)
+        float sector = hue / 60.0f;
+        // 現在のセクターの整数部分
+        int i = floorf(sector);
+        // セクター内の小数部分
+        float f = sector - i;
+        // 一時的な計算用変数
+        float p = v * (1 - s);
+        float q = v * (1 - s * f);
+        float t = v * (1 - s * (1 - f));
+
+        // セクターに応じて RGB の値を計算
+        switch (i)
+        {
+        case 0: // 赤から黄色
+            *r = (uint8_t)(v * 255.0f);
+            *g = (uint8_t)(t * 255.0f);
+            *b = (uint8_t)(p * 255.0f);
+            break;
+        case 1: // 黄色から緑
+            *r = (uint8_t)(q * 255.0f);
+            *g = (uint8_t)(v * 255.0f);
+            *b = (uint8_t)(p * 255.0f);
+            break;
+        case 2: // 緑からシアン
+            *r = (uint8_t)(p * 255.0f);
+            *g = (uint8_t)(v * 255.0f);
+            *b = (uint8_t)(t * 255.0f);
+            break;
+        case 3: // シアンから青
+            *r = (uint8_t)(p * 255.0f);
+            *g = (uint8_t)(q * 255.0f);
+            *b = (uint8_t)(v * 255.0f);
+            break;
+        case 4: // 青からマゼンタ
+            *r = (uint8_t)(t * 255.0f);
+            *g = (uint8_t)(p * 255.0f);
+            *b = (uint8_t)(v * 255.0f);
+            break;
+        default: // マゼンタから赤
+            *r = (uint8_t)(v * 255.0f);
+            *g = (uint8_t)(p * 255.0f);
+            *b = (uint8_t)(q * 255.0f);
+            break;
+        }
+    }
+}
+
+void hsv_to_rgb8(uint16_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b)
+{
+    if (h >= HSV_HUE_MAX)
+    {
+        h %= HSV_HUE_MAX;
+    }
+    // 上位ビットがセクター (各 60 度)、下位 8 ビットがセクター内の位置 f (f / 256 が浮動小数点版の小数部分)
+    uint32_t sector = h >> 8;
+    uint32_t f = h & 0xff;
+
+    // 浮動小数点版の p, q, t に 255 を掛けて切り捨てた値。分母は定数なので除算は乗算とシフトになる
+    uint8_t p = v * (255u - s) / 255u;
+    uint8_t q = v * (255u * 256u - s * f) / (255u * 256u);
+    uint8_t t = v * (255u * 256u - s * (256u - f)) / (255u * 256u);
+
+    switch (sector)
+    {
+    case 0: // 赤から黄色
+        *r = v;
+        *g = t;
+        *b = p;
+        break;
+    case 1: // 黄色から緑
+        *r = q;
+        *g = v;
+        *b = p;
+        break;
+    case 2: // 緑からシアン
+        *r = p;
+        *g = v;
+        *b = t;
+        break;
+    case 3: // シアンから青
+        *r = p;
+        *g = q;
+        *b = v;
+        break;
+    case 4: // 青からマゼンタ
+        *r = t;
+        *g = p;
+        *b = v;
+        break;
+    default: // マゼンタから赤
+        *r = v;
+        *g = p;
+        *b = q;
+        break;
+    }
+}
+
+void hsv_to_rgb_n(const hsv *colors, uint32_t *pixels, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        uint8_t r, g, b;
+        hsv_to_rgb8(colors[i].h, colors[i].s, colors[i].v, &r, &g, &b);
+        pixels[i] = ws2812_pack(hsv_gamma8[r], hsv_gamma8[g], hsv_gamma8[b]);
+    }
+}
+
+void hsv_rainbow_n(uint32_t *pixels, int count, uint16_t hue, uint16_t span, uint8_t s, uint8_t v)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    // 色相を 16 ビットの小数部を持つ固定小数点で進める (count で割るのは最初の 1 回だけ)
+    const uint32_t wrap = (uint32_t)HSV_HUE_MAX << 16;
+    uint32_t step = ((uint32_t)span << 16) / count;
+    uint32_t acc = (uint32_t)(hue % HSV_HUE_MAX) << 16;
+    for (int i = 0; i < count; i++)
+    {
+        uint8_t r, g, b;
+        hsv_to_rgb8(acc >> 16, s, v, &r, &g, &b);
+        pixels[i] = ws2812_pack(hsv_gamma8[r], hsv_gamma8[g], hsv_gamma8[b]);
+        acc += step;
+        if (acc >= wrap)
+        {
+            acc -= wrap;
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef HSV_H
+#define HSV_H
+
+#include <stdint.h> // 固定幅整数型
+
+// HSV (Hue:色相, Saturation:彩度, Value:明度) から RGB への変換
+//
+// 整数版は色相を 0〜1535 (6 つのセクター × 256)、彩度と明度を 0〜255 で表し、浮動小数点演算を使わない。
+// 各セクター内の位置は色相の下位 8 ビットなので、セクターを求める除算も fmodf / floorf も不要になる。
+// ストリップ全体をまとめて変換する関数は、ガンマ補正をして ws2812_pack() の形式で表示バッファに書き込む。
+
+#define HSV_HUE_MAX 1536                          // 色相の範囲 (0〜HSV_HUE_MAX - 1)
+#define HSV_HUE_DEGREES(deg) ((deg) * HSV_HUE_MAX / 360) // 角度 (度) を色相の値に変換する
+#define HSV_GAMMA 2.8                             // hsv_gamma8 のガンマ値
+
+// 整数の HSV 色
+typedef struct
+{
+    uint16_t h; // 色相 (0〜1535。それ以上は 1536 で割った余り)
+    uint8_t s;  // 彩度 (0〜255)
+    uint8_t v;  // 明度 (0〜255)
+} hsv;
+
+// ガンマ補正の表: round(255 × (i / 255) ^ HSV_GAMMA)
+// LED の明るさは PWM のデューティ比に比例するが、人の目には暗い側の変化が大きく見えるので、
+// 明度やグラデーションを目で見て均等に変化させるために使う
+extern const uint8_t hsv_gamma8[256];
+
+// HSV を RGB に変換する (浮動小数点版)
+// h: 色相 (度、範囲外は 360 で割った余り), s: 彩度 (0.0-1.0), v: 明度 (0.0-1.0), *r, *g, *b: 0-255
+void hsv_to_rgb(float h, float s, float v, uint8_t *r, uint8_t *g, uint8_t *b);
+
+// HSV を RGB に変換する (整数版、ガンマ補正なし)。浮動小数点版と同じ式を整数で計算する
+void hsv_to_rgb8(uint16_t h, uint8_t s, uint8_t v, uint8_t *r, uint8_t *g, uint8_t *b);
+
+// count 個の HSV 色をガンマ補正した RGB に変換し、ws2812_pack() の形式で pixels に書き込む
+void hsv_to_rgb_n(const hsv *colors, uint32_t *pixels, int count);
+
+// 色相を hue から span だけ均等にずらした count 個の色 (虹色のグラデーション) を hsv_to_rgb_n() と同じ形式で書き込む
+// i 番目の色相は hue + span × i / count (HSV 色の配列を用意せずに済む)
+void hsv_rainbow_n(uint32_t *pixels, int count, uint16_t hue, uint16_t span, uint8_t s, uint8_t v);
+
+#endif // HSV_H
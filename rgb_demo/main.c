@@ -1,93 +1,50 @@
 #include <stdio.h>           // 標準入出力ライブラリ（printf などを使うため）
-#include <math.h>            // 数学関数ライブラリ（sin, cos などを使う場合がある。ここでは fmodf, floorf を使用）
 #include "pico/stdlib.h"     // PICO SDK の基本的な機能を使うためのヘッダファイル
 #include "hardware/pio.h"    // PICO の Programmable I/O (PIO) 機能を使うためのヘッダファイル
 #include "hardware/clocks.h" // PICO のクロック制御機能を使うためのヘッダファイル
 #include "ws2812.pio.h"      // WS2812 (RGB LED) を制御するための PIO プログラムのヘッダファイル
+#include "ws2812_strip.h"    // 複数の WS2812 をつないだストリップのドライバ (DMA で送信)
+#include "ws2812_pico.h"     // ストリップのドライバの実機向けの PIO と DMA
+#include "ws2812_parallel.h" // 最大 8 本のストリップへの同時送信
+#include "hsv.h"             // HSV から RGB への変換 (整数版とストリップ全体の一括変換)
+#include "animation.h"       // パレットを使うアニメーション (グラデーション・呼吸・チェイス)
 
 // 設定: RGBW（ホワイト）チャンネルを持つLEDを使うかどうか。ここでは使わないので false
 #define IS_RGBW false
 // 設定: WS2812 のデータ信号を接続する GPIO ピンの番号
 #define WS2812_PIN 22
+// 設定: ストリップにつないだ LED の数 (基板上の LED 1 個だけなら 1)
+#define NUM_PIXELS 60
+// 設定: 同時に送るストリップの数 (1〜8)。2 以上なら ws2812_parallel プログラムで WS2812_PARALLEL_PIN から連続したピンに出力します
+#define NUM_STRIPS 1
+// 設定: 2 本以上のときのストリップ 0 のデータ信号を接続する GPIO ピンの番号 (ストリップ n は WS2812_PARALLEL_PIN + n)
+#define WS2812_PARALLEL_PIN 2
+// アニメーションを描く LED の数 (複数のストリップは続けて 1 本のストリップとして描きます)
+#define TOTAL_PIXELS (NUM_STRIPS * NUM_PIXELS)
+// 設定: アニメーションの 1 フレームの時間 [us] (20000us = 50fps)
+#define FRAME_US 20000
+// 設定: 描画時間の統計を表示する間隔 [フレーム]
+#define STATS_INTERVAL 250
 
-// 関数: HSV (Hue:色相, Saturation:彩度, Value:明度) カラーモデルを RGB (Red:赤, Green:緑, Blue:青) カラーモデルに変換します
-// h: 色相 (0-360度の範囲)
-// s: 彩度 (0.0-1.0 の範囲)
-// v: 明度 (0.0-1.0 の範囲)
-// *r, *g, *b: 変換された赤、緑、青の値を格納するポインタ (0-255 の範囲)
-void hsv_to_rgb(float h, float s, float v, uint8_t *r, uint8_t *g, uint8_t *b)
-{
-    // 彩度が 0 の場合、色はグレーになります
-    if (s == 0.0f)
-    {
-        *r = *g = *b = (uint8_t)(v * 255.0f); // 明度をスケールして RGB 全てに同じ値を設定
-    }
-    else
-    {
-        // 色相を 0-360度の範囲に調整
-        float hue = fmodf(h, 360.0f);
-        if (hue < 0)
-        {
-            hue += 360.0f;
-        }
-        // 色相を 6 つのセクターに分割 (各 60 度)
-        float sector = hue / 60.0f;
-        // 現在のセクターの整数部分
-        int i = floorf(sector);
-        // セクター内の小数部分
-        float f = sector - i;
-        // 一時的な計算用変数
-        float p = v * (1 - s);
-        float q = v * (1 - s * f);
-        float t = v * (1 - s * (1 - f));
+#if NUM_STRIPS > 1
+// 表示バッファとビットプレーン 2 つ分 (一方を DMA で送信している間にもう一方へ並べ替える)
+static uint32_t strip_words[WS2812_PARALLEL_PIXEL_WORDS(NUM_STRIPS, NUM_PIXELS)];
+static uint32_t plane_words[WS2812_PARALLEL_PLANE_WORDS(NUM_PIXELS)];
+static ws2812_parallel strips;
+#else
+// 表示バッファ 2 つ分 (一方を DMA で送信している間にもう一方に次のフレームを書き込む)
+static uint32_t strip_words[WS2812_STRIP_WORDS(NUM_PIXELS)];
+static ws2812_strip strip;
+#endif
 
-        // セクターに応じて RGB の値を計算
-        switch (i)
-        {
-        case 0: // 赤から黄色
-            *r = (uint8_t)(v * 255.0f);
-            *g = (uint8_t)(t * 255.0f);
-            *b = (uint8_t)(p * 255.0f);
-            break;
-        case 1: // 黄色から緑
-            *r = (uint8_t)(q * 255.0f);
-            *g = (uint8_t)(v * 255.0f);
-            *b = (uint8_t)(p * 255.0f);
-            break;
-        case 2: // 緑からシアン
-            *r = (uint8_t)(p * 255.0f);
-            *g = (uint8_t)(v * 255.0f);
-            *b = (uint8_t)(t * 255.0f);
-            break;
-        case 3: // シアンから青
-            *r = (uint8_t)(p * 255.0f);
-            *g = (uint8_t)(q * 255.0f);
-            *b = (uint8_t)(v * 255.0f);
-            break;
-        case 4: // 青からマゼンタ
-            *r = (uint8_t)(t * 255.0f);
-            *g = (uint8_t)(p * 255.0f);
-            *b = (uint8_t)(v * 255.0f);
-            break;
-        default: // マゼンタから赤
-            *r = (uint8_t)(v * 255.0f);
-            *g = (uint8_t)(p * 255.0f);
-            *b = (uint8_t)(q * 255.0f);
-            break;
-        }
-    }
-}
+// タイマー割り込みから次のフレームの時刻になったことを知らせる
+static volatile bool frame_due;
 
-// 関数: RGB のデータを WS2812 LED に送信します
-// pio: 使用する PIO コントローラのインスタンス
-// sm: 使用するステートマシンの番号
-// r, g, b: 赤、緑、青の色の値 (0-255 の範囲)
-void ws2812_send_pixel(PIO pio, uint sm, uint8_t r, uint8_t g, uint8_t b)
+// 関数: フレームの周期ごとに呼ばれるタイマーのコールバック (割り込みの中で実行されるので、フラグを立てるだけにします)
+static bool frame_timer_callback(repeating_timer_t *rt)
 {
-    // WS2812 は GRB の順で色データを受け取るため、ここで順番を入れ替えて 32bit のデータを作成
-    uint32_t pixel = ((g << 16) | (r << 8) | b);
-    // PIO ステートマシンにデータを送信 (blocking なので送信完了まで待ちます)
-    pio_sm_put_blocking(pio, sm, pixel << 8u); // 8bit 左シフトすることで、PIO プログラムのデータ形式に合わせます
+    frame_due = true;
+    return true; // 繰り返す
 }
 
 int main()
@@ -99,6 +56,13 @@ int main()
     // 使用するステートマシンの番号 (各 PIO コントローラには複数のステートマシンがあります)
     uint sm = 0;
 
+#if NUM_STRIPS > 1
+    // 並列出力の PIO プログラムをロードし、WS2812_PARALLEL_PIN から NUM_STRIPS 本のピンに出力するように初期化します
+    uint offset = pio_add_program(pio, &ws2812_parallel_program);
+    ws2812_parallel_program_init(pio, sm, offset, WS2812_PARALLEL_PIN, NUM_STRIPS, WS2812_FREQ);
+    // ドライバを初期化します (ステートマシンの送信 FIFO に書き込む DMA チャンネルを確保し、全 LED を消灯にします)
+    ws2812_parallel_init(&strips, ws2812_pico_transport_init(pio, sm), strip_words, plane_words, NUM_STRIPS, NUM_PIXELS);
+#else
     // WS2812 を制御するための PIO プログラムをロードし、そのオフセット (メモリ上の位置) を取得します
     uint offset = pio_add_program(pio, &ws2812_program);
     // ロードした PIO プログラムを初期化します
@@ -106,52 +70,92 @@ int main()
     // sm: 使用するステートマシン
     // offset: ロードしたプログラムのオフセット
     // WS2812_PIN: データピン
-    // 800000: WS2812 の通信速度 (800kHz)
+    // WS2812_FREQ: WS2812 の通信速度 (800kHz)
     // IS_RGBW: RGBW モードかどうか
-    ws2812_program_init(pio, sm, offset, WS2812_PIN, 800000, IS_RGBW);
+    ws2812_program_init(pio, sm, offset, WS2812_PIN, WS2812_FREQ, IS_RGBW);
+
+    // ストリップのドライバを初期化します (ステートマシンの送信 FIFO に書き込む DMA チャンネルを確保し、全 LED を消灯にします)
+    ws2812_strip_init(&strip, ws2812_pico_transport_init(pio, sm), strip_words, NUM_PIXELS);
+#endif
+
+    // グラデーションの基準となる色相 (Hue) を定義します (0-1535 の範囲。HSV_HUE_DEGREES() で角度から変換)。
+    // ここでは、赤(0), 黄(60), 緑(120), シアン(180), 青(240), マゼンタ(300) を基準とし、パレットに等間隔に並べます。
+    // 彩度と明度は 255 (最大) です。キーフレームの間の色は起動時にパレット (256 色の表) に補間しておきます
+    static const anim_keyframe rainbow_keys[] = {
+        {0, {HSV_HUE_DEGREES(0), 255, 255}},
+        {43, {HSV_HUE_DEGREES(60), 255, 255}},
+        {85, {HSV_HUE_DEGREES(120), 255, 255}},
+        {128, {HSV_HUE_DEGREES(180), 255, 255}},
+        {171, {HSV_HUE_DEGREES(240), 255, 255}},
+        {213, {HSV_HUE_DEGREES(300), 255, 255}},
+    };
+    // 呼吸させる区間の色 (赤 → 橙 → 黄 → 赤)
+    static const anim_keyframe warm_keys[] = {
+        {0, {HSV_HUE_DEGREES(0), 255, 255}},
+        {96, {HSV_HUE_DEGREES(25), 255, 255}},
+        {176, {HSV_HUE_DEGREES(50), 200, 255}},
+    };
+    static anim_palette rainbow, warm;
+    anim_palette_build(&rainbow, rainbow_keys, sizeof(rainbow_keys) / sizeof(rainbow_keys[0]));
+    anim_palette_build(&warm, warm_keys, sizeof(warm_keys) / sizeof(warm_keys[0]));
+
+    // エフェクトを登録します (追加した順に描くので、チェイスは前の 2 つの上に重なります)
+    // speed と spread は 256 が 1 の固定小数点です
+    static animation anim;
+    animation_init(&anim, time_us_64);
+    // 前の 2/3: 虹色を 1 周並べ、約 3 秒でパレットを 1 周流す
+    animation_add(&anim, &(anim_effect){
+        .type = ANIM_GRADIENT, .first = 0, .count = TOTAL_PIXELS * 2 / 3, .palette = &rainbow,
+        .speed = 65536 * FRAME_US / 3000000, .spread = 65536 / (TOTAL_PIXELS * 2 / 3),
+    });
+    // 後ろの 1/3: 暖色を並べ、4 秒周期で明るさを上下させる
+    animation_add(&anim, &(anim_effect){
+        .type = ANIM_BREATHE, .first = TOTAL_PIXELS * 2 / 3, .count = TOTAL_PIXELS - TOTAL_PIXELS * 2 / 3, .palette = &warm,
+        .speed = 65536 * FRAME_US / 4000000, .spread = 65536 / (TOTAL_PIXELS - TOTAL_PIXELS * 2 / 3),
+    });
+    // ストリップ全体: 長さ 8 の尾を引く点が 1 フレームに 0.5 個ずつ進む
+    animation_add(&anim, &(anim_effect){
+        .type = ANIM_CHASE, .first = 0, .count = TOTAL_PIXELS, .palette = &rainbow,
+        .speed = 128, .spread = 65536 / TOTAL_PIXELS, .length = 8,
+    });
 
-    // グラデーションの基準となる色相 (Hue) を定義します (0-360度の範囲)。
-    // ここでは、赤(0), 黄(60), 緑(120), シアン(180), 青(240), マゼンタ(300) を基準としています。
-    const float colors_hsv[] = {0.0f, 60.0f, 120.0f, 180.0f, 240.0f, 300.0f};
-    // 定義した色相の数を計算
-    const int num_hues = sizeof(colors_hsv) / sizeof(colors_hsv[(0)]);
-    // 現在表示している基準色のインデックス
-    int current_hue_index = 0;
-    // 彩度 (色の鮮やかさ)。1.0 で最大の色鮮やかさになります。
-    const float saturation = 1.0f;
-    // 明度 (色の明るさ)。1.0 で最大の明るさになります。
-    const float value = 1.0f;
-    // グラデーションのステップ数。この数が多いほど滑らかなグラデーションになりますが、変化が遅くなります。
-    const int gradient_steps = 100;
-    // グラデーションの各ステップ間の遅延時間 (ミリ秒)。この値が小さいほど変化が速くなります。
-    const uint32_t gradient_delay = 5;
+    // フレームの周期でハードウェアタイマーを繰り返し起動します
+    // 遅延を負の値で指定すると、コールバックの処理時間によらず前回の予定時刻から FRAME_US ごとに呼ばれます
+    static repeating_timer_t frame_timer;
+    uint64_t start_us = time_us_64();
+    add_repeating_timer_us(-FRAME_US, frame_timer_callback, NULL, &frame_timer);
 
     // 無限ループ
     while (1)
     {
-        // 現在の基準色の色相を取得
-        float start_hue = colors_hsv[current_hue_index];
-        // 次の基準色のインデックスを計算 (配列の最後まできたら最初に戻る)
-        int next_hue_index = (current_hue_index + 1) % num_hues;
-        // 次の基準色の色相を取得
-        float end_hue = colors_hsv[next_hue_index];
-
-        // 現在の色から次の色へ、色相を滑らかに変化させてグラデーション表示
-        for (int i = 0; i <= gradient_steps; ++i)
+        // 次のフレームの時刻になるまで待つ
+        while (!frame_due)
         {
-            // 現在のグラデーションステップにおける色相を計算
-            float current_hue = start_hue + (end_hue - start_hue) * i / gradient_steps;
-            // HSV を RGB に変換
-            uint8_t r, g, b;
-            hsv_to_rgb(current_hue, saturation, value, &r, &g, &b);
-            // 変換した RGB 値を LED に送信
-            ws2812_send_pixel(pio, sm, r, g, b);
-            // グラデーションの速度を調整するための遅延
-            sleep_ms(gradient_delay);
+            tight_loop_contents();
         }
+        frame_due = false;
+
+        // フレーム番号は開始からの経過時間で決めます (ループの処理時間が積み重なって遅れることはありません)
+        // 描画が間に合わなかったときは、その分のフレームを飛ばして時刻に追いつきます
+        uint32_t frame = (uint32_t)((time_us_64() - start_us) / FRAME_US);
+#if NUM_STRIPS > 1
+        // 表示バッファにフレームを描き、ビットプレーンに並べ替えて DMA で全ストリップに同時に送信します
+        animation_render(&anim, ws2812_parallel_pixels(&strips, 0), TOTAL_PIXELS, frame);
+        ws2812_parallel_show(&strips);
+#else
+        // 送信中でない方のバッファにフレームを描き、DMA で送信します
+        animation_render(&anim, ws2812_strip_pixels(&strip), NUM_PIXELS, frame);
+        ws2812_strip_show(&strip);
+#endif
 
-        // 次のグラデーションのために現在の基準色のインデックスを更新
-        current_hue_index = next_hue_index;
+        // 描画時間の統計を表示
+        const anim_stats *st = animation_get_stats(&anim);
+        if (st->frames % STATS_INTERVAL == 0)
+        {
+            printf("frames %lu skipped %lu render last %lu us max %lu us avg %lu us\n",
+                   (unsigned long)st->frames, (unsigned long)st->skipped, (unsigned long)st->render_us,
+                   (unsigned long)st->render_max_us, (unsigned long)(st->render_total_us / st->frames));
+        }
     }
 
     // プログラムが正常に終了した場合の戻り値 (通常は 0)
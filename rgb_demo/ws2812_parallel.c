@@ -0,0 +1,133 @@
+#include <string.h>          // memset
+#include "ws2812_parallel.h" // 複数の WS2812 ストリップへの同時送信
+
+// 8 × 8 ビットの行列を転置する (Hacker's Delight の transpose8)
+// x のバイト r のビット c が、結果のバイト c のビット r になる
+static inline uint64_t transpose8(uint64_t x)
+{
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaull;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000cccc0000ccccull;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ull;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+void ws2812_transpose(const uint32_t *pixels, int stride, int lanes, int count, uint32_t *planes)
+{
+    for (int i = 0; i < count; i++)
+    {
+        // G, R, B それぞれについて、バイト lane にストリップ lane の値を集める
+        uint64_t g = 0, r = 0, b = 0;
+        const uint32_t *p = pixels + i;
+        for (int lane = 0; lane < lanes; lane++, p += stride)
+        {
+            uint32_t word = *p;
+            g |= (uint64_t)(word >> 24) << (8 * lane);
+            r |= (uint64_t)((word >> 16) & 0xff) << (8 * lane);
+            b |= (uint64_t)((word >> 8) & 0xff) << (8 * lane);
+        }
+
+        // 転置するとバイト k がビット k のプレーンになる。上位のバイト (ビット 7) から送るので、そのまま上位 32 ビットが先
+        g = transpose8(g);
+        r = transpose8(r);
+        b = transpose8(b);
+        planes[0] = (uint32_t)(g >> 32);
+        planes[1] = (uint32_t)g;
+        planes[2] = (uint32_t)(r >> 32);
+        planes[3] = (uint32_t)r;
+        planes[4] = (uint32_t)(b >> 32);
+        planes[5] = (uint32_t)b;
+        planes += WS2812_PARALLEL_WORDS_PER_PIXEL;
+    }
+}
+
+void ws2812_parallel_init(ws2812_parallel *p, const ws2812_transport *transport, uint32_t *pixel_words,
+                          uint32_t *plane_words, int lanes, int length)
+{
+    p->transport = transport;
+    p->pixels = pixel_words;
+    p->planes[0] = plane_words;
+    p->planes[1] = plane_words + length * WS2812_PARALLEL_WORDS_PER_PIXEL;
+    p->lanes = lanes;
+    p->length = length;
+    p->back = 0;
+    p->sending = false;
+    p->ready_us = transport->now_us(transport->ctx);
+    p->stats = (ws2812_strip_stats){0};
+    memset(pixel_words, 0, WS2812_PARALLEL_PIXEL_WORDS(lanes, length) * sizeof(uint32_t));
+    memset(plane_words, 0, WS2812_PARALLEL_PLANE_WORDS(length) * sizeof(uint32_t));
+}
+
+void ws2812_parallel_set_pixel(ws2812_parallel *p, int lane, int index, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (lane >= 0 && lane < p->lanes && index >= 0 && index < p->length)
+    {
+        p->pixels[lane * p->length + index] = ws2812_pack(r, g, b);
+    }
+}
+
+void ws2812_parallel_fill(ws2812_parallel *p, uint8_t r, uint8_t g, uint8_t b)
+{
+    uint32_t word = ws2812_pack(r, g, b);
+    int count = p->lanes * p->length;
+    for (int i = 0; i < count; i++)
+    {
+        p->pixels[i] = word;
+    }
+}
+
+void ws2812_parallel_show(ws2812_parallel *p)
+{
+    const ws2812_transport *t = p->transport;
+
+    // 送信中でない方のビットプレーンに並べ替える (前のフレームの送信と並行して)
+    uint32_t *front = p->planes[p->back];
+    ws2812_transpose(p->pixels, p->length, p->lanes, p->length, front);
+
+    // 前のフレームの DMA 転送が終わってから、ビットの送出と RESET が終わる時刻まで待つ
+    if (p->sending)
+    {
+        t->wait(t->ctx);
+    }
+    uint64_t now = t->now_us(t->ctx);
+    if (now < p->ready_us)
+    {
+        p->stats.waits++;
+        p->stats.wait_us += p->ready_us - now;
+        t->sleep_until(t->ctx, p->ready_us);
+        now = p->ready_us;
+    }
+
+    // すべてのストリップが同時に length 個の LED を受け取るので、1 フレームの時間は 1 本のときと同じ
+    t->start(t->ctx, front, p->length * WS2812_PARALLEL_WORDS_PER_PIXEL);
+    p->sending = true;
+    p->ready_us = now + ws2812_frame_us(p->length);
+    p->stats.frames++;
+    p->back ^= 1;
+}
+
+bool ws2812_parallel_is_ready(const ws2812_parallel *p)
+{
+    return p->transport->now_us(p->transport->ctx) >= p->ready_us;
+}
+
+void ws2812_parallel_wait(ws2812_parallel *p)
+{
+    const ws2812_transport *t = p->transport;
+    if (p->sending)
+    {
+        t->wait(t->ctx);
+    }
+    if (t->now_us(t->ctx) < p->ready_us)
+    {
+        t->sleep_until(t->ctx, p->ready_us);
+    }
+}
+
+const ws2812_strip_stats *ws2812_parallel_get_stats(const ws2812_parallel *p)
+{
+    return &p->stats;
+}
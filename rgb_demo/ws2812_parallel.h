@@ -0,0 +1,79 @@
+#ifndef WS2812_PARALLEL_H
+#define WS2812_PARALLEL_H
+
+#include <stdint.h>       // 固定幅整数型
+#include <stdbool.h>      // bool 型
+#include "ws2812_strip.h" // ws2812_pack(), ws2812_transport
+
+// 最大 8 本の WS2812 ストリップに同時に送るドライバ
+//
+// ws2812_parallel PIO プログラムは連続した最大 8 本のピンに、同じビット位置の信号を同時に出す。
+// 1 ビットの時間に FIFO から 8 ビット (1 ビット目がストリップ 0、2 ビット目がストリップ 1 …) を読むので、
+// 各ストリップの色を「ビット位置ごとに 8 本分を 1 バイトに集めた形 (ビットプレーン)」に並べ替えて送る。
+// 1 本の線は 800kHz のままだが、本数の分だけ 1 秒あたりに送れる LED の数が増える。
+//
+// 色は ws2812_strip と同じ ws2812_pack() の形式でストリップごとの表示バッファに書き込み、
+// ws2812_parallel_show() がビットプレーンに並べ替えて DMA で送る。ビットプレーンのバッファは 2 つあり、
+// 一方を送信している間にもう一方へ並べ替える。ストリップの長さはすべて length 個 (短いストリップは
+// 末尾に黒を送り、その分は先の LED がないので捨てられる)。
+//
+// DMA と時計は ws2812_strip と同じ ws2812_transport を使う (実機では ws2812_pico_transport_init())。
+
+#define WS2812_PARALLEL_MAX_LANES 8                                          // 同時に送るストリップの最大数
+#define WS2812_PARALLEL_WORDS_PER_PIXEL (WS2812_BITS_PER_PIXEL * 8 / 32)    // 8 本分の LED 1 個のビットプレーン [32 ビット] (6)
+
+// lanes 本のストリップの LED のうち、index 番目の色 (pixels[lane × stride + index]、ws2812_pack() の形式) を
+// ビットプレーンに並べ替え、planes に count × WS2812_PARALLEL_WORDS_PER_PIXEL 要素書き込む
+// 各要素は上位のバイトから順に送られ、バイトのビット lane がストリップ lane の G7, G6, … B0 になる。
+// lanes 本目以降のビットは 0
+void ws2812_transpose(const uint32_t *pixels, int stride, int lanes, int count, uint32_t *planes);
+
+typedef struct
+{
+    const ws2812_transport *transport; // DMA と時計
+    uint32_t *pixels;                  // 表示バッファ (ストリップ lane の LED は pixels[lane × length]〜)
+    uint32_t *planes[2];               // ビットプレーン (それぞれ length × WS2812_PARALLEL_WORDS_PER_PIXEL 要素)
+    int lanes;                         // ストリップの数 (1〜WS2812_PARALLEL_MAX_LANES)
+    int length;                        // 1 本のストリップの LED の数
+    int back;                          // 並べ替え先のビットプレーン (もう一方は送信中または送信済み)
+    bool sending;                      // DMA 転送を開始したことがあれば true
+    uint64_t ready_us;                 // 次のフレームを送り始めてよい時刻 [us]
+    ws2812_strip_stats stats;          // 統計
+} ws2812_parallel;
+
+// ws2812_parallel_init() に渡すバッファの要素数
+#define WS2812_PARALLEL_PIXEL_WORDS(lanes, length) ((lanes) * (length))                        // 表示バッファ
+#define WS2812_PARALLEL_PLANE_WORDS(length) (2 * (length) * WS2812_PARALLEL_WORDS_PER_PIXEL)  // ビットプレーン 2 つ分
+
+// lanes 本の length 個の LED のストリップを初期化し、すべて消灯 (黒) にする
+// pixel_words と plane_words は上記の要素数の配列で、使う間は保持すること
+void ws2812_parallel_init(ws2812_parallel *p, const ws2812_transport *transport, uint32_t *pixel_words,
+                          uint32_t *plane_words, int lanes, int length);
+
+// ストリップ lane の表示バッファを返す (length 要素。ws2812_pack() の値をまとめて書き込む場合に使う)
+// lanes 本のストリップの表示バッファは続いているので、lanes × length 個の LED の 1 本のストリップとしても書ける
+static inline uint32_t *ws2812_parallel_pixels(ws2812_parallel *p, int lane)
+{
+    return p->pixels + lane * p->length;
+}
+
+// ストリップ lane の index 番目の LED の色を設定する (範囲外は無視する)
+void ws2812_parallel_set_pixel(ws2812_parallel *p, int lane, int index, uint8_t r, uint8_t g, uint8_t b);
+
+// すべてのストリップのすべての LED を同じ色にする
+void ws2812_parallel_fill(ws2812_parallel *p, uint8_t r, uint8_t g, uint8_t b);
+
+// 表示バッファをビットプレーンに並べ替えて送る。前のフレームのラッチが終わっていなければその時刻まで待つ
+// 並べ替えは前のフレームの送信中に行う。表示バッファは送信に使わないので、戻ったらすぐに書き換えてよい
+void ws2812_parallel_show(ws2812_parallel *p);
+
+// ws2812_parallel_show() が待たずに送信を始められるなら true
+bool ws2812_parallel_is_ready(const ws2812_parallel *p);
+
+// 最後に送ったフレームのラッチが終わる (LED に表示される) まで待つ
+void ws2812_parallel_wait(ws2812_parallel *p);
+
+// 統計を返す
+const ws2812_strip_stats *ws2812_parallel_get_stats(const ws2812_parallel *p);
+
+#endif // WS2812_PARALLEL_H
@@ -0,0 +1,52 @@
+#include "pico/stdlib.h"  // Pico SDK の標準関数
+#include "hardware/dma.h" // DMA (ダイレクトメモリアクセス)
+#include "ws2812_pico.h"  // 実機向けの ws2812_transport
+
+static int dma_channel; // PIO の送信 FIFO に書き込む DMA チャンネル
+
+static void pico_start(void *ctx, const uint32_t *words, int count)
+{
+    (void)ctx;
+    dma_channel_transfer_from_buffer_now(dma_channel, words, count);
+}
+
+static void pico_wait(void *ctx)
+{
+    (void)ctx;
+    dma_channel_wait_for_finish_blocking(dma_channel);
+}
+
+static uint64_t pico_now_us(void *ctx)
+{
+    (void)ctx;
+    return time_us_64();
+}
+
+static void pico_sleep_until(void *ctx, uint64_t time_us)
+{
+    (void)ctx;
+    sleep_until(from_us_since_boot(time_us));
+}
+
+static const ws2812_transport pico_transport = {
+    .start = pico_start,
+    .wait = pico_wait,
+    .now_us = pico_now_us,
+    .sleep_until = pico_sleep_until,
+    .ctx = NULL,
+};
+
+const ws2812_transport *ws2812_pico_transport_init(PIO pio, uint sm)
+{
+    // 32 ビット単位で表示バッファを読み進め、送信 FIFO (書き込み先は固定) に書き込む。
+    // 書き込むタイミングはステートマシンの送信 FIFO の DREQ (空きがある) に合わせる
+    dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dma_channel, &c, &pio->txf[sm], NULL, 0, false);
+
+    return &pico_transport;
+}
@@ -0,0 +1,16 @@
+#ifndef WS2812_PICO_H
+#define WS2812_PICO_H
+
+#include "hardware/pio.h"  // PIO
+#include "ws2812_strip.h"  // WS2812 ストリップのドライバ
+
+// WS2812 ストリップのドライバの実機 (RP2350) 向けの ws2812_transport
+//
+// 表示バッファを DMA で 32 ビットずつ PIO の送信 FIFO に書き込む (FIFO に空きができるたびに 1 要素)。
+// ws2812 PIO プログラムは 24 ビットごとに自動で FIFO から読み込む (autopull) ので、CPU は送信に関わらない。
+// ws2812_parallel のビットプレーンも同じように送れる (ws2812_parallel プログラムは 32 ビットごとに読み込む)。
+
+// ws2812_program_init() または ws2812_parallel_program_init() 済みのステートマシン sm を使う ws2812_transport を用意して返す (DMA チャンネルを 1 つ使う)
+const ws2812_transport *ws2812_pico_transport_init(PIO pio, uint sm);
+
+#endif // WS2812_PICO_H
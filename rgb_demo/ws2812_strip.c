@@ -0,0 +1,87 @@
+#include <string.h>       // memcpy
+#include "ws2812_strip.h" // WS2812 ストリップのドライバ
+
+void ws2812_strip_init(ws2812_strip *s, const ws2812_transport *transport, uint32_t *words, int count)
+{
+    s->transport = transport;
+    s->buffers[0] = words;
+    s->buffers[1] = words + count;
+    s->count = count;
+    s->back = 0;
+    s->sending = false;
+    s->ready_us = transport->now_us(transport->ctx);
+    s->stats = (ws2812_strip_stats){0};
+    memset(words, 0, WS2812_STRIP_WORDS(count) * sizeof(uint32_t));
+}
+
+void ws2812_strip_set_pixel(ws2812_strip *s, int index, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (index >= 0 && index < s->count)
+    {
+        s->buffers[s->back][index] = ws2812_pack(r, g, b);
+    }
+}
+
+void ws2812_strip_fill(ws2812_strip *s, uint8_t r, uint8_t g, uint8_t b)
+{
+    uint32_t word = ws2812_pack(r, g, b);
+    uint32_t *pixels = s->buffers[s->back];
+    for (int i = 0; i < s->count; i++)
+    {
+        pixels[i] = word;
+    }
+}
+
+void ws2812_strip_show(ws2812_strip *s)
+{
+    const ws2812_transport *t = s->transport;
+
+    // 前のフレームの DMA 転送が終わってから (もう一方のバッファを書き込み用に戻すため)、
+    // ビットの送出と RESET が終わる時刻まで待つ
+    if (s->sending)
+    {
+        t->wait(t->ctx);
+    }
+    uint64_t now = t->now_us(t->ctx);
+    if (now < s->ready_us)
+    {
+        s->stats.waits++;
+        s->stats.wait_us += s->ready_us - now;
+        t->sleep_until(t->ctx, s->ready_us);
+        now = s->ready_us;
+    }
+
+    // 書き込み用のバッファを送り始め、もう一方を書き込み用にする
+    const uint32_t *front = s->buffers[s->back];
+    t->start(t->ctx, front, s->count);
+    s->sending = true;
+    s->ready_us = now + ws2812_frame_us(s->count);
+    s->stats.frames++;
+    s->back ^= 1;
+
+    // 次のフレームを今のフレームの続きから書けるように内容を写す (DMA は front を読むだけなので同時でよい)
+    memcpy(s->buffers[s->back], front, s->count * sizeof(uint32_t));
+}
+
+bool ws2812_strip_is_ready(const ws2812_strip *s)
+{
+    return s->transport->now_us(s->transport->ctx) >= s->ready_us;
+}
+
+void ws2812_strip_wait(ws2812_strip *s)
+{
+    const ws2812_transport *t = s->transport;
+    if (s->sending)
+    {
+        t->wait(t->ctx);
+    }
+    if (t->now_us(t->ctx) < s->ready_us)
+    {
+        t->sleep_until(t->ctx, s->ready_us);
+    }
+}
+
+const ws2812_strip_stats *ws2812_strip_get_stats(const ws2812_strip *s)
+{
+    return &s->stats;
+}
@@ -0,0 +1,103 @@
+#ifndef WS2812_STRIP_H
+#define WS2812_STRIP_H
+
+#include <stdint.h>  // 固定幅整数型
+#include <stdbool.h> // bool 型
+
+// 複数の WS2812 をつないだテープ (ストリップ) のドライバ
+//
+// 各 LED の色を ws2812 PIO プログラムにそのまま渡せる 32 ビットの値 (GRB を上位 24 ビットに詰めたもの) で
+// 表示バッファに持ち、ws2812_strip_show() でバッファ全体を DMA で PIO の送信 FIFO に送る。
+// 表示バッファは 2 つあり、一方を送信している間にもう一方へ次のフレームを書き込める (ダブルバッファ)。
+//
+// WS2812 は信号が RESET 時間以上 Low のままになると受け取った色を表示する (ラッチ)。
+// ws2812_strip_show() は前のフレームのビットをすべて送り終え、さらに RESET 時間が過ぎる時刻を覚えておき、
+// 次の送信はその時刻まで待ってから始める。それまでの間、CPU は次のフレームを準備できる。
+//
+// DMA の開始・完了の確認と現在時刻の読み出しは ws2812_transport の関数で行う。host/ws2812_model は
+// これを ws2812.pio のとおりの波形を作るモデルにつなぎ、LED が受け取る色とラッチの時刻を確かめる。
+// 実機では ws2812_pico.h の ws2812_pico_transport_init() が PIO と DMA を使う実装を返す。
+
+#define WS2812_FREQ 800000                                    // 1 秒あたりのビット数 (800kHz)
+#define WS2812_BITS_PER_PIXEL 24                              // 1 個の LED のビット数 (G, R, B 各 8 ビット)
+#define WS2812_PIXEL_NS (WS2812_BITS_PER_PIXEL * (1000000000u / WS2812_FREQ)) // 1 個の LED を送る時間 [ns] (30us)
+#define WS2812_RESET_US 300                                   // ラッチに必要な Low の時間 [us] (WS2812B-V5 の 280us 以上)
+
+// r, g, b (0〜255) を ws2812 PIO プログラムの形式 (上位から G, R, B、下位 8 ビットは送られない) に詰める
+static inline uint32_t ws2812_pack(uint8_t r, uint8_t g, uint8_t b)
+{
+    return (uint32_t)g << 24 | (uint32_t)r << 16 | (uint32_t)b << 8;
+}
+
+// count 個の LED のフレームを送り始めてから次のフレームを送り始められるまでの時間 [us] (ビットの送出 + RESET)
+static inline uint32_t ws2812_frame_us(int count)
+{
+    return (uint32_t)(((uint64_t)count * WS2812_PIXEL_NS + 999) / 1000) + WS2812_RESET_US;
+}
+
+// DMA と時計へのアクセス手段
+typedef struct
+{
+    // words の count 要素を PIO の送信 FIFO へ送り始めてすぐに戻る
+    void (*start)(void *ctx, const uint32_t *words, int count);
+    // start() で始めた DMA 転送が終わるまで待つ (FIFO とシフトレジスタにはまだ残っていてよい)
+    void (*wait)(void *ctx);
+    // 現在時刻 [us]
+    uint64_t (*now_us)(void *ctx);
+    // 指定した時刻まで待つ
+    void (*sleep_until)(void *ctx, uint64_t time_us);
+    void *ctx; // 上記関数に渡すコンテキスト
+} ws2812_transport;
+
+// 送信の統計
+typedef struct
+{
+    uint32_t frames;   // 送信を開始したフレーム数
+    uint32_t waits;    // 前のフレームのラッチを待ったフレーム数
+    uint64_t wait_us;  // 待った時間の合計 [us]
+} ws2812_strip_stats;
+
+typedef struct
+{
+    const ws2812_transport *transport; // DMA と時計
+    uint32_t *buffers[2];              // 表示バッファ (それぞれ count 要素)
+    int count;                         // LED の数
+    int back;                          // 書き込み用のバッファ (もう一方は送信中または送信済み)
+    bool sending;                      // DMA 転送を開始したことがあれば true
+    uint64_t ready_us;                 // 次のフレームを送り始めてよい時刻 [us]
+    ws2812_strip_stats stats;          // 統計
+} ws2812_strip;
+
+// 表示バッファの要素数 (count 個の LED のバッファ 2 つ分)。ws2812_strip_init() に渡す words の大きさ
+#define WS2812_STRIP_WORDS(count) (2 * (count))
+
+// count 個の LED のストリップを初期化し、すべて消灯 (黒) にする
+// words は WS2812_STRIP_WORDS(count) 要素の配列で、ストリップを使う間は保持すること
+void ws2812_strip_init(ws2812_strip *s, const ws2812_transport *transport, uint32_t *words, int count);
+
+// 書き込み用のバッファを返す (ws2812_pack() の値を count 要素まとめて書き込む場合に使う)
+static inline uint32_t *ws2812_strip_pixels(ws2812_strip *s)
+{
+    return s->buffers[s->back];
+}
+
+// index 番目の LED の色を設定する (範囲外は無視する)
+void ws2812_strip_set_pixel(ws2812_strip *s, int index, uint8_t r, uint8_t g, uint8_t b);
+
+// すべての LED を同じ色にする
+void ws2812_strip_fill(ws2812_strip *s, uint8_t r, uint8_t g, uint8_t b);
+
+// 書き込み用のバッファの内容を送る。前のフレームのラッチが終わっていなければその時刻まで待つ
+// 戻ったときの書き込み用のバッファは、送ったフレームと同じ内容になっている (続きから書き換えられる)
+void ws2812_strip_show(ws2812_strip *s);
+
+// ws2812_strip_show() が待たずに送信を始められるなら true
+bool ws2812_strip_is_ready(const ws2812_strip *s);
+
+// 最後に送ったフレームのラッチが終わる (LED に表示される) まで待つ
+void ws2812_strip_wait(ws2812_strip *s);
+
+// 統計を返す
+const ws2812_strip_stats *ws2812_strip_get_stats(const ws2812_strip *s);
+
+#endif // WS2812_STRIP_H
@@ -0,0 +1,550 @@
+#include <stdarg.h> // va_list
+#include <stdio.h>  // 標準入出力ライブラリ
+#include <stdlib.h> // malloc
+#include <string.h> // strcmp
+#include <unistd.h> // getopt
+
+// RP2350 のレジスタ定義 (../reg.h) を生成する
+//
+// 使い方: reg_gen [-o file] [-c file]
+//   -o  生成したヘッダーを file に書き込む (指定しなければ標準出力)
+//   -c  file が生成したヘッダーと一致するかを確かめる (一致しなければ NG を表示して 1 を返す)
+//
+// 下の表は RP2350 の SVD (Pico SDK の src/rp2350/hardware_regs/RP2350.svd) とデータシートから、このリポジトリで
+// 使うペリフェラルとレジスタを写したもの。GPIO0〜47 の CTRL のように同じ形で並ぶレジスタは、1 つの配列として
+// 要素数と間隔を書き、番号を引数にとるマクロ (IO_BANK0_GPIO_CTRL_RW(n) など) を生成する。
+//
+// SET / CLR / XOR のエイリアスがあるペリフェラル (APB のペリフェラル) は、書き込めるレジスタごとに
+// _RW (通常のアドレス)・_XOR (+0x1000)・_SET (+0x2000)・_CLR (+0x3000) を生成する。エイリアスへの書き込みは
+// 読み出しを伴わない 1 回のストアで、割り込みと競合しない。エイリアスのない SIO と PPB はレジスタ名そのままにする。
+
+// レジスタの読み書き
+typedef enum
+{
+    REG_RW, // 読み書き (エイリアスを生成する)
+    REG_RO, // 読み取り専用 (_RW だけ生成する)
+    REG_WO, // 書き込み専用 (_RW だけ生成する)
+    REG_WC, // 1 を書き込んだビットがクリアされる (エイリアスは読み出しを伴うのでビットを消してしまう。_RW だけ生成する)
+} reg_access;
+
+// レジスタ
+typedef struct
+{
+    const char *name;     // レジスタ名 (マクロ名の後半。配列は番号を除いた名前)
+    unsigned long offset; // ベースアドレスからのオフセット (配列は 0 番目の要素)
+    unsigned count;       // 配列の要素数 (0 なら配列ではない)
+    unsigned long stride; // 配列の要素の間隔 [バイト]
+    reg_access access;    // 読み書き
+    const char *comment;  // 説明
+} reg_desc;
+
+// ビットの定数
+typedef struct
+{
+    const char *name;    // マクロ名
+    unsigned bit;        // ビット番号
+    const char *comment; // 説明 (NULL なら付けない)
+} bit_desc;
+
+// ビットの定数のまとまり
+typedef struct
+{
+    const char *comment;  // 説明
+    const bit_desc *bits; // ビット (name が NULL で終わる)
+} bit_group;
+
+// ペリフェラル
+typedef struct
+{
+    const char *name;         // ペリフェラル名 (SVD)
+    const char *title;        // 見出し
+    const char *prefix;       // マクロ名の前半
+    unsigned long base;       // ベースアドレス
+    const char *base_comment; // ベースアドレスの説明
+    int atomic;               // SET / CLR / XOR のエイリアスがあるか
+    const reg_desc *regs;     // レジスタ (name が NULL で終わる)
+    const bit_group *groups;  // ビットの定数 (comment が NULL で終わる。NULL ならなし)
+} periph_desc;
+
+// ---- 表 ----
+
+static const reg_desc resets_regs[] = {
+    {"RESET", 0x000, 0, 0, REG_RW, "全体リセット制御レジスタ (1 の間そのブロックをリセットしておく)"},
+    {"RESET_DONE", 0x008, 0, 0, REG_RO, "リセット完了ステータスレジスタ (各ブロックのリセット完了フラグ)"},
+    {NULL},
+};
+
+static const bit_desc resets_bits[] = {
+    {"RESETS_ADC", 0, NULL},
+    {"RESETS_HSTX", 3, NULL},
+    {"RESETS_I2C0", 4, NULL},
+    {"RESETS_I2C1", 5, NULL},
+    {"RESETS_PIO0", 11, NULL},
+    {"RESETS_PIO1", 12, NULL},
+    {"RESETS_PIO2", 13, NULL},
+    {"RESETS_PWM", 16, NULL},
+    {"RESETS_SHA256", 17, NULL},
+    {"RESETS_SPI0", 18, NULL},
+    {"RESETS_SPI1", 19, NULL},
+    {"RESETS_TRNG", 25, NULL},
+    {"RESETS_UART0", 26, NULL},
+    {"RESETS_UART1", 27, NULL},
+    {"RESETS_USBCTRL", 28, NULL},
+    {NULL},
+};
+
+static const bit_group resets_groups[] = {
+    {"RESETS_RESET のビット (1 の間そのブロックをリセットしておく)", resets_bits},
+    {NULL},
+};
+
+static const reg_desc sio_regs[] = {
+    {"GPIO_IN", 0x004, 0, 0, REG_RO, "GPIO入力レジスタ (各GPIOピンの入力レベル)"},
+    {"GPIO_OUT", 0x010, 0, 0, REG_RW, "GPIO出力データレジスタ (全GPIOピンの出力値)"},
+    {"GPIO_OUT_SET", 0x018, 0, 0, REG_WO, "特定のGPIOピンをHIGHにする (1を書き込む)"},
+    {"GPIO_OUT_CLR", 0x020, 0, 0, REG_WO, "特定のGPIOピンをLOWにする (1を書き込む)"},
+    {"GPIO_OUT_XOR", 0x028, 0, 0, REG_WO, "特定のGPIOピンの出力を反転させる (1を書き込む)"},
+    {"GPIO_OE", 0x030, 0, 0, REG_RW, "GPIO出力イネーブルレジスタ (全GPIOピンの出力有効/無効)"},
+    {"GPIO_OE_SET", 0x038, 0, 0, REG_WO, "特定のGPIOピンを出力有効にする (1を書き込む)"},
+    {"GPIO_OE_CLR", 0x040, 0, 0, REG_WO, "特定のGPIOピンを出力無効にする (1を書き込む)"},
+    {"GPIO_OE_XOR", 0x048, 0, 0, REG_WO, "特定のGPIOピンの出力イネーブル状態を反転させる (1を書き込む)"},
+    {NULL},
+};
+
+static const reg_desc io_bank0_regs[] = {
+    {"GPIO_STATUS", 0x000, 48, 8, REG_RO, "GPIOnピンの状態レジスタ (n: 0〜47、入力レベルなど)"},
+    {"GPIO_CTRL", 0x004, 48, 8, REG_RW, "GPIOnピンの制御レジスタ (n: 0〜47、ビット4〜0: 機能選択。値4でPWM、値5でSIO (GPIO))"},
+    {NULL},
+};
+
+static const reg_desc pads_bank0_regs[] = {
+    {"VOLTAGE_SELECT", 0x000, 0, 0, REG_RW, "IOの電源電圧の選択 (0: 3.3V、1: 1.8V)"},
+    {"GPIO", 0x004, 48, 4, REG_RW,
+     "GPIOnピンのパッド制御レジスタ (n: 0〜47、ドライブ強度、プルアップ/プルダウンなど。ビット8: ISO (1 の間パッドを切り離す))"},
+    {NULL},
+};
+
+static const reg_desc clocks_regs[] = {
+    {"REF_CTRL", 0x030, 0, 0, REG_RW, "基準クロック制御レジスタ"},
+    {"SYS_CTRL", 0x03C, 0, 0, REG_RW, "システムクロック制御レジスタ"},
+    {"SYS_RESUS_CTRL", 0x084, 0, 0, REG_RW, "システムクロック復旧制御レジスタ"},
+    {"WAKE_EN0", 0x0AC, 0, 0, REG_RW, "起きている間に動かすクロック (ビット n はクロック n、0〜31)"},
+    {"WAKE_EN1", 0x0B0, 0, 0, REG_RW, "起きている間に動かすクロック (ビット n はクロック n + 32、32〜61)"},
+    {"SLEEP_EN0", 0x0B4, 0, 0, REG_RW, "ディープスリープ中に動かすクロック (0〜31)"},
+    {"SLEEP_EN1", 0x0B8, 0, 0, REG_RW, "ディープスリープ中に動かすクロック (32〜61)"},
+    {"ENABLED0", 0x0BC, 0, 0, REG_RO, "今動いているクロック (0〜31)"},
+    {"ENABLED1", 0x0C0, 0, 0, REG_RO, "今動いているクロック (32〜61)"},
+    {NULL},
+};
+
+static const bit_desc clk_en0_bits[] = {
+    {"CLK_EN0_ADC", 2, "clk_adc"},
+    {"CLK_EN0_SYS_ADC", 3, "clk_sys_adc"},
+    {"CLK_EN0_HSTX", 9, "clk_hstx"},
+    {"CLK_EN0_SYS_HSTX", 10, "clk_sys_hstx"},
+    {"CLK_EN0_SYS_I2C0", 11, "clk_sys_i2c0"},
+    {"CLK_EN0_SYS_I2C1", 12, "clk_sys_i2c1"},
+    {"CLK_EN0_SYS_PIO0", 18, "clk_sys_pio0"},
+    {"CLK_EN0_SYS_PIO1", 19, "clk_sys_pio1"},
+    {"CLK_EN0_SYS_PIO2", 20, "clk_sys_pio2"},
+    {"CLK_EN0_SYS_PWM", 25, "clk_sys_pwm"},
+    {"CLK_EN0_SYS_SHA256", 30, "clk_sys_sha256"},
+    {NULL},
+};
+
+static const bit_desc clk_en1_bits[] = {
+    {"CLK_EN1_PERI_SPI0", 0, "clk_peri_spi0"},
+    {"CLK_EN1_SYS_SPI0", 1, "clk_sys_spi0"},
+    {"CLK_EN1_PERI_SPI1", 2, "clk_peri_spi1"},
+    {"CLK_EN1_SYS_SPI1", 3, "clk_sys_spi1"},
+    {"CLK_EN1_SYS_TRNG", 21, "clk_sys_trng"},
+    {"CLK_EN1_PERI_UART0", 22, "clk_peri_uart0"},
+    {"CLK_EN1_SYS_UART0", 23, "clk_sys_uart0"},
+    {"CLK_EN1_PERI_UART1", 24, "clk_peri_uart1"},
+    {"CLK_EN1_SYS_UART1", 25, "clk_sys_uart1"},
+    {"CLK_EN1_SYS_USBCTRL", 26, "clk_sys_usbctrl"},
+    {"CLK_EN1_USB", 27, "clk_usb"},
+    {NULL},
+};
+
+static const bit_group clocks_groups[] = {
+    {"WAKE_EN0 / SLEEP_EN0 のビット", clk_en0_bits},
+    {"WAKE_EN1 / SLEEP_EN1 のビット", clk_en1_bits},
+    {NULL},
+};
+
+static const reg_desc xosc_regs[] = {
+    {"CTRL", 0x00, 0, 0, REG_RW, "外部水晶発振器制御レジスタ"},
+    {"STATUS", 0x04, 0, 0, REG_RW, "外部水晶発振器ステータスレジスタ"},
+    {"STARTUP", 0x0C, 0, 0, REG_RW, "外部水晶発振器起動制御レジスタ"},
+    {"COUNT", 0x10, 0, 0, REG_RW, "外部水晶発振器カウンタレジスタ"},
+    {NULL},
+};
+
+static const reg_desc timer_regs[] = {
+    {"TIMEHW", 0x00, 0, 0, REG_WO, "タイマー上位32ビット (書き込み。TIMELW の後に書くと両方が反映される)"},
+    {"TIMELW", 0x04, 0, 0, REG_WO, "タイマー下位32ビット (書き込み)"},
+    {"TIMEHR", 0x08, 0, 0, REG_RO, "タイマー上位32ビット (TIMELR を読んだときにラッチした値。ラッチは 1 つなので割り込みと競合する)"},
+    {"TIMELR", 0x0C, 0, 0, REG_RO, "タイマー下位32ビット (読むと上位をラッチする)"},
+    {"ALARM", 0x10, 4, 4, REG_RW, "アラームn設定値 (n: 0〜3。タイマーの下位32ビットと一致したときに割り込み番号nの割り込みが起きる)"},
+    {"ARMED", 0x20, 0, 0, REG_WC, "アラーム有効ビット (1 を書き込むとアラームが止まる)"},
+    {"TIMERAWH", 0x24, 0, 0, REG_RO, "生タイマー上位32ビット (ラッチしない)"},
+    {"TIMERAWL", 0x28, 0, 0, REG_RO, "生タイマー下位32ビット (ラッチしない)"},
+    {"DBGPAUSE", 0x2C, 0, 0, REG_RW, "デバッグポーズ制御 (デバッグ時にタイマーを止める)"},
+    {"PAUSE", 0x30, 0, 0, REG_RW, "タイマー一時停止制御"},
+    {"LOCKED", 0x34, 0, 0, REG_RW, "ロック制御 (書き込み保護)"},
+    {"SOURCE", 0x38, 0, 0, REG_RW, "クロックソース選択"},
+    {"INTR", 0x3C, 0, 0, REG_WC, "割り込み要求フラグ (1 を書き込むとクリア)"},
+    {"INTE", 0x40, 0, 0, REG_RW, "割り込みイネーブルビット"},
+    {"INTF", 0x44, 0, 0, REG_RW, "割り込み強制フラグ"},
+    {"INTS", 0x48, 0, 0, REG_RO, "割り込みステータス (INTE と INTF を反映した後の割り込み)"},
+    {NULL},
+};
+
+static const reg_desc pwm_regs[] = {
+    {"CH_CSR", 0x00, 12, 0x14, REG_RW, "スライスnの制御・ステータスレジスタ (n: 0〜11、ビット0: 有効)"},
+    {"CH_DIV", 0x04, 12, 0x14, REG_RW, "スライスnのクロック分周 (ビット11〜4: 整数部、ビット3〜0: 小数部)"},
+    {"CH_CTR", 0x08, 12, 0x14, REG_RW, "スライスnのカウンタ"},
+    {"CH_CC", 0x0C, 12, 0x14, REG_RW,
+     "スライスnの比較値 (ビット15〜0: チャンネルA、ビット31〜16: チャンネルB。カウンタが比較値より小さい間 HIGH、周期の終わりに反映)"},
+    {"CH_TOP", 0x10, 12, 0x14, REG_RW, "スライスnのカウンタの最大値 (周期 = TOP + 1 カウント)"},
+    {"EN", 0xF0, 0, 0, REG_RW, "全スライスの有効ビット (各スライスの CSR のビット0 と同じ。まとめて書き込むと同時に動き出す)"},
+    {NULL},
+};
+
+static const reg_desc ppb_regs[] = {
+    {"NVIC_ICPR0", 0x0E280, 0, 0, REG_RW, "NVIC の割り込み保留クリア (ビット n に 1 を書き込むと割り込み番号 n の保留を取り消す)"},
+    {"M33_SCR", 0x0ED10, 0, 0, REG_RW,
+     "システム制御レジスタ (ビット2 SLEEPDEEP: WFI/WFE でディープスリープ、ビット4 SEVONPEND: 保留になった割り込みで WFE から起きる)"},
+    {"M33_DEMCR", 0x0EDFC, 0, 0, REG_RW, "デバッグ例外とモニタの制御 (ビット24 TRCENA: DWT などのトレース機能を動かす)"},
+    {"DWT_CTRL", 0x01000, 0, 0, REG_RW, "DWT の制御 (ビット0 CYCCNTENA: サイクルカウンタを動かす)"},
+    {"DWT_CYCCNT", 0x01004, 0, 0, REG_RW, "サイクルカウンタ (CPU のクロックごとに 1 増える 32 ビットのカウンタ。WFI / WFE で眠っている間は止まる)"},
+    {NULL},
+};
+
+static const periph_desc periphs[] = {
+    {"RESETS", "リセット制御レジスタ", "RESETS_", 0x40020000, "リセット制御レジスタのベースアドレス", 1, resets_regs,
+     resets_groups},
+    {"SIO", "シングルIOレジスタ", "SIO_", 0xd0000000, "シングルIOレジスタのベースアドレス (SET / CLR / XOR は専用のレジスタ)", 0,
+     sio_regs, NULL},
+    {"IO_BANK0", "IOバンク0レジスタ", "IO_BANK0_", 0x40028000, "IOバンク0レジスタのベースアドレス", 1, io_bank0_regs, NULL},
+    {"PADS_BANK0", "パッド制御レジスタ", "PADS_BANK0_", 0x40038000, "パッド制御レジスタのベースアドレス", 1, pads_bank0_regs,
+     NULL},
+    {"CLOCKS", "クロック制御レジスタ", "CLK_", 0x40010000, "クロック制御レジスタのベースアドレス", 1, clocks_regs, clocks_groups},
+    {"XOSC", "外部水晶発振器レジスタ", "XOSC_", 0x40048000, "外部水晶発振器レジスタのベースアドレス", 1, xosc_regs, NULL},
+    {"TIMER0", "タイマー0レジスタ", "TIMER0_", 0x400b0000, "タイマー0レジスタのベースアドレス", 1, timer_regs, NULL},
+    {"TIMER1", "タイマー1レジスタ", "TIMER1_", 0x400b8000, "タイマー1レジスタのベースアドレス", 1, timer_regs, NULL},
+    {"PWM", "PWMレジスタ", "PWM_", 0x400a8000,
+     "PWMレジスタのベースアドレス (スライス 0〜11、GPIOn はスライス (n >> 1) & 7 のチャンネル A (偶数) / B (奇数))", 1,
+     pwm_regs, NULL},
+    {"PPB", "Cortex-M33 のシステム制御", "", 0xe0000000, "プライベート周辺バスのベースアドレス", 0, ppb_regs, NULL},
+    {NULL},
+};
+
+// ---- 生成 ----
+
+// 出力先 (文字列に追記する)
+typedef struct
+{
+    char *buf;
+    size_t len;
+    size_t cap;
+} output;
+
+// 書式を付けて追記する
+static void out(output *o, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(NULL, 0, fmt, ap);
+    va_end(ap);
+    if (o->len + n + 1 > o->cap)
+    {
+        o->cap = (o->len + n + 1) * 2;
+        o->buf = realloc(o->buf, o->cap);
+    }
+    va_start(ap, fmt);
+    vsnprintf(o->buf + o->len, n + 1, fmt, ap);
+    va_end(ap);
+    o->len += n;
+}
+
+// 行を溜めて、末尾のコメントの位置をそろえて出力する
+#define MAX_LINES 64
+
+typedef struct
+{
+    char code[256];      // コメントの前まで
+    const char *comment; // 末尾のコメント (NULL ならなし)
+} line;
+
+static void flush_lines(output *o, line *lines, int n)
+{
+    size_t width = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (lines[i].comment && strlen(lines[i].code) > width)
+        {
+            width = strlen(lines[i].code);
+        }
+    }
+    for (int i = 0; i < n; i++)
+    {
+        if (lines[i].comment)
+        {
+            out(o, "%-*s // %s\n", (int)width, lines[i].code, lines[i].comment);
+        }
+        else
+        {
+            out(o, "%s\n", lines[i].code);
+        }
+    }
+}
+
+// エイリアスのオフセットと説明
+static const struct
+{
+    const char *suffix;
+    unsigned long offset;
+    const char *comment;
+} aliases[] = {
+    {"_RW", 0x0000, "読み書き"},
+    {"_XOR", 0x1000, "排他的論理和 (1を書き込んだビットが反転する)"},
+    {"_SET", 0x2000, "ビットセット (1を書き込んだビットが1になる)"},
+    {"_CLR", 0x3000, "ビットクリア (1を書き込んだビットが0になる)"},
+};
+
+// レジスタ 1 つ (配列ならまとめて 1 つ) のマクロを生成する
+static void gen_reg(output *o, const periph_desc *p, const reg_desc *r)
+{
+    line lines[4];
+    int n = 0;
+    char base[64];
+    snprintf(base, sizeof(base), "%sBASE", p->prefix[0] ? p->prefix : "PPB_");
+    char addr[128]; // ベースアドレスとオフセット
+    if (r->count)
+    {
+        snprintf(addr, sizeof(addr), "%s, 0x%03lX + 0x%lX * (n)", base, r->offset, r->stride);
+    }
+    else
+    {
+        snprintf(addr, sizeof(addr), "%s, 0x%03lX", base, r->offset);
+    }
+    const char *param = r->count ? "(n)" : "";
+
+    out(o, "// %s\n", r->comment);
+    if (!p->atomic)
+    {
+        out(o, "#define %s%s%s REG32(%s)\n", p->prefix, r->name, param, addr);
+        return;
+    }
+    int num_aliases = r->access == REG_RW ? 4 : 1;
+    for (int i = 0; i < num_aliases; i++)
+    {
+        snprintf(lines[n].code, sizeof(lines[n].code), "#define %s%s%s%s REG32(%s + 0x%04lX)", p->prefix, r->name,
+                 aliases[i].suffix, param, addr, aliases[i].offset);
+        lines[n].comment = r->access == REG_RW   ? aliases[i].comment
+                           : r->access == REG_RO ? "読み取り専用"
+                           : r->access == REG_WO ? "書き込み専用"
+                                                 : "1 を書き込んだビットがクリアされる";
+        n++;
+    }
+    flush_lines(o, lines, n);
+}
+
+// ビットの定数を生成する
+static void gen_bits(output *o, const bit_group *g)
+{
+    line lines[MAX_LINES];
+    int n = 0;
+    out(o, "// %s\n", g->comment);
+    for (const bit_desc *b = g->bits; b->name && n < MAX_LINES; b++)
+    {
+        snprintf(lines[n].code, sizeof(lines[n].code), "#define %s (1ul << %u)", b->name, b->bit);
+        lines[n].comment = b->comment;
+        n++;
+    }
+    flush_lines(o, lines, n);
+}
+
+// ペリフェラル 1 つを生成する
+static void gen_periph(output *o, const periph_desc *p)
+{
+    char base[64];
+    snprintf(base, sizeof(base), "%sBASE", p->prefix[0] ? p->prefix : "PPB_");
+    out(o, "\n// -------------------- %s (%s) --------------------\n", p->title, p->name);
+    out(o, "#define %s (0x%08lx) // %s\n", base, p->base, p->base_comment);
+    for (const reg_desc *r = p->regs; r->name; r++)
+    {
+        out(o, "\n");
+        gen_reg(o, p, r);
+    }
+    for (const bit_group *g = p->groups; g && g->comment; g++)
+    {
+        out(o, "\n");
+        gen_bits(o, g);
+    }
+}
+
+// ヘッダー全体を生成する
+static void gen_header(output *o)
+{
+    out(o, "#ifndef REG_H\n"
+           "#define REG_H\n"
+           "\n"
+           "// RP2350 のレジスタ定義\n"
+           "//\n"
+           "// このファイルは host/reg_gen.c が生成する。直接編集せず、reg_gen.c の表を直して作り直す (README.md)。\n"
+           "//\n"
+           "// * SET / CLR / XOR のエイリアスがあるペリフェラルのレジスタは、_RW (通常のアドレス) と _XOR / _SET / _CLR の\n"
+           "//   マクロがある。エイリアスへの書き込みは読み出しを伴わない 1 回のストアで、割り込みと競合しない。\n"
+           "// * GPIO やアラーム、PWM スライスのように同じ形で並ぶレジスタは、番号を引数にとる (IO_BANK0_GPIO_CTRL_RW(n) など)。\n"
+           "//   番号が定数ならアドレスも定数になり、以前のピンごとのマクロと同じ 1 回のストアになる。\n"
+           "// * REG_HOST を定義すると、レジスタの代わりにメモリの配列 reg_host_window を読み書きする (host/reg_host.c)。\n"
+           "//   ホストで、レジスタを直接操作するドライバを動かして確かめたり、時間を測ったりできる。\n"
+           "\n"
+           "#ifdef REG_HOST\n"
+           "// ホストで配列に割り当てるアドレスの範囲 (APB のペリフェラル・SIO・PPB の順に並べる)\n"
+           "#define REG_HOST_APB_BASE 0x40000000ul // APB のペリフェラル\n"
+           "#define REG_HOST_APB_SIZE 0x00200000ul\n"
+           "#define REG_HOST_SIO_BASE 0xd0000000ul // SIO\n"
+           "#define REG_HOST_SIO_SIZE 0x00020000ul\n"
+           "#define REG_HOST_PPB_BASE 0xe0000000ul // PPB\n"
+           "#define REG_HOST_PPB_SIZE 0x00010000ul\n"
+           "#define REG_HOST_WORDS ((REG_HOST_APB_SIZE + REG_HOST_SIO_SIZE + REG_HOST_PPB_SIZE) / 4)\n"
+           "\n"
+           "// ベースアドレス base のペリフェラルの、配列の先頭の要素の番号 (base が定数なら定数になる)\n"
+           "#define REG_HOST_INDEX(base)                                                                                      \\\n"
+           "    (((base) >= REG_HOST_PPB_BASE   ? (base) - REG_HOST_PPB_BASE + REG_HOST_APB_SIZE + REG_HOST_SIO_SIZE           \\\n"
+           "      : (base) >= REG_HOST_SIO_BASE ? (base) - REG_HOST_SIO_BASE + REG_HOST_APB_SIZE                               \\\n"
+           "                                    : (base) - REG_HOST_APB_BASE) /                                                \\\n"
+           "     4)\n"
+           "\n"
+           "extern volatile unsigned long reg_host_window[REG_HOST_WORDS]; // レジスタの代わりのメモリ\n"
+           "\n"
+           "// ベースアドレス base からオフセット offset の 32 ビットのレジスタ\n"
+           "#define REG32(base, offset) (reg_host_window[REG_HOST_INDEX(base) + (offset) / 4])\n"
+           "#else\n"
+           "// ベースアドレス base からオフセット offset の 32 ビットのレジスタ\n"
+           "#define REG32(base, offset) (*(volatile unsigned long *)((base) + (offset)))\n"
+           "#endif\n");
+    for (const periph_desc *p = periphs; p->name; p++)
+    {
+        gen_periph(o, p);
+    }
+    out(o, "\n#endif // REG_H\n");
+}
+
+// 表の誤りを調べる (レジスタの重なり、エイリアスとの重なり、範囲外)
+static int check_table(void)
+{
+    int errors = 0;
+    for (const periph_desc *p = periphs; p->name; p++)
+    {
+        unsigned long limit = p->atomic ? 0x1000 : 0x10000; // エイリアスのあるペリフェラルは 4KB ごとに並ぶ
+        for (const reg_desc *r = p->regs; r->name; r++)
+        {
+            unsigned n = r->count ? r->count : 1;
+            unsigned long end = r->offset + (n - 1) * r->stride + 4;
+            if ((r->offset & 3) || (r->count && (r->stride & 3)) || end > limit)
+            {
+                fprintf(stderr, "%s%s: offset 0x%lx stride 0x%lx out of range\n", p->prefix, r->name, r->offset, r->stride);
+                errors++;
+            }
+            for (const reg_desc *q = p->regs; q < r; q++)
+            {
+                for (unsigned i = 0; i < n; i++)
+                {
+                    unsigned long a = r->offset + i * r->stride;
+                    unsigned m = q->count ? q->count : 1;
+                    for (unsigned j = 0; j < m; j++)
+                    {
+                        if (a == q->offset + j * q->stride)
+                        {
+                            fprintf(stderr, "%s%s[%u] overlaps %s%s[%u]\n", p->prefix, r->name, i, p->prefix, q->name, j);
+                            errors++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+// ファイルを読み込む
+static char *read_file(const char *path, size_t *len)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        return NULL;
+    }
+    size_t cap = 4096;
+    char *buf = malloc(cap);
+    *len = 0;
+    size_t n;
+    while ((n = fread(buf + *len, 1, cap - *len, f)) > 0)
+    {
+        *len += n;
+        if (*len == cap)
+        {
+            cap *= 2;
+            buf = realloc(buf, cap);
+        }
+    }
+    fclose(f);
+    return buf;
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_path = NULL;
+    const char *check_path = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:c:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'o':
+            out_path = optarg;
+            break;
+        case 'c':
+            check_path = optarg;
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-o file] [-c file]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (check_table())
+    {
+        fprintf(stderr, "register table: NG\n");
+        return 1;
+    }
+    output o = {0};
+    gen_header(&o);
+
+    if (check_path)
+    {
+        size_t len;
+        char *buf = read_file(check_path, &len);
+        int same = buf && len == o.len && memcmp(buf, o.buf, len) == 0;
+        printf("%s is %s: %s\n", check_path, same ? "up to date" : "out of date (run reg_gen -o)", same ? "OK" : "NG");
+        free(buf);
+        return same ? 0 : 1;
+    }
+    FILE *f = out_path ? fopen(out_path, "wb") : stdout;
+    if (!f)
+    {
+        perror(out_path);
+        return 1;
+    }
+    fwrite(o.buf, 1, o.len, f);
+    if (out_path)
+    {
+        fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,4 @@
+#include "reg.h" // レジスタ定義 (REG_HOST)
+
+// ホストでレジスタの代わりに読み書きするメモリ
+volatile unsigned long reg_host_window[REG_HOST_WORDS];
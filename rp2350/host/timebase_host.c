@@ -0,0 +1,26 @@
+#include <time.h>     // clock_gettime
+#include "timebase.h" // 時刻とサイクル数の読み出し (TIMEBASE_HOST を定義してビルドする)
+
+// ホストの時刻とサイクル数 (CLOCK_MONOTONIC から求める)
+// サイクル数は実機と同じく 1 us あたり TIMEBASE_CYCLES_PER_US 増える 32 ビットの値にする
+
+static unsigned long long host_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void timebase_init(void)
+{
+}
+
+unsigned long long timebase_now_us(void)
+{
+    return host_now_ns() / 1000;
+}
+
+unsigned long timebase_cycles(void)
+{
+    return (unsigned long)(host_now_ns() * TIMEBASE_CYCLES_PER_US / 1000 & 0xffffffffull);
+}
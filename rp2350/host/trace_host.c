@@ -0,0 +1,21 @@
+#include "trace_host.h" // トレースのホスト向けのバリア
+
+static void (*interrupt_handler)(void); // 次に呼ぶ関数
+static unsigned long interrupt_fence;    // 呼ぶまでのバリアの数
+
+void trace_host_fence(memory_order order)
+{
+    atomic_thread_fence(order);
+    if (interrupt_handler && interrupt_fence-- == 0)
+    {
+        void (*handler)(void) = interrupt_handler;
+        interrupt_handler = 0; // 割り込みの中ではさらに割り込まない
+        handler();
+    }
+}
+
+void trace_host_interrupt_at(unsigned long fence, void (*handler)(void))
+{
+    interrupt_fence = fence;
+    interrupt_handler = handler;
+}
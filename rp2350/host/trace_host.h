@@ -0,0 +1,19 @@
+#ifndef TRACE_HOST_H
+#define TRACE_HOST_H
+
+#include <stdatomic.h> // memory_order
+
+// トレースのホスト向けのバリア
+//
+// スレッドから記録・読み出しできるよう atomic_thread_fence を入れ、さらに trace_host_interrupt_at() で設定した
+// 回数目のバリアで関数を 1 回呼ぶ。記録や読み出しの途中の、順序が問題になる位置に割り込みを入れて試験できる。
+
+#define TRACE_FENCE trace_host_fence
+
+// バリア (TRACE_FENCE)
+void trace_host_fence(memory_order order);
+
+// これから fence 回目 (0 から数える) のバリアで handler を 1 回呼ぶ。handler が 0 なら取り消す
+void trace_host_interrupt_at(unsigned long fence, void (*handler)(void));
+
+#endif // TRACE_HOST_H
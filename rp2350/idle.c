@@ -0,0 +1,69 @@
+#include "idle.h" // アイドル処理
+
+void idle_init(idle *id, const idle_hw *hw)
+{
+    id->hw = hw;
+    id->mark_us = hw->now_us(hw->ctx);
+    id->stats = (idle_stats){0};
+}
+
+void idle_wait_until(idle *id, unsigned long long deadline_us)
+{
+    const idle_hw *hw = id->hw;
+    unsigned long long now = hw->now_us(hw->ctx);
+    id->stats.busy_us += now - id->mark_us;
+    if (now < deadline_us)
+    {
+        unsigned long long start = now;
+        hw->set_alarm(hw->ctx, deadline_us);
+        id->stats.sleeps++;
+        // アラームを設定している間に期限を過ぎても、割り込みの保留でイベントが残るので WFE はすぐに戻る
+        while ((now = hw->now_us(hw->ctx)) < deadline_us)
+        {
+            hw->wait_event(hw->ctx);
+            id->stats.wakeups++;
+        }
+        hw->cancel_alarm(hw->ctx);
+        id->stats.idle_us += now - start;
+    }
+    id->mark_us = now;
+}
+
+void idle_wait_us(idle *id, unsigned long us)
+{
+    idle_wait_until(id, id->hw->now_us(id->hw->ctx) + us);
+}
+
+void idle_sleep(idle *id)
+{
+    const idle_hw *hw = id->hw;
+    hw->irq_disable(hw->ctx);
+    unsigned long long start = hw->now_us(hw->ctx);
+    id->stats.busy_us += start - id->mark_us;
+    hw->wait_interrupt(hw->ctx);
+    unsigned long long now = hw->now_us(hw->ctx);
+    id->stats.sleeps++;
+    id->stats.wakeups++;
+    id->stats.idle_us += now - start;
+    id->mark_us = now;
+    hw->irq_enable(hw->ctx); // ここで割り込みの処理が動く
+}
+
+const idle_stats *idle_get_stats(const idle *id)
+{
+    return &id->stats;
+}
+
+unsigned long idle_busy_permille(const idle_stats *stats)
+{
+    unsigned long long total = stats->busy_us + stats->idle_us;
+    return total ? (unsigned long)(stats->busy_us * 1000 / total) : 0;
+}
+
+unsigned long long idle_energy_nj(const idle_stats *stats, unsigned long active_ua, unsigned long sleep_ua,
+                                  unsigned long supply_mv)
+{
+    // uA × us = pC。1000 で割って nC、mV を掛けて pJ、1000 で割って nJ
+    unsigned long long charge_pc = stats->busy_us * active_ua + stats->idle_us * sleep_ua;
+    return charge_pc / 1000 * supply_mv / 1000;
+}
@@ -0,0 +1,79 @@
+#ifndef IDLE_H
+#define IDLE_H
+
+// 待ち時間や割り込み待ちの間、CPU を眠らせる (WFE / WFI) アイドル処理
+//
+// idle_wait_until() は、時刻を読み続けて待つ代わりに、期限にアラームを設定して WFE で眠る。
+// 割り込みで動くプログラムは、メインループで idle_sleep() を呼び、次の割り込みまで WFI で眠る。
+// どちらも眠っていた時間 (idle_us) と起きていた時間 (busy_us) を数えるので、CPU が動いていた割合や、
+// 電流の値を与えて 1 回の処理あたりのエネルギーを求められる。
+//
+// アラーム・WFE / WFI・割り込みの禁止は idle_hw の関数で行う。blink_without_SDK の host/idle_sim は
+// 眠る命令を仮想時計を起床要因まで進める関数にして、起床の取りこぼしがないことと眠っていた割合を調べる。
+// 実機では idle_pico.h の idle_pico_hw() がレジスタを直接操作する実装を返す。
+
+#define IDLE_ACTIVE_UA 20000 // 起きている間の電流 [uA] (見積もり。実機で測った値に置き換える)
+#define IDLE_SLEEP_UA 1500   // 眠っている間の電流 [uA] (見積もり。使わないクロックを止めた場合)
+#define IDLE_SUPPLY_MV 3300  // 電源電圧 [mV]
+
+// ハードウェアへのアクセス手段
+typedef struct
+{
+    // 現在時刻 [us]
+    unsigned long long (*now_us)(void *ctx);
+    // 指定した時刻に起きるようにアラームを設定する (割り込みハンドラは呼ばず、WFE を起こすだけ)
+    void (*set_alarm)(void *ctx, unsigned long long time_us);
+    // アラームを止め、保留中の起床要因をクリアする
+    void (*cancel_alarm)(void *ctx);
+    // WFE: イベント (アラームなど) が起きるまで眠る (すでに起きていればすぐに戻る)
+    void (*wait_event)(void *ctx);
+    // 割り込みを禁止する / 許可する (PRIMASK)
+    void (*irq_disable)(void *ctx);
+    void (*irq_enable)(void *ctx);
+    // WFI: 割り込みが保留になるまで眠る (割り込みを禁止していても起きる)
+    void (*wait_interrupt)(void *ctx);
+    void *ctx; // 上記関数に渡すコンテキスト
+} idle_hw;
+
+// 統計
+typedef struct
+{
+    unsigned long sleeps;       // 眠った回数
+    unsigned long wakeups;      // WFE / WFI から戻った回数 (期限の前に起きた回数を含む)
+    unsigned long long idle_us; // 眠っていた時間 [us]
+    unsigned long long busy_us; // 起きていた時間 [us] (割り込みの処理を含む)
+} idle_stats;
+
+// アイドル処理
+typedef struct
+{
+    const idle_hw *hw;          // ハードウェア
+    unsigned long long mark_us; // 最後に起きた (または初期化した) 時刻
+    idle_stats stats;           // 統計
+} idle;
+
+// アイドル処理を初期化する。ここから起きていた時間を数え始める
+void idle_init(idle *id, const idle_hw *hw);
+
+// 時刻 deadline_us まで眠って待つ (過ぎていればすぐに戻る)
+void idle_wait_until(idle *id, unsigned long long deadline_us);
+
+// 今から us マイクロ秒眠って待つ
+void idle_wait_us(idle *id, unsigned long us);
+
+// 次の割り込みまで眠る。割り込みを禁止して WFI し、起きた時刻を数えてから許可するので、
+// 割り込みの処理は起きていた時間に数える
+void idle_sleep(idle *id);
+
+// 統計を返す (起きていた時間は最後に眠った時点まで)
+const idle_stats *idle_get_stats(const idle *id);
+
+// 起きていた時間の割合 [‰]
+unsigned long idle_busy_permille(const idle_stats *stats);
+
+// 起きている間の電流 active_ua [uA]、眠っている間の電流 sleep_ua [uA]、電源電圧 supply_mv [mV] での
+// エネルギー [nJ]
+unsigned long long idle_energy_nj(const idle_stats *stats, unsigned long active_ua, unsigned long sleep_ua,
+                                  unsigned long supply_mv);
+
+#endif // IDLE_H
@@ -0,0 +1,79 @@
+#include "reg.h"       // レジスタ定義
+#include "idle_pico.h" // 実機向けの idle_hw
+#include "timebase.h"  // 時刻の読み出し
+
+#define SCR_SLEEPDEEP (1ul << 2) // M33_SCR: WFI / WFE でディープスリープ
+#define SCR_SEVONPEND (1ul << 4) // M33_SCR: 保留になった割り込みで WFE から起きる
+
+static unsigned long long pico_now_us(void *ctx)
+{
+    (void)ctx;
+    return timebase_now_us();
+}
+
+static void pico_cancel_alarm(void *ctx)
+{
+    (void)ctx;
+    TIMER0_INTE_CLR = 1ul << IDLE_PICO_ALARM;
+    TIMER0_ARMED_RW = 1ul << IDLE_PICO_ALARM; // 1 を書き込むとアラームが止まる
+    TIMER0_INTR_RW = 1ul << IDLE_PICO_ALARM;  // アラームの割り込みフラグをクリア
+    NVIC_ICPR0 = 1ul << IDLE_PICO_ALARM;   // NVIC の保留をクリア (次に保留になったときにまたイベントになる)
+}
+
+static void pico_set_alarm(void *ctx, unsigned long long time_us)
+{
+    pico_cancel_alarm(ctx);
+    M33_SCR = M33_SCR | SCR_SEVONPEND;
+    TIMER0_ALARM_RW(IDLE_PICO_ALARM) = (unsigned long)time_us; // 下位 32 ビットが一致したときに割り込みが保留になる
+    TIMER0_INTE_SET = 1ul << IDLE_PICO_ALARM;
+}
+
+static void pico_wait_event(void *ctx)
+{
+    (void)ctx;
+    __asm volatile("wfe");
+}
+
+static void pico_irq_disable(void *ctx)
+{
+    (void)ctx;
+    __asm volatile("cpsid i" ::: "memory");
+}
+
+static void pico_irq_enable(void *ctx)
+{
+    (void)ctx;
+    __asm volatile("cpsie i" ::: "memory");
+}
+
+static void pico_wait_interrupt(void *ctx)
+{
+    (void)ctx;
+    __asm volatile("wfi");
+}
+
+static const idle_hw pico_hw = {
+    .now_us = pico_now_us,
+    .set_alarm = pico_set_alarm,
+    .cancel_alarm = pico_cancel_alarm,
+    .wait_event = pico_wait_event,
+    .irq_disable = pico_irq_disable,
+    .irq_enable = pico_irq_enable,
+    .wait_interrupt = pico_wait_interrupt,
+    .ctx = 0,
+};
+
+const idle_hw *idle_pico_hw(void)
+{
+    return &pico_hw;
+}
+
+void idle_pico_gate(unsigned long clk_en0, unsigned long clk_en1, unsigned long resets)
+{
+    RESETS_RESET_SET = resets; // リセットしたままにする
+    CLK_WAKE_EN0_CLR = clk_en0; // 1 を書き込んだビットのクロックだけを止める (読み出さない)
+    CLK_WAKE_EN1_CLR = clk_en1;
+    CLK_SLEEP_EN0_CLR = clk_en0;
+    CLK_SLEEP_EN1_CLR = clk_en1;
+    M33_SCR = M33_SCR | SCR_SLEEPDEEP;
+}
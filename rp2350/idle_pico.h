@@ -0,0 +1,21 @@
+#ifndef IDLE_PICO_H
+#define IDLE_PICO_H
+
+#include "idle.h" // アイドル処理
+
+// アイドル処理の実機 (RP2350) 向けの idle_hw
+//
+// reg.h のレジスタを直接操作する。idle_wait_until() はタイマー0のアラーム IDLE_PICO_ALARM を使い、
+// NVIC では割り込みを有効にせずに SEVONPEND で WFE を起こす (割り込みハンドラは要らない)。
+
+#define IDLE_PICO_ALARM 3 // idle_wait_until() が使う TIMER0 のアラーム (他のプログラムが使うアラーム0と重ならない)
+
+// idle_hw を返す
+const idle_hw *idle_pico_hw(void);
+
+// 使わないブロックを止める。clk_en0 / clk_en1 のビット (CLK_EN0_* / CLK_EN1_*) のクロックを起きている間も
+// 眠っている間も止め、resets のビット (RESETS_*) のブロックをリセットしたままにする。
+// さらに SLEEPDEEP を立てて、WFI / WFE の間は CLK_SLEEP_EN のクロックだけを動かすようにする
+void idle_pico_gate(unsigned long clk_en0, unsigned long clk_en1, unsigned long resets);
+
+#endif // IDLE_PICO_H
@@ -0,0 +1,432 @@
+#ifndef REG_H
+#define REG_H
+
+// RP2350 のレジスタ定義
+//
+// このファイルは host/reg_gen.c が生成する。直接編集せず、reg_gen.c の表を直して作り直す (README.md)。
+//
+// * SET / CLR / XOR のエイリアスがあるペリフェラルのレジスタは、_RW (通常のアドレス) と _XOR / _SET / _CLR の
+//   マクロがある。エイリアスへの書き込みは読み出しを伴わない 1 回のストアで、割り込みと競合しない。
+// * GPIO やアラーム、PWM スライスのように同じ形で並ぶレジスタは、番号を引数にとる (IO_BANK0_GPIO_CTRL_RW(n) など)。
+//   番号が定数ならアドレスも定数になり、以前のピンごとのマクロと同じ 1 回のストアになる。
+// * REG_HOST を定義すると、レジスタの代わりにメモリの配列 reg_host_window を読み書きする (host/reg_host.c)。
+//   ホストで、レジスタを直接操作するドライバを動かして確かめたり、時間を測ったりできる。
+
+#ifdef REG_HOST
+// ホストで配列に割り当てるアドレスの範囲 (APB のペリフェラル・SIO・PPB の順に並べる)
+#define REG_HOST_APB_BASE 0x40000000ul // APB のペリフェラル
+#define REG_HOST_APB_SIZE 0x00200000ul
+#define REG_HOST_SIO_BASE 0xd0000000ul // SIO
+#define REG_HOST_SIO_SIZE 0x00020000ul
+#define REG_HOST_PPB_BASE 0xe0000000ul // PPB
+#define REG_HOST_PPB_SIZE 0x00010000ul
+#define REG_HOST_WORDS ((REG_HOST_APB_SIZE + REG_HOST_SIO_SIZE + REG_HOST_PPB_SIZE) / 4)
+
+// ベースアドレス base のペリフェラルの、配列の先頭の要素の番号 (base が定数なら定数になる)
+#define REG_HOST_INDEX(base)                                                                                      \
+    (((base) >= REG_HOST_PPB_BASE   ? (base) - REG_HOST_PPB_BASE + REG_HOST_APB_SIZE + REG_HOST_SIO_SIZE           \
+      : (base) >= REG_HOST_SIO_BASE ? (base) - REG_HOST_SIO_BASE + REG_HOST_APB_SIZE                               \
+                                    : (base) - REG_HOST_APB_BASE) /                                                \
+     4)
+
+extern volatile unsigned long reg_host_window[REG_HOST_WORDS]; // レジスタの代わりのメモリ
+
+// ベースアドレス base からオフセット offset の 32 ビットのレジスタ
+#define REG32(base, offset) (reg_host_window[REG_HOST_INDEX(base) + (offset) / 4])
+#else
+// ベースアドレス base からオフセット offset の 32 ビットのレジスタ
+#define REG32(base, offset) (*(volatile unsigned long *)((base) + (offset)))
+#endif
+
+// -------------------- リセット制御レジスタ (RESETS) --------------------
+#define RESETS_BASE (0x40020000) // リセット制御レジスタのベースアドレス
+
+// 全体リセット制御レジスタ (1 の間そのブロックをリセットしておく)
+#define RESETS_RESET_RW REG32(RESETS_BASE, 0x000 + 0x0000)  // 読み書き
+#define RESETS_RESET_XOR REG32(RESETS_BASE, 0x000 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define RESETS_RESET_SET REG32(RESETS_BASE, 0x000 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define RESETS_RESET_CLR REG32(RESETS_BASE, 0x000 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// リセット完了ステータスレジスタ (各ブロックのリセット完了フラグ)
+#define RESETS_RESET_DONE_RW REG32(RESETS_BASE, 0x008 + 0x0000) // 読み取り専用
+
+// RESETS_RESET のビット (1 の間そのブロックをリセットしておく)
+#define RESETS_ADC (1ul << 0)
+#define RESETS_HSTX (1ul << 3)
+#define RESETS_I2C0 (1ul << 4)
+#define RESETS_I2C1 (1ul << 5)
+#define RESETS_PIO0 (1ul << 11)
+#define RESETS_PIO1 (1ul << 12)
+#define RESETS_PIO2 (1ul << 13)
+#define RESETS_PWM (1ul << 16)
+#define RESETS_SHA256 (1ul << 17)
+#define RESETS_SPI0 (1ul << 18)
+#define RESETS_SPI1 (1ul << 19)
+#define RESETS_TRNG (1ul << 25)
+#define RESETS_UART0 (1ul << 26)
+#define RESETS_UART1 (1ul << 27)
+#define RESETS_USBCTRL (1ul << 28)
+
+// -------------------- シングルIOレジスタ (SIO) --------------------
+#define SIO_BASE (0xd0000000) // シングルIOレジスタのベースアドレス (SET / CLR / XOR は専用のレジスタ)
+
+// GPIO入力レジスタ (各GPIOピンの入力レベル)
+#define SIO_GPIO_IN REG32(SIO_BASE, 0x004)
+
+// GPIO出力データレジスタ (全GPIOピンの出力値)
+#define SIO_GPIO_OUT REG32(SIO_BASE, 0x010)
+
+// 特定のGPIOピンをHIGHにする (1を書き込む)
+#define SIO_GPIO_OUT_SET REG32(SIO_BASE, 0x018)
+
+// 特定のGPIOピンをLOWにする (1を書き込む)
+#define SIO_GPIO_OUT_CLR REG32(SIO_BASE, 0x020)
+
+// 特定のGPIOピンの出力を反転させる (1を書き込む)
+#define SIO_GPIO_OUT_XOR REG32(SIO_BASE, 0x028)
+
+// GPIO出力イネーブルレジスタ (全GPIOピンの出力有効/無効)
+#define SIO_GPIO_OE REG32(SIO_BASE, 0x030)
+
+// 特定のGPIOピンを出力有効にする (1を書き込む)
+#define SIO_GPIO_OE_SET REG32(SIO_BASE, 0x038)
+
+// 特定のGPIOピンを出力無効にする (1を書き込む)
+#define SIO_GPIO_OE_CLR REG32(SIO_BASE, 0x040)
+
+// 特定のGPIOピンの出力イネーブル状態を反転させる (1を書き込む)
+#define SIO_GPIO_OE_XOR REG32(SIO_BASE, 0x048)
+
+// -------------------- IOバンク0レジスタ (IO_BANK0) --------------------
+#define IO_BANK0_BASE (0x40028000) // IOバンク0レジスタのベースアドレス
+
+// GPIOnピンの状態レジスタ (n: 0〜47、入力レベルなど)
+#define IO_BANK0_GPIO_STATUS_RW(n) REG32(IO_BANK0_BASE, 0x000 + 0x8 * (n) + 0x0000) // 読み取り専用
+
+// GPIOnピンの制御レジスタ (n: 0〜47、ビット4〜0: 機能選択。値4でPWM、値5でSIO (GPIO))
+#define IO_BANK0_GPIO_CTRL_RW(n) REG32(IO_BANK0_BASE, 0x004 + 0x8 * (n) + 0x0000)  // 読み書き
+#define IO_BANK0_GPIO_CTRL_XOR(n) REG32(IO_BANK0_BASE, 0x004 + 0x8 * (n) + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define IO_BANK0_GPIO_CTRL_SET(n) REG32(IO_BANK0_BASE, 0x004 + 0x8 * (n) + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define IO_BANK0_GPIO_CTRL_CLR(n) REG32(IO_BANK0_BASE, 0x004 + 0x8 * (n) + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// -------------------- パッド制御レジスタ (PADS_BANK0) --------------------
+#define PADS_BANK0_BASE (0x40038000) // パッド制御レジスタのベースアドレス
+
+// IOの電源電圧の選択 (0: 3.3V、1: 1.8V)
+#define PADS_BANK0_VOLTAGE_SELECT_RW REG32(PADS_BANK0_BASE, 0x000 + 0x0000)  // 読み書き
+#define PADS_BANK0_VOLTAGE_SELECT_XOR REG32(PADS_BANK0_BASE, 0x000 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define PADS_BANK0_VOLTAGE_SELECT_SET REG32(PADS_BANK0_BASE, 0x000 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define PADS_BANK0_VOLTAGE_SELECT_CLR REG32(PADS_BANK0_BASE, 0x000 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// GPIOnピンのパッド制御レジスタ (n: 0〜47、ドライブ強度、プルアップ/プルダウンなど。ビット8: ISO (1 の間パッドを切り離す))
+#define PADS_BANK0_GPIO_RW(n) REG32(PADS_BANK0_BASE, 0x004 + 0x4 * (n) + 0x0000)  // 読み書き
+#define PADS_BANK0_GPIO_XOR(n) REG32(PADS_BANK0_BASE, 0x004 + 0x4 * (n) + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define PADS_BANK0_GPIO_SET(n) REG32(PADS_BANK0_BASE, 0x004 + 0x4 * (n) + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define PADS_BANK0_GPIO_CLR(n) REG32(PADS_BANK0_BASE, 0x004 + 0x4 * (n) + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// -------------------- クロック制御レジスタ (CLOCKS) --------------------
+#define CLK_BASE (0x40010000) // クロック制御レジスタのベースアドレス
+
+// 基準クロック制御レジスタ
+#define CLK_REF_CTRL_RW REG32(CLK_BASE, 0x030 + 0x0000)  // 読み書き
+#define CLK_REF_CTRL_XOR REG32(CLK_BASE, 0x030 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define CLK_REF_CTRL_SET REG32(CLK_BASE, 0x030 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define CLK_REF_CTRL_CLR REG32(CLK_BASE, 0x030 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// システムクロック制御レジスタ
+#define CLK_SYS_CTRL_RW REG32(CLK_BASE, 0x03C + 0x0000)  // 読み書き
+#define CLK_SYS_CTRL_XOR REG32(CLK_BASE, 0x03C + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define CLK_SYS_CTRL_SET REG32(CLK_BASE, 0x03C + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define CLK_SYS_CTRL_CLR REG32(CLK_BASE, 0x03C + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// システムクロック復旧制御レジスタ
+#define CLK_SYS_RESUS_CTRL_RW REG32(CLK_BASE, 0x084 + 0x0000)  // 読み書き
+#define CLK_SYS_RESUS_CTRL_XOR REG32(CLK_BASE, 0x084 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define CLK_SYS_RESUS_CTRL_SET REG32(CLK_BASE, 0x084 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define CLK_SYS_RESUS_CTRL_CLR REG32(CLK_BASE, 0x084 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 起きている間に動かすクロック (ビット n はクロック n、0〜31)
+#define CLK_WAKE_EN0_RW REG32(CLK_BASE, 0x0AC + 0x0000)  // 読み書き
+#define CLK_WAKE_EN0_XOR REG32(CLK_BASE, 0x0AC + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define CLK_WAKE_EN0_SET REG32(CLK_BASE, 0x0AC + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define CLK_WAKE_EN0_CLR REG32(CLK_BASE, 0x0AC + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 起きている間に動かすクロック (ビット n はクロック n + 32、32〜61)
+#define CLK_WAKE_EN1_RW REG32(CLK_BASE, 0x0B0 + 0x0000)  // 読み書き
+#define CLK_WAKE_EN1_XOR REG32(CLK_BASE, 0x0B0 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define CLK_WAKE_EN1_SET REG32(CLK_BASE, 0x0B0 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define CLK_WAKE_EN1_CLR REG32(CLK_BASE, 0x0B0 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// ディープスリープ中に動かすクロック (0〜31)
+#define CLK_SLEEP_EN0_RW REG32(CLK_BASE, 0x0B4 + 0x0000)  // 読み書き
+#define CLK_SLEEP_EN0_XOR REG32(CLK_BASE, 0x0B4 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define CLK_SLEEP_EN0_SET REG32(CLK_BASE, 0x0B4 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define CLK_SLEEP_EN0_CLR REG32(CLK_BASE, 0x0B4 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// ディープスリープ中に動かすクロック (32〜61)
+#define CLK_SLEEP_EN1_RW REG32(CLK_BASE, 0x0B8 + 0x0000)  // 読み書き
+#define CLK_SLEEP_EN1_XOR REG32(CLK_BASE, 0x0B8 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define CLK_SLEEP_EN1_SET REG32(CLK_BASE, 0x0B8 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define CLK_SLEEP_EN1_CLR REG32(CLK_BASE, 0x0B8 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 今動いているクロック (0〜31)
+#define CLK_ENABLED0_RW REG32(CLK_BASE, 0x0BC + 0x0000) // 読み取り専用
+
+// 今動いているクロック (32〜61)
+#define CLK_ENABLED1_RW REG32(CLK_BASE, 0x0C0 + 0x0000) // 読み取り専用
+
+// WAKE_EN0 / SLEEP_EN0 のビット
+#define CLK_EN0_ADC (1ul << 2)         // clk_adc
+#define CLK_EN0_SYS_ADC (1ul << 3)     // clk_sys_adc
+#define CLK_EN0_HSTX (1ul << 9)        // clk_hstx
+#define CLK_EN0_SYS_HSTX (1ul << 10)   // clk_sys_hstx
+#define CLK_EN0_SYS_I2C0 (1ul << 11)   // clk_sys_i2c0
+#define CLK_EN0_SYS_I2C1 (1ul << 12)   // clk_sys_i2c1
+#define CLK_EN0_SYS_PIO0 (1ul << 18)   // clk_sys_pio0
+#define CLK_EN0_SYS_PIO1 (1ul << 19)   // clk_sys_pio1
+#define CLK_EN0_SYS_PIO2 (1ul << 20)   // clk_sys_pio2
+#define CLK_EN0_SYS_PWM (1ul << 25)    // clk_sys_pwm
+#define CLK_EN0_SYS_SHA256 (1ul << 30) // clk_sys_sha256
+
+// WAKE_EN1 / SLEEP_EN1 のビット
+#define CLK_EN1_PERI_SPI0 (1ul << 0)    // clk_peri_spi0
+#define CLK_EN1_SYS_SPI0 (1ul << 1)     // clk_sys_spi0
+#define CLK_EN1_PERI_SPI1 (1ul << 2)    // clk_peri_spi1
+#define CLK_EN1_SYS_SPI1 (1ul << 3)     // clk_sys_spi1
+#define CLK_EN1_SYS_TRNG (1ul << 21)    // clk_sys_trng
+#define CLK_EN1_PERI_UART0 (1ul << 22)  // clk_peri_uart0
+#define CLK_EN1_SYS_UART0 (1ul << 23)   // clk_sys_uart0
+#define CLK_EN1_PERI_UART1 (1ul << 24)  // clk_peri_uart1
+#define CLK_EN1_SYS_UART1 (1ul << 25)   // clk_sys_uart1
+#define CLK_EN1_SYS_USBCTRL (1ul << 26) // clk_sys_usbctrl
+#define CLK_EN1_USB (1ul << 27)         // clk_usb
+
+// -------------------- 外部水晶発振器レジスタ (XOSC) --------------------
+#define XOSC_BASE (0x40048000) // 外部水晶発振器レジスタのベースアドレス
+
+// 外部水晶発振器制御レジスタ
+#define XOSC_CTRL_RW REG32(XOSC_BASE, 0x000 + 0x0000)  // 読み書き
+#define XOSC_CTRL_XOR REG32(XOSC_BASE, 0x000 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define XOSC_CTRL_SET REG32(XOSC_BASE, 0x000 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define XOSC_CTRL_CLR REG32(XOSC_BASE, 0x000 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 外部水晶発振器ステータスレジスタ
+#define XOSC_STATUS_RW REG32(XOSC_BASE, 0x004 + 0x0000)  // 読み書き
+#define XOSC_STATUS_XOR REG32(XOSC_BASE, 0x004 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define XOSC_STATUS_SET REG32(XOSC_BASE, 0x004 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define XOSC_STATUS_CLR REG32(XOSC_BASE, 0x004 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 外部水晶発振器起動制御レジスタ
+#define XOSC_STARTUP_RW REG32(XOSC_BASE, 0x00C + 0x0000)  // 読み書き
+#define XOSC_STARTUP_XOR REG32(XOSC_BASE, 0x00C + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define XOSC_STARTUP_SET REG32(XOSC_BASE, 0x00C + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define XOSC_STARTUP_CLR REG32(XOSC_BASE, 0x00C + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 外部水晶発振器カウンタレジスタ
+#define XOSC_COUNT_RW REG32(XOSC_BASE, 0x010 + 0x0000)  // 読み書き
+#define XOSC_COUNT_XOR REG32(XOSC_BASE, 0x010 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define XOSC_COUNT_SET REG32(XOSC_BASE, 0x010 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define XOSC_COUNT_CLR REG32(XOSC_BASE, 0x010 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// -------------------- タイマー0レジスタ (TIMER0) --------------------
+#define TIMER0_BASE (0x400b0000) // タイマー0レジスタのベースアドレス
+
+// タイマー上位32ビット (書き込み。TIMELW の後に書くと両方が反映される)
+#define TIMER0_TIMEHW_RW REG32(TIMER0_BASE, 0x000 + 0x0000) // 書き込み専用
+
+// タイマー下位32ビット (書き込み)
+#define TIMER0_TIMELW_RW REG32(TIMER0_BASE, 0x004 + 0x0000) // 書き込み専用
+
+// タイマー上位32ビット (TIMELR を読んだときにラッチした値。ラッチは 1 つなので割り込みと競合する)
+#define TIMER0_TIMEHR_RW REG32(TIMER0_BASE, 0x008 + 0x0000) // 読み取り専用
+
+// タイマー下位32ビット (読むと上位をラッチする)
+#define TIMER0_TIMELR_RW REG32(TIMER0_BASE, 0x00C + 0x0000) // 読み取り専用
+
+// アラームn設定値 (n: 0〜3。タイマーの下位32ビットと一致したときに割り込み番号nの割り込みが起きる)
+#define TIMER0_ALARM_RW(n) REG32(TIMER0_BASE, 0x010 + 0x4 * (n) + 0x0000)  // 読み書き
+#define TIMER0_ALARM_XOR(n) REG32(TIMER0_BASE, 0x010 + 0x4 * (n) + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER0_ALARM_SET(n) REG32(TIMER0_BASE, 0x010 + 0x4 * (n) + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER0_ALARM_CLR(n) REG32(TIMER0_BASE, 0x010 + 0x4 * (n) + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// アラーム有効ビット (1 を書き込むとアラームが止まる)
+#define TIMER0_ARMED_RW REG32(TIMER0_BASE, 0x020 + 0x0000) // 1 を書き込んだビットがクリアされる
+
+// 生タイマー上位32ビット (ラッチしない)
+#define TIMER0_TIMERAWH_RW REG32(TIMER0_BASE, 0x024 + 0x0000) // 読み取り専用
+
+// 生タイマー下位32ビット (ラッチしない)
+#define TIMER0_TIMERAWL_RW REG32(TIMER0_BASE, 0x028 + 0x0000) // 読み取り専用
+
+// デバッグポーズ制御 (デバッグ時にタイマーを止める)
+#define TIMER0_DBGPAUSE_RW REG32(TIMER0_BASE, 0x02C + 0x0000)  // 読み書き
+#define TIMER0_DBGPAUSE_XOR REG32(TIMER0_BASE, 0x02C + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER0_DBGPAUSE_SET REG32(TIMER0_BASE, 0x02C + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER0_DBGPAUSE_CLR REG32(TIMER0_BASE, 0x02C + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// タイマー一時停止制御
+#define TIMER0_PAUSE_RW REG32(TIMER0_BASE, 0x030 + 0x0000)  // 読み書き
+#define TIMER0_PAUSE_XOR REG32(TIMER0_BASE, 0x030 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER0_PAUSE_SET REG32(TIMER0_BASE, 0x030 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER0_PAUSE_CLR REG32(TIMER0_BASE, 0x030 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// ロック制御 (書き込み保護)
+#define TIMER0_LOCKED_RW REG32(TIMER0_BASE, 0x034 + 0x0000)  // 読み書き
+#define TIMER0_LOCKED_XOR REG32(TIMER0_BASE, 0x034 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER0_LOCKED_SET REG32(TIMER0_BASE, 0x034 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER0_LOCKED_CLR REG32(TIMER0_BASE, 0x034 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// クロックソース選択
+#define TIMER0_SOURCE_RW REG32(TIMER0_BASE, 0x038 + 0x0000)  // 読み書き
+#define TIMER0_SOURCE_XOR REG32(TIMER0_BASE, 0x038 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER0_SOURCE_SET REG32(TIMER0_BASE, 0x038 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER0_SOURCE_CLR REG32(TIMER0_BASE, 0x038 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 割り込み要求フラグ (1 を書き込むとクリア)
+#define TIMER0_INTR_RW REG32(TIMER0_BASE, 0x03C + 0x0000) // 1 を書き込んだビットがクリアされる
+
+// 割り込みイネーブルビット
+#define TIMER0_INTE_RW REG32(TIMER0_BASE, 0x040 + 0x0000)  // 読み書き
+#define TIMER0_INTE_XOR REG32(TIMER0_BASE, 0x040 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER0_INTE_SET REG32(TIMER0_BASE, 0x040 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER0_INTE_CLR REG32(TIMER0_BASE, 0x040 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 割り込み強制フラグ
+#define TIMER0_INTF_RW REG32(TIMER0_BASE, 0x044 + 0x0000)  // 読み書き
+#define TIMER0_INTF_XOR REG32(TIMER0_BASE, 0x044 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER0_INTF_SET REG32(TIMER0_BASE, 0x044 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER0_INTF_CLR REG32(TIMER0_BASE, 0x044 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 割り込みステータス (INTE と INTF を反映した後の割り込み)
+#define TIMER0_INTS_RW REG32(TIMER0_BASE, 0x048 + 0x0000) // 読み取り専用
+
+// -------------------- タイマー1レジスタ (TIMER1) --------------------
+#define TIMER1_BASE (0x400b8000) // タイマー1レジスタのベースアドレス
+
+// タイマー上位32ビット (書き込み。TIMELW の後に書くと両方が反映される)
+#define TIMER1_TIMEHW_RW REG32(TIMER1_BASE, 0x000 + 0x0000) // 書き込み専用
+
+// タイマー下位32ビット (書き込み)
+#define TIMER1_TIMELW_RW REG32(TIMER1_BASE, 0x004 + 0x0000) // 書き込み専用
+
+// タイマー上位32ビット (TIMELR を読んだときにラッチした値。ラッチは 1 つなので割り込みと競合する)
+#define TIMER1_TIMEHR_RW REG32(TIMER1_BASE, 0x008 + 0x0000) // 読み取り専用
+
+// タイマー下位32ビット (読むと上位をラッチする)
+#define TIMER1_TIMELR_RW REG32(TIMER1_BASE, 0x00C + 0x0000) // 読み取り専用
+
+// アラームn設定値 (n: 0〜3。タイマーの下位32ビットと一致したときに割り込み番号nの割り込みが起きる)
+#define TIMER1_ALARM_RW(n) REG32(TIMER1_BASE, 0x010 + 0x4 * (n) + 0x0000)  // 読み書き
+#define TIMER1_ALARM_XOR(n) REG32(TIMER1_BASE, 0x010 + 0x4 * (n) + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER1_ALARM_SET(n) REG32(TIMER1_BASE, 0x010 + 0x4 * (n) + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER1_ALARM_CLR(n) REG32(TIMER1_BASE, 0x010 + 0x4 * (n) + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// アラーム有効ビット (1 を書き込むとアラームが止まる)
+#define TIMER1_ARMED_RW REG32(TIMER1_BASE, 0x020 + 0x0000) // 1 を書き込んだビットがクリアされる
+
+// 生タイマー上位32ビット (ラッチしない)
+#define TIMER1_TIMERAWH_RW REG32(TIMER1_BASE, 0x024 + 0x0000) // 読み取り専用
+
+// 生タイマー下位32ビット (ラッチしない)
+#define TIMER1_TIMERAWL_RW REG32(TIMER1_BASE, 0x028 + 0x0000) // 読み取り専用
+
+// デバッグポーズ制御 (デバッグ時にタイマーを止める)
+#define TIMER1_DBGPAUSE_RW REG32(TIMER1_BASE, 0x02C + 0x0000)  // 読み書き
+#define TIMER1_DBGPAUSE_XOR REG32(TIMER1_BASE, 0x02C + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER1_DBGPAUSE_SET REG32(TIMER1_BASE, 0x02C + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER1_DBGPAUSE_CLR REG32(TIMER1_BASE, 0x02C + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// タイマー一時停止制御
+#define TIMER1_PAUSE_RW REG32(TIMER1_BASE, 0x030 + 0x0000)  // 読み書き
+#define TIMER1_PAUSE_XOR REG32(TIMER1_BASE, 0x030 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER1_PAUSE_SET REG32(TIMER1_BASE, 0x030 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER1_PAUSE_CLR REG32(TIMER1_BASE, 0x030 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// ロック制御 (書き込み保護)
+#define TIMER1_LOCKED_RW REG32(TIMER1_BASE, 0x034 + 0x0000)  // 読み書き
+#define TIMER1_LOCKED_XOR REG32(TIMER1_BASE, 0x034 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER1_LOCKED_SET REG32(TIMER1_BASE, 0x034 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER1_LOCKED_CLR REG32(TIMER1_BASE, 0x034 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// クロックソース選択
+#define TIMER1_SOURCE_RW REG32(TIMER1_BASE, 0x038 + 0x0000)  // 読み書き
+#define TIMER1_SOURCE_XOR REG32(TIMER1_BASE, 0x038 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER1_SOURCE_SET REG32(TIMER1_BASE, 0x038 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER1_SOURCE_CLR REG32(TIMER1_BASE, 0x038 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 割り込み要求フラグ (1 を書き込むとクリア)
+#define TIMER1_INTR_RW REG32(TIMER1_BASE, 0x03C + 0x0000) // 1 を書き込んだビットがクリアされる
+
+// 割り込みイネーブルビット
+#define TIMER1_INTE_RW REG32(TIMER1_BASE, 0x040 + 0x0000)  // 読み書き
+#define TIMER1_INTE_XOR REG32(TIMER1_BASE, 0x040 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER1_INTE_SET REG32(TIMER1_BASE, 0x040 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER1_INTE_CLR REG32(TIMER1_BASE, 0x040 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 割り込み強制フラグ
+#define TIMER1_INTF_RW REG32(TIMER1_BASE, 0x044 + 0x0000)  // 読み書き
+#define TIMER1_INTF_XOR REG32(TIMER1_BASE, 0x044 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define TIMER1_INTF_SET REG32(TIMER1_BASE, 0x044 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define TIMER1_INTF_CLR REG32(TIMER1_BASE, 0x044 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 割り込みステータス (INTE と INTF を反映した後の割り込み)
+#define TIMER1_INTS_RW REG32(TIMER1_BASE, 0x048 + 0x0000) // 読み取り専用
+
+// -------------------- PWMレジスタ (PWM) --------------------
+#define PWM_BASE (0x400a8000) // PWMレジスタのベースアドレス (スライス 0〜11、GPIOn はスライス (n >> 1) & 7 のチャンネル A (偶数) / B (奇数))
+
+// スライスnの制御・ステータスレジスタ (n: 0〜11、ビット0: 有効)
+#define PWM_CH_CSR_RW(n) REG32(PWM_BASE, 0x000 + 0x14 * (n) + 0x0000)  // 読み書き
+#define PWM_CH_CSR_XOR(n) REG32(PWM_BASE, 0x000 + 0x14 * (n) + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define PWM_CH_CSR_SET(n) REG32(PWM_BASE, 0x000 + 0x14 * (n) + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define PWM_CH_CSR_CLR(n) REG32(PWM_BASE, 0x000 + 0x14 * (n) + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// スライスnのクロック分周 (ビット11〜4: 整数部、ビット3〜0: 小数部)
+#define PWM_CH_DIV_RW(n) REG32(PWM_BASE, 0x004 + 0x14 * (n) + 0x0000)  // 読み書き
+#define PWM_CH_DIV_XOR(n) REG32(PWM_BASE, 0x004 + 0x14 * (n) + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define PWM_CH_DIV_SET(n) REG32(PWM_BASE, 0x004 + 0x14 * (n) + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define PWM_CH_DIV_CLR(n) REG32(PWM_BASE, 0x004 + 0x14 * (n) + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// スライスnのカウンタ
+#define PWM_CH_CTR_RW(n) REG32(PWM_BASE, 0x008 + 0x14 * (n) + 0x0000)  // 読み書き
+#define PWM_CH_CTR_XOR(n) REG32(PWM_BASE, 0x008 + 0x14 * (n) + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define PWM_CH_CTR_SET(n) REG32(PWM_BASE, 0x008 + 0x14 * (n) + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define PWM_CH_CTR_CLR(n) REG32(PWM_BASE, 0x008 + 0x14 * (n) + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// スライスnの比較値 (ビット15〜0: チャンネルA、ビット31〜16: チャンネルB。カウンタが比較値より小さい間 HIGH、周期の終わりに反映)
+#define PWM_CH_CC_RW(n) REG32(PWM_BASE, 0x00C + 0x14 * (n) + 0x0000)  // 読み書き
+#define PWM_CH_CC_XOR(n) REG32(PWM_BASE, 0x00C + 0x14 * (n) + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define PWM_CH_CC_SET(n) REG32(PWM_BASE, 0x00C + 0x14 * (n) + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define PWM_CH_CC_CLR(n) REG32(PWM_BASE, 0x00C + 0x14 * (n) + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// スライスnのカウンタの最大値 (周期 = TOP + 1 カウント)
+#define PWM_CH_TOP_RW(n) REG32(PWM_BASE, 0x010 + 0x14 * (n) + 0x0000)  // 読み書き
+#define PWM_CH_TOP_XOR(n) REG32(PWM_BASE, 0x010 + 0x14 * (n) + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define PWM_CH_TOP_SET(n) REG32(PWM_BASE, 0x010 + 0x14 * (n) + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define PWM_CH_TOP_CLR(n) REG32(PWM_BASE, 0x010 + 0x14 * (n) + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// 全スライスの有効ビット (各スライスの CSR のビット0 と同じ。まとめて書き込むと同時に動き出す)
+#define PWM_EN_RW REG32(PWM_BASE, 0x0F0 + 0x0000)  // 読み書き
+#define PWM_EN_XOR REG32(PWM_BASE, 0x0F0 + 0x1000) // 排他的論理和 (1を書き込んだビットが反転する)
+#define PWM_EN_SET REG32(PWM_BASE, 0x0F0 + 0x2000) // ビットセット (1を書き込んだビットが1になる)
+#define PWM_EN_CLR REG32(PWM_BASE, 0x0F0 + 0x3000) // ビットクリア (1を書き込んだビットが0になる)
+
+// -------------------- Cortex-M33 のシステム制御 (PPB) --------------------
+#define PPB_BASE (0xe0000000) // プライベート周辺バスのベースアドレス
+
+// NVIC の割り込み保留クリア (ビット n に 1 を書き込むと割り込み番号 n の保留を取り消す)
+#define NVIC_ICPR0 REG32(PPB_BASE, 0xE280)
+
+// システム制御レジスタ (ビット2 SLEEPDEEP: WFI/WFE でディープスリープ、ビット4 SEVONPEND: 保留になった割り込みで WFE から起きる)
+#define M33_SCR REG32(PPB_BASE, 0xED10)
+
+// デバッグ例外とモニタの制御 (ビット24 TRCENA: DWT などのトレース機能を動かす)
+#define M33_DEMCR REG32(PPB_BASE, 0xEDFC)
+
+// DWT の制御 (ビット0 CYCCNTENA: サイクルカウンタを動かす)
+#define DWT_CTRL REG32(PPB_BASE, 0x1000)
+
+// サイクルカウンタ (CPU のクロックごとに 1 増える 32 ビットのカウンタ。WFI / WFE で眠っている間は止まる)
+#define DWT_CYCCNT REG32(PPB_BASE, 0x1004)
+
+#endif // REG_H
@@ -0,0 +1,41 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+// 時刻とサイクル数の読み出し
+//
+// timebase_now_us() は TIMER0 の 64 ビットの時刻 [us] を返す。以前の get_time() のように TIMELR → TIMEHR の順に
+// 読むと、TIMELR を読んだときに上位がラッチされるので 1 回だけなら正しいが、ラッチは 1 つしかないので、
+// 間に割り込みの中で時刻を読むとラッチが上書きされて上位と下位が食い違う。ここではラッチを使わない
+// TIMERAWH / TIMERAWL を読み、上位を読み直して下位を読む間の桁上がりを除くので、割り込みの中からも呼べる。
+//
+// TIMEBASE_CYCLES() は CPU のクロックごとに 1 増える 32 ビットのカウンタ (実機では DWT_CYCCNT) を読む。
+// 150MHz で約 28.6 秒で一周するので、短い区間を引き算で測る (一周しても符号なしの引き算で正しく求まる)。
+// WFI / WFE で眠っている間は止まる。SysTick (24 ビット、減っていく) は使わない。
+//
+// 実装は実機なら timebase_pico.c、ホストなら host/timebase_host.c (TIMEBASE_HOST を定義してビルドする)。
+
+#define TIMEBASE_CYCLES_PER_US 150 // 1 us あたりのサイクル数 (clk_sys 150MHz)
+
+#ifdef TIMEBASE_HOST
+#define TIMEBASE_CYCLES() timebase_cycles()
+#else
+#include "reg.h" // レジスタ定義
+#define TIMEBASE_CYCLES() (DWT_CYCCNT) // 関数を呼ばずにカウンタを直接読む
+#endif
+
+// サイクルカウンタを動かす (最初に 1 回呼ぶ)
+void timebase_init(void);
+
+// 現在時刻 [us] (64 ビット。割り込みの中からも呼べる)
+unsigned long long timebase_now_us(void);
+
+// サイクルカウンタの値
+unsigned long timebase_cycles(void);
+
+// サイクル数を ns に変換する
+static inline unsigned long long timebase_cycles_to_ns(unsigned long cycles)
+{
+    return (unsigned long long)cycles * 1000 / TIMEBASE_CYCLES_PER_US;
+}
+
+#endif // TIMEBASE_H
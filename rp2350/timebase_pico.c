@@ -0,0 +1,29 @@
+#include "reg.h"      // レジスタ定義
+#include "timebase.h" // 時刻とサイクル数の読み出し
+
+#define DEMCR_TRCENA (1ul << 24)   // M33_DEMCR: DWT を動かす
+#define DWT_CTRL_CYCCNTENA (1ul << 0) // DWT_CTRL: サイクルカウンタを動かす
+
+void timebase_init(void)
+{
+    M33_DEMCR = M33_DEMCR | DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL = DWT_CTRL | DWT_CTRL_CYCCNTENA;
+}
+
+unsigned long long timebase_now_us(void)
+{
+    // 上位を読み直して、下位を読む間に桁上がりした場合を除く (ラッチを使わないので割り込みと競合しない)
+    unsigned long hi, lo;
+    do
+    {
+        hi = TIMER0_TIMERAWH_RW;
+        lo = TIMER0_TIMERAWL_RW;
+    } while (hi != TIMER0_TIMERAWH_RW);
+    return (unsigned long long)hi << 32 | lo;
+}
+
+unsigned long timebase_cycles(void)
+{
+    return DWT_CYCCNT;
+}
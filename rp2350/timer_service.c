@@ -0,0 +1,204 @@
+#include "timer_service.h" // タイマーサービス
+
+// アラームはタイマーの下位 32 ビットと比べるので、これより先の期限には途中で一度割り込んで設定し直す
+#define ALARM_MAX_AHEAD_US 0x80000000ull
+
+// ヒープの位置 i にタイマーを置く
+static void place(timer_service *ts, int i, timer_event *ev)
+{
+    ts->heap[i] = ev;
+    ev->index = i;
+}
+
+// 位置 i のタイマーを、親より期限が早い間は上に移す
+static void sift_up(timer_service *ts, int i)
+{
+    timer_event *ev = ts->heap[i];
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (ts->heap[parent]->deadline_us <= ev->deadline_us)
+        {
+            break;
+        }
+        place(ts, i, ts->heap[parent]);
+        i = parent;
+    }
+    place(ts, i, ev);
+}
+
+// 位置 i のタイマーを、子より期限が遅い間は下に移す
+static void sift_down(timer_service *ts, int i)
+{
+    timer_event *ev = ts->heap[i];
+    while (1)
+    {
+        int child = 2 * i + 1;
+        if (child >= ts->count)
+        {
+            break;
+        }
+        if (child + 1 < ts->count && ts->heap[child + 1]->deadline_us < ts->heap[child]->deadline_us)
+        {
+            child++;
+        }
+        if (ts->heap[child]->deadline_us >= ev->deadline_us)
+        {
+            break;
+        }
+        place(ts, i, ts->heap[child]);
+        i = child;
+    }
+    place(ts, i, ev);
+}
+
+// 位置 i のタイマーをヒープから取り除く (最後のタイマーを空いた位置に移して並べ直す)
+static void remove_at(timer_service *ts, int i)
+{
+    timer_event *last = ts->heap[--ts->count];
+    ts->heap[i]->index = -1;
+    if (i < ts->count)
+    {
+        place(ts, i, last);
+        sift_up(ts, i);
+        sift_down(ts, last->index);
+    }
+}
+
+// 最も早い期限にアラームを設定する。設定している間に期限を過ぎていたら 1 を返す
+static int arm(timer_service *ts)
+{
+    const timer_service_hw *hw = ts->hw;
+    if (ts->count == 0)
+    {
+        return 0; // 前に設定したアラームが残っていても、割り込みで何もせずに戻るだけ
+    }
+    unsigned long long deadline = ts->heap[0]->deadline_us;
+    unsigned long long now = hw->now_us(hw->ctx);
+    if (deadline > now && deadline - now > ALARM_MAX_AHEAD_US)
+    {
+        deadline = now + ALARM_MAX_AHEAD_US;
+    }
+    hw->set_alarm(hw->ctx, deadline);
+    return hw->now_us(hw->ctx) >= deadline;
+}
+
+void timer_service_init(timer_service *ts, const timer_service_hw *hw, timer_event **heap, int capacity)
+{
+    ts->hw = hw;
+    ts->heap = heap;
+    ts->capacity = capacity;
+    ts->count = 0;
+    ts->handling = 0;
+    ts->stats = (timer_service_stats){0};
+}
+
+void timer_event_init(timer_event *ev, timer_callback callback, void *arg)
+{
+    ev->deadline_us = 0;
+    ev->period_us = 0;
+    ev->callback = callback;
+    ev->arg = arg;
+    ev->index = -1;
+}
+
+int timer_service_start_at(timer_service *ts, timer_event *ev, unsigned long long deadline_us, unsigned long period_us)
+{
+    ev->deadline_us = deadline_us;
+    ev->period_us = period_us;
+    if (ev->index >= 0)
+    {
+        // 動いているタイマーの期限を変える
+        sift_up(ts, ev->index);
+        sift_down(ts, ev->index);
+    }
+    else
+    {
+        if (ts->count == ts->capacity)
+        {
+            return -1;
+        }
+        place(ts, ts->count++, ev);
+        sift_up(ts, ev->index);
+        if ((unsigned long)ts->count > ts->stats.max_count)
+        {
+            ts->stats.max_count = ts->count;
+        }
+    }
+
+    // 最も早い期限になった場合はアラームを設定し直す (割り込みの中では最後にまとめて設定する)
+    if (ev->index == 0 && !ts->handling && arm(ts))
+    {
+        ts->hw->trigger(ts->hw->ctx);
+    }
+    return 0;
+}
+
+int timer_service_start(timer_service *ts, timer_event *ev, unsigned long delay_us, unsigned long period_us)
+{
+    return timer_service_start_at(ts, ev, ts->hw->now_us(ts->hw->ctx) + delay_us, period_us);
+}
+
+void timer_service_cancel(timer_service *ts, timer_event *ev)
+{
+    if (ev->index >= 0)
+    {
+        remove_at(ts, ev->index); // アラームは設定し直さない (早く割り込んでも、期限が来ていなければ設定し直すだけ)
+    }
+}
+
+int timer_event_active(const timer_event *ev)
+{
+    return ev->index >= 0;
+}
+
+void timer_service_handle(timer_service *ts)
+{
+    const timer_service_hw *hw = ts->hw;
+    hw->clear_irq(hw->ctx);
+    ts->stats.interrupts++;
+    ts->handling = 1;
+
+    do
+    {
+        unsigned long long now = hw->now_us(hw->ctx);
+        // 期限が来たタイマーを期限の順に処理する
+        while (ts->count > 0 && ts->heap[0]->deadline_us <= now)
+        {
+            timer_event *ev = ts->heap[0];
+            if (now - ev->deadline_us > ts->stats.max_latency_us)
+            {
+                ts->stats.max_latency_us = (unsigned long)(now - ev->deadline_us);
+            }
+            if (ev->period_us)
+            {
+                // 前の期限から次の期限を決める (遅れを積み重ねない)。期限を過ぎた回は飛ばす
+                ev->deadline_us += ev->period_us;
+                if (ev->deadline_us <= now)
+                {
+                    unsigned long long skipped = (now - ev->deadline_us) / ev->period_us + 1;
+                    ev->deadline_us += skipped * ev->period_us;
+                    ts->stats.overruns += (unsigned long)skipped;
+                }
+                sift_down(ts, 0);
+            }
+            else
+            {
+                remove_at(ts, 0);
+            }
+
+            // コールバックの中でタイマーを止めたり動かしたりできるよう、ヒープを並べ直してから呼ぶ
+            ts->stats.callbacks++;
+            ev->callback(ev, ev->arg);
+            now = hw->now_us(hw->ctx);
+        }
+
+        // 次の期限にアラームを設定する。設定している間に期限を過ぎていたら続けて処理する
+    } while (arm(ts));
+    ts->handling = 0;
+}
+
+const timer_service_stats *timer_service_get_stats(const timer_service *ts)
+{
+    return &ts->stats;
+}
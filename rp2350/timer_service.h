@@ -0,0 +1,97 @@
+#ifndef TIMER_SERVICE_H
+#define TIMER_SERVICE_H
+
+// 1 つのハードウェアアラームで、任意の数の単発・周期タイマーを動かすタイマーサービス
+//
+// タイマー (timer_event) は期限 (絶対時刻 [us]) の小さい順の二分ヒープ (最小ヒープ) に入れ、
+// ハードウェアのアラームは先頭 (最も早い期限) にだけ設定する。割り込みは期限が来たときだけ起き、
+// 一定間隔の割り込み (ティック) は使わない。追加・取り消し・期限の更新はヒープの高さ分 O(log n) で済む。
+//
+// 周期タイマーは前の期限に周期を足して次の期限にする (「今」からではない) ので、割り込みやコールバックの
+// 遅れが次の周期に積み重ならない。遅れが周期を超えて期限を過ぎた回は飛ばし、overruns に数える。
+//
+// RP2350 の TIMER0 にはアラームが 4 つ (割り込み番号 0〜3) あるので、timer_service を 4 つまで作れる
+// (例えば software_pwm がアラーム0を使い、こちらはアラーム1を使う)。
+// アラームの設定と現在時刻の読み出しは timer_service_hw の関数で行う。blink_interrupt の host/timer_sim は
+// 割り込みの遅れを加えた仮想のアラームで数千個のタイマーを動かし、ヒープの順序と期限の遅れを確かめる。
+// 実機では timer_service_pico.h の timer_service_pico_hw() がレジスタを直接操作する実装を返す。
+//
+// timer_service_start*() / timer_service_cancel() は、タイマーの割り込みの中 (コールバックを含む) か、
+// その割り込みを止めた状態で呼ぶこと。
+
+typedef struct timer_event timer_event;
+
+// 期限が来たときに呼ばれる関数。割り込みの中から呼ばれる
+typedef void (*timer_callback)(timer_event *ev, void *arg);
+
+// タイマー (呼び出し側が確保する)
+struct timer_event
+{
+    unsigned long long deadline_us; // 期限 (絶対時刻 [us])
+    unsigned long period_us;        // 周期 [us] (0 なら単発)
+    timer_callback callback;        // 期限が来たときに呼ぶ関数
+    void *arg;                      // callback に渡す引数
+    int index;                      // ヒープの中の位置 (-1 なら止まっている)
+};
+
+// ハードウェアへのアクセス手段
+typedef struct
+{
+    // 現在時刻 [us]
+    unsigned long long (*now_us)(void *ctx);
+    // 指定した時刻に割り込みが起きるようにする (時刻を過ぎていたら起きないことがある)
+    void (*set_alarm)(void *ctx, unsigned long long time_us);
+    // すぐに割り込みを起こす (アラームの時刻を過ぎていたときに使う)
+    void (*trigger)(void *ctx);
+    // 割り込みの要因をクリアする (timer_service_handle() の最初に呼ぶ)
+    void (*clear_irq)(void *ctx);
+    void *ctx; // 上記関数に渡すコンテキスト
+} timer_service_hw;
+
+// 統計
+typedef struct
+{
+    unsigned long interrupts;     // timer_service_handle() の呼び出し回数
+    unsigned long callbacks;      // 呼んだコールバックの数
+    unsigned long overruns;       // 期限を過ぎて飛ばした周期タイマーの回数
+    unsigned long max_latency_us; // 期限からコールバックまでの遅れの最大値 [us]
+    unsigned long max_count;      // ヒープに入っていたタイマーの数の最大値
+} timer_service_stats;
+
+// タイマーサービス
+typedef struct
+{
+    const timer_service_hw *hw; // ハードウェア
+    timer_event **heap;         // 期限の小さい順の最小ヒープ (heap[0] が最も早い)
+    int capacity;               // heap の要素数
+    int count;                  // ヒープに入っているタイマーの数
+    int handling;               // timer_service_handle() の中なら 1 (アラームは最後にまとめて設定する)
+    timer_service_stats stats;  // 統計
+} timer_service;
+
+// 最大 capacity 個のタイマーを入れられる heap (呼び出し側が確保する) でタイマーサービスを初期化する
+void timer_service_init(timer_service *ts, const timer_service_hw *hw, timer_event **heap, int capacity);
+
+// タイマーを初期化する (止まった状態)
+void timer_event_init(timer_event *ev, timer_callback callback, void *arg);
+
+// タイマーを絶対時刻 deadline_us から、period_us ごと (0 なら 1 回だけ) に動かす
+// 動いているタイマーなら期限を変える。ヒープが一杯なら -1、成功したら 0 を返す
+int timer_service_start_at(timer_service *ts, timer_event *ev, unsigned long long deadline_us, unsigned long period_us);
+
+// タイマーを今から delay_us 後に、period_us ごと (0 なら 1 回だけ) に動かす
+int timer_service_start(timer_service *ts, timer_event *ev, unsigned long delay_us, unsigned long period_us);
+
+// タイマーを止める (止まっていれば何もしない)
+void timer_service_cancel(timer_service *ts, timer_event *ev);
+
+// タイマーが動いていれば 1 を返す
+int timer_event_active(const timer_event *ev);
+
+// タイマーの割り込みから呼ぶ。期限が来たタイマーのコールバックを期限の順に呼び、次の期限にアラームを設定する
+void timer_service_handle(timer_service *ts);
+
+// 統計を返す
+const timer_service_stats *timer_service_get_stats(const timer_service *ts);
+
+#endif // TIMER_SERVICE_H
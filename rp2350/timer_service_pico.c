@@ -0,0 +1,48 @@
+#include "reg.h"                // レジスタ定義
+#include "timer_service_pico.h" // 実機向けの timer_service_hw
+#include "timebase.h"           // 時刻の読み出し
+
+#define NUM_ALARMS 4 // TIMER0 のアラームの数
+
+static unsigned long long pico_now_us(void *ctx)
+{
+    (void)ctx;
+    return timebase_now_us();
+}
+
+static void pico_set_alarm(void *ctx, unsigned long long time_us)
+{
+    unsigned alarm = *(const unsigned char *)ctx;
+    TIMER0_ALARM_RW(alarm) = (unsigned long)time_us; // 下位 32 ビットが一致したときに割り込む
+}
+
+static void pico_trigger(void *ctx)
+{
+    unsigned alarm = *(const unsigned char *)ctx;
+    TIMER0_INTF_SET = 1ul << alarm; // 割り込みを強制する
+}
+
+static void pico_clear_irq(void *ctx)
+{
+    unsigned alarm = *(const unsigned char *)ctx;
+    TIMER0_INTF_CLR = 1ul << alarm; // 強制した割り込みを戻す
+    TIMER0_INTR_RW = 1ul << alarm;  // アラームの割り込みフラグをクリア
+}
+
+static const unsigned char alarm_numbers[NUM_ALARMS] = {0, 1, 2, 3}; // ctx が指すアラームの番号
+
+#define PICO_HW(n)                           \
+    {                                        \
+        .now_us = pico_now_us,               \
+        .set_alarm = pico_set_alarm,         \
+        .trigger = pico_trigger,             \
+        .clear_irq = pico_clear_irq,         \
+        .ctx = (void *)&alarm_numbers[n],    \
+    }
+
+static const timer_service_hw pico_hw[NUM_ALARMS] = {PICO_HW(0), PICO_HW(1), PICO_HW(2), PICO_HW(3)};
+
+const timer_service_hw *timer_service_pico_hw(unsigned alarm)
+{
+    return &pico_hw[alarm < NUM_ALARMS ? alarm : 0];
+}
@@ -0,0 +1,14 @@
+#ifndef TIMER_SERVICE_PICO_H
+#define TIMER_SERVICE_PICO_H
+
+#include "timer_service.h" // タイマーサービス
+
+// タイマーサービスの実機 (RP2350) 向けの timer_service_hw
+//
+// reg.h のレジスタを直接操作する。TIMER0 のアラーム alarm (0〜3) を使い、割り込みは割り込み番号 alarm で起きる。
+// 割り込みハンドラで timer_service_handle() を呼び、TIMER0_INTE のビット alarm を立てて使う。
+
+// アラーム alarm (0〜3) を使う timer_service_hw を返す
+const timer_service_hw *timer_service_pico_hw(unsigned alarm);
+
+#endif // TIMER_SERVICE_PICO_H
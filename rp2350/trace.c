@@ -0,0 +1,116 @@
+#include "trace.h" // トレースポイント
+
+#if TRACE_SIZE & (TRACE_SIZE - 1)
+#error TRACE_SIZE must be a power of two
+#endif
+
+void trace_init(trace_buffer *tr)
+{
+    atomic_init(&tr->head, 0);
+    tr->tail = 0;
+    tr->lost = 0;
+    for (unsigned long i = 0; i < TRACE_SIZE; i++)
+    {
+        // まだ書いていない要素は、1 周前の通し番号にしておく (これから読む通し番号と一致しない)
+        atomic_init(&tr->entries[i].tag, (i - TRACE_SIZE) << TRACE_ID_BITS);
+        atomic_init(&tr->entries[i].cycles, 0);
+    }
+}
+
+unsigned long trace_read(trace_buffer *tr, trace_event *out, unsigned long max)
+{
+    unsigned long count = 0;
+    while (count < max)
+    {
+        unsigned long head = atomic_load_explicit(&tr->head, memory_order_relaxed);
+        if (head - tr->tail > TRACE_SIZE)
+        {
+            // 1 周以上遅れた分は上書きされている
+            tr->lost += head - tr->tail - TRACE_SIZE;
+            tr->tail = head - TRACE_SIZE;
+        }
+        if (tr->tail == head)
+        {
+            break;
+        }
+
+        trace_entry *e = &tr->entries[tr->tail & (TRACE_SIZE - 1)];
+        unsigned long tag = atomic_load_explicit(&e->tag, memory_order_relaxed);
+        TRACE_FENCE(memory_order_acquire);
+        unsigned long cycles = atomic_load_explicit(&e->cycles, memory_order_relaxed);
+        TRACE_FENCE(memory_order_acquire);
+        // サイクル数を読んだ後に、同じ要素に次の周の記録が通し番号を取っていなければ、上書きされていない
+        int overwritten = atomic_load_explicit(&tr->head, memory_order_relaxed) - tr->tail > TRACE_SIZE;
+        if (overwritten || (tag & ((1ul << TRACE_ID_BITS) - 1)) == TRACE_ID_LOST)
+        {
+            tr->lost++;
+        }
+        else if ((tag >> TRACE_ID_BITS & TRACE_SEQ_MASK) == (tr->tail & TRACE_SEQ_MASK))
+        {
+            out[count].seq = tr->tail;
+            out[count].cycles = cycles;
+            out[count].id = (unsigned char)tag;
+            count++;
+        }
+        else
+        {
+            break; // 通し番号は取ったが、まだ書いている途中なので次に読む
+        }
+        tr->tail++;
+    }
+    return count;
+}
+
+unsigned long trace_lost(const trace_buffer *tr)
+{
+    return tr->lost;
+}
+
+unsigned long trace_overhead_cycles(trace_buffer *tr)
+{
+    // カウンタを続けて読んだ差を、間に TRACE_POINT() を入れた差から引く
+    unsigned long c0 = TIMEBASE_CYCLES();
+    unsigned long c1 = TIMEBASE_CYCLES();
+    TRACE_POINT(tr, 0);
+    unsigned long c2 = TIMEBASE_CYCLES();
+    unsigned long diff = ((c2 - c1) - (c1 - c0)) & 0xfffffffful;
+    return diff < 0x80000000ul ? diff : 0; // カウンタの読み出しのばらつきで負になったら 0 にする
+}
+
+void trace_span_init(trace_span *sp, unsigned char begin_id, unsigned char end_id)
+{
+    *sp = (trace_span){0};
+    sp->begin_id = begin_id;
+    sp->end_id = end_id;
+}
+
+void trace_span_add(trace_span *sp, const trace_event *events, unsigned long n)
+{
+    for (unsigned long i = 0; i < n; i++)
+    {
+        const trace_event *ev = &events[i];
+        if (ev->seq != sp->next_seq)
+        {
+            sp->open = 0; // 間の記録が読めなかったので、始まりと終わりが対応しているかわからない
+        }
+        sp->next_seq = ev->seq + 1;
+        if (ev->id == sp->begin_id)
+        {
+            sp->open = 1;
+            sp->begin_cycles = ev->cycles;
+        }
+        else if (ev->id == sp->end_id && sp->open)
+        {
+            // カウンタは 32 ビットなので、一周しても 32 ビットの符号なしの引き算で求まる
+            unsigned long cycles = (ev->cycles - sp->begin_cycles) & 0xfffffffful;
+            sp->open = 0;
+            sp->count++;
+            sp->last_cycles = cycles;
+            sp->total_cycles += cycles;
+            if (cycles > sp->max_cycles)
+            {
+                sp->max_cycles = cycles;
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdatomic.h> // atomic_ulong
+#include "timebase.h"  // TIMEBASE_CYCLES()
+
+// トレースポイント: (サイクル数, 番号) をリングバッファに記録して、処理の時間を測る
+//
+// 測りたい処理の前後に TRACE_POINT(&buf, 番号) を置き、あとで trace_read() で取り出して、同じ区間の
+// 番号どうしのサイクル数の差を求める。記録は関数を呼ばずにインラインで行い、ロックも割り込みの禁止も使わない
+// (通し番号の取得は 1 回の不可分な加算 (LDREX / STREX)、あとはストア 2 回と、上書きされなかったかの確認)。バッファが一杯になると古いものから
+// 上書きし、読めなかった数を数える。
+//
+// 記録はメインループと割り込みのどちらからでもできる (割り込みが記録の途中に入っても壊れない)。
+// 読み出し (trace_read()) は 1 か所からだけ行う。書き終えていない記録に来たら、そこで止めて次に回す。
+// 2 つのコアから記録する場合は、TRACE_FENCE を atomic_thread_fence に定義してビルドする
+// (既定の atomic_signal_fence は同じコアの割り込みとの間の順序だけを守り、命令は入らない)。
+// ホストでは TRACE_HOST を定義してビルドし、host/trace_host.h の TRACE_FENCE でバリアの位置に割り込みを模擬する。
+//
+// 最後の確認 (TRACE_CHECK_LAP) は、記録の途中に入った割り込みが TRACE_SIZE 個以上記録して 1 周追い越した場合に
+// 要素を壊れた印にするためのもの。記録の途中に入る割り込みが 1 回に記録する数が TRACE_SIZE より少なければ
+// (1 つの優先度の割り込みの中からしか記録しない場合を含む) 追い越されないので、TRACE_CHECK_LAP=0 でビルドして
+// 省ける (Cortex-M33 の命令からの見積もりで、1 回の記録が約 17 サイクルから約 13 サイクルになる)。
+// trace_overhead_cycles() が同じ記録を測るよう、trace.c も同じ定義でビルドする。
+
+#ifdef TRACE_HOST
+#include "trace_host.h" // バリアの位置で割り込みを模擬する TRACE_FENCE
+#endif
+
+#ifndef TRACE_FENCE
+#define TRACE_FENCE atomic_signal_fence
+#endif
+
+#ifndef TRACE_SIZE
+#define TRACE_SIZE 256 // リングバッファの要素の数 (2 のべき乗)
+#endif
+
+#ifndef TRACE_CHECK_LAP
+#define TRACE_CHECK_LAP 1 // 記録の最後に、1 周追い越されていないかを確かめる
+#endif
+
+#define TRACE_ID_BITS 8                                 // 番号のビット数
+#define TRACE_ID_LOST 255                               // 壊れた記録の印 (番号は 0〜254 を使う)
+#define TRACE_SEQ_MASK (0xfffffffful >> TRACE_ID_BITS) // tag に入れる通し番号のビット
+
+// リングバッファの 1 つの要素
+typedef struct
+{
+    atomic_ulong tag;    // 通し番号の下位 24 ビット << 8 | 番号 (最後に書く)
+    atomic_ulong cycles; // 記録したときのサイクル数
+} trace_entry;
+
+// 取り出した記録
+typedef struct
+{
+    unsigned long seq;    // 通し番号 (記録した順)
+    unsigned long cycles; // 記録したときのサイクル数
+    unsigned char id;     // トレースポイントの番号
+} trace_event;
+
+// リングバッファ
+typedef struct
+{
+    atomic_ulong head;               // 次に記録する通し番号
+    unsigned long tail;              // 次に読む通し番号 (読み出し側だけが使う)
+    unsigned long lost;              // 上書きされて読めなかった数
+    trace_entry entries[TRACE_SIZE]; // 要素
+} trace_buffer;
+
+// 区間 (begin_id の記録から end_id の記録まで) のサイクル数の統計
+typedef struct
+{
+    unsigned char begin_id;          // 区間の始まりの番号
+    unsigned char end_id;            // 区間の終わりの番号
+    int open;                        // 始まりを読んで、終わりをまだ読んでいない
+    unsigned long next_seq;          // 次に来るはずの通し番号 (飛んだら読めなかった記録がある)
+    unsigned long begin_cycles;      // 始まりのサイクル数
+    unsigned long count;             // 区間の数
+    unsigned long last_cycles;       // 最後の区間のサイクル数
+    unsigned long max_cycles;        // 区間のサイクル数の最大値
+    unsigned long long total_cycles; // 区間のサイクル数の合計
+} trace_span;
+
+// 現在のサイクル数で番号 id (0〜254) を記録する
+#define TRACE_POINT(tr, id) trace_record((tr), (id), TIMEBASE_CYCLES())
+
+// サイクル数 cycles で番号 id (0〜254) を記録する。cycles を読んでから通し番号を取るまでに割り込みが記録すると、
+// 通し番号の順とサイクル数の順が入れ替わることがある
+static inline void trace_record(trace_buffer *tr, unsigned char id, unsigned long cycles)
+{
+    unsigned long n = atomic_fetch_add_explicit(&tr->head, 1, memory_order_relaxed);
+    trace_entry *e = &tr->entries[n & (TRACE_SIZE - 1)];
+    // 通し番号を取ってから書く (読み出し側は head を見て、上書きが始まったかどうかを知る)
+    TRACE_FENCE(memory_order_release);
+    atomic_store_explicit(&e->cycles, cycles, memory_order_relaxed);
+    TRACE_FENCE(memory_order_release);
+    unsigned long tag = n << TRACE_ID_BITS | id;
+    atomic_store_explicit(&e->tag, tag, memory_order_relaxed);
+#if TRACE_CHECK_LAP
+    TRACE_FENCE(memory_order_seq_cst);
+    unsigned long head = atomic_load_explicit(&tr->head, memory_order_relaxed);
+    if (head - n > TRACE_SIZE)
+    {
+        // 書いている間に割り込みが 1 周以上記録し、同じ要素の新しい記録を古い記録で上書きした (めったに起きない)。
+        // 書いた tag が残っていれば、その要素の最後の記録を壊れた印にする
+        unsigned long last = n + (head - 1 - n) / TRACE_SIZE * TRACE_SIZE;
+        atomic_compare_exchange_strong_explicit(&e->tag, &tag, last << TRACE_ID_BITS | TRACE_ID_LOST,
+                                                memory_order_relaxed, memory_order_relaxed);
+    }
+#endif
+}
+
+// リングバッファを空にする
+void trace_init(trace_buffer *tr);
+
+// 記録を古い順に最大 max 個 out に取り出し、取り出した数を返す
+unsigned long trace_read(trace_buffer *tr, trace_event *out, unsigned long max);
+
+// 上書きされて読めなかった数を返す
+unsigned long trace_lost(const trace_buffer *tr);
+
+// TRACE_POINT() 1 回にかかるサイクル数を測る。tr に 1 つ記録するので、trace_init() の前に呼ぶ
+unsigned long trace_overhead_cycles(trace_buffer *tr);
+
+// begin_id から end_id までの区間の統計を初期化する
+void trace_span_init(trace_span *sp, unsigned char begin_id, unsigned char end_id);
+
+// trace_read() で取り出した n 個の記録から区間を探して統計に加える (読めなかった記録をまたぐ区間は数えない)
+void trace_span_add(trace_span *sp, const trace_event *events, unsigned long n);
+
+#endif // TRACE_H
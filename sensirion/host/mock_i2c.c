@@ -0,0 +1,111 @@
+#include "mock_i2c.h" // 模擬 I2C バス
+
+void mock_i2c_init(mock_i2c_bus *bus, uint32_t baudrate)
+{
+    *bus = (mock_i2c_bus){0};
+    bus->baudrate = baudrate;
+}
+
+void mock_i2c_attach(mock_i2c_bus *bus, mock_i2c_device *dev)
+{
+    if (bus->device_count < MOCK_I2C_MAX_DEVICES)
+    {
+        bus->devices[bus->device_count++] = dev;
+    }
+}
+
+// 転送時間 (START + アドレス + データ + STOP、1 バイト 9 クロック) だけ時計を進める
+static void mock_i2c_bus_time(mock_i2c_bus *bus, size_t len)
+{
+    uint64_t clocks = (uint64_t)(len + 1) * 9 + 2;
+    uint64_t us = (clocks * 1000000 + bus->baudrate - 1) / bus->baudrate;
+
+    bus->transactions++;
+    bus->bytes += len + 1;
+    bus->bus_busy_us += us;
+    mock_i2c_advance(bus, us);
+}
+
+// アドレスに一致するデバイスを探す
+static mock_i2c_device *mock_i2c_find(mock_i2c_bus *bus, uint8_t addr)
+{
+    for (int i = 0; i < bus->device_count; i++)
+    {
+        if (bus->devices[i]->addr == addr)
+        {
+            return bus->devices[i];
+        }
+    }
+    return NULL;
+}
+
+int mock_i2c_write(mock_i2c_bus *bus, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    (void)nostop;
+    mock_i2c_device *dev = mock_i2c_find(bus, addr);
+    int ret = dev ? dev->write(dev, src, len, bus->now_us) : MOCK_I2C_NACK;
+
+    // NACK の場合はアドレスバイトだけで転送が終わる
+    mock_i2c_bus_time(bus, ret < 0 ? 0 : len);
+    if (ret < 0)
+    {
+        bus->nacks++;
+    }
+    return ret;
+}
+
+int mock_i2c_read(mock_i2c_bus *bus, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    (void)nostop;
+    mock_i2c_device *dev = mock_i2c_find(bus, addr);
+    int ret = dev ? dev->read(dev, dst, len, bus->now_us) : MOCK_I2C_NACK;
+
+    mock_i2c_bus_time(bus, ret < 0 ? 0 : len);
+    if (ret < 0)
+    {
+        bus->nacks++;
+    }
+    return ret;
+}
+
+void mock_i2c_add_alarm(mock_i2c_bus *bus, uint32_t delay_us, void (*callback)(void *), void *arg)
+{
+    for (int i = 0; i < MOCK_I2C_MAX_TIMERS; i++)
+    {
+        if (!bus->timers[i].active)
+        {
+            bus->timers[i] = (mock_i2c_timer){true, bus->now_us + delay_us, callback, arg};
+            return;
+        }
+    }
+}
+
+void mock_i2c_advance(mock_i2c_bus *bus, uint64_t us)
+{
+    uint64_t end = bus->now_us + us;
+
+    // 期限の早い順に発火させる
+    while (1)
+    {
+        mock_i2c_timer *next = NULL;
+        for (int i = 0; i < MOCK_I2C_MAX_TIMERS; i++)
+        {
+            mock_i2c_timer *t = &bus->timers[i];
+            if (t->active && t->deadline_us <= end && (!next || t->deadline_us < next->deadline_us))
+            {
+                next = t;
+            }
+        }
+        if (!next)
+        {
+            break;
+        }
+        if (next->deadline_us > bus->now_us)
+        {
+            bus->now_us = next->deadline_us;
+        }
+        next->active = false;
+        next->callback(next->arg);
+    }
+    bus->now_us = end;
+}
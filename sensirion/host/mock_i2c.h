@@ -0,0 +1,68 @@
+#ifndef MOCK_I2C_H
+#define MOCK_I2C_H
+
+#include <stdint.h>  // 固定幅整数型
+#include <stdbool.h> // bool 型
+#include <stddef.h>  // size_t
+
+// ホスト用の模擬 I2C バスと仮想時計
+//
+// 実機の i2c_write_blocking / i2c_read_blocking と add_alarm_in_us の代わりに使う。
+// 転送すると、そのバイト数ぶんのバス時間だけ仮想時計が進む。
+// アラームは仮想時計が期限に達したときに発火する。
+
+#define MOCK_I2C_MAX_DEVICES 8 // 接続できるデバイス数
+#define MOCK_I2C_MAX_TIMERS 8  // 同時に待機できるアラーム数
+#define MOCK_I2C_NACK (-1)     // NACK 時の戻り値 (PICO_ERROR_GENERIC と同じ)
+
+typedef struct mock_i2c_device mock_i2c_device;
+
+// バス上のデバイスモデル
+struct mock_i2c_device
+{
+    uint8_t addr; // I2C アドレス
+    // 書き込み / 読み出し要求。受け付けたら len、拒否 (NACK) したら MOCK_I2C_NACK を返す
+    int (*write)(mock_i2c_device *dev, const uint8_t *src, size_t len, uint64_t now_us);
+    int (*read)(mock_i2c_device *dev, uint8_t *dst, size_t len, uint64_t now_us);
+};
+
+// 待機中のアラーム
+typedef struct
+{
+    bool active;              // 待機中なら true
+    uint64_t deadline_us;     // 発火時刻
+    void (*callback)(void *); // 発火時に呼ぶ関数
+    void *arg;                // callback の引数
+} mock_i2c_timer;
+
+// 模擬バス
+typedef struct
+{
+    uint32_t baudrate;                                   // バスクロック [Hz]
+    uint64_t now_us;                                     // 仮想時計 [us]
+    uint64_t bus_busy_us;                                // 転送に費やした時間の合計 [us]
+    uint32_t transactions;                               // トランザクション数
+    uint32_t bytes;                                      // 転送したバイト数 (アドレスバイトを含む)
+    uint32_t nacks;                                      // NACK された回数
+    mock_i2c_device *devices[MOCK_I2C_MAX_DEVICES];      // 接続されたデバイス
+    int device_count;                                    // 接続されたデバイス数
+    mock_i2c_timer timers[MOCK_I2C_MAX_TIMERS];          // アラーム
+} mock_i2c_bus;
+
+// バスを初期化する
+void mock_i2c_init(mock_i2c_bus *bus, uint32_t baudrate);
+
+// デバイスを接続する
+void mock_i2c_attach(mock_i2c_bus *bus, mock_i2c_device *dev);
+
+// i2c_write_blocking / i2c_read_blocking 相当
+int mock_i2c_write(mock_i2c_bus *bus, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int mock_i2c_read(mock_i2c_bus *bus, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+// add_alarm_in_us 相当
+void mock_i2c_add_alarm(mock_i2c_bus *bus, uint32_t delay_us, void (*callback)(void *), void *arg);
+
+// 仮想時計を us だけ進め、期限に達したアラームを発火する
+void mock_i2c_advance(mock_i2c_bus *bus, uint64_t us);
+
+#endif // MOCK_I2C_H
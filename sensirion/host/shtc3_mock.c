@@ -0,0 +1,114 @@
+#include "shtc3_mock.h" // 模擬 SHTC3
+
+// Sensirion の CRC-8 (多項式 0x31、初期値 0xFF)
+static uint8_t shtc3_mock_crc(const uint8_t *data)
+{
+    uint8_t crc = 0xFF;
+    for (int i = 0; i < 2; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// 16 ビット値と CRC を応答バッファに書き込む
+static void shtc3_mock_put_word(uint8_t *dst, uint16_t word)
+{
+    dst[0] = word >> 8;
+    dst[1] = word & 0xFF;
+    dst[2] = shtc3_mock_crc(dst);
+}
+
+static int shtc3_mock_write(mock_i2c_device *dev, const uint8_t *src, size_t len, uint64_t now_us)
+{
+    shtc3_mock *mock = (shtc3_mock *)dev;
+    uint16_t command = (len == 2) ? (src[0] << 8) | src[1] : 0;
+
+    if (command == 0x3517)
+    {
+        // ウェイクアップ (起きていても受け付ける)
+        if (!mock->awake)
+        {
+            mock->awake = true;
+            mock->awake_since_us = now_us;
+            mock->ready_us = now_us + SHTC3_MOCK_WAKEUP_US;
+        }
+        return 2;
+    }
+    if (!mock->awake || now_us < mock->ready_us)
+    {
+        return MOCK_I2C_NACK; // スリープ中、ウェイクアップ中、変換中
+    }
+
+    switch (command)
+    {
+    case 0xB098: // スリープ
+        mock->awake = false;
+        mock->awake_total_us += now_us - mock->awake_since_us;
+        mock->response_len = 0;
+        return 2;
+    case 0xEFC8: // ID 読み出し
+        shtc3_mock_put_word(mock->response, 0x0887);
+        mock->response_len = 3;
+        return 2;
+    case 0x7866: // ノーマルモード測定
+    case 0x609C: // 低消費電力モード測定
+        shtc3_mock_put_word(mock->response, mock->temp_raw);
+        shtc3_mock_put_word(mock->response + 3, mock->humidity_raw);
+        mock->response_len = 6;
+        mock->measurements++;
+        if (command == 0x609C)
+        {
+            mock->low_power_count++;
+            mock->ready_us = now_us + SHTC3_MOCK_LOW_POWER_MEASURE_US;
+        }
+        else
+        {
+            mock->ready_us = now_us + SHTC3_MOCK_NORMAL_MEASURE_US;
+        }
+        if (mock->corrupt_every && mock->measurements % mock->corrupt_every == 0)
+        {
+            mock->response[(mock->measurements / mock->corrupt_every) % 2 ? 1 : 4] ^= 0x10; // 温度と湿度を交互に壊す
+            mock->corrupted++;
+        }
+        return 2;
+    default:
+        return MOCK_I2C_NACK; // 未対応のコマンド
+    }
+}
+
+static int shtc3_mock_read(mock_i2c_device *dev, uint8_t *dst, size_t len, uint64_t now_us)
+{
+    shtc3_mock *mock = (shtc3_mock *)dev;
+
+    if (!mock->awake || now_us < mock->ready_us || mock->response_len == 0 || len > mock->response_len)
+    {
+        mock->early_reads += mock->awake && now_us < mock->ready_us;
+        return MOCK_I2C_NACK;
+    }
+    for (size_t i = 0; i < len; i++)
+    {
+        dst[i] = mock->response[i];
+    }
+    mock->response_len = 0;
+    return (int)len;
+}
+
+void shtc3_mock_init(shtc3_mock *mock)
+{
+    *mock = (shtc3_mock){0};
+    mock->device.addr = 0x70;
+    mock->device.write = shtc3_mock_write;
+    mock->device.read = shtc3_mock_read;
+    mock->temp_raw = 0x6666;     // 25℃
+    mock->humidity_raw = 0x8000; // 50%
+}
+
+uint64_t shtc3_mock_awake_us(const shtc3_mock *mock, uint64_t now_us)
+{
+    return mock->awake_total_us + (mock->awake ? now_us - mock->awake_since_us : 0);
+}
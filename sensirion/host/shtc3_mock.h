@@ -0,0 +1,40 @@
+#ifndef SHTC3_MOCK_H
+#define SHTC3_MOCK_H
+
+#include "mock_i2c.h" // 模擬 I2C バス
+
+// 模擬 SHTC3
+//
+// スリープ中はウェイクアップコマンド以外に NACK を返し、ウェイクアップ後 240us までは応答しない。
+// 測定コマンド (クロックストレッチ無効) の後は変換時間が経過するまで読み出しに NACK を返す。
+// corrupt_every を設定すると、その回数ごとに測定データの 1 ビットを反転させて CRC エラーを起こす。
+
+#define SHTC3_MOCK_WAKEUP_US (240)            // ウェイクアップ時間 [us]
+#define SHTC3_MOCK_NORMAL_MEASURE_US (12100)  // ノーマルモードの変換時間 [us]
+#define SHTC3_MOCK_LOW_POWER_MEASURE_US (800) // 低消費電力モードの変換時間 [us]
+
+typedef struct
+{
+    mock_i2c_device device;     // バスに接続するデバイス (先頭に置く)
+    bool awake;                 // ウェイクアップ中なら true
+    uint64_t awake_since_us;    // ウェイクアップした時刻
+    uint64_t awake_total_us;    // 起きていた時間の合計 [us]
+    uint64_t ready_us;          // 応答が読める時刻
+    uint8_t response[6];        // 次に返す応答
+    size_t response_len;        // 応答のバイト数 (0 なら応答なし)
+    uint16_t temp_raw;          // 測定時に返す温度の生データ
+    uint16_t humidity_raw;      // 測定時に返す湿度の生データ
+    uint32_t corrupt_every;     // この回数ごとにデータを壊す (0 なら壊さない)
+    uint32_t measurements;      // 受け付けた測定コマンド数
+    uint32_t low_power_count;   // そのうち低消費電力モードの数
+    uint32_t corrupted;         // 壊したデータの数
+    uint32_t early_reads;       // 準備前に読まれた回数
+} shtc3_mock;
+
+// 模擬 SHTC3 を初期化する (スリープ状態で始まる)
+void shtc3_mock_init(shtc3_mock *mock);
+
+// 現在時刻までの起きていた時間を返す
+uint64_t shtc3_mock_awake_us(const shtc3_mock *mock, uint64_t now_us);
+
+#endif // SHTC3_MOCK_H
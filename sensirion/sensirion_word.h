@@ -0,0 +1,45 @@
+#ifndef SENSIRION_WORD_H
+#define SENSIRION_WORD_H
+
+#include <stdint.h> // 固定幅整数型
+#include <stddef.h> // size_t
+
+// Sensirion センサー (SGP40, SHTC3 など) の I2C ワードプロトコル
+//
+// コマンドのパラメータと応答は 16 ビットのワード (上位バイトが先) ごとに CRC-8 が 1 バイト付く。
+// CRC-8 は多項式 0x31 (x^8 + x^5 + x^4 + 1)、初期値 0xFF、反転なし。
+// ビットごとに計算する代わりに 256 要素のテーブルを引くので、1 ワードあたり 2 回の表引きで済む。
+
+#define SENSIRION_CRC8_POLYNOMIAL (0x31) // CRC-8 の多項式
+#define SENSIRION_CRC8_INIT (0xFF)       // CRC-8 の初期値
+#define SENSIRION_WORD_SIZE (3)          // 1 ワードのバイト数 (データ 2 + CRC 1)
+
+// CRC-8 の表 (sensirion_crc8_table[i] は 1 バイト i を初期値 0 で処理した結果)
+extern const uint8_t sensirion_crc8_table[256];
+
+// 任意長のデータの CRC-8 を計算する
+uint8_t sensirion_crc8(const uint8_t *data, size_t len);
+
+// 1 ワードの CRC-8 を計算する
+static inline uint8_t sensirion_word_crc(uint16_t word)
+{
+    uint8_t crc = sensirion_crc8_table[SENSIRION_CRC8_INIT ^ (word >> 8)];
+    return sensirion_crc8_table[crc ^ (word & 0xFF)];
+}
+
+// 1 ワードを dst[0..2] に書き込む (上位バイト, 下位バイト, CRC)
+static inline void sensirion_put_word(uint8_t *dst, uint16_t word)
+{
+    dst[0] = word >> 8;
+    dst[1] = word & 0xFF;
+    dst[2] = sensirion_word_crc(word);
+}
+
+// n ワードを dst に書き込む (dst は n * SENSIRION_WORD_SIZE バイト)
+void sensirion_put_words(uint8_t *dst, const uint16_t *words, size_t n);
+
+// n ワードの応答 src の CRC をまとめて確かめ、データを words に取り出す
+// CRC が一致しなかったワードの数を返す (0 ならすべて正しい)
+size_t sensirion_verify_words(const uint8_t *src, uint16_t *words, size_t n);
+
+#endif // SENSIRION_WORD_H
@@ -0,0 +1,144 @@
+#include "shtc3.h"          // SHTC3 ドライバ
+#include "sensirion_word.h" // Sensirion I2C ワードプロトコル (CRC-8)
+
+// SHTC3にコマンドを送信する
+static bool shtc3_write_command(shtc3 *dev, uint16_t command)
+{
+    const shtc3_transport *t = dev->transport;
+    uint8_t write_buf[2] = {
+        (command >> 8) & 0xFF, // コマンドの上位8ビット
+        command & 0xFF         // コマンドの下位8ビット
+    };
+    return t->write(t->ctx, SHTC3_I2C_ADDR, write_buf, 2, false) == 2; // 2バイト送信成功でtrue
+}
+
+// タイマーを起動して次の状態へ進む
+static void shtc3_wait(shtc3 *dev, uint32_t delay_us, shtc3_state next)
+{
+    const shtc3_transport *t = dev->transport;
+
+    dev->timer_expired = false;
+    dev->state = next;
+    t->start_timer(t->ctx, delay_us, dev);
+}
+
+// エラー時はスリープを試みてから SHTC3_ERROR を返す
+static shtc3_status shtc3_fail(shtc3 *dev)
+{
+    shtc3_write_command(dev, SHTC3_CMD_SLEEP);
+    dev->state = SHTC3_STATE_SLEEP;
+    return SHTC3_ERROR;
+}
+
+void shtc3_init(shtc3 *dev, const shtc3_transport *transport, shtc3_mode mode)
+{
+    dev->transport = transport;
+    dev->mode = mode;
+    dev->state = SHTC3_STATE_SLEEP;
+    dev->timer_expired = false;
+    dev->crc_errors = 0;
+}
+
+bool shtc3_start_check_id(shtc3 *dev)
+{
+    if (dev->state != SHTC3_STATE_SLEEP || !shtc3_write_command(dev, SHTC3_CMD_WAKEUP))
+    {
+        return false;
+    }
+    shtc3_wait(dev, SHTC3_WAKEUP_US, SHTC3_STATE_WAKEUP_ID);
+    return true;
+}
+
+bool shtc3_start_measure(shtc3 *dev)
+{
+    if (dev->state != SHTC3_STATE_SLEEP || !shtc3_write_command(dev, SHTC3_CMD_WAKEUP))
+    {
+        return false;
+    }
+    shtc3_wait(dev, SHTC3_WAKEUP_US, SHTC3_STATE_WAKEUP);
+    return true;
+}
+
+shtc3_status shtc3_poll(shtc3 *dev, float *temp, float *humidity)
+{
+    const shtc3_transport *t = dev->transport;
+    uint8_t read_buf[6]; // 受信するデータを格納する配列
+    uint16_t words[2];   // CRC を確かめたワード (温度・湿度、または ID)
+
+    if (dev->state == SHTC3_STATE_SLEEP || !dev->timer_expired)
+    {
+        return SHTC3_BUSY; // 待ち時間中 (または何もしていない)
+    }
+
+    switch (dev->state)
+    {
+    case SHTC3_STATE_WAKEUP_ID:
+        // ID を読み出して SHTC3 であることを確認する (xxxx 1xxx xx00 0111)
+        if (!shtc3_write_command(dev, SHTC3_CMD_READ_ID) ||
+            t->read(t->ctx, SHTC3_I2C_ADDR, read_buf, 3, false) != 3)
+        {
+            return shtc3_fail(dev);
+        }
+        if (sensirion_verify_words(read_buf, words, 1) != 0)
+        {
+            dev->crc_errors++;
+            return shtc3_fail(dev);
+        }
+        if ((words[0] & 0x083F) != 0x0807)
+        {
+            return shtc3_fail(dev);
+        }
+        shtc3_write_command(dev, SHTC3_CMD_SLEEP);
+        dev->state = SHTC3_STATE_SLEEP;
+        return SHTC3_READY;
+
+    case SHTC3_STATE_WAKEUP:
+        // 測定コマンドを送信 (クロックストレッチ無効。変換中は I2C バスを解放する)
+        if (dev->mode == SHTC3_MODE_LOW_POWER)
+        {
+            if (!shtc3_write_command(dev, SHTC3_CMD_LOW_POWER_T_F))
+            {
+                return shtc3_fail(dev);
+            }
+            shtc3_wait(dev, SHTC3_LOW_POWER_MEASURE_US, SHTC3_STATE_MEASURE);
+        }
+        else
+        {
+            if (!shtc3_write_command(dev, SHTC3_CMD_NORMAL_T_F))
+            {
+                return shtc3_fail(dev);
+            }
+            shtc3_wait(dev, SHTC3_NORMAL_MEASURE_US, SHTC3_STATE_MEASURE);
+        }
+        return SHTC3_BUSY;
+
+    case SHTC3_STATE_MEASURE:
+        // 測定データを読み取り、すぐにスリープさせる
+        if (t->read(t->ctx, SHTC3_I2C_ADDR, read_buf, 6, false) != 6)
+        {
+            return shtc3_fail(dev);
+        }
+        shtc3_write_command(dev, SHTC3_CMD_SLEEP);
+        dev->state = SHTC3_STATE_SLEEP;
+
+        // CRCチェック
+        if (sensirion_verify_words(read_buf, words, 2) != 0)
+        {
+            dev->crc_errors++;
+            return SHTC3_ERROR;
+        }
+
+        // 生のデータ（16ビット値）を実際の温度と湿度に変換
+        *temp = (float)words[0] * 175.0f / 65535.0f - 45.0f; // 温度データを温度に変換
+        *humidity = (float)words[1] * 100.0f / 65535.0f;     // 湿度データを湿度に変換
+        return SHTC3_READY;
+
+    default:
+        return shtc3_fail(dev);
+    }
+}
+
+void shtc3_timer_expired(shtc3 *dev)
+{
+    dev->timer_expired = true;
+}
@@ -0,0 +1,96 @@
+#ifndef SHTC3_H
+#define SHTC3_H
+
+#include <stdint.h>  // 固定幅整数型
+#include <stdbool.h> // bool 型
+#include <stddef.h>  // size_t
+
+// SHTC3 ドライバ (ノンブロッキング)
+//
+// 1 回の測定は「ウェイクアップ → (240us) → 測定コマンド → (変換時間) → 読み出し → スリープ」の順に進む。
+// 待ち時間はタイマー (ハードウェアアラーム) で計り、満了すると shtc3_timer_expired() が呼ばれる。
+// 測定コマンドはクロックストレッチ無効版を使うので、変換中に I2C バスを占有しない。
+// 測定の合間はスリープさせておき、消費電流を抑える。
+
+#define SHTC3_I2C_ADDR (0x70) // SHTC3のI2Cアドレス
+
+// SHTC3のコマンド定義
+#define SHTC3_CMD_WAKEUP (0x3517)        // ウェイクアップ
+#define SHTC3_CMD_SLEEP (0xB098)         // スリープ
+#define SHTC3_CMD_READ_ID (0xEFC8)       // ID 読み出し
+#define SHTC3_CMD_NORMAL_T_F (0x7866)    // ノーマルモード、温度が先、クロックストレッチ無効
+#define SHTC3_CMD_LOW_POWER_T_F (0x609C) // 低消費電力モード、温度が先、クロックストレッチ無効
+
+// 待ち時間 (データシートの最大値) [us]
+#define SHTC3_WAKEUP_US (240)            // ウェイクアップ完了まで
+#define SHTC3_NORMAL_MEASURE_US (12100)  // ノーマルモードの変換時間
+#define SHTC3_LOW_POWER_MEASURE_US (800) // 低消費電力モードの変換時間
+
+typedef struct shtc3 shtc3;
+
+// I2C とタイマーへのアクセス手段
+typedef struct
+{
+    // I2C 書き込み / 読み出し。戻り値は転送バイト数、失敗時は負の値 (i2c_write_blocking と同じ)
+    int (*write)(void *ctx, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+    int (*read)(void *ctx, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+    // delay_us 後に shtc3_timer_expired(dev) を呼ぶタイマーを起動する
+    void (*start_timer)(void *ctx, uint32_t delay_us, shtc3 *dev);
+    void *ctx; // 上記関数に渡すコンテキスト
+} shtc3_transport;
+
+// 測定モード
+typedef enum
+{
+    SHTC3_MODE_NORMAL,    // ノーマルモード (高精度、変換 12.1ms)
+    SHTC3_MODE_LOW_POWER, // 低消費電力モード (変換 0.8ms)
+} shtc3_mode;
+
+// ドライバの状態
+typedef enum
+{
+    SHTC3_STATE_SLEEP,     // スリープ中 (測定を開始できる)
+    SHTC3_STATE_WAKEUP,    // ウェイクアップ待ち (測定前)
+    SHTC3_STATE_WAKEUP_ID, // ウェイクアップ待ち (ID 確認前)
+    SHTC3_STATE_MEASURE,   // 変換待ち
+} shtc3_state;
+
+// shtc3_poll() の戻り値
+typedef enum
+{
+    SHTC3_BUSY,  // 処理中 (または何もしていない)
+    SHTC3_READY, // ID 確認が完了した、または測定値が得られた
+    SHTC3_ERROR, // 通信エラー、CRC エラー、ID 不一致
+} shtc3_status;
+
+struct shtc3
+{
+    const shtc3_transport *transport; // I2C とタイマー
+    shtc3_mode mode;                  // 測定モード
+    shtc3_state state;                // 現在の状態
+    volatile bool timer_expired;      // アラームが満了したら true (割り込みから書き込まれる)
+    uint32_t crc_errors;              // CRC エラーの回数
+};
+
+// ドライバを初期化する (I2C 通信はしない)
+void shtc3_init(shtc3 *dev, const shtc3_transport *transport, shtc3_mode mode);
+
+// ウェイクアップして ID を確認し、スリープに戻す。成功すると shtc3_poll() が SHTC3_READY を返す
+bool shtc3_start_check_id(shtc3 *dev);
+
+// 測定を開始する
+bool shtc3_start_measure(shtc3 *dev);
+
+// 状態を進める。測定完了時は *temp (摂氏) と *humidity (%) に格納して SHTC3_READY を返す
+shtc3_status shtc3_poll(shtc3 *dev, float *temp, float *humidity);
+
+// タイマー満了時に呼ぶ (割り込みコンテキストから呼んでよい)
+void shtc3_timer_expired(shtc3 *dev);
+
+// 測定を開始できる状態なら true
+static inline bool shtc3_is_idle(const shtc3 *dev)
+{
+    return dev->state == SHTC3_STATE_SLEEP;
+}
+
+#endif // SHTC3_H
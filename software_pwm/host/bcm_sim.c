@@ -0,0 +1,447 @@
+#include <stdio.h>        // 標準入出力ライブラリ
+#include <stdlib.h>       // strtoul
+#include <math.h>         // pow, sin, cos, sqrt
+#include <unistd.h>       // getopt
+#include "host_util.h"    // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "software_pwm.h" // 複数チャンネルの PWM (software_pwm と同じソース)
+
+// BCM モードとフェードを、以前の PWM と比べる
+//
+// 使い方: bcm_sim [-j block_ns]
+//   -j  他の割り込みなどで割り込みの開始が遅れる時間の最大値 [ns] (既定 0。0〜block_ns の一様乱数)
+//
+// 1. software_pwm_gamma16 が round(65535 × (i / 255) ^ 2.8) と一致するかを確かめる。
+// 2. software_pwm_fade() で 0 → 255 → 0 とフェードさせ、HIGH の期間が単調に変わって指定した周期数で目標に
+//    一致すること、PWM スライスのチャンネルにも同じ値が書かれることを確かめ、通る明るさの段数を数える。
+// 3. 9 チャンネルをすべて割り込みで出力し、明るさを 12 ビットの値 (4095 分の L) で固定して、仮想時刻で動かす。
+//    出力の波形をフーリエ変換し、平均の明るさの誤差 (12 ビットの LSB 単位)、目にちらつきが見える 200Hz 未満の
+//    成分の振幅、最も低い成分の周波数を、割り込みの回数・負荷・前のエッジと同じ割り込みにまとまったエッジの数・
+//    エッジの最大の遅れと一緒に表示する。"fading" の行は main.c と同じく、周期の始めの割り込みで全チャンネルの
+//    フェードを進める時間 (FADE_CH_NS × チャンネル数) もかかる場合。
+//    以前の方式 (100us ごとに割り込むカウンタの PWM) の波形は理想的なタイミングで作る。
+//
+// 割り込みの処理時間のモデルは pwm_sim と同じ (150MHz の Cortex-M33 のサイクル数からの見積もり)。
+
+#define IRQ_ENTRY_NS 100     // 割り込みに入るまで
+#define IRQ_EXIT_NS 70       // 割り込みから戻るまで
+#define ISR_BODY_NS 60       // timer_interrupt() の割り込みフラグのクリアと呼び出し
+#define EDGE_NS 60           // 1 つのエッジの処理
+#define GPIO_WRITE_NS 15     // SIO_GPIO_OUT_SET / CLR への 1 回の書き込み
+#define TIMER_READ_NS 60     // 64 ビットの時刻の読み出し
+#define ALARM_WRITE_NS 30    // アラームの設定
+#define OLD_UPDATE_NS 150    // 以前の software_pwm_update() (1 チャンネル)
+#define FADE_CH_NS 400       // 周期の始めに 1 チャンネルのフェードを進める処理 (advance_fades() と main.c の折り返しの確認)
+#define OLD_TICK_US 100      // 以前の割り込みの間隔 [us]
+#define NUM_PINS 32
+#define MAX_TRANSITIONS 20000 // ピンごとに記録する出力の変化の数
+#define WINDOW_NS 500000000ull // 波形を解析する時間 (0.5 秒。周波数の分解能 2Hz)
+#define FLICKER_HZ 200       // これより低い成分をちらつきとみなす
+#define RIPPLE_LEVEL 0.01    // 最も低い成分として数える振幅 (最大の明るさに対する割合)
+#define MAX_HZ 2000          // 解析する周波数の上限
+
+// ピンの出力の変化
+typedef struct
+{
+    unsigned long long t_ns; // 時刻
+    int high;                // 変化した後の出力
+} transition;
+
+// ホストのハードウェア (仮想時刻)
+typedef struct
+{
+    unsigned long long clock_ns; // 仮想時刻
+    unsigned long long alarm_us; // アラームの時刻
+    int force_software;          // 1 ならすべてのピンを割り込みで出力する
+    int fading;                  // 1 なら周期の始めの割り込みで、全チャンネルのフェードを進める時間もかかる (main.c と同じ)
+    unsigned long levels[NUM_PINS]; // PWM スライスのチャンネルの HIGH の期間 [us]
+    unsigned long out;           // SIO の出力
+    unsigned long long isr_ns;   // 割り込みの処理時間の合計
+} host_hw;
+
+static software_pwm pwm;
+static host_hw hw;
+static transition log_buf[NUM_PINS][MAX_TRANSITIONS]; // ピンごとの出力の変化
+static int log_count[NUM_PINS];
+
+static int host_pwm_channel(void *ctx, unsigned char pin)
+{
+    host_hw *h = ctx;
+    return h->force_software || pin >= 30 ? -1 : ((pin >> 1) & 7) << 1 | (pin & 1);
+}
+
+static void host_pwm_setup(void *ctx, unsigned char pin, unsigned long top)
+{
+    (void)ctx;
+    (void)pin;
+    (void)top;
+}
+
+static void host_pwm_level(void *ctx, unsigned char pin, unsigned long level)
+{
+    host_hw *h = ctx;
+    h->levels[pin] = level;
+}
+
+static void host_pwm_enable(void *ctx, unsigned long slices)
+{
+    (void)ctx;
+    (void)slices;
+}
+
+static void host_gpio_setup(void *ctx, unsigned char pin)
+{
+    host_hw *h = ctx;
+    h->out &= ~(1ul << pin);
+}
+
+// 出力が変わったピンの時刻を記録する
+static void record(unsigned long old, unsigned long now, unsigned long long t_ns)
+{
+    for (int pin = 0; pin < NUM_PINS; pin++)
+    {
+        unsigned long mask = 1ul << pin;
+        if ((old ^ now) & mask && log_count[pin] < MAX_TRANSITIONS)
+        {
+            log_buf[pin][log_count[pin]++] = (transition){t_ns, (now & mask) != 0};
+        }
+    }
+}
+
+static void host_gpio_write(void *ctx, unsigned long set, unsigned long clr)
+{
+    host_hw *h = ctx;
+    unsigned long old = h->out;
+    if (set)
+    {
+        h->clock_ns += GPIO_WRITE_NS;
+        h->out |= set;
+        record(old, h->out, h->clock_ns);
+        old = h->out;
+    }
+    if (clr)
+    {
+        h->clock_ns += GPIO_WRITE_NS;
+        h->out &= ~clr;
+        record(old, h->out, h->clock_ns);
+    }
+}
+
+static unsigned long long host_now_us(void *ctx)
+{
+    host_hw *h = ctx;
+    h->clock_ns += TIMER_READ_NS;
+    return h->clock_ns / 1000;
+}
+
+static void host_set_alarm(void *ctx, unsigned long long time_us)
+{
+    host_hw *h = ctx;
+    h->clock_ns += ALARM_WRITE_NS;
+    h->alarm_us = time_us;
+}
+
+static const software_pwm_hw host = {
+    .pwm_channel = host_pwm_channel,
+    .pwm_setup = host_pwm_setup,
+    .pwm_level = host_pwm_level,
+    .pwm_enable = host_pwm_enable,
+    .gpio_setup = host_gpio_setup,
+    .gpio_write = host_gpio_write,
+    .now_us = host_now_us,
+    .set_alarm = host_set_alarm,
+    .ctx = &hw,
+};
+
+// 仮想時刻が end_ns になるまで割り込みを実行する
+static void run_until(unsigned long long end_ns, unsigned long block_ns)
+{
+    while (hw.alarm_us * 1000 < end_ns)
+    {
+        unsigned long long fire_ns = hw.alarm_us * 1000;
+        unsigned long long start_ns = hw.clock_ns > fire_ns ? hw.clock_ns : fire_ns;
+        if (block_ns)
+        {
+            start_ns += rng() % block_ns;
+        }
+        hw.clock_ns = start_ns + IRQ_ENTRY_NS + ISR_BODY_NS;
+        unsigned long edges = pwm.stats.edges;
+        int ret = software_pwm_update(&pwm);
+        hw.clock_ns += (pwm.stats.edges - edges) * EDGE_NS + IRQ_EXIT_NS;
+        if (ret == 1 && hw.fading)
+        {
+            hw.clock_ns += pwm.count * FADE_CH_NS;
+        }
+        hw.isr_ns += hw.clock_ns - start_ns;
+    }
+}
+
+// 次の周期が始まるまで割り込みを 1 回ずつ実行する
+static void next_period(void)
+{
+    unsigned long periods = pwm.stats.periods;
+    while (pwm.stats.periods == periods)
+    {
+        run_until(hw.alarm_us * 1000 + 1, 0);
+    }
+}
+
+// ガンマ補正の表を pow() と照合する。失敗の数を返す
+static int check_gamma(void)
+{
+    int errors = 0;
+    for (int i = 0; i < 256; i++)
+    {
+        long expect = lround(65535.0 * pow(i / 255.0, SOFTWARE_PWM_GAMMA));
+        errors += software_pwm_gamma16[i] != expect;
+    }
+    printf("gamma16 table vs pow(): %s\n", errors ? "MISMATCH" : "ok");
+    return errors != 0;
+}
+
+// フェードで HIGH の期間が単調に変わり、指定した周期数で目標に一致するかを確かめる。失敗の数を返す
+static int check_fade(const char *name, int bcm_bits, unsigned short periods)
+{
+    static const unsigned char pins[] = {10, 26}; // PWM スライスと割り込み
+    hw = (host_hw){0};
+    if (bcm_bits)
+    {
+        software_pwm_init_bcm(&pwm, &host, bcm_bits, 1, pins, 2);
+    }
+    else
+    {
+        software_pwm_init(&pwm, &host, 200, pins, 2);
+    }
+    software_pwm_start(&pwm);
+    next_period();
+
+    int failures = 0;
+    int steps = 0;              // 異なる HIGH の期間の数
+    unsigned short low_max = 0; // フェードの最初の 1/4 (暗い側) の HIGH の期間の最大値
+    int low_steps = 0;          // その間の異なる HIGH の期間の数
+    static const unsigned char targets[] = {255, 0};
+    for (int t = 0; t < 2; t++)
+    {
+        software_pwm_fade(&pwm, 0, targets[t], periods);
+        software_pwm_fade(&pwm, 1, targets[t], periods);
+        unsigned short prev = pwm.channels[0].duty_period;
+        for (int p = 1; p <= periods; p++)
+        {
+            // software_pwm_update() は周期の始めにフェードを進める。次の周期が始まるまで割り込みを実行する
+            next_period();
+            unsigned short duty = pwm.channels[0].duty_period;
+            int up = targets[t] != 0;
+            failures += up ? duty < prev : duty > prev;
+            failures += pwm.channels[1].duty_period != duty;
+            failures += hw.levels[pins[0]] != duty * (bcm_bits ? 1ul : SOFTWARE_PWM_TICK_US);
+            failures += software_pwm_fading(&pwm, 0) != (p < periods);
+            if (duty != prev && t == 0)
+            {
+                steps++;
+                if (p <= periods / 4)
+                {
+                    low_steps++;
+                    low_max = duty;
+                }
+            }
+            prev = duty;
+        }
+        failures += prev != (targets[t] ? pwm.max_duty : 0);
+    }
+    printf("fade %-22s 0->255->0 over %u periods: %4d distinct levels, %3d in the darkest quarter (up to %u/%u): %s\n",
+           name, periods, steps + 1, low_steps + 1, low_max, pwm.max_duty, failures ? "FAIL" : "ok");
+    return failures != 0;
+}
+
+// 解析の結果
+typedef struct
+{
+    double dc_error_lsb;  // 平均の明るさの誤差 (12 ビットの LSB)
+    double flicker;       // FLICKER_HZ 未満の成分の最大の振幅 (最大の明るさに対する割合)
+    double lowest_hz;     // 振幅が RIPPLE_LEVEL 以上の最も低い成分の周波数 (なければ 0)
+} analysis;
+
+// ピンの出力を [t0, t0 + WINDOW_NS) でフーリエ変換する。level12 は目標の明るさ (4095 分の level12)
+static analysis analyze(const transition *tr, int count, unsigned long long t0, double level12)
+{
+    analysis a = {0, 0, 0};
+    double window = WINDOW_NS * 1e-9;
+    unsigned long long t1 = t0 + WINDOW_NS;
+
+    // HIGH の区間 [s, e) を集める
+    static double s_buf[MAX_TRANSITIONS], e_buf[MAX_TRANSITIONS];
+    int n = 0;
+    int high = 0;
+    unsigned long long start = t0;
+    for (int i = 0; i <= count; i++)
+    {
+        unsigned long long t = i < count ? tr[i].t_ns : t1;
+        if (t > t1)
+        {
+            t = t1;
+        }
+        if (t >= t0 && high && t > start)
+        {
+            s_buf[n] = (start - t0) * 1e-9;
+            e_buf[n] = (t - t0) * 1e-9;
+            n++;
+        }
+        if (i == count || tr[i].t_ns >= t1)
+        {
+            break;
+        }
+        high = tr[i].high;
+        start = tr[i].t_ns > t0 ? tr[i].t_ns : t0;
+    }
+
+    double dc = 0;
+    for (int i = 0; i < n; i++)
+    {
+        dc += e_buf[i] - s_buf[i];
+    }
+    a.dc_error_lsb = (dc / window - level12 / 4095.0) * 4095.0;
+
+    // c_k = (1/T) Σ ∫ e^{-iωt} dt、正弦波の振幅は 2|c_k|
+    for (int k = 1; k <= MAX_HZ * window; k++)
+    {
+        double w = 2 * M_PI * k / window;
+        double re = 0, im = 0;
+        for (int i = 0; i < n; i++)
+        {
+            re += sin(w * e_buf[i]) - sin(w * s_buf[i]);
+            im += cos(w * e_buf[i]) - cos(w * s_buf[i]);
+        }
+        double amp = 2 * sqrt(re * re + im * im) / (w * window);
+        double hz = k / window;
+        if (hz < FLICKER_HZ && amp > a.flicker)
+        {
+            a.flicker = amp;
+        }
+        if (a.lowest_hz == 0 && amp >= RIPPLE_LEVEL)
+        {
+            a.lowest_hz = hz;
+        }
+    }
+    return a;
+}
+
+static const double levels12[] = {1, 3, 10, 40, 200, 1000, 2048, 3000, 4094}; // 12 ビットの明るさ
+#define NUM_LEVELS (int)(sizeof levels12 / sizeof levels12[0])
+
+// 結果を 1 行表示する
+static void report(const char *name, double irq_per_s, double load, double late_per_s, unsigned long max_latency_us,
+                   const analysis *a)
+{
+    double dc_mean = 0, dc_max = 0, flicker = 0, lowest = 0;
+    for (int i = 0; i < NUM_LEVELS; i++)
+    {
+        double e = fabs(a[i].dc_error_lsb);
+        dc_mean += e / NUM_LEVELS;
+        dc_max = e > dc_max ? e : dc_max;
+        flicker = a[i].flicker > flicker ? a[i].flicker : flicker;
+        if (a[i].lowest_hz > 0 && (lowest == 0 || a[i].lowest_hz < lowest))
+        {
+            lowest = a[i].lowest_hz;
+        }
+    }
+    printf("%-30s %8.0f %8.3f%% %8.0f %6lu %9.2f %9.2f %10.2f%% %8.0f\n", name, irq_per_s, load, late_per_s,
+           max_latency_us, dc_mean, dc_max, 100 * flicker, lowest);
+}
+
+// 9 チャンネルを割り込みで出力し、levels12 の明るさで解析する
+static void measure(const char *name, int bcm_bits, unsigned char unit_us, int fading, unsigned long block_ns)
+{
+    static const unsigned char pins[NUM_LEVELS] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    hw = (host_hw){0};
+    hw.force_software = 1;
+    hw.fading = fading;
+    for (int pin = 0; pin < NUM_PINS; pin++)
+    {
+        log_count[pin] = 0;
+    }
+    if (bcm_bits)
+    {
+        software_pwm_init_bcm(&pwm, &host, bcm_bits, unit_us, pins, NUM_LEVELS);
+    }
+    else
+    {
+        software_pwm_init(&pwm, &host, 200, pins, NUM_LEVELS);
+    }
+    for (int ch = 0; ch < NUM_LEVELS; ch++)
+    {
+        software_pwm_set_duty(&pwm, ch, (unsigned short)lround(levels12[ch] * pwm.max_duty / 4095.0));
+    }
+    software_pwm_start(&pwm);
+
+    // 表を作り直した後の周期から解析する
+    run_until((pwm.period_start_us + 2 * pwm.period_us) * 1000, block_ns);
+    unsigned long long t0 = (pwm.period_start_us + pwm.period_us) * 1000;
+    run_until(t0, block_ns);
+    unsigned long interrupts = pwm.stats.interrupts;
+    unsigned long late_edges = pwm.stats.late_edges;
+    unsigned long long isr_ns = hw.isr_ns;
+    run_until(t0 + WINDOW_NS, block_ns);
+
+    analysis a[NUM_LEVELS];
+    for (int ch = 0; ch < NUM_LEVELS; ch++)
+    {
+        a[ch] = analyze(log_buf[pins[ch]], log_count[pins[ch]], t0, levels12[ch]);
+    }
+    report(name, (pwm.stats.interrupts - interrupts) / (WINDOW_NS * 1e-9), 100.0 * (hw.isr_ns - isr_ns) / WINDOW_NS,
+           (pwm.stats.late_edges - late_edges) / (WINDOW_NS * 1e-9), pwm.stats.max_latency_us, a);
+}
+
+// 以前の方式: 100us ごとの割り込みでカウンタを進める PWM (周期 200)。波形は理想的なタイミングで作る
+static void measure_old(void)
+{
+    static transition tr[2 * 1000];
+    analysis a[NUM_LEVELS];
+    for (int ch = 0; ch < NUM_LEVELS; ch++)
+    {
+        unsigned long duty = lround(levels12[ch] * 200 / 4095.0);
+        int n = 0;
+        for (unsigned long long t = 0; t < WINDOW_NS && duty > 0; t += 200 * OLD_TICK_US * 1000ull)
+        {
+            tr[n++] = (transition){t, 1};
+            tr[n++] = (transition){t + duty * OLD_TICK_US * 1000ull, 0};
+        }
+        a[ch] = analyze(tr, n, 0, levels12[ch]);
+    }
+    double isr_ns = IRQ_ENTRY_NS + ISR_BODY_NS + 2 * TIMER_READ_NS + ALARM_WRITE_NS + NUM_LEVELS * OLD_UPDATE_NS + IRQ_EXIT_NS;
+    report("old 100us tick PWM (200)", 1e6 / OLD_TICK_US, 100.0 * isr_ns / (OLD_TICK_US * 1000), 0, 0, a);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long block_ns = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'j':
+            block_ns = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-j block_ns]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int failures = check_gamma();
+    failures += check_fade("PWM (200 steps)", 0, 100);
+    failures += check_fade("BCM 10 bit", 10, 366);
+
+    printf("9 channels by IRQ at 12-bit levels 1..4094, other-IRQ blocking up to %lu ns:\n", block_ns);
+    printf("%-30s %8s %9s %8s %6s %9s %9s %11s %8s\n", "", "IRQ/s", "ISR load", "late/s", "max us", "|dc| LSB",
+           "max LSB", "<200Hz amp", "ripple Hz");
+    measure_old();
+    measure("edge PWM (200)", 0, 0, 0, block_ns);
+    measure("BCM 10 bit, 4us LSB", 10, 4, 0, block_ns);
+    measure("BCM 12 bit, 1us LSB", 12, 1, 0, block_ns);
+    measure("BCM 12 bit, 2us LSB", 12, 2, 0, block_ns);
+    measure("BCM 12 bit, 1us LSB, fading", 12, 1, 1, block_ns);
+    measure("BCM 11 bit, 2us LSB, fading", 11, 2, 1, block_ns);
+    measure("BCM 10 bit, 4us LSB, fading", 10, 4, 1, block_ns);
+    measure("BCM 9 bit, 8us LSB, fading", 9, 8, 1, block_ns);
+    return failures != 0;
+}
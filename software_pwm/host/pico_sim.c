@@ -0,0 +1,244 @@
+#include <stdio.h>             // 標準入出力ライブラリ
+#include <stdlib.h>            // strtoul
+#include <unistd.h>            // getopt
+#include "host_util.h"         // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "reg.h"               // レジスタ定義 (REG_HOST: メモリの配列を読み書きする)
+#include "software_pwm.h"      // 複数チャンネルの PWM (software_pwm と同じソース)
+#include "software_pwm_pico.h" // 実機向けの software_pwm_hw (software_pwm と同じソース)
+
+// 実機向けの software_pwm_hw (software_pwm_pico.c) を、レジスタの代わりのメモリ (reg_host_window) で動かす
+//
+// 使い方: pico_sim [-n periods]
+//   -n  動かす周期の数 (既定 1000)
+//
+// 時刻はタイマーのレジスタ (TIMER0_TIMERAWH / TIMERAWL) に書いて進める。アラーム (TIMER0_ALARM_RW(0)) の時刻に
+// software_pwm_update() を呼び、SIO_GPIO_OUT_SET / CLR に書かれた値から割り込みで出力するピンの HIGH の期間を測る。
+//
+// 1. main.c と同じピン・BCM 10 ビット (4us) で初期化し、IO_BANK0・PADS_BANK0・PWM のレジスタに書かれた値を確かめる。
+//    パッドの ISO の解除と PWM スライスの有効化は、_CLR / _SET のエイリアスへの 1 回の書き込みで、通常のアドレスは
+//    読み書きしない。
+// 2. PWM スライスのチャンネルの比較値 (PWM_CH_CC_RW(n)) が HIGH の期間どおりかを確かめる。
+// 3. 割り込みで出力するピンの HIGH の期間が、周期ごとに設定どおりかを確かめる。
+// 4. ホストの CPU で、software_pwm_set_duty() と software_pwm_update() の時間を測る。
+
+#define PWM_BCM_BITS 10    // main.c と同じ BCM のビット数
+#define PWM_BCM_UNIT_US 4  // main.c と同じ BCM の最下位ビットのスロットの長さ [us]
+#define NUM_GPIOS 30       // RP2350A の GPIO の数
+#define GPIO_FUNC_PWM 4    // IO_BANK0 の機能選択: PWM
+#define GPIO_FUNC_SIO 5    // IO_BANK0 の機能選択: SIO (GPIO)
+#define PADS_ISO (1ul << 8) // PADS_BANK0: ISO
+#define BENCH_CALLS 1000000
+
+static const unsigned char pwm_pins[] = {10, 11, 12, 13, 14, 15, 26, 27, 28}; // main.c と同じピン
+#define NUM_CHANNELS (sizeof(pwm_pins) / sizeof(pwm_pins[0]))
+
+static software_pwm pwm;
+static int failures; // 確かめて違っていた数
+
+// 値を確かめる
+static void expect(const char *what, int pin, unsigned long actual, unsigned long expected)
+{
+    if (actual != expected)
+    {
+        if (failures < 10)
+        {
+            printf("  %s (GPIO%d): 0x%lx, expected 0x%lx\n", what, pin, actual, expected);
+        }
+        failures++;
+    }
+}
+
+// タイマーのレジスタに時刻を書く
+static void set_time(unsigned long long time_us)
+{
+    TIMER0_TIMERAWH_RW = (unsigned long)(time_us >> 32);
+    TIMER0_TIMERAWL_RW = (unsigned long)time_us & 0xffffffff;
+}
+
+// アラームのレジスタ (下位 32 ビット) から、時刻 now_us 以降の 64 ビットの時刻を求める
+static unsigned long long alarm_time(unsigned long long now_us)
+{
+    unsigned long long t = (now_us & ~0xffffffffull) | (TIMER0_ALARM_RW(0) & 0xffffffff);
+    return t < now_us ? t + (1ull << 32) : t;
+}
+
+// BCM の duty_period の HIGH の期間 [us]
+static unsigned long high_us(unsigned short duty)
+{
+    return (unsigned long)duty * PWM_BCM_UNIT_US;
+}
+
+// ---- 1. 初期化 ----
+
+static void check_init(void)
+{
+    set_time(0xfffff000ull); // 下位 32 ビットの桁上がりの少し前から始める
+    software_pwm_init_bcm(&pwm, software_pwm_pico_hw(), PWM_BCM_BITS, PWM_BCM_UNIT_US, pwm_pins, NUM_CHANNELS);
+
+    unsigned long used = 0;
+    unsigned long slices = 0;
+    for (unsigned ch = 0; ch < NUM_CHANNELS; ch++)
+    {
+        int pin = pwm_pins[ch];
+        used |= 1ul << pin;
+        expect("IO_BANK0_GPIO_CTRL_RW", pin, IO_BANK0_GPIO_CTRL_RW(pin),
+               pwm.channels[ch].hardware ? GPIO_FUNC_PWM : GPIO_FUNC_SIO);
+        expect("PADS_BANK0_GPIO_CLR", pin, PADS_BANK0_GPIO_CLR(pin), PADS_ISO);
+        expect("PADS_BANK0_GPIO_RW", pin, PADS_BANK0_GPIO_RW(pin), 0); // 読み書きしない
+        if (pwm.channels[ch].hardware)
+        {
+            unsigned slice = (pin >> 1) & 7;
+            slices |= 1ul << slice;
+            expect("PWM_CH_DIV_RW", pin, PWM_CH_DIV_RW(slice), (SOFTWARE_PWM_CLK_SYS_HZ / 1000000) << 4);
+            expect("PWM_CH_TOP_RW", pin, PWM_CH_TOP_RW(slice), pwm.period_us - 1);
+            expect("PWM_CH_CC_RW", pin, PWM_CH_CC_RW(slice), 0);
+        }
+    }
+    for (int pin = 0; pin < NUM_GPIOS; pin++)
+    {
+        if (!(used >> pin & 1))
+        {
+            expect("IO_BANK0_GPIO_CTRL_RW (unused)", pin, IO_BANK0_GPIO_CTRL_RW(pin), 0);
+        }
+    }
+
+    software_pwm_start(&pwm);
+    expect("PWM_EN_SET", -1, PWM_EN_SET, slices);
+    expect("PWM_EN_RW", -1, PWM_EN_RW, 0); // 読み書きしない
+    expect("TIMER0_ALARM_RW(0)", -1, TIMER0_ALARM_RW(0), (0xfffff000ul + SOFTWARE_PWM_TICK_US) & 0xffffffff);
+
+    printf("init (%u pins, slices 0x%lx): IO_BANK0 / PADS_BANK0 / PWM registers, alias writes only: %s\n",
+           (unsigned)NUM_CHANNELS, slices, failures ? "NG" : "OK");
+}
+
+// ---- 2. / 3. 出力 ----
+
+static void check_output(unsigned long periods)
+{
+    int before = failures;
+    unsigned long rng = 12345;
+    unsigned short duty[NUM_CHANNELS] = {0};
+    unsigned long long now = alarm_time(0xfffff000ull);
+    set_time(now);
+
+    unsigned long out = 0;                        // SIO の出力
+    unsigned long long rise_us[NUM_GPIOS] = {0};  // HIGH になった時刻
+    unsigned long long high_sum[NUM_GPIOS] = {0}; // 今の周期の HIGH の期間
+    unsigned long checked = 0;                    // 確かめたピンの数 (周期 × ピン)
+    unsigned long started = 0;                    // 始まった周期の数
+
+    while (started <= periods)
+    {
+        SIO_GPIO_OUT_SET = 0;
+        SIO_GPIO_OUT_CLR = 0;
+        int ret = software_pwm_update(&pwm);
+
+        // 書かれた値から出力を求める
+        unsigned long set = SIO_GPIO_OUT_SET;
+        unsigned long clr = SIO_GPIO_OUT_CLR;
+        for (int pin = 0; pin < NUM_GPIOS; pin++)
+        {
+            if ((set >> pin & 1) && !(out >> pin & 1))
+            {
+                rise_us[pin] = now;
+            }
+            if ((clr >> pin & 1) && (out >> pin & 1))
+            {
+                high_sum[pin] += now - rise_us[pin];
+            }
+        }
+        out = (out | set) & ~clr;
+
+        // 割り込みで出力するチャンネルの表は周期の最後のエッジで作り直す (エッジが 1 つなら次の周期の最初のエッジの
+        // 後になる) ので、HIGH の期間は 3 周期ごとに変え、変える直前の周期を確かめる
+        if (ret && started % 3 == 0)
+        {
+            for (unsigned ch = 0; ch < NUM_CHANNELS && started >= 3; ch++)
+            {
+                int pin = pwm_pins[ch];
+                if (pwm.channels[ch].hardware)
+                {
+                    unsigned long cc = PWM_CH_CC_RW((pin >> 1) & 7);
+                    expect("PWM_CH_CC_RW", pin, pin & 1 ? cc >> 16 : cc & 0xffff, high_us(duty[ch]));
+                }
+                else
+                {
+                    // 周期の境目をまたいで HIGH のピンは、開始時刻までを足す
+                    unsigned long long high = high_sum[pin] + ((out >> pin & 1) ? now - rise_us[pin] : 0);
+                    expect("HIGH [us]", pin, (unsigned long)high, high_us(duty[ch]));
+                }
+                checked++;
+            }
+            for (unsigned ch = 0; ch < NUM_CHANNELS; ch++)
+            {
+                rng ^= rng << 13;
+                rng ^= rng >> 17;
+                rng ^= rng << 5;
+                rng &= 0xffffffff;
+                duty[ch] = rng % 4 == 0 ? (rng % 8 == 0 ? 0 : pwm.max_duty) : (unsigned short)(rng % (pwm.max_duty + 1));
+                software_pwm_set_duty(&pwm, ch, duty[ch]);
+            }
+        }
+        if (ret)
+        {
+            started++;
+            for (int pin = 0; pin < NUM_GPIOS; pin++)
+            {
+                high_sum[pin] = 0;
+                rise_us[pin] = now;
+            }
+        }
+        now = alarm_time(now);
+        set_time(now);
+    }
+    printf("%lu periods (%lu us each), PWM_CH_CC_RW of slice pins and HIGH time of SIO pins (%lu checks): %s\n", periods,
+           pwm.period_us, checked, failures == before ? "OK" : "NG");
+}
+
+// ---- 4. 時間 ----
+
+static void bench(void)
+{
+    unsigned long long now = alarm_time(TIMER0_TIMERAWL_RW);
+    double t0 = now_sec();
+    for (unsigned long i = 0; i < BENCH_CALLS; i++)
+    {
+        software_pwm_set_duty(&pwm, (int)(i & 1), (unsigned short)(i & pwm.max_duty)); // PWM スライスのチャンネル
+    }
+    double t1 = now_sec();
+    unsigned long calls = 0;
+    for (unsigned long i = 0; i < BENCH_CALLS; i++)
+    {
+        set_time(now);
+        software_pwm_update(&pwm);
+        now = alarm_time(now);
+        calls++;
+    }
+    double t2 = now_sec();
+    printf("host CPU (register writes go to reg_host_window): software_pwm_set_duty() %.1f ns, software_pwm_update() "
+           "%.1f ns\n",
+           (t1 - t0) * 1e9 / BENCH_CALLS, (t2 - t1) * 1e9 / calls);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long periods = 1000;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            periods = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n periods]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    check_init();
+    check_output(periods);
+    bench();
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,311 @@
+#include <stdio.h>        // 標準入出力ライブラリ
+#include <stdlib.h>       // strtol, abs
+#include <unistd.h>       // getopt
+#include "host_util.h"    // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "software_pwm.h" // 複数チャンネルの PWM (software_pwm と同じソース)
+
+// 複数チャンネルの PWM をホストで動かし、タイマー割り込みの負荷とエッジの遅れ (ジッタ) を調べる
+//
+// 使い方: pwm_sim [-n periods] [-j block_ns]
+//   -n  シミュレーションする周期の数 (既定 500 = 10 秒)
+//   -j  他の割り込みなどで割り込みの開始が遅れる時間の最大値 [ns] (既定 0。0〜block_ns の一様乱数)
+//
+// 時計は仮想時刻 (ns) で、アラームの時刻になると割り込みに入り、ハードウェアへのアクセスごとに下の時間だけ進む
+// (150MHz の Cortex-M33 のおおよそのサイクル数から見積もった値)。
+// GPIO の出力は SIO_GPIO_OUT_SET / CLR を書いた時刻に変わるものとし、ピンごとに HIGH の期間を測る。
+//
+// 1. main.c と同じピン (GPIO10〜15 と、スライスが重なる GPIO26〜28) で、PWM スライスと割り込みの振り分けを確かめる。
+// 2. HIGH の期間を固定して、割り込みで出力するピンの HIGH の期間が設定どおりか (誤差はジッタの範囲か) を確かめる。
+// 3. PWM モードの main.c (PWM_BCM_BITS = 0) と同じく周期ごとに HIGH の期間を変えながら、割り込みの回数・負荷・ジッタを、
+//    すべて割り込みで出力する場合 (9 / 16 チャンネル) も含めて以前の方式 (100us ごとの割り込み) と比べる。
+
+#define IRQ_ENTRY_NS 100     // 割り込みに入るまで (例外の受け付けとレジスタの退避)
+#define IRQ_EXIT_NS 70       // 割り込みから戻るまで
+#define ISR_BODY_NS 60       // timer_interrupt() の割り込みフラグのクリアと呼び出し
+#define EDGE_NS 60           // 1 つのエッジの処理 (表を読んで次へ進む)
+#define GPIO_WRITE_NS 15     // SIO_GPIO_OUT_SET / CLR への 1 回の書き込み
+#define TIMER_READ_NS 60     // 64 ビットの時刻の読み出し
+#define ALARM_WRITE_NS 30    // アラームの設定
+#define REBUILD_NS_PER_CH 50 // エッジの表の作り直し (チャンネルあたり)
+#define SET_DUTY_NS 40       // software_pwm_set_duty() の 1 回の呼び出し
+#define OLD_UPDATE_NS 150    // 以前の software_pwm_update() (カウンタの比較と SET / CLR の書き込み)
+#define OLD_TICK_US 100      // 以前の割り込みの間隔 [us]
+#define CYCLE_PERIOD 200     // main.c と同じ周期 (200 × 100us = 20ms)
+#define NUM_PINS 32
+
+// ホストのハードウェア (仮想時刻)
+typedef struct
+{
+    unsigned long long clock_ns;    // 仮想時刻
+    unsigned long long alarm_us;    // アラームの時刻
+    int force_software;             // 1 ならすべてのピンを割り込みで出力する (PWM スライスを使わない)
+    unsigned long levels[NUM_PINS]; // PWM スライスのチャンネルの HIGH の期間 [us]
+    unsigned long pwm_pins;         // PWM の出力にしたピン
+    unsigned long enabled_slices;   // 動いているスライス
+    unsigned long out;              // SIO の出力
+    unsigned long long rise_ns[NUM_PINS]; // HIGH になった時刻
+    unsigned long rises[NUM_PINS];  // HIGH になった回数
+    long long high_error_max_ns;    // HIGH の期間の誤差の最大値 (絶対値)
+    int check_high;                 // 1 なら HIGH の期間を expected_us と比べる
+    unsigned long expected_us[NUM_PINS]; // 期待する HIGH の期間 [us]
+    unsigned long high_count;       // 測った HIGH の期間の数
+    unsigned long long jitter_max_ns; // エッジの時刻から出力までの遅れの最大値
+    unsigned long long jitter_sum_ns; // その合計
+    unsigned long writes;           // 出力したエッジの数
+    unsigned long long isr_ns;      // 割り込みの処理時間の合計
+} host_hw;
+
+static software_pwm pwm;
+static host_hw hw;
+
+static int host_pwm_channel(void *ctx, unsigned char pin)
+{
+    host_hw *h = ctx;
+    return h->force_software || pin >= 30 ? -1 : ((pin >> 1) & 7) << 1 | (pin & 1);
+}
+
+static void host_pwm_setup(void *ctx, unsigned char pin, unsigned long top)
+{
+    (void)top;
+    host_hw *h = ctx;
+    h->pwm_pins |= 1ul << pin;
+}
+
+static void host_pwm_level(void *ctx, unsigned char pin, unsigned long level)
+{
+    host_hw *h = ctx;
+    h->levels[pin] = level;
+}
+
+static void host_pwm_enable(void *ctx, unsigned long slices)
+{
+    host_hw *h = ctx;
+    h->enabled_slices |= slices;
+}
+
+static void host_gpio_setup(void *ctx, unsigned char pin)
+{
+    host_hw *h = ctx;
+    h->out &= ~(1ul << pin);
+}
+
+static void host_gpio_write(void *ctx, unsigned long set, unsigned long clr)
+{
+    host_hw *h = ctx;
+    // 出力するエッジの予定時刻 (software_pwm_update() はエッジを出力してから次へ進む)
+    unsigned long long due_ns = (pwm.period_start_us + pwm.edges[pwm.next].offset_us) * 1000;
+    h->clock_ns += (set ? GPIO_WRITE_NS : 0) + (clr ? GPIO_WRITE_NS : 0);
+    unsigned long long jitter = h->clock_ns - due_ns;
+    h->jitter_max_ns = jitter > h->jitter_max_ns ? jitter : h->jitter_max_ns;
+    h->jitter_sum_ns += jitter;
+    h->writes++;
+
+    for (int pin = 0; pin < NUM_PINS; pin++)
+    {
+        unsigned long mask = 1ul << pin;
+        if ((set & mask) && !(h->out & mask))
+        {
+            h->rise_ns[pin] = h->clock_ns;
+            h->rises[pin]++;
+        }
+        if ((clr & mask) && (h->out & mask) && h->check_high)
+        {
+            long long error = (long long)(h->clock_ns - h->rise_ns[pin]) - (long long)h->expected_us[pin] * 1000;
+            error = error < 0 ? -error : error;
+            h->high_error_max_ns = error > h->high_error_max_ns ? error : h->high_error_max_ns;
+            h->high_count++;
+        }
+    }
+    h->out = (h->out | set) & ~clr;
+}
+
+static unsigned long long host_now_us(void *ctx)
+{
+    host_hw *h = ctx;
+    h->clock_ns += TIMER_READ_NS;
+    return h->clock_ns / 1000;
+}
+
+static void host_set_alarm(void *ctx, unsigned long long time_us)
+{
+    host_hw *h = ctx;
+    h->clock_ns += ALARM_WRITE_NS;
+    h->alarm_us = time_us;
+}
+
+static const software_pwm_hw host = {
+    .pwm_channel = host_pwm_channel,
+    .pwm_setup = host_pwm_setup,
+    .pwm_level = host_pwm_level,
+    .pwm_enable = host_pwm_enable,
+    .gpio_setup = host_gpio_setup,
+    .gpio_write = host_gpio_write,
+    .now_us = host_now_us,
+    .set_alarm = host_set_alarm,
+    .ctx = &hw,
+};
+
+// 割り込みで出力するチャンネルの数
+static int software_channels(void)
+{
+    int count = 0;
+    for (int ch = 0; ch < pwm.count; ch++)
+    {
+        count += !pwm.channels[ch].hardware;
+    }
+    return count;
+}
+
+// periods 周期分の割り込みを実行する。sweep なら PWM モードの main.c と同じく周期ごとに HIGH の期間を 1 ずつ増やす
+static void run(int periods, int sweep, unsigned long block_ns)
+{
+    unsigned long target = pwm.stats.periods + periods;
+    while (pwm.stats.periods < target)
+    {
+        // アラームの時刻に割り込みに入る (他の割り込みで遅れることがある)
+        unsigned long long fire_ns = hw.alarm_us * 1000;
+        unsigned long long start_ns = hw.clock_ns > fire_ns ? hw.clock_ns : fire_ns;
+        if (block_ns)
+        {
+            start_ns += rng() % block_ns;
+        }
+        hw.clock_ns = start_ns + IRQ_ENTRY_NS + ISR_BODY_NS;
+
+        unsigned long edges = pwm.stats.edges;
+        int dirty = pwm.dirty;
+        int ret = software_pwm_update(&pwm);
+        hw.clock_ns += (pwm.stats.edges - edges) * EDGE_NS;
+        if (dirty && !pwm.dirty)
+        {
+            hw.clock_ns += REBUILD_NS_PER_CH * pwm.count; // エッジの表を作り直した
+        }
+        if (ret == 1 && sweep)
+        {
+            for (int ch = 0; ch < pwm.count; ch++)
+            {
+                unsigned char duty = pwm.channels[ch].duty_period + 1;
+                software_pwm_set_duty(&pwm, ch, duty > pwm.cycle_period ? 0 : duty);
+                hw.clock_ns += SET_DUTY_NS;
+            }
+        }
+        hw.clock_ns += IRQ_EXIT_NS;
+        hw.isr_ns += hw.clock_ns - start_ns;
+    }
+}
+
+// pins で PWM を始める。force_software ならすべて割り込みで出力する
+static void setup(const unsigned char *pins, int count, int force_software)
+{
+    hw = (host_hw){0};
+    hw.force_software = force_software;
+    software_pwm_init(&pwm, &host, CYCLE_PERIOD, pins, count);
+    for (int ch = 0; ch < count; ch++)
+    {
+        software_pwm_set_duty(&pwm, ch, ch * CYCLE_PERIOD / count); // PWM モードの main.c と同じく位相をずらす
+    }
+    software_pwm_start(&pwm);
+}
+
+// main.c と同じピンの振り分けと、HIGH の期間を確かめる。失敗の数を返す
+static int check_outputs(unsigned long block_ns)
+{
+    static const unsigned char pins[] = {10, 11, 12, 13, 14, 15, 26, 27, 28}; // main.c と同じ
+    const int count = sizeof pins / sizeof pins[0];
+    int failures = 0;
+    setup(pins, count, 0);
+
+    printf("channels:");
+    for (int ch = 0; ch < count; ch++)
+    {
+        printf(" GPIO%d=%s", pwm.channels[ch].pin, pwm.channels[ch].hardware ? "pwm" : "irq");
+        failures += pwm.channels[ch].hardware != (pins[ch] < 16); // 10〜15 がスライス 5〜7、26〜28 はそれと重なる
+    }
+    printf("\n");
+
+    // HIGH の期間を固定し (0, 途中, 周期以上を含む)、表を作り直した後の周期から測る
+    static const unsigned char duties[] = {1, 37, 100, 100, 199, 255, 0, 200, 3};
+    for (int ch = 0; ch < count; ch++)
+    {
+        software_pwm_set_duty(&pwm, ch, duties[ch]);
+        hw.expected_us[pwm.channels[ch].pin] = duties[ch] * SOFTWARE_PWM_TICK_US;
+    }
+    run(2, 0, block_ns);
+    hw.check_high = 1;
+    run(50, 0, block_ns);
+
+    int level_errors = 0;
+    for (int ch = 0; ch < count; ch++)
+    {
+        const software_pwm_channel *c = &pwm.channels[ch];
+        unsigned long expect = (duties[ch] < CYCLE_PERIOD ? duties[ch] : CYCLE_PERIOD) * SOFTWARE_PWM_TICK_US;
+        level_errors += c->hardware && hw.levels[c->pin] != expect;
+    }
+    // 割り込みのチャンネルは GPIO26 = 0 (HIGH にならない)、GPIO27 = 200 (LOW に戻らない)、GPIO28 = 3 (毎周期 300us)
+    int ok = level_errors == 0 && hw.rises[26] == 0 && hw.rises[27] == 1 && hw.high_count == 50 &&
+             hw.high_error_max_ns < 1000 + (long long)block_ns; // 誤差は割り込みの遅れの範囲
+    printf("fixed duties: PWM slice levels %s, %lu interrupt-driven pulses measured, max high-time error %lld ns: %s\n",
+           level_errors ? "WRONG" : "ok", hw.high_count, hw.high_error_max_ns, ok ? "ok" : "FAIL");
+    return failures + !ok;
+}
+
+// 周期ごとに HIGH の期間を変えながら負荷とジッタを調べる
+static void measure(const char *name, const unsigned char *pins, int count, int force_software, int periods, unsigned long block_ns)
+{
+    setup(pins, count, force_software);
+    run(periods, 1, block_ns);
+    double seconds = hw.clock_ns * 1e-9;
+    printf("%-26s %3d/%-3d %10.0f %9.3f%% %10.0f %10llu %6lu\n", name, count - software_channels(), software_channels(),
+           pwm.stats.interrupts / seconds, 100.0 * hw.isr_ns / hw.clock_ns,
+           hw.writes ? (double)hw.jitter_sum_ns / hw.writes : 0.0, hw.jitter_max_ns, pwm.stats.late_edges);
+}
+
+int main(int argc, char **argv)
+{
+    int periods = 500;
+    unsigned long block_ns = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:j:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            periods = (int)strtol(optarg, NULL, 0);
+            break;
+        case 'j':
+            block_ns = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-n periods] [-j block_ns]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (periods <= 0)
+    {
+        fprintf(stderr, "usage: %s [-n periods] [-j block_ns]\n", argv[0]);
+        return 2;
+    }
+
+    int failures = check_outputs(block_ns);
+
+    static const unsigned char demo[] = {10, 11, 12, 13, 14, 15, 26, 27, 28};
+    static const unsigned char sixteen[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    printf("sweeping duties for %d periods (%.1f s), other-IRQ blocking up to %lu ns:\n", periods,
+           periods * CYCLE_PERIOD * SOFTWARE_PWM_TICK_US * 1e-6, block_ns);
+    printf("%-26s %7s %10s %10s %10s %10s %6s\n", "", "pwm/irq", "IRQ/s", "ISR load", "avg ns", "max ns", "late");
+    measure("main.c pins", demo, sizeof demo, 0, periods, block_ns);
+    measure("main.c pins, all by IRQ", demo, sizeof demo, 1, periods, block_ns);
+    measure("16 pins, all by IRQ", sixteen, sizeof sixteen, 1, periods, block_ns);
+
+    // 以前の方式: 100us ごとに割り込み、1 チャンネルにつき 1 回 software_pwm_update() を呼ぶ
+    static const int old_channels[] = {1, 9, 16};
+    for (size_t k = 0; k < sizeof old_channels / sizeof old_channels[0]; k++)
+    {
+        int n = old_channels[k];
+        double isr_ns = IRQ_ENTRY_NS + ISR_BODY_NS + 2 * TIMER_READ_NS + ALARM_WRITE_NS + n * OLD_UPDATE_NS + IRQ_EXIT_NS;
+        char name[32];
+        snprintf(name, sizeof name, "old 100us tick, %d ch", n);
+        printf("%-26s %3d/%-3d %10.0f %9.3f%% %10s %10s %6s\n", name, 0, n, 1e6 / OLD_TICK_US,
+               100.0 * isr_ns / (OLD_TICK_US * 1000), "-", "-", "-");
+    }
+    return failures != 0;
+}
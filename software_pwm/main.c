@@ -1,79 +1,76 @@
 #include "reg.h"
 #include "hardware/irq.h"
+#include "software_pwm.h"      // 複数チャンネルの PWM
+#include "software_pwm_pico.h" // レジスタを直接操作する software_pwm_hw
+#include "idle.h"              // アイドル処理 (割り込みを待つ間 CPU を眠らせる)
+#include "idle_pico.h"         // レジスタを直接操作する idle_hw
+#include "trace.h"             // トレースポイント (処理の時間を測る)
 
-// ソフトウェアPWM制御用の構造体
-typedef struct
-{
-    unsigned char cycle_period;  // PWM周期 (単位: 割り込み回数)
-    unsigned char cycle_counter; // 現在の周期カウンタ
-    unsigned char duty_period;   // HIGHレベルの期間 (デューティー比、単位: 割り込み回数)
-    unsigned char duty_counter;  // 現在のデューティー比カウンタ
-} software_pwm;
+// PWMで出力するGPIOピン
+// GPIO10〜15 は PWM スライス 5〜7 のチャンネルA/B でハードウェア出力になる。
+// GPIO26〜28 はそれぞれ GPIO10〜12 と同じスライスのチャンネルにつながるので、タイマー割り込みで出力する
+static const unsigned char pwm_pins[] = {10, 11, 12, 13, 14, 15, 26, 27, 28};
+#define NUM_CHANNELS (sizeof(pwm_pins) / sizeof(pwm_pins[0]))
+
+// BCM モードのビット数 (0 なら以前と同じ PWM モードで、周期 20ms、デューティー比を直線的に変える)
+// 10 ビット、最下位ビットのスロット 4us なら周期は 4092us (244Hz)
+// 周期の始めの割り込みは全チャンネルのフェードを進めるので約 4us かかる (host/bcm_sim の見積もり)。
+// スロットをこれより短くすると下位ビットのエッジが遅れて同じ割り込みにまとまり、そのビットは出せない
+// (12 ビット・1us にしても、明るさの誤差は 10 ビット・4us と変わらない)。
+#define PWM_BCM_BITS 10
+#define PWM_BCM_UNIT_US 4   // BCM の最下位ビットのスロットの長さ [us] (周期の始めの割り込みの時間以上にする)
+#define FADE_PERIODS 366    // 消灯から最大の明るさまでのフェードの周期数 (約 1.5 秒)
+#define TRACE_PWM_BEGIN 0   // トレースポイントの番号: エッジの出力の始まり
+#define TRACE_PWM_END 1     // トレースポイントの番号: エッジの出力の終わり
+#define TRACE_READ_COUNT 16 // 1 回に取り出す記録の数
 
-software_pwm SoftPwm; // ソフトウェアPWM制御構造体のインスタンス
+software_pwm SoftPwm;                        // ソフトウェアPWM制御構造体のインスタンス
+static idle Idle;                            // アイドル処理 (眠っていた時間・起きていた時間を数える)
+static trace_buffer Trace;                   // トレースのリングバッファ
+static trace_span PwmSpan;                   // エッジの出力のサイクル数の統計 (デバッガで見る)
+static volatile unsigned long TraceOverhead; // TRACE_POINT() 1 回のサイクル数 (PwmSpan から引いて見る)
 
-// LEDの初期化を行う関数
-static void init_led(void);
-// 現在の時間を取得する関数
-static unsigned long long get_time(void);
-// タイマー0のアラーム0を再設定する関数
-static void reload_alarm0(void);
 // タイマー割り込みが発生した際に実行される関数
 static void timer_interrupt(void);
 // タイマー関連の初期化を行う関数
 static void init_timer(void);
-// ソフトウェアPWMのデューティー比を更新し、LEDを制御する関数
-static int software_pwm_update(software_pwm *sp);
-
-// LEDの初期化を行う関数
-static void init_led(void)
-{
-    /* OE:output enable */
-    // GPIO10番ピンの出力機能を無効にする (最初は出力を止めておく)
-    SIO_GPIO_OE_CLR = 1 << 10;
-    // GPIO10番ピンの出力をクリア (LOWレベルにする)
-    SIO_GPIO_OUT_CLR = 1 << 10;
-
-    /* GPIOとして使う為の設定 */
-    // IOバンク0のGPIO10番ピンをGPIO機能として設定 (値5はGPIOモードを示す)
-    IO_BANK0_GPIO10_CTRL_RW = 5;
-    // IOバンク0のGPIO10番ピンのプルアップ/プルダウン抵抗などをクリア (デフォルト設定にする)
-    PADS_BANK0_BASE_GPIO10_CLR = 1 << 8;
-
-    // GPIO10番ピンの出力機能を有効にする (ここで初めて出力が可能になる)
-    SIO_GPIO_OE_SET = 1 << 10;
-}
-
-// 現在の時間を取得する関数 (64ビットのunsigned long long型で返す)
-static unsigned long long get_time(void)
-{
-    volatile unsigned long time_l = (TIMER0_TIMELR);     // 下位32bit
-    volatile unsigned long time_h = (TIMER0_TIMEHR);     // 上位32bit
-    return ((unsigned long long)time_h << 32u) | time_l; // 64bitに結合
-}
-
-// タイマー0のアラーム0を再設定する関数
-static void reload_alarm0(void)
-{
-    TIMER0_ALARM0 = (unsigned long)(get_time() + 100); // 100クロック後に割り込みが発生するように設定
-}
+// トレースの記録を取り出して、エッジの出力のサイクル数の統計に加える関数
+static void update_trace(void);
 
 // タイマー割り込みが発生した際に実行される関数
 static void timer_interrupt(void)
 {
-    int ret = 0;
-    reload_alarm0();                     // 次の割り込みタイミングを設定
-    TIMER0_INTR = 1 << 0;                // タイマー0の割り込みフラグをクリア (これを行わないと割り込みが止まらない)
-    ret = software_pwm_update(&SoftPwm); // ソフトウェアPWMのデューティー比を更新し、LEDを制御する
+    TIMER0_INTR_RW = 1 << 0; // タイマー0の割り込みフラグをクリア (これを行わないと割り込みが止まらない)
+    TRACE_POINT(&Trace, TRACE_PWM_BEGIN);
+    int ret = software_pwm_update(&SoftPwm); // 時刻になったエッジを出力し、次のエッジの割り込みを設定する
+    TRACE_POINT(&Trace, TRACE_PWM_END);
+#if PWM_BCM_BITS > 0
+    if (ret == 1)
+    {
+        // 周期が始まった場合: フェードが終わったチャンネルを、最大の明るさと消灯の間で折り返してフェードさせる
+        for (int ch = 0; ch < (int)NUM_CHANNELS; ch++)
+        {
+            if (!software_pwm_fading(&SoftPwm, ch))
+            {
+                software_pwm_fade(&SoftPwm, ch, SoftPwm.channels[ch].fade_target ? 0 : 255, FADE_PERIODS);
+            }
+        }
+    }
+#else
     if (ret == 1)
     {
-        // 周期が終了した場合
-        SoftPwm.duty_period++;                          // デューティー比をインクリメント
-        if (SoftPwm.duty_period > SoftPwm.cycle_period) // デューティー比が周期を超えた場合
+        // 周期が始まった場合: 各チャンネルのデューティー比をインクリメント (チャンネルごとに位相をずらす)
+        for (int ch = 0; ch < (int)NUM_CHANNELS; ch++)
         {
-            SoftPwm.duty_period = 0; // デューティー比をリセット
+            unsigned char duty = SoftPwm.channels[ch].duty_period + 1;
+            if (duty > SoftPwm.cycle_period) // デューティー比が周期を超えた場合
+            {
+                duty = 0; // デューティー比をリセット
+            }
+            software_pwm_set_duty(&SoftPwm, ch, duty);
         }
     }
+#endif
 }
 
 // タイマー関連の初期化を行う関数
@@ -81,54 +78,66 @@ static void init_timer(void)
 {
     irq_set_exclusive_handler(0, timer_interrupt); // 割り込み番号0にタイマー割り込みハンドラ (timer_interrupt関数) を設定
     irq_set_enabled(0, 1);                         // 割り込み番号0を有効にする
-    reload_alarm0();                               // 最初の割り込みタイミングを設定
-    TIMER0_INTE = 1 << 0;                          // タイマー0のアラーム0割り込みを有効にする
+    software_pwm_start(&SoftPwm);                  // PWMスライスを動かし、最初の周期の割り込みを設定
+    TIMER0_INTE_SET = 1 << 0;                      // タイマー0のアラーム0割り込みを有効にする
 }
 
-// ソフトウェアPWMのデューティー比を更新し、LEDを制御する関数
-static int software_pwm_update(software_pwm *sp)
+// トレースの記録を取り出して、エッジの出力のサイクル数の統計に加える関数
+static void update_trace(void)
 {
-    int ret = 0;
-    if (sp->cycle_counter > sp->cycle_period)
+    trace_event events[TRACE_READ_COUNT];
+    unsigned long n;
+    while ((n = trace_read(&Trace, events, TRACE_READ_COUNT)) != 0)
     {
-        // 周期が終了した場合
-        sp->cycle_counter = 0; // 周期カウンタをリセット
-        sp->duty_counter = 0;  // デューティー比カウンタをリセット
-        ret = 1;               // 周期終了フラグを立てる
+        trace_span_add(&PwmSpan, events, n);
     }
-    else
-    {
-        // 周期内の場合
-        sp->cycle_counter++; // 周期カウンタをインクリメント
-        sp->duty_counter++;  // デューティー比カウンタをインクリメント
-        if (sp->duty_counter > sp->duty_period)
-        {
-            // デューティー比期間が終了した場合 (LOWレベル出力)
-            SIO_GPIO_OUT_CLR = 1 << 10; // LEDを消灯
-        }
-        else
-        {
-            // デューティー比期間内の場合 (HIGHレベル出力)
-            SIO_GPIO_OUT_SET = 1 << 10; // LEDを点灯
-        }
-    }
-    return ret;
 }
 
 // メイン関数 (プログラムのエントリーポイント)
 void main(void)
 {
-    SoftPwm.cycle_period = 200; // PWM周期を200に設定 (タイマー割り込み100クロック毎なので、200*100クロック = 20ms)
-    SoftPwm.cycle_counter = 0;
-    SoftPwm.duty_period = 0; // 初期デューティー比は0%
-    SoftPwm.duty_counter = 0;
+    // 使わないブロック (PIO・SPI・I2C・UART・ADC・USB など) のクロックを止めてリセットしたままにする
+    // PWM スライスを使うので、PWM は止めない
+    idle_pico_gate(CLK_EN0_ADC | CLK_EN0_SYS_ADC | CLK_EN0_HSTX | CLK_EN0_SYS_HSTX | CLK_EN0_SYS_I2C0 |
+                       CLK_EN0_SYS_I2C1 | CLK_EN0_SYS_PIO0 | CLK_EN0_SYS_PIO1 | CLK_EN0_SYS_PIO2 | CLK_EN0_SYS_SHA256,
+                   CLK_EN1_PERI_SPI0 | CLK_EN1_SYS_SPI0 | CLK_EN1_PERI_SPI1 | CLK_EN1_SYS_SPI1 | CLK_EN1_SYS_TRNG |
+                       CLK_EN1_PERI_UART0 | CLK_EN1_SYS_UART0 | CLK_EN1_PERI_UART1 | CLK_EN1_SYS_UART1 |
+                       CLK_EN1_SYS_USBCTRL | CLK_EN1_USB,
+                   RESETS_ADC | RESETS_HSTX | RESETS_I2C0 | RESETS_I2C1 | RESETS_PIO0 | RESETS_PIO1 | RESETS_PIO2 |
+                       RESETS_SHA256 | RESETS_SPI0 | RESETS_SPI1 | RESETS_TRNG | RESETS_UART0 | RESETS_UART1 |
+                       RESETS_USBCTRL);
+    idle_init(&Idle, idle_pico_hw());
+
+#if PWM_BCM_BITS > 0
+    // BCM モードで各チャンネルの出力ピンを初期化 (初期デューティー比は0%)
+    software_pwm_init_bcm(&SoftPwm, software_pwm_pico_hw(), PWM_BCM_BITS, PWM_BCM_UNIT_US, pwm_pins, NUM_CHANNELS);
+    for (int ch = 0; ch < (int)NUM_CHANNELS; ch++)
+    {
+        software_pwm_fade(&SoftPwm, ch, 255, FADE_PERIODS * (ch + 1) / NUM_CHANNELS); // チャンネルごとに位相をずらす
+    }
+#else
+    // PWM周期を200に設定 (単位 100us なので 20ms)。各チャンネルの出力ピンを初期化 (初期デューティー比は0%)
+    software_pwm_init(&SoftPwm, software_pwm_pico_hw(), 200, pwm_pins, NUM_CHANNELS);
+    for (int ch = 0; ch < (int)NUM_CHANNELS; ch++)
+    {
+        software_pwm_set_duty(&SoftPwm, ch, ch * 200 / NUM_CHANNELS); // チャンネルごとに位相をずらす
+    }
+#endif
+
+    // サイクルカウンタを動かし、トレースを初期化する
+    timebase_init();
+    TraceOverhead = trace_overhead_cycles(&Trace);
+    trace_init(&Trace);
+    trace_span_init(&PwmSpan, TRACE_PWM_BEGIN, TRACE_PWM_END);
 
-    init_led();   // LEDの初期化
     init_timer(); // タイマーの初期化
 
     while (1)
     {
-        /* Do Nothing */
-        // 割り込み処理でPWM制御を行うため、メインループでは何も処理を行わない
+        // 割り込み処理でPWM制御を行うため、メインループでは次の割り込みまで眠る
+        // (割り込みの処理は起きていた時間として Idle.stats に数える)
+        idle_sleep(&Idle);
+        // 割り込みで記録したトレースを統計に加える
+        update_trace();
     }
 }
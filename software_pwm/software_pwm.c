@@ -0,0 +1,328 @@
+#include "software_pwm.h" // 複数チャンネルの PWM
+
+// round(65535 × (i / 255) ^ 2.8) (host/bcm_sim で pow() の値と照合している)
+const unsigned short software_pwm_gamma16[256] = {
+        0,     0,     0,     0,     1,     1,     2,     3,     4,     6,     8,    10,    13,    16,    19,    24,
+       28,    33,    39,    46,    53,    60,    69,    78,    88,    98,   110,   122,   135,   149,   164,   179,
+      196,   214,   232,   252,   273,   295,   317,   341,   366,   393,   420,   449,   478,   510,   542,   575,
+      610,   647,   684,   723,   764,   806,   849,   894,   940,   988,  1037,  1088,  1140,  1194,  1250,  1307,
+     1366,  1427,  1489,  1553,  1619,  1686,  1756,  1827,  1900,  1975,  2051,  2130,  2210,  2293,  2377,  2463,
+     2552,  2642,  2734,  2829,  2925,  3024,  3124,  3227,  3332,  3439,  3548,  3660,  3774,  3890,  4008,  4128,
+     4251,  4376,  4504,  4634,  4766,  4901,  5038,  5177,  5319,  5464,  5611,  5760,  5912,  6067,  6224,  6384,
+     6546,  6711,  6879,  7049,  7222,  7397,  7576,  7757,  7941,  8128,  8317,  8509,  8704,  8902,  9103,  9307,
+     9514,  9723,  9936, 10151, 10370, 10591, 10816, 11043, 11274, 11507, 11744, 11984, 12227, 12473, 12722, 12975,
+    13230, 13489, 13751, 14017, 14285, 14557, 14833, 15111, 15393, 15678, 15967, 16259, 16554, 16853, 17155, 17461,
+    17770, 18083, 18399, 18719, 19042, 19369, 19700, 20034, 20372, 20713, 21058, 21407, 21759, 22115, 22475, 22838,
+    23206, 23577, 23952, 24330, 24713, 25099, 25489, 25884, 26282, 26683, 27089, 27499, 27913, 28330, 28752, 29178,
+    29608, 30041, 30479, 30921, 31367, 31818, 32272, 32730, 33193, 33660, 34131, 34606, 35085, 35569, 36057, 36549,
+    37046, 37547, 38052, 38561, 39075, 39593, 40116, 40643, 41175, 41711, 42251, 42796, 43346, 43899, 44458, 45021,
+    45588, 46161, 46737, 47319, 47905, 48495, 49091, 49691, 50295, 50905, 51519, 52138, 52761, 53390, 54023, 54661,
+    55303, 55951, 56604, 57261, 57923, 58590, 59262, 59939, 60621, 61308, 62000, 62697, 63399, 64106, 64818, 65535,
+};
+
+// BCM モード: スロット k (周期の開始から unit_us × (2^k - 1) [us]) ごとに、ビット k が 1 のピンを HIGH、0 のピンを LOW にする
+// 前のスロットと出力が同じスロットはエッジを出さない (割り込みを減らす)
+static void build_bcm_edges(software_pwm *sp)
+{
+    software_pwm_edge *edges = sp->edges;
+    unsigned long all = 0; // 割り込みで出力するピン
+    int count = 0;
+
+    for (int ch = 0; ch < sp->count; ch++)
+    {
+        all |= sp->channels[ch].hardware ? 0 : 1ul << sp->channels[ch].pin;
+    }
+    for (int k = 0; k < sp->bcm_bits; k++)
+    {
+        unsigned long set = 0;
+        for (int ch = 0; ch < sp->count; ch++)
+        {
+            const software_pwm_channel *c = &sp->channels[ch];
+            unsigned duty = c->duty_period < sp->max_duty ? c->duty_period : sp->max_duty;
+            if (!c->hardware && (duty >> k & 1))
+            {
+                set |= 1ul << c->pin;
+            }
+        }
+        if (count > 0 && edges[count - 1].set == set)
+        {
+            continue; // 出力が変わらない
+        }
+        edges[count++] = (software_pwm_edge){((1ul << k) - 1) * sp->bcm_unit_us, set, all & ~set};
+    }
+    sp->edge_count = count;
+}
+
+// 割り込みで出力するチャンネルの HIGH の期間から、1 周期分のエッジの表を作る
+static void build_edges(software_pwm *sp)
+{
+    if (sp->mode == SOFTWARE_PWM_MODE_BCM)
+    {
+        build_bcm_edges(sp);
+        return;
+    }
+
+    software_pwm_edge *edges = sp->edges;
+    int count = 1;
+
+    // 先頭は周期の開始: HIGH の期間が 0 より長いピンを HIGH に、0 のピンを LOW にする
+    edges[0] = (software_pwm_edge){0, 0, 0};
+    for (int ch = 0; ch < sp->count; ch++)
+    {
+        const software_pwm_channel *c = &sp->channels[ch];
+        if (c->hardware)
+        {
+            continue;
+        }
+        unsigned long mask = 1ul << c->pin;
+        if (c->duty_period == 0)
+        {
+            edges[0].clr |= mask;
+            continue;
+        }
+        edges[0].set |= mask;
+        if (c->duty_period >= sp->cycle_period)
+        {
+            continue; // 常に HIGH
+        }
+
+        // HIGH の期間の終わりのエッジ。同じ時刻のエッジがあればまとめ、なければ時刻順の位置に挿入する
+        unsigned long offset = (unsigned long)c->duty_period * SOFTWARE_PWM_TICK_US;
+        int i = count;
+        while (i > 1 && edges[i - 1].offset_us > offset)
+        {
+            i--;
+        }
+        if (i > 1 && edges[i - 1].offset_us == offset)
+        {
+            edges[i - 1].clr |= mask;
+            continue;
+        }
+        for (int j = count; j > i; j--)
+        {
+            edges[j] = edges[j - 1];
+        }
+        edges[i] = (software_pwm_edge){offset, 0, mask};
+        count++;
+    }
+    sp->edge_count = count;
+}
+
+// duty_period を PWM スライスの HIGH の期間 [us] にする
+static unsigned long duty_us(const software_pwm *sp, unsigned short duty_period)
+{
+    unsigned long duty = duty_period < sp->max_duty ? duty_period : sp->max_duty;
+    return duty * (sp->mode == SOFTWARE_PWM_MODE_BCM ? sp->bcm_unit_us : SOFTWARE_PWM_TICK_US);
+}
+
+// mode・周期を設定した sp のチャンネルを初期化する
+static void init_channels(software_pwm *sp, const software_pwm_hw *hw, const unsigned char *pins, int count)
+{
+    unsigned long used = 0; // 使っている PWM スライスのチャンネル
+    unsigned long top = sp->period_us - 1;
+
+    sp->hw = hw;
+    sp->count = count < SOFTWARE_PWM_MAX_CHANNELS ? count : SOFTWARE_PWM_MAX_CHANNELS;
+    for (int ch = 0; ch < sp->count; ch++)
+    {
+        software_pwm_channel *c = &sp->channels[ch];
+        int pwm = hw->pwm_channel(hw->ctx, pins[ch]);
+        c->pin = pins[ch];
+        c->duty_period = 0;
+        c->fade_left = 0;
+        c->fade_target = 0;
+        c->fade_pos = 0;
+        c->hardware = pwm >= 0 && !(used >> pwm & 1);
+        if (c->hardware)
+        {
+            used |= 1ul << pwm;
+            hw->pwm_setup(hw->ctx, c->pin, top);
+            hw->pwm_level(hw->ctx, c->pin, 0);
+        }
+        else
+        {
+            hw->gpio_setup(hw->ctx, c->pin);
+        }
+    }
+    build_edges(sp);
+    sp->next = 0;
+    sp->dirty = 0;
+    sp->period_start_us = 0;
+    sp->stats = (software_pwm_stats){0};
+}
+
+void software_pwm_init(software_pwm *sp, const software_pwm_hw *hw, unsigned char cycle_period,
+                       const unsigned char *pins, int count)
+{
+    sp->mode = SOFTWARE_PWM_MODE_PWM;
+    sp->cycle_period = cycle_period;
+    sp->bcm_bits = 0;
+    sp->bcm_unit_us = 0;
+    sp->max_duty = cycle_period;
+    sp->period_us = (unsigned long)cycle_period * SOFTWARE_PWM_TICK_US;
+    init_channels(sp, hw, pins, count);
+}
+
+void software_pwm_init_bcm(software_pwm *sp, const software_pwm_hw *hw, unsigned char bits, unsigned char unit_us,
+                           const unsigned char *pins, int count)
+{
+    bits = bits < 1 ? 1 : bits > SOFTWARE_PWM_BCM_MAX_BITS ? SOFTWARE_PWM_BCM_MAX_BITS : bits;
+    unit_us = unit_us < 1 ? 1 : unit_us;
+    sp->mode = SOFTWARE_PWM_MODE_BCM;
+    sp->cycle_period = 0;
+    sp->bcm_bits = bits;
+    sp->bcm_unit_us = unit_us;
+    sp->max_duty = (unsigned short)((1ul << bits) - 1);
+    sp->period_us = (unsigned long)sp->max_duty * unit_us;
+    init_channels(sp, hw, pins, count);
+}
+
+void software_pwm_start(software_pwm *sp)
+{
+    const software_pwm_hw *hw = sp->hw;
+    unsigned long slices = 0;
+    for (int ch = 0; ch < sp->count; ch++)
+    {
+        if (sp->channels[ch].hardware)
+        {
+            slices |= 1ul << (hw->pwm_channel(hw->ctx, sp->channels[ch].pin) >> 1);
+        }
+    }
+    hw->pwm_enable(hw->ctx, slices);
+
+    // 最初の周期は少し先から始める (割り込みを設定する前に時刻を過ぎないように)
+    sp->next = 0;
+    sp->period_start_us = hw->now_us(hw->ctx) + SOFTWARE_PWM_TICK_US;
+    hw->set_alarm(hw->ctx, sp->period_start_us);
+}
+
+void software_pwm_set_duty(software_pwm *sp, int ch, unsigned short duty_period)
+{
+    if (ch < 0 || ch >= sp->count)
+    {
+        return;
+    }
+    software_pwm_channel *c = &sp->channels[ch];
+    c->duty_period = duty_period;
+    if (c->hardware)
+    {
+        sp->hw->pwm_level(sp->hw->ctx, c->pin, duty_us(sp, duty_period));
+    }
+    else
+    {
+        sp->dirty = 1; // 今の周期の最後のエッジを出力した後に表を作り直す
+    }
+}
+
+// 目で見た明るさ (0〜255 の 16 ビット固定小数点) を、ガンマ補正の表を線形補間して duty_period にする
+static unsigned short fade_duty(const software_pwm *sp, unsigned long pos)
+{
+    unsigned i = pos >> 16;
+    unsigned long g = software_pwm_gamma16[i];
+    if (i < 255)
+    {
+        g += ((software_pwm_gamma16[i + 1] - g) * (pos >> 8 & 0xff)) >> 8;
+    }
+    return (unsigned short)((g * sp->max_duty + 32767) / 65535);
+}
+
+void software_pwm_fade(software_pwm *sp, int ch, unsigned char level, unsigned short periods)
+{
+    if (ch < 0 || ch >= sp->count)
+    {
+        return;
+    }
+    software_pwm_channel *c = &sp->channels[ch];
+    c->fade_target = level;
+    c->fade_left = periods;
+    if (periods == 0)
+    {
+        c->fade_pos = (unsigned long)level << 16;
+        software_pwm_set_duty(sp, ch, fade_duty(sp, c->fade_pos));
+    }
+}
+
+int software_pwm_fading(const software_pwm *sp, int ch)
+{
+    return ch >= 0 && ch < sp->count && sp->channels[ch].fade_left != 0;
+}
+
+// フェード中のチャンネルを 1 周期分進める (残りの周期で目標まで等分する。最後の周期で目標に一致する)
+static void advance_fades(software_pwm *sp)
+{
+    for (int ch = 0; ch < sp->count; ch++)
+    {
+        software_pwm_channel *c = &sp->channels[ch];
+        if (c->fade_left == 0)
+        {
+            continue;
+        }
+        long target = (long)c->fade_target << 16;
+        c->fade_pos += (target - (long)c->fade_pos) / c->fade_left--;
+        unsigned short duty = fade_duty(sp, c->fade_pos);
+        if (duty != c->duty_period)
+        {
+            software_pwm_set_duty(sp, ch, duty);
+        }
+    }
+}
+
+int software_pwm_update(software_pwm *sp)
+{
+    const software_pwm_hw *hw = sp->hw;
+    int ret = 0;
+    int handled = 0;
+    unsigned long long due = sp->period_start_us + sp->edges[sp->next].offset_us;
+    unsigned long long now = hw->now_us(hw->ctx);
+
+    sp->stats.interrupts++;
+    do
+    {
+        // 時刻になったエッジをすべて出力する
+        while (due <= now)
+        {
+            const software_pwm_edge *e = &sp->edges[sp->next];
+            hw->gpio_write(hw->ctx, e->set, e->clr);
+            if (now - due > sp->stats.max_latency_us)
+            {
+                sp->stats.max_latency_us = (unsigned long)(now - due);
+            }
+            sp->stats.edges++;
+            sp->stats.late_edges += handled++ > 0;
+            if (sp->next == 0)
+            {
+                sp->stats.periods++;
+                ret = 1; // 周期の開始
+            }
+
+            if (++sp->next == sp->edge_count)
+            {
+                // 周期の最後のエッジ: 次の周期の開始までに HIGH の期間の変更を表に反映する
+                if (sp->dirty)
+                {
+                    sp->dirty = 0; // 作り直している間の変更は次の周期に反映する
+                    build_edges(sp);
+                }
+                sp->next = 0;
+                sp->period_start_us += sp->period_us;
+            }
+            due = sp->period_start_us + sp->edges[sp->next].offset_us;
+            now = hw->now_us(hw->ctx);
+        }
+
+        // 次のエッジの割り込みを設定する。設定している間に時刻を過ぎていたら続けて出力する
+        hw->set_alarm(hw->ctx, due);
+        now = hw->now_us(hw->ctx);
+    } while (due <= now);
+
+    if (ret)
+    {
+        advance_fades(sp); // 次のエッジの割り込みを設定した後に行う (エッジを遅らせない)
+    }
+    return ret;
+}
+
+const software_pwm_stats *software_pwm_get_stats(const software_pwm *sp)
+{
+    return &sp->stats;
+}
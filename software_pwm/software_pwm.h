@@ -0,0 +1,150 @@
+#ifndef SOFTWARE_PWM_H
+#define SOFTWARE_PWM_H
+
+// 複数チャンネルの PWM
+//
+// すべてのチャンネルは同じ周期 (cycle_period × SOFTWARE_PWM_TICK_US) で動き、チャンネルごとに HIGH の期間
+// (duty_period) を設定する。出力ピンが空いている PWM スライスのチャンネルにつながっていればハードウェアで出力し、
+// CPU は関わらない。スライスのチャンネルが他のピンと重なったものは、タイマー割り込みで出力する。
+//
+// 割り込みで出力するチャンネルは、1 周期分の出力の変化 (エッジ) を時刻順に並べた表を作っておく。
+// 周期の始めに HIGH にするピンをまとめて SIO_GPIO_OUT_SET に 1 回書き、HIGH の期間が同じピンは
+// 同じ時刻に SIO_GPIO_OUT_CLR に 1 回書いて LOW にする。割り込みは 1 周期に (異なる HIGH の期間の数 + 1) 回で、
+// 以前のように SOFTWARE_PWM_TICK_US ごとに割り込む必要はない。エッジの時刻は周期の開始時刻からの絶対時刻なので、
+// 割り込みの遅れは積み重ならない。
+//
+// BCM (Binary Code Modulation) モード (software_pwm_init_bcm()) では、HIGH の期間を bits ビットの値で表し、
+// 周期を長さ unit_us × 2^k のスロット (k = 0〜bits-1) に分けて、ビット k が 1 のピンをスロット k の間 HIGH にする。
+// 割り込みは 1 周期に最大 bits 回で、チャンネルの数にも値にもよらないので、少ない割り込みで 10〜12 ビットの明るさを出せる。
+// 例えば 12 ビット、unit_us = 1 なら周期は 4095us (244Hz)、割り込みは最大 2930 回/秒になる。
+// ただし unit_us は周期の始めの割り込み (フェードを進める処理を含む) の時間以上にする。短いと下位ビットのエッジが
+// 遅れて同じ割り込みにまとまり (stats.late_edges)、そのビットの分の明るさは出せない。
+// 通常の PWM で 12 ビットを出すには 1us ごとに割り込む (100万回/秒) か、チャンネルごとにエッジが要る。
+//
+// software_pwm_fade() は、チャンネルの明るさを目で見た明るさ (0〜255) で指定し、周期ごとに少しずつ変える。
+// 明るさはガンマ補正の表 (software_pwm_gamma16) を線形補間して HIGH の期間にするので、暗い側でも段差が目立たない。
+//
+// PWM スライスの設定・GPIO の出力・アラームは software_pwm_hw の関数で行う。host/pwm_sim と host/bcm_sim は
+// 出力の変化を仮想時刻つきで記録し、各ピンの HIGH の期間とエッジの遅れを数える。
+// 実機では software_pwm_pico.h の software_pwm_pico_hw() がレジスタを直接操作する実装を返す。
+
+#define SOFTWARE_PWM_TICK_US 100      // PWM モードの cycle_period と duty_period の単位 [us]
+#define SOFTWARE_PWM_MAX_CHANNELS 16  // チャンネルの最大数
+#define SOFTWARE_PWM_BCM_MAX_BITS 16  // BCM モードのビット数の最大値
+#define SOFTWARE_PWM_GAMMA 2.8        // software_pwm_gamma16 のガンマ値
+
+// 動作モード
+#define SOFTWARE_PWM_MODE_PWM 0 // HIGH の期間の終わりにエッジを出す通常の PWM
+#define SOFTWARE_PWM_MODE_BCM 1 // ビットごとの重み付きスロットで出力する BCM
+
+// ガンマ補正の表: round(65535 × (i / 255) ^ SOFTWARE_PWM_GAMMA)
+// software_pwm_fade() が、目で見た明るさを HIGH の期間 (最大値に対する割合) に変換するのに使う
+extern const unsigned short software_pwm_gamma16[256];
+
+// ハードウェアへのアクセス手段
+typedef struct
+{
+    // pin がつながる PWM スライスのチャンネル (スライス × 2 + A:0 / B:1) を返す。PWM で出力できないピンなら -1
+    int (*pwm_channel)(void *ctx, unsigned char pin);
+    // pin を PWM の出力にし、スライスのカウンタを 1us ごとに進めて周期を (top + 1) us にする (まだ動かさない)
+    void (*pwm_setup)(void *ctx, unsigned char pin, unsigned long top);
+    // pin の HIGH の期間を level [us] にする (周期の終わりに反映される)
+    void (*pwm_level)(void *ctx, unsigned char pin, unsigned long level);
+    // slices のビットが立っているスライスを同時に動かし始める
+    void (*pwm_enable)(void *ctx, unsigned long slices);
+    // pin を SIO の出力にして LOW にする
+    void (*gpio_setup)(void *ctx, unsigned char pin);
+    // set のビットのピンを HIGH に、clr のビットのピンを LOW にする (0 のほうは書き込まない)
+    void (*gpio_write)(void *ctx, unsigned long set, unsigned long clr);
+    // 現在時刻 [us]
+    unsigned long long (*now_us)(void *ctx);
+    // 指定した時刻に割り込みが起きるようにする (時刻を過ぎていたら起きないことがある)
+    void (*set_alarm)(void *ctx, unsigned long long time_us);
+    void *ctx; // 上記関数に渡すコンテキスト
+} software_pwm_hw;
+
+// チャンネル
+typedef struct
+{
+    unsigned char pin;          // 出力する GPIO の番号
+    unsigned short duty_period; // HIGHレベルの期間 (デューティー比。PWM: 単位 SOFTWARE_PWM_TICK_US、cycle_period 以上で常に HIGH、
+                                // BCM: 0〜2^bits-1 の値)
+    unsigned char hardware;     // 1: PWM スライスで出力、0: 割り込みで出力 (software_pwm_init() が決める)
+    unsigned short fade_left;   // フェードの残りの周期数 (0 ならフェードしていない)
+    unsigned char fade_target;  // フェードの目標の明るさ (0〜255)
+    unsigned long fade_pos;     // 今の明るさ (0〜255 を 16 ビット左シフトした固定小数点)
+} software_pwm_channel;
+
+// 割り込みで出力するチャンネルの 1 つのエッジ
+typedef struct
+{
+    unsigned long offset_us; // 周期の開始からの時刻 [us]
+    unsigned long set;       // HIGH にするピン
+    unsigned long clr;       // LOW にするピン
+} software_pwm_edge;
+
+// 統計
+typedef struct
+{
+    unsigned long interrupts;     // software_pwm_update() の呼び出し回数
+    unsigned long periods;        // 始まった周期の数
+    unsigned long edges;          // 出力したエッジの数
+    unsigned long late_edges;     // 前のエッジと同じ割り込みで出力したエッジの数 (割り込みが間に合わなかった)
+    unsigned long max_latency_us; // エッジの時刻から出力までの遅れの最大値 [us]
+} software_pwm_stats;
+
+// ソフトウェアPWM制御用の構造体
+typedef struct
+{
+    const software_pwm_hw *hw;                                   // ハードウェア
+    unsigned char mode;                                          // 動作モード (SOFTWARE_PWM_MODE_*)
+    unsigned char cycle_period;                                  // PWM周期 (単位: SOFTWARE_PWM_TICK_US。PWM モードのみ)
+    unsigned char bcm_bits;                                      // BCM のビット数 (BCM モードのみ)
+    unsigned char bcm_unit_us;                                   // BCM の最下位ビットのスロットの長さ [us] (BCM モードのみ)
+    unsigned short max_duty;                                     // 常に HIGH になる duty_period (PWM: cycle_period、BCM: 2^bits-1)
+    unsigned long period_us;                                     // 周期 [us]
+    software_pwm_channel channels[SOFTWARE_PWM_MAX_CHANNELS];    // チャンネル
+    int count;                                                   // チャンネルの数
+    software_pwm_edge edges[SOFTWARE_PWM_MAX_CHANNELS + 1];      // エッジの表 (時刻順。先頭は周期の開始。BCM はスロットごと)
+    int edge_count;                                              // エッジの表の要素数
+    int next;                                                    // 次に出力するエッジ
+    volatile int dirty;                                          // 割り込みで出力するチャンネルの duty_period が変わった
+    unsigned long long period_start_us;                          // 今の周期の開始時刻 [us]
+    software_pwm_stats stats;                                    // 統計
+} software_pwm;
+
+// count 本の pins のチャンネルを、周期 cycle_period、HIGH の期間 0 で初期化する
+// ピンがつながる PWM スライスのチャンネルが空いていればハードウェアで、そうでなければ割り込みで出力する
+void software_pwm_init(software_pwm *sp, const software_pwm_hw *hw, unsigned char cycle_period,
+                       const unsigned char *pins, int count);
+
+// count 本の pins のチャンネルを BCM モードで初期化する。bits は 1〜SOFTWARE_PWM_BCM_MAX_BITS、
+// 周期は unit_us × (2^bits - 1) [us]。PWM スライスで出力するチャンネルは同じ周期の PWM で、HIGH の期間は
+// duty_period × unit_us [us] になる
+void software_pwm_init_bcm(software_pwm *sp, const software_pwm_hw *hw, unsigned char bits, unsigned char unit_us,
+                           const unsigned char *pins, int count);
+
+// PWM スライスを同時に動かし始め、最初の周期の割り込みを設定する
+void software_pwm_start(software_pwm *sp);
+
+// チャンネル ch の HIGH の期間を変える
+// PWM スライスのチャンネルはその周期の終わりに反映される。割り込みのチャンネルは今の周期の最後のエッジを出力した後に
+// エッジの表を作り直し、次の周期から反映する (最後のエッジの後に変えた場合はその次の周期から)
+void software_pwm_set_duty(software_pwm *sp, int ch, unsigned short duty_period);
+
+// チャンネル ch の明るさを、periods 周期かけて目で見た明るさ level (0〜255) まで変える (0 周期ならすぐに変える)
+// フェードは前のフェードの明るさ (最初は 0) から始まり、software_pwm_update() が周期の始めに進める。
+// 割り込みと同時に呼ばないこと (タイマー割り込みの中で呼ぶ)
+void software_pwm_fade(software_pwm *sp, int ch, unsigned char level, unsigned short periods);
+
+// チャンネル ch がフェード中なら 1 を返す
+int software_pwm_fading(const software_pwm *sp, int ch);
+
+// タイマー割り込みから呼ぶ。時刻になったエッジを出力し、次のエッジの割り込みを設定する
+// 新しい周期が始まったら、フェードを 1 周期分進めて 1 を返す (以前の software_pwm_update() と同じく、周期ごとの処理に使う)
+int software_pwm_update(software_pwm *sp);
+
+// 統計を返す
+const software_pwm_stats *software_pwm_get_stats(const software_pwm *sp);
+
+#endif // SOFTWARE_PWM_H
@@ -0,0 +1,101 @@
+#include "reg.h"               // レジスタ定義
+#include "software_pwm_pico.h" // 実機向けの software_pwm_hw
+#include "timebase.h"          // 時刻の読み出し
+
+#define PWM_SLICE(pin) (((pin) >> 1) & 7) // GPIO がつながる PWM スライス
+#define GPIO_FUNC_PWM 4                   // IO_BANK0 の機能選択: PWM
+#define GPIO_FUNC_SIO 5                   // IO_BANK0 の機能選択: SIO (GPIO)
+#define NUM_GPIOS 30                      // RP2350A の GPIO の数
+
+static int pico_pwm_channel(void *ctx, unsigned char pin)
+{
+    (void)ctx;
+    return pin < NUM_GPIOS ? PWM_SLICE(pin) << 1 | (pin & 1) : -1;
+}
+
+static void pico_pwm_setup(void *ctx, unsigned char pin, unsigned long top)
+{
+    (void)ctx;
+    unsigned slice = PWM_SLICE(pin);
+    PWM_CH_CSR_RW(slice) = 0;                                        // 止めておく (software_pwm_start() でまとめて動かす)
+    PWM_CH_DIV_RW(slice) = (SOFTWARE_PWM_CLK_SYS_HZ / 1000000) << 4; // 1us ごとにカウント (整数部のみ)
+    PWM_CH_CTR_RW(slice) = 0;
+    PWM_CH_TOP_RW(slice) = top;
+
+    IO_BANK0_GPIO_CTRL_RW(pin) = GPIO_FUNC_PWM; // PWM の出力にする
+    PADS_BANK0_GPIO_CLR(pin) = 1 << 8;          // パッドの ISO を解除する
+}
+
+static void pico_pwm_level(void *ctx, unsigned char pin, unsigned long level)
+{
+    (void)ctx;
+    unsigned slice = PWM_SLICE(pin);
+    unsigned long cc = PWM_CH_CC_RW(slice);
+    if (pin & 1)
+    {
+        cc = (cc & 0x0000ffff) | level << 16; // チャンネルB
+    }
+    else
+    {
+        cc = (cc & 0xffff0000) | level; // チャンネルA
+    }
+    PWM_CH_CC_RW(slice) = cc;
+}
+
+static void pico_pwm_enable(void *ctx, unsigned long slices)
+{
+    (void)ctx;
+    PWM_EN_SET = slices; // 1 回の書き込みで同時に動き出す (位相がそろう)
+}
+
+static void pico_gpio_setup(void *ctx, unsigned char pin)
+{
+    (void)ctx;
+    SIO_GPIO_OE_CLR = 1ul << pin;  // 出力を止めておく
+    SIO_GPIO_OUT_CLR = 1ul << pin; // LOW にする
+    IO_BANK0_GPIO_CTRL_RW(pin) = GPIO_FUNC_SIO;
+    PADS_BANK0_GPIO_CLR(pin) = 1 << 8;
+    SIO_GPIO_OE_SET = 1ul << pin; // 出力を有効にする
+}
+
+static void pico_gpio_write(void *ctx, unsigned long set, unsigned long clr)
+{
+    (void)ctx;
+    if (set)
+    {
+        SIO_GPIO_OUT_SET = set;
+    }
+    if (clr)
+    {
+        SIO_GPIO_OUT_CLR = clr;
+    }
+}
+
+static unsigned long long pico_now_us(void *ctx)
+{
+    (void)ctx;
+    return timebase_now_us();
+}
+
+static void pico_set_alarm(void *ctx, unsigned long long time_us)
+{
+    (void)ctx;
+    TIMER0_ALARM_RW(0) = (unsigned long)time_us; // 下位 32 ビットが一致したときに割り込む
+}
+
+static const software_pwm_hw pico_hw = {
+    .pwm_channel = pico_pwm_channel,
+    .pwm_setup = pico_pwm_setup,
+    .pwm_level = pico_pwm_level,
+    .pwm_enable = pico_pwm_enable,
+    .gpio_setup = pico_gpio_setup,
+    .gpio_write = pico_gpio_write,
+    .now_us = pico_now_us,
+    .set_alarm = pico_set_alarm,
+    .ctx = 0,
+};
+
+const software_pwm_hw *software_pwm_pico_hw(void)
+{
+    return &pico_hw;
+}
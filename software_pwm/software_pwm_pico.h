@@ -0,0 +1,16 @@
+#ifndef SOFTWARE_PWM_PICO_H
+#define SOFTWARE_PWM_PICO_H
+
+#include "software_pwm.h" // 複数チャンネルの PWM
+
+// 複数チャンネルの PWM の実機 (RP2350) 向けの software_pwm_hw
+//
+// reg.h のレジスタを直接操作する。PWM スライスはシステムクロック (SOFTWARE_PWM_CLK_SYS_HZ) を分周して
+// カウンタを 1us ごとに進め、割り込みはタイマー0のアラーム0 (割り込み番号 0) を使う。
+
+#define SOFTWARE_PWM_CLK_SYS_HZ 150000000 // システムクロック [Hz] (Pico SDK の既定値)
+
+// software_pwm_hw を返す
+const software_pwm_hw *software_pwm_pico_hw(void);
+
+#endif // SOFTWARE_PWM_PICO_H
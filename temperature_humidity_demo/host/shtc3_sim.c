@@ -0,0 +1,112 @@
+#include <stdio.h>      // 標準入出力ライブラリ
+#include "shtc3.h"      // SHTC3 ドライバ (ノンブロッキング)
+#include "shtc3_mock.h" // 模擬 SHTC3
+
+// 模擬 I2C バス上で SHTC3 ドライバを動かし、センサーが起きている時間と CRC エラー処理を確認するシミュレーション
+
+#define SIM_BAUDRATE (100 * 1000) // I2C クロック (main.c と同じ 100kHz)
+#define SIM_INTERVAL_US (1000000) // 測定間隔 (main.c と同じ 1 秒)
+#define SIM_SAMPLES (1000)        // シミュレーションする測定回数
+#define SIM_LOOP_US (20)          // メインループ 1 周で他の処理に使う時間 [us]
+#define SIM_CORRUPT_EVERY (50)    // この回数ごとにデータを壊す
+
+static mock_i2c_bus bus; // 模擬バス
+
+static int sim_write(void *ctx, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    return mock_i2c_write(ctx, addr, src, len, nostop);
+}
+
+static int sim_read(void *ctx, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    return mock_i2c_read(ctx, addr, dst, len, nostop);
+}
+
+static void sim_alarm(void *arg)
+{
+    shtc3_timer_expired((shtc3 *)arg);
+}
+
+static void sim_start_timer(void *ctx, uint32_t delay_us, shtc3 *dev)
+{
+    mock_i2c_add_alarm(ctx, delay_us, sim_alarm, dev);
+}
+
+static const shtc3_transport sim_transport = {
+    .write = sim_write,
+    .read = sim_read,
+    .start_timer = sim_start_timer,
+    .ctx = &bus,
+};
+
+// status が BUSY 以外になるまでメインループを回す
+static shtc3_status sim_wait(shtc3 *dev, float *temp, float *humidity)
+{
+    shtc3_status status;
+    while ((status = shtc3_poll(dev, temp, humidity)) == SHTC3_BUSY)
+    {
+        mock_i2c_advance(&bus, SIM_LOOP_US); // 他の処理をしている時間
+    }
+    return status;
+}
+
+// 1 つのモードで SIM_SAMPLES 回測定し、結果を表示する
+static void sim_run(shtc3_mode mode, const char *name)
+{
+    shtc3_mock mock;
+    shtc3 dev;
+    float temp = 0, humidity = 0;
+    uint32_t ok = 0, errors = 0;
+    uint64_t latency_max = 0;
+
+    mock_i2c_init(&bus, SIM_BAUDRATE);
+    shtc3_mock_init(&mock);
+    mock.corrupt_every = SIM_CORRUPT_EVERY;
+    mock_i2c_attach(&bus, &mock.device);
+    shtc3_init(&dev, &sim_transport, mode);
+
+    shtc3_start_check_id(&dev);
+    if (sim_wait(&dev, &temp, &humidity) != SHTC3_READY)
+    {
+        printf("%s: ID check failed\n", name);
+        return;
+    }
+
+    uint64_t start_us = bus.now_us;
+    uint64_t awake_start = shtc3_mock_awake_us(&mock, bus.now_us);
+    uint64_t busy_start = bus.bus_busy_us;
+    for (int i = 0; i < SIM_SAMPLES; i++)
+    {
+        uint64_t t0 = bus.now_us;
+        shtc3_start_measure(&dev);
+        if (sim_wait(&dev, &temp, &humidity) == SHTC3_READY)
+        {
+            ok++;
+        }
+        else
+        {
+            errors++;
+        }
+        uint64_t latency = bus.now_us - t0;
+        latency_max = latency > latency_max ? latency : latency_max;
+        mock_i2c_advance(&bus, SIM_INTERVAL_US - latency);
+    }
+    uint64_t elapsed = bus.now_us - start_us;
+    uint64_t awake = shtc3_mock_awake_us(&mock, bus.now_us) - awake_start;
+
+    printf("%s:\n", name);
+    printf("  samples %d, ok %u, errors %u (corrupted %u, detected by CRC %u), early reads %u\n",
+           SIM_SAMPLES, ok, errors, mock.corrupted, dev.crc_errors, mock.early_reads);
+    printf("  last value %.2f C, %.2f %%, latency max %.2f ms\n", temp, humidity, latency_max / 1000.0);
+    printf("  sensor awake %.1f us/sample (%.3f %% duty), bus busy %.3f %%\n",
+           (double)awake / SIM_SAMPLES, 100.0 * awake / elapsed,
+           100.0 * (bus.bus_busy_us - busy_start) / elapsed);
+}
+
+int main(void)
+{
+    sim_run(SHTC3_MODE_NORMAL, "normal mode");
+    sim_run(SHTC3_MODE_LOW_POWER, "low power mode");
+    printf("previous driver: sensor never put to sleep (100 %% duty), CPU blocked 15 ms/sample in sleep_ms\n");
+    return 0;
+}
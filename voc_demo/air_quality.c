@@ -0,0 +1,85 @@
+#include "air_quality.h" // 温湿度補償付き VOC Index の計測パイプライン
+
+void air_quality_init(air_quality *aq, sgp40 *voc_sensor, shtc3 *rht_sensor)
+{
+    aq->voc_sensor = voc_sensor;
+    aq->rht_sensor = rht_sensor;
+    aq->state = AIR_QUALITY_IDLE;
+    aq->temperature = AIR_QUALITY_DEFAULT_TEMPERATURE;
+    aq->humidity = AIR_QUALITY_DEFAULT_HUMIDITY;
+    aq->rht_valid = false;
+    aq->sraw = 0;
+    aq->voc_index = 0;
+    aq->rht_errors = 0;
+    VocAlgorithm_init(&aq->voc_params);
+}
+
+// 現在の温湿度で SGP40 の測定を開始する
+static air_quality_status air_quality_start_voc(air_quality *aq)
+{
+    if (!sgp40_start_measure(aq->voc_sensor, aq->temperature, aq->humidity))
+    {
+        aq->state = AIR_QUALITY_IDLE;
+        return AIR_QUALITY_ERROR;
+    }
+    aq->state = AIR_QUALITY_WAIT_VOC;
+    return AIR_QUALITY_BUSY;
+}
+
+bool air_quality_start(air_quality *aq)
+{
+    if (aq->state != AIR_QUALITY_IDLE)
+    {
+        return false; // 前の周期が終わっていない
+    }
+    if (shtc3_start_measure(aq->rht_sensor))
+    {
+        aq->state = AIR_QUALITY_WAIT_RHT;
+        return true;
+    }
+    // SHTC3 が使えない場合は前回 (または既定) の温湿度で SGP40 を測る
+    aq->rht_errors++;
+    aq->rht_valid = false;
+    return air_quality_start_voc(aq) == AIR_QUALITY_BUSY;
+}
+
+air_quality_status air_quality_poll(air_quality *aq)
+{
+    float temperature, humidity;
+
+    switch (aq->state)
+    {
+    case AIR_QUALITY_WAIT_RHT:
+        switch (shtc3_poll(aq->rht_sensor, &temperature, &humidity))
+        {
+        case SHTC3_READY:
+            aq->temperature = temperature;
+            aq->humidity = humidity;
+            aq->rht_valid = true;
+            return air_quality_start_voc(aq);
+        case SHTC3_ERROR:
+            aq->rht_errors++; // 前回の温湿度のまま続ける
+            aq->rht_valid = false;
+            return air_quality_start_voc(aq);
+        default:
+            return AIR_QUALITY_BUSY;
+        }
+
+    case AIR_QUALITY_WAIT_VOC:
+        switch (sgp40_poll(aq->voc_sensor, &aq->sraw))
+        {
+        case SGP40_READY:
+            VocAlgorithm_process(&aq->voc_params, aq->sraw, &aq->voc_index);
+            aq->state = AIR_QUALITY_IDLE;
+            return AIR_QUALITY_READY;
+        case SGP40_ERROR:
+            aq->state = AIR_QUALITY_IDLE;
+            return AIR_QUALITY_ERROR;
+        default:
+            return AIR_QUALITY_BUSY;
+        }
+
+    default:
+        return AIR_QUALITY_BUSY;
+    }
+}
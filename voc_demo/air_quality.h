@@ -0,0 +1,69 @@
+#ifndef AIR_QUALITY_H
+#define AIR_QUALITY_H
+
+#include <stdint.h>                  // 固定幅整数型
+#include <stdbool.h>                 // bool 型
+#include "sgp40.h"                   // SGP40 ドライバ (ノンブロッキング)
+#include "shtc3.h"                   // SHTC3 ドライバ (ノンブロッキング)
+#include "sensirion_voc_algorithm.h" // Sensirion VOC アルゴリズムライブラリ
+
+// 温湿度補償付き VOC Index の計測パイプライン
+//
+// 同じ I2C バス上の SHTC3 と SGP40 を 1 周期 (1 秒) ごとに次の順で動かす。
+//   1. SHTC3 の測定を開始 (ウェイクアップ → 測定 → スリープ、低消費電力モードで約 2.5ms)
+//   2. 温湿度が得られたら、その値で SGP40 の湿度補償付き測定を開始 (31ms)
+//   3. raw データが得られたら VOC アルゴリズムで VOC Index を計算
+// どちらの待ち時間もアラームで計るので、CPU はブロックされない。
+// SGP40 に渡す温湿度は常に同じ周期に測った値 (数 ms 前) になる。
+
+#define AIR_QUALITY_INTERVAL_MS 1000 // 計測周期 [ms] (VOC アルゴリズムのサンプリング間隔 1 秒)
+
+#define AIR_QUALITY_DEFAULT_TEMPERATURE 25.0f // SHTC3 が読めないときの温度 [℃]
+#define AIR_QUALITY_DEFAULT_HUMIDITY 50.0f    // SHTC3 が読めないときの湿度 [%]
+
+// パイプラインの状態
+typedef enum
+{
+    AIR_QUALITY_IDLE,     // 次の周期を待っている
+    AIR_QUALITY_WAIT_RHT, // SHTC3 の測定待ち
+    AIR_QUALITY_WAIT_VOC, // SGP40 の測定待ち
+} air_quality_state;
+
+// air_quality_poll() の戻り値
+typedef enum
+{
+    AIR_QUALITY_BUSY,  // 処理中 (または何もしていない)
+    AIR_QUALITY_READY, // 新しい VOC Index が得られた
+    AIR_QUALITY_ERROR, // SGP40 の通信エラー
+} air_quality_status;
+
+typedef struct
+{
+    sgp40 *voc_sensor;             // SGP40 ドライバ
+    shtc3 *rht_sensor;             // SHTC3 ドライバ
+    VocAlgorithmParams voc_params; // VOC アルゴリズムの状態
+    air_quality_state state;       // パイプラインの状態
+    float temperature;             // 補償に使った温度 [℃]
+    float humidity;                // 補償に使った湿度 [%]
+    bool rht_valid;                // temperature / humidity が SHTC3 の実測値なら true
+    uint16_t sraw;                 // SGP40 の raw データ
+    int32_t voc_index;             // VOC Index
+    uint32_t rht_errors;           // SHTC3 の読み取りエラー回数
+} air_quality;
+
+// パイプラインを初期化する (両センサーのドライバは初期化済みであること)
+void air_quality_init(air_quality *aq, sgp40 *voc_sensor, shtc3 *rht_sensor);
+
+// 1 周期分の計測を開始する。前の周期が終わっていない、または SGP40 に書き込めなければ false
+bool air_quality_start(air_quality *aq);
+
+// 状態を進める。VOC Index が得られたら AIR_QUALITY_READY を返す
+air_quality_status air_quality_poll(air_quality *aq);
+
+// 次の周期を開始できるなら true
+static inline bool air_quality_is_idle(const air_quality *aq)
+{
+    return aq->state == AIR_QUALITY_IDLE;
+}
+
+#endif // AIR_QUALITY_H
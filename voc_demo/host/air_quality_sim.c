@@ -0,0 +1,264 @@
+#include <stdio.h>       // 標準入出力ライブラリ
+#include <stdlib.h>      // strtoul, abs
+#include <string.h>      // strcmp
+#include <unistd.h>      // getopt
+#include "air_quality.h" // 温湿度補償付き VOC Index の計測パイプライン
+#include "sgp40_mock.h"  // 模擬 SGP40
+#include "shtc3_mock.h"  // 模擬 SHTC3
+
+// 模擬 I2C バス上に SHTC3 と SGP40 をつなぎ、main.c と同じ計測パイプラインを動かすシミュレーション
+//
+// 使い方: air_quality_sim [-f script.csv] [-n seconds] [-c corrupt_every]
+//   -f  1 行 1 秒ぶんのセンサー応答 "温度[℃],湿度[%],SRAW" を並べた CSV。
+//       '#' で始まる行は無視し、最後の行に達したらその値を使い続ける。
+//       省略時は組み込みのシナリオ (湿度が急に上がり、VOC が一時的に増える) を使う。
+//   -n  シミュレーションする秒数 (省略時はスクリプトの行数、組み込みシナリオは 600 秒)
+//   -c  SHTC3 の測定データをこの回数ごとに壊す (CRC エラーの扱いを確かめる)
+//
+// 標準出力に毎秒の "秒,温度,湿度,SRAW,VOC Index" を、標準エラーに統計を出力する。
+
+#define SIM_BAUDRATE (100 * 1000) // I2C クロック (main.c と同じ 100kHz)
+#define SIM_LOOP_US (50)          // メインループ 1 周で他の処理に使う時間 [us]
+#define SIM_DEFAULT_SECONDS (600) // 組み込みシナリオの長さ [s]
+#define SIM_MAX_LINES (100000)    // スクリプトの最大行数
+
+// 1 秒ぶんのセンサー応答
+typedef struct
+{
+    float temperature; // 温度 [℃]
+    float humidity;    // 湿度 [%]
+    uint16_t sraw;     // SGP40 の raw データ
+} sim_step;
+
+static mock_i2c_bus bus;   // 模擬バス
+static sim_step current;   // 現在の周期のセンサー応答
+
+static int sim_write(void *ctx, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    return mock_i2c_write(ctx, addr, src, len, nostop);
+}
+
+static int sim_read(void *ctx, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    return mock_i2c_read(ctx, addr, dst, len, nostop);
+}
+
+static void sim_sgp40_alarm(void *arg)
+{
+    sgp40_timer_expired((sgp40 *)arg);
+}
+
+static void sim_sgp40_start_timer(void *ctx, uint32_t delay_us, sgp40 *dev)
+{
+    mock_i2c_add_alarm(ctx, delay_us, sim_sgp40_alarm, dev);
+}
+
+static void sim_shtc3_alarm(void *arg)
+{
+    shtc3_timer_expired((shtc3 *)arg);
+}
+
+static void sim_shtc3_start_timer(void *ctx, uint32_t delay_us, shtc3 *dev)
+{
+    mock_i2c_add_alarm(ctx, delay_us, sim_shtc3_alarm, dev);
+}
+
+static const sgp40_transport sim_sgp40_transport = {
+    .write = sim_write,
+    .read = sim_read,
+    .start_timer = sim_sgp40_start_timer,
+    .ctx = &bus,
+};
+
+static const shtc3_transport sim_shtc3_transport = {
+    .write = sim_write,
+    .read = sim_read,
+    .start_timer = sim_shtc3_start_timer,
+    .ctx = &bus,
+};
+
+// 模擬 SGP40 が測定時に返す raw データ
+static uint16_t sim_sraw(void *ctx)
+{
+    (void)ctx;
+    return current.sraw;
+}
+
+// 組み込みシナリオ: 2 分後に湿度が 40% → 80% に上がり (シャワーなど)、5 分後に VOC が 1 分間増える
+static sim_step sim_builtin_step(uint32_t second)
+{
+    sim_step step = {24.0f, 40.0f, 30000};
+    if (second >= 120)
+    {
+        uint32_t t = second - 120;
+        step.humidity = t < 40 ? 40.0f + t : 80.0f;
+        step.temperature = t < 40 ? 24.0f + t * 0.05f : 26.0f;
+    }
+    if (second >= 300 && second < 360)
+    {
+        step.sraw = 27000; // VOC が増えると SRAW は下がる
+    }
+    step.sraw += second % 7; // 測定ノイズ
+    return step;
+}
+
+// スクリプトを読み込む。読み込んだ行数を返す (失敗時は -1)
+static long sim_load_script(const char *path, sim_step *steps, long max_steps)
+{
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    char line[256];
+    long n = 0;
+    while (n < max_steps && fgets(line, sizeof line, fp) != NULL)
+    {
+        unsigned sraw;
+        if (line[0] == '#' || sscanf(line, "%f,%f,%u", &steps[n].temperature, &steps[n].humidity, &sraw) != 3)
+        {
+            continue; // コメント行、ヘッダ行、空行
+        }
+        steps[n++].sraw = (uint16_t)sraw;
+    }
+    fclose(fp);
+    return n;
+}
+
+// 温湿度を SHTC3 の生データに変換する (shtc3.c の変換の逆)
+static void sim_set_shtc3(shtc3_mock *mock, const sim_step *step)
+{
+    mock->temp_raw = (uint16_t)((step->temperature + 45.0f) * 65535.0f / 175.0f + 0.5f);
+    mock->humidity_raw = (uint16_t)(step->humidity * 65535.0f / 100.0f + 0.5f);
+}
+
+int main(int argc, char **argv)
+{
+    const char *script_path = NULL;
+    long seconds = -1;
+    uint32_t corrupt_every = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:n:c:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+            script_path = optarg;
+            break;
+        case 'n':
+            seconds = strtol(optarg, NULL, 0);
+            break;
+        case 'c':
+            corrupt_every = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-f script.csv] [-n seconds] [-c corrupt_every]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    static sim_step script[SIM_MAX_LINES];
+    long script_len = 0;
+    if (script_path != NULL)
+    {
+        script_len = sim_load_script(script_path, script, SIM_MAX_LINES);
+        if (script_len <= 0)
+        {
+            fprintf(stderr, "%s: no sensor responses\n", script_path);
+            return 1;
+        }
+    }
+    if (seconds < 0)
+    {
+        seconds = script_path != NULL ? script_len : SIM_DEFAULT_SECONDS;
+    }
+
+    // 1 本のバスに両方のセンサーをつなぐ
+    sgp40_mock voc_mock;
+    shtc3_mock rht_mock;
+    mock_i2c_init(&bus, SIM_BAUDRATE);
+    sgp40_mock_init(&voc_mock);
+    voc_mock.sraw = sim_sraw;
+    shtc3_mock_init(&rht_mock);
+    rht_mock.corrupt_every = corrupt_every;
+    mock_i2c_attach(&bus, &voc_mock.device);
+    mock_i2c_attach(&bus, &rht_mock.device);
+
+    sgp40 voc_sensor;
+    shtc3 rht_sensor;
+    sgp40_init(&voc_sensor, &sim_sgp40_transport);
+    shtc3_init(&rht_sensor, &sim_shtc3_transport, SHTC3_MODE_LOW_POWER);
+
+    air_quality aq;
+    air_quality_init(&aq, &voc_sensor, &rht_sensor);
+
+    // 計測
+    uint64_t start_us = bus.now_us;
+    uint64_t start_busy = bus.bus_busy_us;
+    uint64_t latency_max = 0;
+    uint64_t latency_sum = 0;
+    uint32_t stale = 0;  // SGP40 に前の周期の温湿度が渡された回数
+    uint32_t errors = 0; // SGP40 の通信エラー
+    uint32_t mismatch = 0;
+    printf("second,temperature,humidity,sraw,voc_index\n");
+    for (long s = 0; s < seconds; s++)
+    {
+        if (script_path != NULL)
+        {
+            current = script[s < script_len ? s : script_len - 1];
+        }
+        else
+        {
+            current = sim_builtin_step((uint32_t)s);
+        }
+        sim_set_shtc3(&rht_mock, &current);
+
+        uint64_t t0 = bus.now_us;
+        air_quality_status status;
+        air_quality_start(&aq);
+        while ((status = air_quality_poll(&aq)) == AIR_QUALITY_BUSY)
+        {
+            mock_i2c_advance(&bus, SIM_LOOP_US); // 他の処理をしている時間
+        }
+        uint64_t latency = bus.now_us - t0;
+        latency_sum += latency;
+        latency_max = latency > latency_max ? latency : latency_max;
+
+        if (status != AIR_QUALITY_READY)
+        {
+            errors++;
+        }
+        else
+        {
+            // SGP40 が受け取った補償パラメータがこの周期の温湿度と一致するか確かめる
+            uint16_t expect_rh = (uint16_t)(rht_mock.humidity_raw * 100.0f / 65535.0f * 0xffff / 100);
+            uint16_t expect_t = (uint16_t)((rht_mock.temp_raw * 175.0f / 65535.0f) * 0xffff / 175);
+            if (!aq.rht_valid)
+            {
+                stale++;
+            }
+            else if (abs((int)voc_mock.last_humidity - expect_rh) > 1 ||
+                     abs((int)voc_mock.last_temperature - expect_t) > 1)
+            {
+                mismatch++;
+            }
+            printf("%ld,%.2f,%.2f,%u,%d\n", s, aq.temperature, aq.humidity, aq.sraw, (int)aq.voc_index);
+        }
+        mock_i2c_advance(&bus, AIR_QUALITY_INTERVAL_MS * 1000ULL - latency); // 次の周期まで
+    }
+    uint64_t elapsed = bus.now_us - start_us;
+    uint64_t busy = bus.bus_busy_us - start_busy;
+
+    fprintf(stderr, "cycles          : %ld (sgp40 errors %u, crc errors %u, early reads %u)\n",
+            seconds, errors, voc_mock.crc_errors, voc_mock.early_reads + rht_mock.early_reads);
+    fprintf(stderr, "compensation    : %ld fresh, %u stale (shtc3 errors %u, corrupted %u), %u mismatched\n",
+            seconds - errors - stale, stale, aq.rht_errors, rht_mock.corrupted, mismatch);
+    fprintf(stderr, "cycle latency   : avg %.2f ms, max %.2f ms\n",
+            seconds ? latency_sum / 1000.0 / seconds : 0.0, latency_max / 1000.0);
+    fprintf(stderr, "bus utilization : %.3f %% (%u transactions)\n",
+            elapsed ? 100.0 * busy / elapsed : 0.0, bus.transactions);
+    fprintf(stderr, "shtc3 awake     : %.3f %%\n",
+            elapsed ? 100.0 * shtc3_mock_awake_us(&rht_mock, bus.now_us) / elapsed : 0.0);
+    return errors != 0 || mismatch != 0 || stale != rht_mock.corrupted;
+}
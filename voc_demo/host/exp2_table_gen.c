@@ -0,0 +1,24 @@
+#include <stdio.h> // 標準入出力ライブラリ
+#include <math.h>  // exp2 / floor
+
+// fix16_exp_fast() の exp2_table (sensirion_voc_algorithm.c) を生成する
+//
+// exp2_table[i] = round(2^(i / 256) * 2^30)  (i = 0..256、Q30)
+//
+// 出力はソースの表と同じ並び (1 行 6 要素) なので、表の部分と diff を取れば一致を確かめられる。
+// 2^30 倍しても 2^31 以下なので、double (53 ビット) で丸め前の値を十分な精度で計算できる。
+
+#define TABLE_BITS (8)                    // 表を引く f の上位ビット数
+#define TABLE_SIZE ((1 << TABLE_BITS) + 1) // 補間のため最後の 2^1 も持つ
+#define PER_LINE (6)                       // 1 行の要素数
+
+int main(void)
+{
+    for (int i = 0; i < TABLE_SIZE; i++)
+    {
+        unsigned long value = (unsigned long)floor(ldexp(exp2((double)i / (1 << TABLE_BITS)), 30) + 0.5);
+        printf("%s0x%08lXu,%s", i % PER_LINE == 0 ? "    " : " ", value,
+               (i % PER_LINE == PER_LINE - 1 || i == TABLE_SIZE - 1) ? "\n" : "");
+    }
+    return 0;
+}
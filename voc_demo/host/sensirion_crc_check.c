@@ -0,0 +1,135 @@
+#include <stdio.h>          // 標準入出力ライブラリ
+#include "host_util.h"      // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "sensirion_word.h" // Sensirion I2C ワードプロトコル (CRC-8)
+
+// sensirion_word.c の CRC-8 表を全 65536 ワードについて確かめ、ビットごとの計算と速度を比べる
+
+#define BENCH_WORDS (4096) // ベンチマークで 1 回に処理するワード数 (SGP40 の応答 4096 回分)
+#define BENCH_REPEAT (2000) // ベンチマークの繰り返し回数
+
+static volatile uint32_t sink; // 計測ループが最適化で消えないようにする
+
+// 基準: ビットごとの CRC-8 (以前の shtc3_crc8 と同じ計算)
+static uint8_t crc8_bitwise(const uint8_t *data, size_t len)
+{
+    uint8_t crc = 0xFF;
+    while (len--)
+    {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// 以前の sgp40.c の crc_value (下位バイトが 0 のときにそのバイトを処理しない)
+static uint8_t crc8_old_sgp40(uint8_t msb, uint8_t lsb)
+{
+    uint8_t crc = 0xFF ^ msb;
+    for (int i = 0; i < 8; i++)
+    {
+        crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+    }
+    if (lsb != 0)
+    {
+        crc ^= lsb;
+        for (int i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// 全ワードについて表引きとビットごとの計算を比べ、1 ビット・2 ビットの誤りが検出されることを確かめる
+static int check_exhaustive(void)
+{
+    uint32_t mismatch = 0;
+    uint32_t old_mismatch = 0;
+    uint32_t missed_1bit = 0;
+    uint32_t missed_2bit = 0;
+
+    for (uint32_t w = 0; w <= 0xFFFF; w++)
+    {
+        uint8_t buf[SENSIRION_WORD_SIZE];
+        uint16_t word;
+        sensirion_put_word(buf, (uint16_t)w);
+
+        uint8_t reference = crc8_bitwise(buf, 2);
+        mismatch += buf[2] != reference;
+        mismatch += sensirion_crc8(buf, 2) != reference;
+        mismatch += sensirion_verify_words(buf, &word, 1) != 0 || word != w;
+        old_mismatch += crc8_old_sgp40(buf[0], buf[1]) != reference;
+
+        // データと CRC を合わせた 24 ビットのうち 1 ビットまたは 2 ビットを反転させる
+        for (int i = 0; i < 24; i++)
+        {
+            buf[i / 8] ^= 0x80 >> (i % 8);
+            missed_1bit += sensirion_verify_words(buf, &word, 1) == 0;
+            for (int j = i + 1; j < 24; j++)
+            {
+                buf[j / 8] ^= 0x80 >> (j % 8);
+                missed_2bit += sensirion_verify_words(buf, &word, 1) == 0;
+                buf[j / 8] ^= 0x80 >> (j % 8);
+            }
+            buf[i / 8] ^= 0x80 >> (i % 8);
+        }
+    }
+
+    printf("table vs bitwise   : %u mismatches over 65536 words\n", mismatch);
+    printf("old sgp40 crc_value: %u wrong CRCs (words with LSB == 0)\n", old_mismatch);
+    printf("undetected errors  : %u single-bit, %u double-bit\n", missed_1bit, missed_2bit);
+    return mismatch != 0 || missed_1bit != 0 || missed_2bit != 0;
+}
+
+// 1 ワードあたりの処理時間 [ns] を測る
+static void bench(void)
+{
+    static uint16_t words[BENCH_WORDS];
+    static uint8_t buf[BENCH_WORDS * SENSIRION_WORD_SIZE];
+    for (int i = 0; i < BENCH_WORDS; i++)
+    {
+        words[i] = (uint16_t)(i * 40503u); // 適当にばらつかせる
+    }
+    sensirion_put_words(buf, words, BENCH_WORDS);
+
+    double start = now_sec();
+    for (int rep = 0; rep < BENCH_REPEAT; rep++)
+    {
+        uint32_t errors = 0;
+        for (int i = 0; i < BENCH_WORDS; i++)
+        {
+            errors += crc8_bitwise(buf + i * SENSIRION_WORD_SIZE, 2) != buf[i * SENSIRION_WORD_SIZE + 2];
+        }
+        sink = errors;
+    }
+    double bitwise = (now_sec() - start) * 1e9 / ((double)BENCH_WORDS * BENCH_REPEAT);
+
+    start = now_sec();
+    for (int rep = 0; rep < BENCH_REPEAT; rep++)
+    {
+        sink = sensirion_verify_words(buf, words, BENCH_WORDS);
+    }
+    double table = (now_sec() - start) * 1e9 / ((double)BENCH_WORDS * BENCH_REPEAT);
+
+    start = now_sec();
+    for (int rep = 0; rep < BENCH_REPEAT; rep++)
+    {
+        sensirion_put_words(buf, words, BENCH_WORDS);
+        sink = buf[rep % sizeof buf];
+    }
+    double put = (now_sec() - start) * 1e9 / ((double)BENCH_WORDS * BENCH_REPEAT);
+
+    printf("verify bitwise     : %6.2f ns/word\n", bitwise);
+    printf("verify table       : %6.2f ns/word (%.1fx)\n", table, bitwise / table);
+    printf("put_words table    : %6.2f ns/word\n", put);
+}
+
+int main(void)
+{
+    int failed = check_exhaustive();
+    bench();
+    return failed;
+}
@@ -0,0 +1,77 @@
+#include "sgp40_mock.h" // 模擬 SGP40
+
+// Sensirion の CRC-8 (多項式 0x31、初期値 0xFF)
+static uint8_t sgp40_mock_crc(uint8_t msb, uint8_t lsb)
+{
+    uint8_t data[2] = {msb, lsb};
+    uint8_t crc = 0xFF;
+    for (int i = 0; i < 2; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static int sgp40_mock_write(mock_i2c_device *dev, const uint8_t *src, size_t len, uint64_t now_us)
+{
+    sgp40_mock *mock = (sgp40_mock *)dev;
+    uint16_t command = (len >= 2) ? (src[0] << 8) | src[1] : 0;
+
+    if (command == 0x202F && len == 2)
+    {
+        mock->response = 0x3220; // Feature Set
+        mock->ready_us = now_us + 1000;
+    }
+    else if (command == 0x280E && len == 2)
+    {
+        mock->response = 0xD400; // Measure Test 成功
+        mock->ready_us = now_us + SGP40_MOCK_SELF_TEST_US;
+    }
+    else if (command == 0x260F && len == 8)
+    {
+        if (sgp40_mock_crc(src[2], src[3]) != src[4] || sgp40_mock_crc(src[5], src[6]) != src[7])
+        {
+            mock->crc_errors++;
+            return MOCK_I2C_NACK;
+        }
+        mock->last_humidity = (src[2] << 8) | src[3];
+        mock->last_temperature = (src[5] << 8) | src[6];
+        mock->response = mock->sraw ? mock->sraw(mock->sraw_ctx) : 30000;
+        mock->ready_us = now_us + SGP40_MOCK_MEASURE_US;
+        mock->measurements++;
+    }
+    else
+    {
+        return MOCK_I2C_NACK; // 未対応のコマンド
+    }
+    mock->pending = true;
+    return (int)len;
+}
+
+static int sgp40_mock_read(mock_i2c_device *dev, uint8_t *dst, size_t len, uint64_t now_us)
+{
+    sgp40_mock *mock = (sgp40_mock *)dev;
+
+    if (!mock->pending || now_us < mock->ready_us || len != 3)
+    {
+        mock->early_reads += mock->pending && now_us < mock->ready_us;
+        return MOCK_I2C_NACK; // 変換中は応答しない
+    }
+    dst[0] = mock->response >> 8;
+    dst[1] = mock->response & 0xFF;
+    dst[2] = sgp40_mock_crc(dst[0], dst[1]);
+    mock->pending = false;
+    return 3;
+}
+
+void sgp40_mock_init(sgp40_mock *mock)
+{
+    *mock = (sgp40_mock){0};
+    mock->device.addr = 0x59;
+    mock->device.write = sgp40_mock_write;
+    mock->device.read = sgp40_mock_read;
+}
@@ -0,0 +1,32 @@
+#ifndef SGP40_MOCK_H
+#define SGP40_MOCK_H
+
+#include "mock_i2c.h" // 模擬 I2C バス
+
+// 模擬 SGP40
+//
+// コマンドを受け取ると変換時間だけ経過するまで読み出しに NACK を返す。
+// 湿度補償パラメータの CRC が誤っている場合もコマンドを NACK する。
+
+#define SGP40_MOCK_MEASURE_US (30 * 1000)    // raw データ測定の変換時間 (データシート最大値) [us]
+#define SGP40_MOCK_SELF_TEST_US (250 * 1000) // Measure Test の所要時間 [us]
+
+typedef struct
+{
+    mock_i2c_device device;       // バスに接続するデバイス (先頭に置く)
+    uint16_t response;            // 次に返す応答
+    uint64_t ready_us;            // 応答が読める時刻
+    bool pending;                 // 未読の応答があれば true
+    uint16_t (*sraw)(void *ctx);  // 測定時に返す raw データ (NULL なら固定値)
+    void *sraw_ctx;               // sraw の引数
+    uint16_t last_humidity;       // 最後に受け取った湿度パラメータ
+    uint16_t last_temperature;    // 最後に受け取った温度パラメータ
+    uint32_t measurements;        // 受け付けた測定コマンド数
+    uint32_t crc_errors;          // CRC が誤っていたコマンド数
+    uint32_t early_reads;         // 変換完了前に読まれた回数
+} sgp40_mock;
+
+// 模擬 SGP40 を初期化する
+void sgp40_mock_init(sgp40_mock *mock);
+
+#endif // SGP40_MOCK_H
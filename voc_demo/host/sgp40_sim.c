@@ -0,0 +1,117 @@
+#include <stdio.h>      // 標準入出力ライブラリ
+#include "sgp40.h"      // SGP40 ドライバ (ノンブロッキング)
+#include "sgp40_mock.h" // 模擬 SGP40
+
+// 模擬 I2C バス上で SGP40 ドライバの状態遷移を動かし、タイミングを測るシミュレーション
+
+#define SIM_BAUDRATE (100 * 1000)   // I2C クロック (main.c と同じ 100kHz)
+#define SIM_INTERVAL_US (100000)    // 測定間隔 (main.c と同じ 100ms)
+#define SIM_MEASUREMENTS (1000)     // シミュレーションする測定回数
+#define SIM_LOOP_US (50)            // メインループ 1 周で他の処理に使う時間 [us]
+
+static mock_i2c_bus bus; // 模擬バス
+
+static int sim_write(void *ctx, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    return mock_i2c_write(ctx, addr, src, len, nostop);
+}
+
+static int sim_read(void *ctx, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    return mock_i2c_read(ctx, addr, dst, len, nostop);
+}
+
+static void sim_alarm(void *arg)
+{
+    sgp40_timer_expired((sgp40 *)arg);
+}
+
+static void sim_start_timer(void *ctx, uint32_t delay_us, sgp40 *dev)
+{
+    mock_i2c_add_alarm(ctx, delay_us, sim_alarm, dev);
+}
+
+static const sgp40_transport sim_transport = {
+    .write = sim_write,
+    .read = sim_read,
+    .start_timer = sim_start_timer,
+    .ctx = &bus,
+};
+
+// 測定ごとに少しずつ変化する raw データ
+static uint16_t sim_sraw(void *ctx)
+{
+    uint32_t *n = ctx;
+    return 30000 + (*n)++ % 500;
+}
+
+// status が BUSY 以外になるまでメインループを回す。ループ回数を返す
+static uint32_t sim_wait(sgp40 *dev, uint16_t *sraw, sgp40_status *status)
+{
+    uint32_t loops = 0;
+    while ((*status = sgp40_poll(dev, sraw)) == SGP40_BUSY)
+    {
+        mock_i2c_advance(&bus, SIM_LOOP_US); // 他の処理をしている時間
+        loops++;
+    }
+    return loops;
+}
+
+int main(void)
+{
+    sgp40_mock mock;
+    sgp40 dev;
+    uint16_t sraw;
+    sgp40_status status;
+    uint32_t counter = 0;
+
+    // センサーが接続されていない場合はエラーになること
+    mock_i2c_init(&bus, SIM_BAUDRATE);
+    sgp40_init(&dev, &sim_transport);
+    printf("no device       : start_self_test %s\n", sgp40_start_self_test(&dev) ? "ok" : "failed (expected)");
+
+    // セルフテスト
+    mock_i2c_init(&bus, SIM_BAUDRATE);
+    sgp40_mock_init(&mock);
+    mock.sraw = sim_sraw;
+    mock.sraw_ctx = &counter;
+    mock_i2c_attach(&bus, &mock.device);
+    sgp40_init(&dev, &sim_transport);
+
+    sgp40_start_self_test(&dev);
+    uint32_t loops = sim_wait(&dev, &sraw, &status);
+    printf("self test       : %s, %.1f ms, bus %llu us, %u loop iterations free for other work\n",
+           status == SGP40_READY ? "ok" : "failed", bus.now_us / 1000.0,
+           (unsigned long long)bus.bus_busy_us, loops);
+
+    // 測定
+    uint64_t start_us = bus.now_us;
+    uint64_t start_busy = bus.bus_busy_us;
+    uint64_t latency_max = 0;
+    uint64_t latency_sum = 0;
+    uint32_t errors = 0;
+    for (int i = 0; i < SIM_MEASUREMENTS; i++)
+    {
+        uint64_t t0 = bus.now_us;
+        sgp40_start_measure(&dev, 25.0f, 50.0f);
+        sim_wait(&dev, &sraw, &status);
+        errors += status != SGP40_READY;
+
+        uint64_t latency = bus.now_us - t0;
+        latency_sum += latency;
+        latency_max = latency > latency_max ? latency : latency_max;
+        mock_i2c_advance(&bus, SIM_INTERVAL_US - latency); // 次の測定まで
+    }
+    uint64_t elapsed = bus.now_us - start_us;
+    uint64_t busy = bus.bus_busy_us - start_busy;
+
+    printf("measurements    : %d (errors %u, crc errors %u, early reads %u)\n",
+           SIM_MEASUREMENTS, errors, mock.crc_errors, mock.early_reads);
+    printf("latency         : avg %.2f ms, max %.2f ms\n",
+           latency_sum / 1000.0 / SIM_MEASUREMENTS, latency_max / 1000.0);
+    printf("CPU in driver   : %.2f %% (bus transfers only)\n", 100.0 * busy / elapsed);
+    printf("blocking driver : %.2f %% (bus transfers + sleep_ms(%d))\n",
+           100.0 * (busy + (uint64_t)SIM_MEASUREMENTS * SGP40_MEASURE_DELAY_US) / elapsed,
+           SGP40_MEASURE_DELAY_US / 1000);
+    return errors != 0;
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>                   // 標準入出力ライブラリ
+#include <stdlib.h>                  // malloc / free
+#include "host_util.h"               // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "sensirion_voc_algorithm.h" // Sensirion VOC アルゴリズムライブラリ
+
+#define BENCH_SAMPLES (1000000) // 1 計測あたりに処理する総サンプル数
+#define BENCH_RUNS (3)          // 計測の回数 (最も速かった回を使う)
+
+// 疑似的な SRAW 値を生成する (ストリームごとにベースラインをずらす)
+static int32_t fake_sraw(uint32_t *seed, int32_t stream)
+{
+    *seed = *seed * 1103515245u + 12345u;
+    return 25000 + (stream % 64) * 100 + (int32_t)((*seed >> 16) % 2000);
+}
+
+// スカラー API (VocAlgorithm_process) でのサンプル/秒
+static double bench_scalar(int32_t streams)
+{
+    VocAlgorithmParams *params = malloc(sizeof(VocAlgorithmParams) * streams);
+    int32_t steps = BENCH_SAMPLES / streams;
+    uint32_t seed = 1;
+    int32_t voc_index;
+
+    for (int32_t i = 0; i < streams; i++)
+    {
+        VocAlgorithm_init(&params[i]);
+    }
+
+    double start = now_sec();
+    for (int32_t t = 0; t < steps; t++)
+    {
+        for (int32_t i = 0; i < streams; i++)
+        {
+            VocAlgorithm_process(&params[i], fake_sraw(&seed, i), &voc_index);
+        }
+    }
+    double elapsed = now_sec() - start;
+
+    free(params);
+    return (double)steps * streams / elapsed;
+}
+
+// バッチ API (VocAlgorithm_process_batch) でのサンプル/秒
+static double bench_batch(int32_t streams)
+{
+    VocAlgorithmBatchParams params;
+    int32_t *buffer = malloc(sizeof(int32_t) * VocAlgorithm_BATCH_BUFFER_WORDS(streams));
+    int32_t *sraw = malloc(sizeof(int32_t) * streams);
+    int32_t *voc_index = malloc(sizeof(int32_t) * streams);
+    int32_t steps = BENCH_SAMPLES / streams;
+    uint32_t seed = 1;
+
+    VocAlgorithm_batch_init(&params, buffer, streams);
+
+    double start = now_sec();
+    for (int32_t t = 0; t < steps; t++)
+    {
+        for (int32_t i = 0; i < streams; i++)
+        {
+            sraw[i] = fake_sraw(&seed, i);
+        }
+        VocAlgorithm_process_batch(&params, sraw, voc_index);
+    }
+    double elapsed = now_sec() - start;
+
+    free(voc_index);
+    free(sraw);
+    free(buffer);
+    return (double)steps * streams / elapsed;
+}
+
+// BENCH_RUNS 回計測して最も速かった回のサンプル/秒を返す (他のプロセスによるばらつきを除く)
+static double best_of(double (*bench)(int32_t), int32_t streams)
+{
+    double best = 0;
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        double rate = bench(streams);
+        if (rate > best)
+        {
+            best = rate;
+        }
+    }
+    return best;
+}
+
+int main(void)
+{
+    const int32_t stream_counts[] = {1, 64, 4096}; // 計測するストリーム数
+
+    // 結果が一致することは voc_batch_check で確かめる
+    printf("%8s %16s %16s %8s\n", "streams", "scalar [S/s]", "batch [S/s]", "ratio");
+    for (size_t k = 0; k < sizeof(stream_counts) / sizeof(stream_counts[0]); k++)
+    {
+        int32_t streams = stream_counts[k];
+        double scalar = best_of(bench_scalar, streams);
+        double batch = best_of(bench_batch, streams);
+        printf("%8d %16.0f %16.0f %8.2f\n", streams, scalar, batch, batch / scalar);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <stdio.h>                   // 標準入出力ライブラリ
+#include <stdlib.h>                  // malloc / free
+#include "sensirion_voc_algorithm.h" // Sensirion VOC アルゴリズムライブラリ
+
+// VocAlgorithm_process_batch() の結果が、ストリームごとに VocAlgorithm_process() を呼んだ結果と
+// ビット単位で一致することを、すべてのストリーム・すべてのサンプルについて確かめる
+//
+// ストリーム数はブロック (VocAlgorithm_BATCH_BLOCK_SIZE) 1 個分・途中で終わるブロックを含む数にする。
+// SRAW は範囲外 (0、65000 以上) や丸められる値 (20001 未満、52767 超) を混ぜ、ときどき大きく跳ねて
+// ゲーティングと平均のオフセットの移し替えが起きるようにする。途中で get_states / set_states と
+// set_tuning_parameters を両方に同じように行う。
+
+#define CHECK_STEPS (9000)         // 1 つのストリーム数で処理するサンプル数 (初期化の遷移 5220 秒を過ぎるまで)
+#define CHECK_SET_STATES_STEP (3000) // 状態を読んで書き直すサンプル
+#define CHECK_TUNING_STEP (6000)     // チューニングパラメータを変えるサンプル
+#define CHECK_MAX_REPORTS (10)       // 表示する不一致の数
+
+// ストリーム stream の時刻 t の SRAW を作る (スカラー側とバッチ側で同じ値を使う)
+static int32_t test_sraw(uint32_t *seed, int32_t stream, int32_t t)
+{
+    *seed = *seed * 1103515245u + 12345u;
+    uint32_t r = *seed >> 16;
+    switch (r % 997)
+    {
+    case 0:
+        return 0; // 範囲外 (前の値を使う)
+    case 1:
+        return 65000 + (int32_t)(r % 500); // 範囲外
+    case 2:
+        return 15000; // 20001 に丸められる
+    case 3:
+        return 60000; // 52767 に丸められる
+    default:
+        break;
+    }
+    int32_t sraw = 22000 + (stream % 50) * 500 + (int32_t)(r % 800);
+    if ((t + stream * 131) % 1500 < 200)
+    {
+        sraw -= 6000; // VOC が増えた (SRAW が下がる) 期間
+    }
+    return sraw;
+}
+
+// ストリーム数 streams で比べ、一致しなかったサンプルの数を返す
+static long check_streams(int32_t streams)
+{
+    VocAlgorithmParams *scalar = malloc(sizeof(VocAlgorithmParams) * streams);
+    VocAlgorithmBatchParams batch;
+    int32_t *buffer = malloc(sizeof(int32_t) * VocAlgorithm_BATCH_BUFFER_WORDS(streams));
+    int32_t *sraw = malloc(sizeof(int32_t) * streams);
+    int32_t *voc_index = malloc(sizeof(int32_t) * streams);
+    uint32_t seed = 1 + (uint32_t)streams;
+    long mismatches = 0;
+    long state_mismatches = 0;
+
+    for (int32_t i = 0; i < streams; i++)
+    {
+        VocAlgorithm_init(&scalar[i]);
+    }
+    VocAlgorithm_batch_init(&batch, buffer, streams);
+
+    for (int32_t t = 0; t < CHECK_STEPS; t++)
+    {
+        if (t == CHECK_SET_STATES_STEP)
+        {
+            for (int32_t i = 0; i < streams; i += 7)
+            {
+                // 保存した状態から再開した場合 (値を少しずらして書き戻す)
+                int32_t s0, s1;
+                VocAlgorithm_get_states(&scalar[i], &s0, &s1);
+                VocAlgorithm_set_states(&scalar[i], s0 + 0x10000, s1);
+                VocAlgorithm_batch_set_states(&batch, i, s0 + 0x10000, s1);
+            }
+        }
+        if (t == CHECK_TUNING_STEP)
+        {
+            for (int32_t i = 0; i < streams; i++)
+            {
+                VocAlgorithm_set_tuning_parameters(&scalar[i], 150, 6, 60, 30);
+            }
+            VocAlgorithm_batch_set_tuning_parameters(&batch, 150, 6, 60, 30);
+        }
+
+        for (int32_t i = 0; i < streams; i++)
+        {
+            sraw[i] = test_sraw(&seed, i, t);
+        }
+        VocAlgorithm_process_batch(&batch, sraw, voc_index);
+        for (int32_t i = 0; i < streams; i++)
+        {
+            // VOC Index は丸めた値なので、平均・標準偏差の推定値 (get_states) も固定小数点のまま比べる
+            int32_t expected, s0, s1, b0, b1;
+            VocAlgorithm_process(&scalar[i], sraw[i], &expected);
+            VocAlgorithm_get_states(&scalar[i], &s0, &s1);
+            VocAlgorithm_batch_get_states(&batch, i, &b0, &b1);
+            if (voc_index[i] != expected || b0 != s0 || b1 != s1)
+            {
+                if (mismatches + state_mismatches < CHECK_MAX_REPORTS)
+                {
+                    printf("  streams %d, stream %d, sample %d: batch %d (0x%x, 0x%x), scalar %d (0x%x, 0x%x)\n",
+                           streams, i, t, voc_index[i], b0, b1, expected, s0, s1);
+                }
+                mismatches += voc_index[i] != expected;
+                state_mismatches += b0 != s0 || b1 != s1;
+            }
+        }
+    }
+
+    printf("%5d streams x %d samples: %ld voc_index mismatches, %ld state mismatches: %s\n", streams, CHECK_STEPS,
+           mismatches, state_mismatches, mismatches == 0 && state_mismatches == 0 ? "OK" : "NG");
+
+    free(voc_index);
+    free(sraw);
+    free(buffer);
+    free(scalar);
+    return mismatches + state_mismatches;
+}
+
+int main(void)
+{
+    // 1 ストリーム、ちょうど 1 ブロック、途中で終わるブロックを含む数
+    const int32_t stream_counts[] = {1, VocAlgorithm_BATCH_BLOCK_SIZE, VocAlgorithm_BATCH_BLOCK_SIZE * 3 + 5};
+    long failures = 0;
+
+    for (size_t k = 0; k < sizeof(stream_counts) / sizeof(stream_counts[0]); k++)
+    {
+        failures += check_streams(stream_counts[k]);
+    }
+    return failures != 0;
+}
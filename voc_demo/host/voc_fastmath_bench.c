@@ -0,0 +1,103 @@
+#include <stdio.h>     // 標準入出力ライブラリ
+#include <math.h>      // exp / sqrt (誤差の基準値)
+#include "host_util.h" // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+
+// FIXMATH_FAST_MATH を有効にしてライブラリ本体を取り込み、
+// static な fix16_*_iterative と fix16_*_fast を直接比較する
+#define FIXMATH_FAST_MATH
+#include "../sensirion_voc_algorithm.c"
+
+#define SQRT_EXHAUSTIVE_MAX (1 << 24) // sqrt はこの値までは全入力を調べる
+#define SQRT_STRIDE (127)             // それ以上は間引いて調べる
+
+static volatile fix16_t sink; // 計測ループが最適化で消えないようにする
+
+// 誤差の集計
+// 出力が 1.0 未満なら絶対誤差 [LSB]、1.0 以上なら相対誤差で評価する
+typedef struct
+{
+    double max_lsb;         // 出力 < 1.0 での真値 (double) との差の最大値 [LSB]
+    double max_rel;         // 出力 >= 1.0 での真値との相対誤差の最大値
+    double max_lsb_vs_iter; // 出力 < 1.0 での従来実装との差の最大値 [LSB]
+} error_stats;
+
+static void accumulate(error_stats *stats, fix16_t value, fix16_t iterative, double exact)
+{
+    if (exact < 65536.0)
+    {
+        stats->max_lsb = fmax(stats->max_lsb, fabs(value - exact));
+        stats->max_lsb_vs_iter = fmax(stats->max_lsb_vs_iter, fabs((double)value - iterative));
+    }
+    else
+    {
+        stats->max_rel = fmax(stats->max_rel, fabs(value - exact) / exact);
+    }
+}
+
+// exp：アルゴリズムが使う範囲 (飽和しない [-11.7835, 10.3972]) の全 fix16 値を調べる
+static void sweep_exp(void)
+{
+    error_stats fast = {0};
+    error_stats iterative = {0};
+    for (fix16_t x = F16(-11.7835); x <= F16(10.3972); x++)
+    {
+        double exact = exp(x / 65536.0) * 65536.0;
+        fix16_t reference = fix16_exp_iterative(x);
+        accumulate(&fast, fix16_exp_fast(x), reference, exact);
+        accumulate(&iterative, reference, reference, exact);
+    }
+    printf("exp  fast     : x < 0 max err %.3f LSB (vs iterative %.0f LSB), x >= 0 max rel err %.2e\n",
+           fast.max_lsb, fast.max_lsb_vs_iter, fast.max_rel);
+    printf("exp  iterative: x < 0 max err %.3f LSB, x >= 0 max rel err %.2e\n",
+           iterative.max_lsb, iterative.max_rel);
+}
+
+// sqrt：0..2^24 は全入力、それ以上は SQRT_STRIDE おきに調べる
+// 従来の実装は入力を uint32_t として扱うので、最上位ビットが 1 の値 (負の fix16) も 2^32 - 1 まで調べる
+static void sweep_sqrt(void)
+{
+    double max_fast = 0;
+    double max_iterative = 0;
+    double max_diff = 0;
+    for (int64_t x = 0; x <= UINT32_MAX; x += (x < SQRT_EXHAUSTIVE_MAX) ? 1 : SQRT_STRIDE)
+    {
+        double exact = sqrt((double)x * 65536.0);
+        fix16_t fast = fix16_sqrt_fast((fix16_t)(uint32_t)x);
+        fix16_t iterative = fix16_sqrt_iterative((fix16_t)(uint32_t)x);
+        max_fast = fmax(max_fast, fabs(fast - exact));
+        max_iterative = fmax(max_iterative, fabs(iterative - exact));
+        max_diff = fmax(max_diff, fabs((double)fast - iterative));
+    }
+    printf("sqrt fast     : max err %.3f LSB (vs iterative %.0f LSB)\n", max_fast, max_diff);
+    printf("sqrt iterative: max err %.3f LSB\n", max_iterative);
+}
+
+// 1 回あたりの実行時間 [ns] を計測する
+#define BENCH(func, first, last, step)                               \
+    do                                                               \
+    {                                                                \
+        long calls = 0;                                              \
+        double start = now_sec();                                    \
+        for (int rep = 0; rep < 20; rep++)                           \
+        {                                                            \
+            for (int64_t x = (first); x <= (last); x += (step))      \
+            {                                                        \
+                sink = func((fix16_t)x);                             \
+                calls++;                                             \
+            }                                                        \
+        }                                                            \
+        printf("%-22s %8.1f ns/call\n", #func,                       \
+               (now_sec() - start) * 1e9 / calls);                   \
+    } while (0)
+
+int main(void)
+{
+    sweep_exp();
+    sweep_sqrt();
+
+    BENCH(fix16_exp_iterative, F16(-11.7835), F16(10.3972), 97);
+    BENCH(fix16_exp_fast, F16(-11.7835), F16(10.3972), 97);
+    BENCH(fix16_sqrt_iterative, 0, FIX16_MAXIMUM, 9973);
+    BENCH(fix16_sqrt_fast, 0, FIX16_MAXIMUM, 9973);
+    return 0;
+}
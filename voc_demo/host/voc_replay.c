@@ -0,0 +1,236 @@
+#include <stdio.h>                   // 標準入出力ライブラリ
+#include <stdlib.h>                  // strtol など
+#include <string.h>                  // strcmp / strrchr
+#include <unistd.h>                  // getopt
+#include <pthread.h>                 // 複数ファイルの並列処理
+#include <sys/resource.h>            // getrusage (ピーク RSS)
+#include "host_util.h"               // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+#include "sensirion_voc_algorithm.h" // Sensirion VOC アルゴリズムライブラリ
+
+// 記録済み SRAW ログを VOC アルゴリズムに通して VOC Index 系列を出力するツール
+//
+// 入力形式
+//   CSV    : 1 行 1 サンプル。カンマ区切りの場合は最後の列を SRAW とみなす。数値で始まらない行 (ヘッダなど) は読み飛ばす
+//   バイナリ: リトルエンディアンの uint16 の並び (-b)
+// 出力形式
+//   "sraw,voc_index" の CSV。入力が 1 ファイルなら標準出力、複数ファイルなら <入力>.voc.csv
+
+#define MAX_THREADS 64 // 並列スレッド数の上限
+
+// チューニングパラメータ (VocAlgorithm_set_tuning_parameters の引数)
+typedef struct
+{
+    int32_t voc_index_offset;
+    int32_t learning_time_hours;
+    int32_t gating_max_duration_minutes;
+    int32_t std_initial;
+} replay_tuning;
+
+// 1 ファイル分のジョブ
+typedef struct
+{
+    const char *path; // 入力ファイル
+    FILE *out;        // 出力先 (NULL なら <path>.voc.csv を作る)
+    long samples;     // 処理したサンプル数
+    int failed;       // エラーが発生したら 1
+} replay_job;
+
+static replay_tuning tuning = {100, 12, 180, 50}; // 既定値は VocAlgorithm_init と同じ
+static int binary_input = 0;                      // 1 ならバイナリ入力
+static replay_job *jobs;                          // ジョブ一覧
+static int job_count;                             // ジョブ数
+static int next_job;                              // 次に処理するジョブ番号
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// 次の SRAW 値を読む。読めたら 1、ファイル終端なら 0 を返す
+static int read_sraw(FILE *in, int32_t *sraw)
+{
+    if (binary_input)
+    {
+        uint8_t raw[2];
+        if (fread(raw, 1, 2, in) != 2)
+        {
+            return 0;
+        }
+        *sraw = raw[0] | (raw[1] << 8);
+        return 1;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), in))
+    {
+        char *field = strrchr(line, ',');
+        field = field ? field + 1 : line;
+        char *end;
+        long value = strtol(field, &end, 10);
+        if (end != field)
+        {
+            *sraw = (int32_t)value;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 1 ファイルを VOC アルゴリズムに通す
+static void replay_file(replay_job *job)
+{
+    FILE *in = fopen(job->path, binary_input ? "rb" : "r");
+    if (!in)
+    {
+        perror(job->path);
+        job->failed = 1;
+        return;
+    }
+
+    FILE *out = job->out;
+    if (!out)
+    {
+        char out_path[4096];
+        snprintf(out_path, sizeof(out_path), "%s.voc.csv", job->path);
+        out = fopen(out_path, "w");
+        if (!out)
+        {
+            perror(out_path);
+            fclose(in);
+            job->failed = 1;
+            return;
+        }
+    }
+
+    VocAlgorithmParams params;
+    VocAlgorithm_init(&params);
+    VocAlgorithm_set_tuning_parameters(&params, tuning.voc_index_offset, tuning.learning_time_hours,
+                                       tuning.gating_max_duration_minutes, tuning.std_initial);
+
+    int32_t sraw, voc_index;
+    while (read_sraw(in, &sraw))
+    {
+        VocAlgorithm_process(&params, sraw, &voc_index);
+        fprintf(out, "%d,%d\n", (int)sraw, (int)voc_index);
+        job->samples++;
+    }
+
+    fclose(in);
+    if (out != job->out)
+    {
+        fclose(out);
+    }
+}
+
+// ワーカースレッド：未処理のジョブを順に取り出して処理する
+static void *replay_worker(void *arg)
+{
+    (void)arg;
+    while (1)
+    {
+        pthread_mutex_lock(&job_lock);
+        int index = next_job++;
+        pthread_mutex_unlock(&job_lock);
+        if (index >= job_count)
+        {
+            return NULL;
+        }
+        replay_file(&jobs[index]);
+    }
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-b] [-j threads] [-o offset] [-l learning_hours] [-g gating_minutes] [-s std_initial] file...\n"
+            "  -b  入力を uint16 リトルエンディアンのバイナリとして読む\n"
+            "  -j  並列スレッド数 (既定 1)\n",
+            name);
+}
+
+int main(int argc, char *argv[])
+{
+    int threads = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "bj:o:l:g:s:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+            binary_input = 1;
+            break;
+        case 'j':
+            threads = atoi(optarg);
+            break;
+        case 'o':
+            tuning.voc_index_offset = atoi(optarg);
+            break;
+        case 'l':
+            tuning.learning_time_hours = atoi(optarg);
+            break;
+        case 'g':
+            tuning.gating_max_duration_minutes = atoi(optarg);
+            break;
+        case 's':
+            tuning.std_initial = atoi(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    job_count = argc - optind;
+    if (job_count <= 0)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+    if (threads > MAX_THREADS)
+    {
+        threads = MAX_THREADS;
+    }
+    if (threads > job_count)
+    {
+        threads = job_count;
+    }
+
+    jobs = calloc(job_count, sizeof(replay_job));
+    for (int i = 0; i < job_count; i++)
+    {
+        jobs[i].path = argv[optind + i];
+        jobs[i].out = (job_count == 1) ? stdout : NULL; // 1 ファイルなら標準出力へ
+    }
+
+    double start = now_sec();
+    pthread_t workers[MAX_THREADS];
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_create(&workers[i], NULL, replay_worker, NULL);
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    double elapsed = now_sec() - start;
+
+    long total = 0;
+    int failed = 0;
+    for (int i = 0; i < job_count; i++)
+    {
+        total += jobs[i].samples;
+        failed |= jobs[i].failed;
+    }
+
+    // スループットとピーク RSS を標準エラーに出力する
+    struct rusage usage_info;
+    getrusage(RUSAGE_SELF, &usage_info);
+    fprintf(stderr, "files: %d, threads: %d, samples: %ld\n", job_count, threads, total);
+    fprintf(stderr, "elapsed: %.3f s, throughput: %.0f samples/s (%.1f h of 1 Hz data per second)\n",
+            elapsed, total / elapsed, total / elapsed / 3600.0);
+    fprintf(stderr, "peak RSS: %ld KiB\n", usage_info.ru_maxrss);
+
+    free(jobs);
+    return failed;
+}
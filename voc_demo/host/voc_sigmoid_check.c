@@ -0,0 +1,374 @@
+#include <stdio.h>     // 標準入出力ライブラリ
+#include "host_util.h" // 疑似乱数 rng() と現在時刻 now_sec() (ホスト共通)
+
+// ライブラリ本体を取り込み、static な関数を直接呼ぶ
+#include "../sensirion_voc_algorithm.c"
+
+// サンプルごとの割り算を減らした現在の実装が、以前の実装と同じ値を返すことを確かめ、両者の実行時間を比べる
+//
+// - シグモイド (sigmoid_scaled) の shift と offset / 100 は set_parameters でキャッシュする
+// - 平均・分散推定器の定数 (GAMMA_SCALING・additional_scaling、どちらも 2 のべき乗) での割り算は
+//   fix16_div() の代わりに fix16_div_pow2() を使う
+//
+// 1 サンプルの fix16_div() は 13 回から 9 回になる (シグモイド 2 → 1、推定器 3 → 0。
+// MOX モデル 1・適応ローパスフィルタ 1・推定器のシグモイド 6 はそのまま)。
+// 以前の実装は下の sigmoid_scaled_uncached() / mean_variance_estimator_uncached() / process_uncached() に
+// そのまま残してある。
+
+#define SWEEP_MIN F16(-1000.)          // 関数単位で調べるシグモイド入力の範囲
+#define SWEEP_MAX F16(1000.)
+#define SWEEP_STRIDE (61)              // 入力を SWEEP_STRIDE LSB おきに調べる
+#define DIV_SWEEP_STRIDE (4099)         // fix16_div_pow2 は全 fix16 値を DIV_SWEEP_STRIDE おきに調べる
+#define REPLAY_SAMPLES (7L * 24 * 3600) // リプレイするサンプル数 (1 秒ごとに 1 週間分)
+#define REPLAY_TUNING_PERIOD (86400L)   // この間隔でチューニングパラメータを変える
+#define BENCH_SAMPLES (200000L)         // ベンチマークで処理するサンプル数
+#define BENCH_RUNS (3)                  // ベンチマークの回数 (最も速い回を使う)
+#define CHECK_MAX_REPORTS (10)          // 表示する不一致の数
+
+static volatile fix16_t sink; // 計測ループが最適化で消えないようにする
+
+// キャッシュする前のシグモイド：shift と offset / 100 を毎回割り算で求める
+static fix16_t sigmoid_scaled_uncached(fix16_t offset, fix16_t sample)
+{
+    fix16_t x;
+    fix16_t shift;
+
+    x = (fix16_mul(F16(VocAlgorithm_SIGMOID_K), (sample - F16(VocAlgorithm_SIGMOID_X0))));
+    if ((x < F16(-50.)))
+    {
+        return F16(VocAlgorithm_SIGMOID_L);
+    }
+    else if ((x > F16(50.)))
+    {
+        return F16(0.);
+    }
+    else
+    {
+        if ((sample >= F16(0.)))
+        {
+            shift = (fix16_div((F16(VocAlgorithm_SIGMOID_L) - (fix16_mul(F16(5.), offset))), F16(4.)));
+            return ((fix16_div((F16(VocAlgorithm_SIGMOID_L) + shift), (F16(1.) + fix16_exp(x)))) - shift);
+        }
+        else
+        {
+            return (fix16_mul((fix16_div(offset, F16(VocAlgorithm_VOC_INDEX_OFFSET_DEFAULT))),
+                              (fix16_div(F16(VocAlgorithm_SIGMOID_L), (F16(1.) + fix16_exp(x))))));
+        }
+    }
+}
+
+// 2 のべき乗の定数も fix16_div() で割る平均・分散推定器
+static void mean_variance_estimator_uncached(VocAlgorithmParams *params, fix16_t sraw, fix16_t voc_index_from_prior)
+{
+    fix16_t delta_sgp;
+    fix16_t c;
+    fix16_t additional_scaling;
+
+    if ((params->m_Mean_Variance_Estimator___Initialized == false))
+    {
+        params->m_Mean_Variance_Estimator___Initialized = true;
+        params->m_Mean_Variance_Estimator___Sraw_Offset = sraw;
+        params->m_Mean_Variance_Estimator___Mean = F16(0.);
+        return;
+    }
+    if (((params->m_Mean_Variance_Estimator___Mean >= F16(100.)) ||
+         (params->m_Mean_Variance_Estimator___Mean <= F16(-100.))))
+    {
+        params->m_Mean_Variance_Estimator___Sraw_Offset =
+            (params->m_Mean_Variance_Estimator___Sraw_Offset + params->m_Mean_Variance_Estimator___Mean);
+        params->m_Mean_Variance_Estimator___Mean = F16(0.);
+    }
+    sraw = (sraw - params->m_Mean_Variance_Estimator___Sraw_Offset);
+    VocAlgorithm__mean_variance_estimator___calculate_gamma(
+        params->m_Mean_Variance_Estimator___Gamma, params->m_Mean_Variance_Estimator___Gamma_Initial_Mean,
+        params->m_Mean_Variance_Estimator___Gamma_Initial_Variance,
+        params->m_Mean_Variance_Estimator__Gating_Max_Duration_Minutes,
+        &params->m_Mean_Variance_Estimator___Uptime_Gamma, &params->m_Mean_Variance_Estimator___Uptime_Gating,
+        &params->m_Mean_Variance_Estimator___Gating_Duration_Minutes, &params->m_Mean_Variance_Estimator__Gamma_Mean,
+        &params->m_Mean_Variance_Estimator__Gamma_Variance, voc_index_from_prior);
+    delta_sgp = (fix16_div((sraw - params->m_Mean_Variance_Estimator___Mean),
+                           F16(VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING)));
+    if ((delta_sgp < F16(0.)))
+    {
+        c = (params->m_Mean_Variance_Estimator___Std - delta_sgp);
+    }
+    else
+    {
+        c = (params->m_Mean_Variance_Estimator___Std + delta_sgp);
+    }
+    additional_scaling = F16(1.);
+    if ((c > F16(1440.)))
+    {
+        additional_scaling = F16(4.);
+    }
+    params->m_Mean_Variance_Estimator___Std = (fix16_mul(
+        fix16_sqrt((fix16_mul(additional_scaling, (F16(VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING) -
+                                                   params->m_Mean_Variance_Estimator__Gamma_Variance)))),
+        fix16_sqrt(((fix16_mul(params->m_Mean_Variance_Estimator___Std,
+                               (fix16_div(params->m_Mean_Variance_Estimator___Std,
+                                          (fix16_mul(F16(VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING),
+                                                     additional_scaling)))))) +
+                    (fix16_mul((fix16_div((fix16_mul(params->m_Mean_Variance_Estimator__Gamma_Variance, delta_sgp)),
+                                          additional_scaling)),
+                               delta_sgp))))));
+    params->m_Mean_Variance_Estimator___Mean =
+        (params->m_Mean_Variance_Estimator___Mean +
+         (fix16_mul(params->m_Mean_Variance_Estimator__Gamma_Mean, delta_sgp)));
+}
+
+// VocAlgorithm_process() のシグモイドと平均・分散推定器を、以前の実装に置き換えたもの
+static void process_uncached(VocAlgorithmParams *params, int32_t sraw, int32_t *voc_index)
+{
+    if ((params->mUptime <= F16(VocAlgorithm_INITIAL_BLACKOUT)))
+    {
+        params->mUptime = (params->mUptime + F16(VocAlgorithm_SAMPLING_INTERVAL));
+    }
+    else
+    {
+        if (((sraw > 0) && (sraw < 65000)))
+        {
+            if ((sraw < 20001))
+            {
+                sraw = 20001;
+            }
+            else if ((sraw > 52767))
+            {
+                sraw = 52767;
+            }
+            params->mSraw = (fix16_from_int((sraw - 20000)));
+        }
+        params->mVoc_Index = VocAlgorithm__mox_model__process(params, params->mSraw);
+        params->mVoc_Index = sigmoid_scaled_uncached(params->m_Sigmoid_Scaled__Offset, params->mVoc_Index);
+        params->mVoc_Index = VocAlgorithm__adaptive_lowpass__process(params, params->mVoc_Index);
+        if ((params->mVoc_Index < F16(0.5)))
+        {
+            params->mVoc_Index = F16(0.5);
+        }
+        if ((params->mSraw > F16(0.)))
+        {
+            mean_variance_estimator_uncached(params, params->mSraw, params->mVoc_Index);
+            VocAlgorithm__mox_model__set_parameters(params, VocAlgorithm__mean_variance_estimator__get_std(params),
+                                                    VocAlgorithm__mean_variance_estimator__get_mean(params));
+        }
+    }
+    *voc_index = (fix16_cast_to_int((params->mVoc_Index + F16(0.5))));
+}
+
+// 時刻 t の SRAW を作る (日周の変化・ときどきの VOC の増加・範囲外の値を含む)
+static int32_t test_sraw(uint32_t *seed, long t)
+{
+    *seed = *seed * 1103515245u + 12345u;
+    uint32_t r = *seed >> 16;
+    if (r % 1009 == 0)
+    {
+        return 0; // 範囲外 (前の値を使う)
+    }
+    int32_t sraw = 30000 + (int32_t)((t % 86400) / 20) + (int32_t)(r % 400);
+    if (t % 7200 < 600)
+    {
+        sraw -= 8000; // VOC が増えた (SRAW が下がる) 期間
+    }
+    else if (t % 10000 < 300)
+    {
+        sraw += 4000; // VOC が減った (SRAW が上がる) 期間
+    }
+    return sraw;
+}
+
+// チューニングの範囲 (voc_index_offset 1..250) のオフセットごとに、関数単位で比べる
+static long sweep_sigmoid(void)
+{
+    static const int32_t offsets[] = {1, 50, 100, 150, 250};
+    long mismatches = 0;
+    long calls = 0;
+
+    for (size_t k = 0; k < sizeof(offsets) / sizeof(offsets[0]); k++)
+    {
+        VocAlgorithmParams params;
+        VocAlgorithm__sigmoid_scaled__set_parameters(&params, fix16_from_int(offsets[k]));
+        for (fix16_t sample = SWEEP_MIN; sample <= SWEEP_MAX; sample += SWEEP_STRIDE)
+        {
+            fix16_t cached = VocAlgorithm__sigmoid_scaled__process(&params, sample);
+            fix16_t uncached = sigmoid_scaled_uncached(params.m_Sigmoid_Scaled__Offset, sample);
+            if (cached != uncached)
+            {
+                if (mismatches < CHECK_MAX_REPORTS)
+                {
+                    printf("  offset %d, sample 0x%x: cached 0x%x, uncached 0x%x\n", offsets[k], sample, cached,
+                           uncached);
+                }
+                mismatches++;
+            }
+            calls++;
+        }
+    }
+    printf("sigmoid sweep: %ld inputs, %ld mismatches: %s\n", calls, mismatches, mismatches == 0 ? "OK" : "NG");
+    return mismatches;
+}
+
+// fix16_div_pow2() が fix16_div() と同じ値を返すかを、推定器が使うシフト量 (1・4・64・256 で割る) で調べる
+static long sweep_div_pow2(void)
+{
+    static const int32_t shifts[] = {0, 2, VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING_SHIFT,
+                                     VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING_SHIFT + 2};
+    static const fix16_t edges[] = {(fix16_t)FIX16_MINIMUM + 1, -0x10001, -0x8000, -0x7FFF, -1, 0,
+                                    1, 0x7FFF, 0x8000, 0x10001, FIX16_MAXIMUM - 1, FIX16_MAXIMUM};
+    long mismatches = 0;
+    long calls = 0;
+
+    for (size_t k = 0; k < sizeof(shifts) / sizeof(shifts[0]); k++)
+    {
+        fix16_t divisor = fix16_from_int(1 << shifts[k]);
+        int64_t a = (fix16_t)FIX16_MINIMUM;
+        size_t e = 0;
+        while (a <= FIX16_MAXIMUM || e < sizeof(edges) / sizeof(edges[0]))
+        {
+            // 間引いた値に加えて、丸めと符号の境目 (edges) とその前後のビットパターンも調べる
+            fix16_t x = (a <= FIX16_MAXIMUM) ? (fix16_t)a : edges[e++];
+            for (int32_t d = -1; d <= 1; d++)
+            {
+                fix16_t v = (fix16_t)((uint32_t)x + (uint32_t)(d << shifts[k]) + (uint32_t)d);
+                if (v == (fix16_t)FIX16_MINIMUM)
+                {
+                    continue; // fix16_div() の -a が符号付きオーバーフローになり、比べる値が決まらない
+                }
+                fix16_t shifted = fix16_div_pow2(v, shifts[k]);
+                fix16_t divided = fix16_div(v, divisor);
+                if (shifted != divided)
+                {
+                    if (mismatches < CHECK_MAX_REPORTS)
+                    {
+                        printf("  shift %d, x 0x%x: fix16_div_pow2 0x%x, fix16_div 0x%x\n", shifts[k], v, shifted,
+                               divided);
+                    }
+                    mismatches++;
+                }
+                calls++;
+            }
+            if (a <= FIX16_MAXIMUM)
+            {
+                a += DIV_SWEEP_STRIDE;
+            }
+        }
+    }
+    printf("fix16_div_pow2 sweep: %ld inputs, %ld mismatches: %s\n", calls, mismatches, mismatches == 0 ? "OK" : "NG");
+    return mismatches;
+}
+
+// 1 週間分の SRAW を両方の実装に流し、すべてのサンプルの VOC Index と状態を比べる
+static long replay_diff(void)
+{
+    static const int32_t offsets[] = {100, 1, 250, 150, 60, 100, 200};
+    VocAlgorithmParams cached;
+    VocAlgorithmParams uncached;
+    uint32_t seed = 1;
+    long mismatches = 0;
+
+    VocAlgorithm_init(&cached);
+    VocAlgorithm_init(&uncached);
+    for (long t = 0; t < REPLAY_SAMPLES; t++)
+    {
+        if (t % REPLAY_TUNING_PERIOD == 0 && t != 0)
+        {
+            int32_t offset = offsets[(t / REPLAY_TUNING_PERIOD) % (sizeof(offsets) / sizeof(offsets[0]))];
+            VocAlgorithm_set_tuning_parameters(&cached, offset, 12, 180, 50);
+            VocAlgorithm_set_tuning_parameters(&uncached, offset, 12, 180, 50);
+        }
+        int32_t sraw = test_sraw(&seed, t);
+        int32_t a, b, a0, a1, b0, b1;
+        VocAlgorithm_process(&cached, sraw, &a);
+        process_uncached(&uncached, sraw, &b);
+        VocAlgorithm_get_states(&cached, &a0, &a1);
+        VocAlgorithm_get_states(&uncached, &b0, &b1);
+        if (a != b || a0 != b0 || a1 != b1)
+        {
+            if (mismatches < CHECK_MAX_REPORTS)
+            {
+                printf("  sample %ld: cached %d (0x%x, 0x%x), uncached %d (0x%x, 0x%x)\n", t, a, a0, a1, b, b0, b1);
+            }
+            mismatches++;
+        }
+    }
+    printf("replay: %ld samples, %ld mismatches: %s\n", REPLAY_SAMPLES, mismatches, mismatches == 0 ? "OK" : "NG");
+    return mismatches;
+}
+
+// シグモイド 1 回の実行時間 [ns] (BENCH_RUNS 回のうち最も速い回)
+static double bench_sigmoid(int use_cache)
+{
+    VocAlgorithmParams params;
+    double best = 0;
+
+    VocAlgorithm__sigmoid_scaled__set_parameters(&params, F16(VocAlgorithm_VOC_INDEX_OFFSET_DEFAULT));
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        long calls = 0;
+        double start = now_sec();
+        for (fix16_t sample = F16(-300.); sample <= F16(500.); sample += 97)
+        {
+            sink = use_cache ? VocAlgorithm__sigmoid_scaled__process(&params, sample)
+                             : sigmoid_scaled_uncached(params.m_Sigmoid_Scaled__Offset, sample);
+            calls++;
+        }
+        double ns = (now_sec() - start) * 1e9 / calls;
+        if (run == 0 || ns < best)
+        {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+// VocAlgorithm_process 1 サンプルの実行時間 [ns] (初期化の遷移を過ぎた定常状態)
+static double bench_process(int use_cache)
+{
+    double best = 0;
+
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        VocAlgorithmParams params;
+        uint32_t seed = 1;
+        int32_t voc_index;
+        VocAlgorithm_init(&params);
+        params.mUptime = F16(VocAlgorithm_INITIAL_BLACKOUT) + 1; // ブラックアウトを飛ばす
+        double start = now_sec();
+        for (long t = 0; t < BENCH_SAMPLES; t++)
+        {
+            int32_t sraw = test_sraw(&seed, t);
+            if (use_cache)
+            {
+                VocAlgorithm_process(&params, sraw, &voc_index);
+            }
+            else
+            {
+                process_uncached(&params, sraw, &voc_index);
+            }
+            sink = voc_index;
+        }
+        double ns = (now_sec() - start) * 1e9 / BENCH_SAMPLES;
+        if (run == 0 || ns < best)
+        {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+int main(void)
+{
+    long failures = 0;
+
+    failures += sweep_sigmoid();
+    failures += sweep_div_pow2();
+    failures += replay_diff();
+
+    double sigmoid_uncached = bench_sigmoid(0);
+    double sigmoid_cached = bench_sigmoid(1);
+    double process_before = bench_process(0);
+    double process_after = bench_process(1);
+    printf("%-20s: uncached %7.1f ns, cached %7.1f ns (%.2fx)\n", "sigmoid_scaled", sigmoid_uncached, sigmoid_cached,
+           sigmoid_uncached / sigmoid_cached);
+    printf("%-20s: before %7.1f ns, after %7.1f ns (%.2fx, fix16_div 13 -> 9 per sample)\n", "VocAlgorithm_process",
+           process_before, process_after, process_before / process_after);
+    return failures != 0;
+}
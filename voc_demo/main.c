@@ -2,110 +2,73 @@
 #include "pico/stdlib.h"             // Pico SDK の標準ライブラリ
 #include "hardware/i2c.h"            // I2C 通信ライブラリ
 #include "hardware/gpio.h"           // GPIO 制御ライブラリ
-#include "sensirion_voc_algorithm.h" // Sensirion VOC アルゴリズムライブラリ
-
-// SGP40 I2C アドレス
-#define SGP40_ADDR 0x59 // SGP40 センサーの I2C アドレス
+#include "sgp40.h"                   // SGP40 ドライバ (ノンブロッキング)
+#include "shtc3.h"                   // SHTC3 ドライバ (ノンブロッキング)
+#include "air_quality.h"             // 温湿度補償付き VOC Index の計測パイプライン
 
 // I2C ポートとピン (配線に合わせて調整)
 #define I2C_PORT i2c0 // 使用する I2C ポート (i2c0 または i2c1)
 #define I2C_SDA_PIN 8 // SDA (データ) ピン
 #define I2C_SCL_PIN 9 // SCL (クロック) ピン
 
-// SGP40 コマンド
-uint8_t WITH_HUM_COMP[] = {0x26, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}; // 湿度補償付き raw データ用
-
-// I2C 読み取りバイト関数
-static uint16_t SGP40_ReadByte()
+// I2C 書き込み (sgp40_transport / shtc3_transport 用)
+static int pico_i2c_write(void *ctx, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
 {
-    uint8_t Rbuf[3];                                         // 受信バッファ
-    i2c_read_blocking(I2C_PORT, SGP40_ADDR, Rbuf, 3, false); // I2C 受信
-    return (Rbuf[0] << 8) | Rbuf[1];                         // 受信データを 16 ビットに合成して返す
+    return i2c_write_blocking((i2c_inst_t *)ctx, addr, src, len, nostop);
 }
 
-// CRC8 チェックサム計算
-uint8_t crc_value(uint8_t msb, uint8_t lsb)
+// I2C 読み出し (sgp40_transport / shtc3_transport 用)
+static int pico_i2c_read(void *ctx, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
 {
-    uint8_t crc = 0xFF; // CRCの初期値を0xFFに設定
-
-    crc ^= msb; // 上位バイト(msb)とCRCのXORをとる
-    for (int i = 0; i < 8; i++)
-    { // 8回繰り返す (1バイトは8ビットのため)
-        if (crc & 0x80)
-        {                            // CRCの最上位ビット(MSB)が1かどうかをチェック
-            crc = (crc << 1) ^ 0x31; // MSBが1の場合、左シフトして0x31とのXORをとる
-        }
-        else
-        {
-            crc <<= 1; // MSBが0の場合、左シフトする
-        }
-    }
-
-    if (lsb != 0)
-    {               // 下位バイト(lsb)が0でない場合
-        crc ^= lsb; // 下位バイトとCRCのXORをとる
-        for (int i = 0; i < 8; i++)
-        { // 8回繰り返す
-            if (crc & 0x80)
-            {                            // CRCのMSBが1かどうかをチェック
-                crc = (crc << 1) ^ 0x31; // MSBが1の場合、左シフトして0x31とのXORをとる
-            }
-            else
-            {
-                crc <<= 1; // MSBが0の場合、左シフトする
-            }
-        }
-    }
-    return crc; // 最終的なCRC値を返す
+    return i2c_read_blocking((i2c_inst_t *)ctx, addr, dst, len, nostop);
 }
 
-// SGP40 初期化
-uint8_t SGP40_init(void)
+// アラーム満了時のコールバック (割り込みコンテキストで実行される)
+static int64_t sgp40_alarm_callback(alarm_id_t id, void *user_data)
 {
-    uint8_t cmd_feature_set[] = {0x20, 0x2F};  // Feature Set コマンド
-    uint8_t cmd_measure_test[] = {0x28, 0x0E}; // Measure Test コマンド
+    (void)id;
+    sgp40_timer_expired((sgp40 *)user_data); // ドライバに変換完了を通知
+    return 0;                                // 0 を返すとアラームは繰り返さない
+}
 
-    i2c_write_blocking(I2C_PORT, SGP40_ADDR, cmd_feature_set, 2, false); // Feature Set コマンド送信
-    sleep_ms(250);                                                       // 250ms 待機
-    if (SGP40_ReadByte() != 0x3220)
-    {
-        printf("Self test failed (Feature Set)\n"); // エラーメッセージ
-        return 1;                                   // エラーを返す
-    }
+// ハードウェアアラームを起動する (sgp40_transport 用)
+static void pico_sgp40_start_timer(void *ctx, uint32_t delay_us, sgp40 *dev)
+{
+    (void)ctx;
+    add_alarm_in_us(delay_us, sgp40_alarm_callback, dev, true);
+}
 
-    i2c_write_blocking(I2C_PORT, SGP40_ADDR, cmd_measure_test, 2, false); // Measure Test コマンド送信
-    sleep_ms(250);                                                        // 250ms 待機
-    if (SGP40_ReadByte() != 0xD400)
-    {
-        printf("Self test failed (Measure Test)\n"); // エラーメッセージ
-        return 1;                                    // エラーを返す
-    }
-    return 0; // 正常終了
+// アラーム満了時のコールバック (割り込みコンテキストで実行される)
+static int64_t shtc3_alarm_callback(alarm_id_t id, void *user_data)
+{
+    (void)id;
+    shtc3_timer_expired((shtc3 *)user_data); // ドライバに待ち時間の経過を通知
+    return 0;                                // 0 を返すとアラームは繰り返さない
 }
 
-// SGP40 Raw データ測定 (温度と湿度を引数として受け取る)
-uint16_t SGP40_MeasureRaw(float temp, float humi)
+// ハードウェアアラームを起動する (shtc3_transport 用)
+static void pico_shtc3_start_timer(void *ctx, uint32_t delay_us, shtc3 *dev)
 {
-    uint16_t h = humi * 0xffff / 100;               // 湿度を 16bit 値に変換
-    uint8_t paramh[2] = {h >> 8, h & 0xff};         // 上位バイトと下位バイトに分割
-    uint8_t crch = crc_value(paramh[0], paramh[1]); // 湿度パラメータの CRC 値を計算
-
-    uint16_t t = (temp + 45) * 0xffff / 175;        // 温度を 16bit 値に変換
-    uint8_t paramt[2] = {t >> 8, t & 0xff};         // 上位バイトと下位バイトに分割
-    uint8_t crct = crc_value(paramt[0], paramt[1]); // 温度パラメータの CRC 値を計算
-
-    WITH_HUM_COMP[2] = paramh[0]; // 湿度パラメータ (上位バイト) を設定
-    WITH_HUM_COMP[3] = paramh[1]; // 湿度パラメータ (下位バイト) を設定
-    WITH_HUM_COMP[4] = crch;      // 湿度パラメータの CRC 値を設定
-    WITH_HUM_COMP[5] = paramt[0]; // 温度パラメータ (上位バイト) を設定
-    WITH_HUM_COMP[6] = paramt[1]; // 温度パラメータ (下位バイト) を設定
-    WITH_HUM_COMP[7] = crct;      // 温度パラメータの CRC 値を設定
-
-    i2c_write_blocking(I2C_PORT, SGP40_ADDR, WITH_HUM_COMP, 8, false); // 湿度補償付き raw データ測定コマンド送信
-    sleep_ms(31);                                                      // 31ms 待機
-    return SGP40_ReadByte();                                           // SGP40 からの応答 (raw データ) を返す
+    (void)ctx;
+    add_alarm_in_us(delay_us, shtc3_alarm_callback, dev, true);
 }
 
+// SGP40 から I2C とタイマーを使うための関数テーブル
+static const sgp40_transport sgp40_pico_transport = {
+    .write = pico_i2c_write,
+    .read = pico_i2c_read,
+    .start_timer = pico_sgp40_start_timer,
+    .ctx = I2C_PORT,
+};
+
+// SHTC3 から I2C とタイマーを使うための関数テーブル (SGP40 と同じバスを共有する)
+static const shtc3_transport shtc3_pico_transport = {
+    .write = pico_i2c_write,
+    .read = pico_i2c_read,
+    .start_timer = pico_shtc3_start_timer,
+    .ctx = I2C_PORT,
+};
+
 int main()
 {
     stdio_init_all();                              // 標準入出力の初期化
@@ -115,30 +78,79 @@ int main()
     gpio_pull_up(I2C_SDA_PIN);                     // SDA ピンをプルアップ
     gpio_pull_up(I2C_SCL_PIN);                     // SCL ピンをプルアップ
 
-    VocAlgorithmParams voc_params; // VOC アルゴリズムのパラメータ構造体を定義
-
-    if (SGP40_init() != 0)
+    sgp40 voc_sensor;        // SGP40 ドライバの状態
+    shtc3 rht_sensor;        // SHTC3 ドライバの状態
+    air_quality aq;          // 計測パイプラインの状態
+    uint16_t sraw;           // SGP40 の raw データ (セルフテストでは結果)
+    float temperature;       // SHTC3 の温度 (ID 確認では未使用)
+    float humidity;          // SHTC3 の湿度 (ID 確認では未使用)
+    sgp40_status voc_status; // SGP40 ドライバの処理結果
+    shtc3_status rht_status; // SHTC3 ドライバの処理結果
+
+    // SGP40 のセルフテストと SHTC3 の ID 確認を同時に開始し、両方終わるまで待つ
+    sgp40_init(&voc_sensor, &sgp40_pico_transport);
+    shtc3_init(&rht_sensor, &shtc3_pico_transport, SHTC3_MODE_LOW_POWER);
+    sgp40_start_self_test(&voc_sensor);
+    shtc3_start_check_id(&rht_sensor);
+    voc_status = SGP40_BUSY;
+    rht_status = SHTC3_BUSY;
+    while (voc_status == SGP40_BUSY || rht_status == SHTC3_BUSY)
+    {
+        if (voc_status == SGP40_BUSY)
+        {
+            voc_status = sgp40_poll(&voc_sensor, &sraw);
+        }
+        if (rht_status == SHTC3_BUSY)
+        {
+            rht_status = shtc3_poll(&rht_sensor, &temperature, &humidity);
+        }
+        tight_loop_contents(); // ここに他の処理を書ける
+    }
+    if (voc_status != SGP40_READY)
     {
         printf("SGP40 initialization failed\n"); // SGP40 の初期化に失敗した場合のエラーメッセージ
         return 1;                                // エラーを返す
     }
+    if (rht_status != SHTC3_READY)
+    {
+        // SHTC3 がなくても既定の温湿度 (25℃, 50%) で VOC Index は計算できる
+        printf("SHTC3 not found, using %.0f C / %.0f %%RH\n",
+               AIR_QUALITY_DEFAULT_TEMPERATURE, AIR_QUALITY_DEFAULT_HUMIDITY);
+    }
 
-    printf("SGP40 VOC Index Reader (100ms interval)\n");                // プログラムの開始メッセージ
-    printf("I2C SDA Pin: %d, SCL Pin: %d\n", I2C_SDA_PIN, I2C_SCL_PIN); // 使用する I2C ピンを表示
-    printf("SGP40 I2C Address: 0x%02X\n", SGP40_ADDR);                  // SGP40 の I2C アドレスを表示
-
-    float temperature = 25.0f; // 仮の温度 (摂氏)
-    float humidity = 50.0f;    // 仮の湿度 (%)
-    uint32_t voc_index;        // VOC Index を格納する変数
+    printf("SGP40 VOC Index Reader (%dms interval)\n", AIR_QUALITY_INTERVAL_MS); // プログラムの開始メッセージ
+    printf("I2C SDA Pin: %d, SCL Pin: %d\n", I2C_SDA_PIN, I2C_SCL_PIN);          // 使用する I2C ピンを表示
+    printf("SGP40 I2C Address: 0x%02X\n", SGP40_ADDR);                           // SGP40 の I2C アドレスを表示
+    printf("SHTC3 I2C Address: 0x%02X\n", SHTC3_I2C_ADDR);                       // SHTC3 の I2C アドレスを表示
 
-    VocAlgorithm_init(&voc_params); // VOC アルゴリズムの初期化
+    air_quality_init(&aq, &voc_sensor, &rht_sensor); // パイプライン (と VOC アルゴリズム) の初期化
 
+    absolute_time_t next_measure = get_absolute_time(); // 次に測定を開始する時刻
     while (true)
     {
-        uint16_t sraw = SGP40_MeasureRaw(temperature, humidity); // SGP40 から raw データを取得
-        VocAlgorithm_process(&voc_params, sraw, &voc_index);     // VOC Index を計算
-        printf("VOC Index: %ld\n", voc_index);                   // VOC Index を表示
-        sleep_ms(100);                                           // 100ms 待機
+        // 1 秒ごとに SHTC3 → SGP40 の計測を開始する (変換完了は待たない)
+        if (air_quality_is_idle(&aq) && time_reached(next_measure))
+        {
+            next_measure = delayed_by_ms(next_measure, AIR_QUALITY_INTERVAL_MS);
+            if (!air_quality_start(&aq))
+            {
+                printf("SGP40 write error\n"); // 測定コマンドを送れなかった
+            }
+        }
+
+        // 計測が終わっていれば、補償に使った温湿度と VOC Index を表示
+        air_quality_status status = air_quality_poll(&aq);
+        if (status == AIR_QUALITY_READY)
+        {
+            printf("Temperature: %.2f C, Humidity: %.2f %%%s, VOC Index: %ld\n",
+                   aq.temperature, aq.humidity, aq.rht_valid ? "" : " (previous)", aq.voc_index);
+        }
+        else if (status == AIR_QUALITY_ERROR)
+        {
+            printf("SGP40 read error\n"); // 通信エラー
+        }
+
+        tight_loop_contents(); // 変換中はここで他のセンサーや表示の処理ができる
     }
 
     return 0; // プログラム終了
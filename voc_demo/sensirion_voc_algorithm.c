@@ -31,6 +31,10 @@
 
 #include "sensirion_voc_algorithm.h"
 
+#ifdef FIXMATH_FAST_MATH
+#include <math.h>
+#endif
+
 /* The fixed point arithmetic parts of this code were originally created by
  * https://github.com/PetteriAimonen/libfixmath
  */
@@ -45,11 +49,11 @@
 /*!< fix16_t value of 1 */
 #define FIX16_ONE 0x00010000
 
-inline fix16_t fix16_from_int(int32_t a) {
+static inline fix16_t fix16_from_int(int32_t a) {
     return a * FIX16_ONE;
 }
 
-inline int32_t fix16_cast_to_int(fix16_t a) {
+static inline int32_t fix16_cast_to_int(fix16_t a) {
     return (a >> 16);
 }
 
@@ -59,12 +63,35 @@ static fix16_t fix16_mul(fix16_t inArg0, fix16_t inArg1);
 /*! Divides the first given fix16_t by the second and returns the result. */
 static fix16_t fix16_div(fix16_t inArg0, fix16_t inArg1);
 
+/*! Divides the given fix16_t by 2^shift. Same result as fix16_div() by
+ * F16(1 << shift), without the bit-by-bit division loop. */
+static inline fix16_t fix16_div_pow2(fix16_t inArg0, int32_t shift);
+
 /*! Returns the square root of the given fix16_t. */
 static fix16_t fix16_sqrt(fix16_t inValue);
 
 /*! Returns the exponent (e^) of the given fix16_t. */
 static fix16_t fix16_exp(fix16_t inValue);
 
+/*! Bit-by-bit square root (libfixmath). Used unless FIXMATH_FAST_MATH. */
+static inline fix16_t fix16_sqrt_iterative(fix16_t inValue);
+
+/*! Code-size optimized exponent (libfixmath). Used unless FIXMATH_FAST_MATH.
+ */
+static inline fix16_t fix16_exp_iterative(fix16_t inValue);
+
+#ifdef FIXMATH_FAST_MATH
+/*! Square root from a single precision hardware square root, corrected to
+ * the nearest fix16_t. Result is round(sqrt(x)), |error| <= 0.5 LSB. */
+static inline fix16_t fix16_sqrt_fast(fix16_t inValue);
+
+/*! Exponent as 2^(x / ln 2) using a 257-entry 2^f table with linear
+ * interpolation. Measured over every input in [-11.7835, 10.3972] by
+ * host/voc_fastmath_bench: |error| <= 0.56 LSB for results < 1.0 and
+ * relative error <= 8.4e-6 for results >= 1.0. */
+static inline fix16_t fix16_exp_fast(fix16_t inValue);
+#endif
+
 static fix16_t fix16_mul(fix16_t inArg0, fix16_t inArg1) {
     // Each argument is divided to 16-bit parts.
     //					AB
@@ -188,7 +215,39 @@ static fix16_t fix16_div(fix16_t a, fix16_t b) {
     return result;
 }
 
+static inline fix16_t fix16_div_pow2(fix16_t a, int32_t shift) {
+    // fix16_div() rounds the magnitude of the quotient half up and then
+    // applies the sign. Dividing by a power of two only needs the shift and
+    // the highest discarded bit.
+    uint32_t magnitude = (a >= 0) ? (uint32_t)a : -(uint32_t)a;
+    uint32_t quotient = magnitude >> shift;
+
+#ifndef FIXMATH_NO_ROUNDING
+    if (shift > 0)
+        quotient += (magnitude >> (shift - 1)) & 1;
+#endif
+
+    // -FIX16_MINIMUM stays FIX16_MINIMUM (= FIX16_OVERFLOW), as in fix16_div()
+    return (fix16_t)((a >= 0) ? quotient : 0u - quotient);
+}
+
 static fix16_t fix16_sqrt(fix16_t x) {
+#ifdef FIXMATH_FAST_MATH
+    return fix16_sqrt_fast(x);
+#else
+    return fix16_sqrt_iterative(x);
+#endif
+}
+
+static fix16_t fix16_exp(fix16_t x) {
+#ifdef FIXMATH_FAST_MATH
+    return fix16_exp_fast(x);
+#else
+    return fix16_exp_iterative(x);
+#endif
+}
+
+static inline fix16_t fix16_sqrt_iterative(fix16_t x) {
     // It is assumed that x is not negative
 
     uint32_t num = x;
@@ -245,7 +304,7 @@ static fix16_t fix16_sqrt(fix16_t x) {
     return (fix16_t)result;
 }
 
-static fix16_t fix16_exp(fix16_t x) {
+static inline fix16_t fix16_exp_iterative(fix16_t x) {
 // Function to approximate exp(); optimized more for code size than speed
 
 // exp(x) for x = +/- {1, 1/8, 1/64, 1/512}
@@ -283,11 +342,98 @@ static fix16_t fix16_exp(fix16_t x) {
     return res;
 }
 
+#ifdef FIXMATH_FAST_MATH
+static inline fix16_t fix16_sqrt_fast(fix16_t x) {
+    // It is assumed that x is not negative. Like fix16_sqrt_iterative, the
+    // bits are read as uint32_t, so a negative x still ends in a few steps.
+
+    // sqrt(x / 2^16) * 2^16 = sqrt(x) * 2^8. The float estimate is within
+    // +/-2 of the result, the loops round it to the nearest integer:
+    // (2r - 1)^2 <= 4 * x * 2^16 < (2r + 1)^2
+    uint64_t v4 = (uint64_t)(uint32_t)x << 18;
+    uint32_t r = (uint32_t)(sqrtf((float)(uint32_t)x) * 256.0f + 0.5f);
+
+    while (r > 0 && (uint64_t)(2 * r - 1) * (2 * r - 1) > v4)
+        r--;
+    while ((uint64_t)(2 * r + 1) * (2 * r + 1) <= v4)
+        r++;
+    return (fix16_t)r;
+}
+
+static inline fix16_t fix16_exp_fast(fix16_t x) {
+    // round(2^(i / 256) * 2^30) for i = 0..256, printed by host/exp2_table_gen
+    static const uint32_t exp2_table[257] = {
+    0x40000000u, 0x402C6BE9u, 0x4058F6A8u, 0x4085A051u, 0x40B268FAu, 0x40DF50B8u,
+    0x410C57A2u, 0x41397DCCu, 0x4166C34Cu, 0x41942839u, 0x41C1ACA7u, 0x41EF50AEu,
+    0x421D1462u, 0x424AF7DAu, 0x4278FB2Bu, 0x42A71E6Cu, 0x42D561B4u, 0x4303C518u,
+    0x433248AEu, 0x4360EC8Du, 0x438FB0CBu, 0x43BE957Fu, 0x43ED9AC0u, 0x441CC0A3u,
+    0x444C0740u, 0x447B6EADu, 0x44AAF702u, 0x44DAA054u, 0x450A6ABBu, 0x453A564Du,
+    0x456A6323u, 0x459A9152u, 0x45CAE0F2u, 0x45FB521Au, 0x462BE4E2u, 0x465C9961u,
+    0x468D6FAEu, 0x46BE67E0u, 0x46EF8210u, 0x4720BE55u, 0x47521CC6u, 0x47839D7Bu,
+    0x47B5408Cu, 0x47E70611u, 0x4818EE22u, 0x484AF8D6u, 0x487D2646u, 0x48AF768Au,
+    0x48E1E9BAu, 0x49147FEEu, 0x4947393Fu, 0x497A15C4u, 0x49AD1598u, 0x49E038D0u,
+    0x4A137F88u, 0x4A46E9D6u, 0x4A7A77D4u, 0x4AAE299Bu, 0x4AE1FF43u, 0x4B15F8E6u,
+    0x4B4A169Cu, 0x4B7E587Eu, 0x4BB2BEA5u, 0x4BE7492Bu, 0x4C1BF829u, 0x4C50CBB8u,
+    0x4C85C3F1u, 0x4CBAE0EFu, 0x4CF022CAu, 0x4D25899Cu, 0x4D5B157Eu, 0x4D90C68Bu,
+    0x4DC69CDDu, 0x4DFC988Cu, 0x4E32B9B4u, 0x4E69006Eu, 0x4E9F6CD4u, 0x4ED5FF00u,
+    0x4F0CB70Cu, 0x4F439514u, 0x4F7A9930u, 0x4FB1C37Cu, 0x4FE91413u, 0x50208B0Eu,
+    0x50582888u, 0x508FEC9Cu, 0x50C7D765u, 0x50FFE8FEu, 0x51382182u, 0x5170810Bu,
+    0x51A907B4u, 0x51E1B59Au, 0x521A8AD7u, 0x52538786u, 0x528CABC3u, 0x52C5F7AAu,
+    0x52FF6B55u, 0x533906E0u, 0x5372CA68u, 0x53ACB607u, 0x53E6C9DAu, 0x542105FDu,
+    0x545B6A8Bu, 0x5495F7A1u, 0x54D0AD5Au, 0x550B8BD4u, 0x55469329u, 0x5581C378u,
+    0x55BD1CDBu, 0x55F89F70u, 0x56344B52u, 0x567020A0u, 0x56AC1F75u, 0x56E847EFu,
+    0x57249A29u, 0x57611642u, 0x579DBC57u, 0x57DA8C83u, 0x581786E6u, 0x5854AB9Bu,
+    0x5891FAC1u, 0x58CF7474u, 0x590D18D3u, 0x594AE7FBu, 0x5988E209u, 0x59C7071Cu,
+    0x5A055751u, 0x5A43D2C6u, 0x5A82799Au, 0x5AC14BEAu, 0x5B0049D4u, 0x5B3F7377u,
+    0x5B7EC8F2u, 0x5BBE4A61u, 0x5BFDF7E5u, 0x5C3DD19Cu, 0x5C7DD7A4u, 0x5CBE0A1Cu,
+    0x5CFE6923u, 0x5D3EF4D7u, 0x5D7FAD59u, 0x5DC092C7u, 0x5E01A53Fu, 0x5E42E4E3u,
+    0x5E8451D0u, 0x5EC5EC26u, 0x5F07B405u, 0x5F49A98Cu, 0x5F8BCCDBu, 0x5FCE1E12u,
+    0x60109D51u, 0x60534AB7u, 0x60962665u, 0x60D9307Bu, 0x611C6919u, 0x615FD05Eu,
+    0x61A3666Du, 0x61E72B65u, 0x622B1F66u, 0x626F4292u, 0x62B39509u, 0x62F816EBu,
+    0x633CC85Bu, 0x6381A978u, 0x63C6BA64u, 0x640BFB41u, 0x64516C2Eu, 0x64970D4Fu,
+    0x64DCDEC3u, 0x6522E0ADu, 0x6569132Fu, 0x65AF766Au, 0x65F60A7Fu, 0x663CCF92u,
+    0x6683C5C3u, 0x66CAED35u, 0x6712460Bu, 0x6759D065u, 0x67A18C68u, 0x67E97A34u,
+    0x683199EDu, 0x6879EBB6u, 0x68C26FB1u, 0x690B2601u, 0x69540EC9u, 0x699D2A2Cu,
+    0x69E6784Du, 0x6A2FF94Fu, 0x6A79AD56u, 0x6AC39485u, 0x6B0DAEFFu, 0x6B57FCE9u,
+    0x6BA27E65u, 0x6BED3399u, 0x6C381CA6u, 0x6C8339B2u, 0x6CCE8AE1u, 0x6D1A1057u,
+    0x6D65CA38u, 0x6DB1B8A8u, 0x6DFDDBCCu, 0x6E4A33C9u, 0x6E96C0C3u, 0x6EE382DEu,
+    0x6F307A41u, 0x6F7DA710u, 0x6FCB096Fu, 0x7018A185u, 0x70666F76u, 0x70B47368u,
+    0x7102AD80u, 0x71511DE4u, 0x719FC4B9u, 0x71EEA226u, 0x723DB650u, 0x728D015Du,
+    0x72DC8374u, 0x732C3CBAu, 0x737C2D55u, 0x73CC556Du, 0x741CB528u, 0x746D4CACu,
+    0x74BE1C20u, 0x750F23ABu, 0x75606374u, 0x75B1DBA2u, 0x76038C5Bu, 0x765575C8u,
+    0x76A7980Fu, 0x76F9F359u, 0x774C87CCu, 0x779F5590u, 0x77F25CCEu, 0x78459DACu,
+    0x78991854u, 0x78ECCCECu, 0x7940BB9Eu, 0x7994E492u, 0x79E947EFu, 0x7A3DE5DFu,
+    0x7A92BE8Bu, 0x7AE7D21Au, 0x7B3D20B6u, 0x7B92AA88u, 0x7BE86FBAu, 0x7C3E7073u,
+    0x7C94ACDEu, 0x7CEB2523u, 0x7D41D96Eu, 0x7D98C9E6u, 0x7DEFF6B6u, 0x7E476009u,
+    0x7E9F0606u, 0x7EF6E8DAu, 0x7F4F08AEu, 0x7FA765ADu, 0x80000000u,
+    };
+    // 2^32 / ln(2)
+    const int64_t inv_ln2_q32 = 6196328019LL;
+
+    if (x >= F16(10.3972))
+        return FIX16_MAXIMUM;
+    if (x <= F16(-11.7835))
+        return 0;
+
+    // y = x / ln(2) in Q32, split into integer n and fraction f
+    int64_t y = ((int64_t)x * inv_ln2_q32) >> 16;
+    int32_t n = (int32_t)(y >> 32);
+    uint32_t f = (uint32_t)y;
+
+    // 2^f in Q30, then scale by 2^n into Q16 (n is in -17..14)
+    uint32_t i = f >> 24;
+    uint64_t p = exp2_table[i] +
+                 (((uint64_t)(exp2_table[i + 1] - exp2_table[i]) *
+                   (f & 0xFFFFFF)) >>
+                  24);
+    int32_t shift = 14 - n;
+    return (fix16_t)((p + (((uint64_t)1 << shift) >> 1)) >> shift);
+}
+#endif
+
 static void VocAlgorithm__init_instances(VocAlgorithmParams* params);
 static void
 VocAlgorithm__mean_variance_estimator__init(VocAlgorithmParams* params);
-static void VocAlgorithm__mean_variance_estimator___init_instances(
-    VocAlgorithmParams* params);
 static void VocAlgorithm__mean_variance_estimator__set_parameters(
     VocAlgorithmParams* params, fix16_t std_initial,
     fix16_t tau_mean_variance_hours, fix16_t gating_max_duration_minutes);
@@ -300,33 +446,51 @@ VocAlgorithm__mean_variance_estimator__get_std(VocAlgorithmParams* params);
 static fix16_t
 VocAlgorithm__mean_variance_estimator__get_mean(VocAlgorithmParams* params);
 static void VocAlgorithm__mean_variance_estimator___calculate_gamma(
-    VocAlgorithmParams* params, fix16_t voc_index_from_prior);
+    fix16_t gamma, fix16_t gamma_initial_mean, fix16_t gamma_initial_variance,
+    fix16_t gating_max_duration_minutes, fix16_t* uptime_gamma,
+    fix16_t* uptime_gating, fix16_t* gating_duration_minutes,
+    fix16_t* gamma_mean, fix16_t* gamma_variance,
+    fix16_t voc_index_from_prior);
 static void VocAlgorithm__mean_variance_estimator__process(
     VocAlgorithmParams* params, fix16_t sraw, fix16_t voc_index_from_prior);
-static void VocAlgorithm__mean_variance_estimator___sigmoid__init(
-    VocAlgorithmParams* params);
-static void VocAlgorithm__mean_variance_estimator___sigmoid__set_parameters(
-    VocAlgorithmParams* params, fix16_t L, fix16_t X0, fix16_t K);
-static fix16_t VocAlgorithm__mean_variance_estimator___sigmoid__process(
-    VocAlgorithmParams* params, fix16_t sample);
+static void VocAlgorithm__mean_variance_estimator__compute(
+    fix16_t gamma, fix16_t gamma_initial_mean, fix16_t gamma_initial_variance,
+    fix16_t gating_max_duration_minutes, bool initialized, fix16_t* mean,
+    fix16_t* sraw_offset, fix16_t* std, fix16_t* uptime_gamma,
+    fix16_t* uptime_gating, fix16_t* gating_duration_minutes,
+    fix16_t* gamma_mean, fix16_t* gamma_variance, fix16_t sraw,
+    fix16_t voc_index_from_prior);
+static fix16_t VocAlgorithm__sigmoid__compute(fix16_t L, fix16_t X0, fix16_t K,
+                                              fix16_t sample);
 static void VocAlgorithm__mox_model__init(VocAlgorithmParams* params);
 static void VocAlgorithm__mox_model__set_parameters(VocAlgorithmParams* params,
                                                     fix16_t SRAW_STD,
                                                     fix16_t SRAW_MEAN);
 static fix16_t VocAlgorithm__mox_model__process(VocAlgorithmParams* params,
                                                 fix16_t sraw);
+static fix16_t VocAlgorithm__mox_model__compute(fix16_t sraw_std,
+                                                fix16_t sraw_mean,
+                                                fix16_t sraw);
 static void VocAlgorithm__sigmoid_scaled__init(VocAlgorithmParams* params);
 static void
 VocAlgorithm__sigmoid_scaled__set_parameters(VocAlgorithmParams* params,
                                              fix16_t offset);
 static fix16_t VocAlgorithm__sigmoid_scaled__process(VocAlgorithmParams* params,
                                                      fix16_t sample);
+static fix16_t VocAlgorithm__sigmoid_scaled__compute(fix16_t shift,
+                                                     fix16_t offset_scale,
+                                                     fix16_t sample);
 static void VocAlgorithm__adaptive_lowpass__init(VocAlgorithmParams* params);
 static void
 VocAlgorithm__adaptive_lowpass__set_parameters(VocAlgorithmParams* params);
 static fix16_t
 VocAlgorithm__adaptive_lowpass__process(VocAlgorithmParams* params,
                                         fix16_t sample);
+static fix16_t VocAlgorithm__adaptive_lowpass__compute(fix16_t a1, fix16_t a2,
+                                                       bool initialized,
+                                                       fix16_t* x1, fix16_t* x2,
+                                                       fix16_t* x3,
+                                                       fix16_t sample);
 
 void VocAlgorithm_init(VocAlgorithmParams* params) {
 
@@ -430,13 +594,6 @@ VocAlgorithm__mean_variance_estimator__init(VocAlgorithmParams* params) {
 
     VocAlgorithm__mean_variance_estimator__set_parameters(params, F16(0.),
                                                           F16(0.), F16(0.));
-    VocAlgorithm__mean_variance_estimator___init_instances(params);
-}
-
-static void VocAlgorithm__mean_variance_estimator___init_instances(
-    VocAlgorithmParams* params) {
-
-    VocAlgorithm__mean_variance_estimator___sigmoid__init(params);
 }
 
 static void VocAlgorithm__mean_variance_estimator__set_parameters(
@@ -494,189 +651,178 @@ VocAlgorithm__mean_variance_estimator__get_mean(VocAlgorithmParams* params) {
 }
 
 static void VocAlgorithm__mean_variance_estimator___calculate_gamma(
-    VocAlgorithmParams* params, fix16_t voc_index_from_prior) {
+    fix16_t gamma, fix16_t gamma_initial_mean, fix16_t gamma_initial_variance,
+    fix16_t gating_max_duration_minutes, fix16_t* uptime_gamma,
+    fix16_t* uptime_gating, fix16_t* gating_duration_minutes,
+    fix16_t* gamma_mean, fix16_t* gamma_variance,
+    fix16_t voc_index_from_prior) {
 
     fix16_t uptime_limit;
     fix16_t sigmoid_gamma_mean;
-    fix16_t gamma_mean;
+    fix16_t gamma_mean_ungated;
     fix16_t gating_threshold_mean;
     fix16_t sigmoid_gating_mean;
     fix16_t sigmoid_gamma_variance;
-    fix16_t gamma_variance;
+    fix16_t gamma_variance_ungated;
     fix16_t gating_threshold_variance;
     fix16_t sigmoid_gating_variance;
 
     uptime_limit = F16((VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__FIX16_MAX -
                         VocAlgorithm_SAMPLING_INTERVAL));
-    if ((params->m_Mean_Variance_Estimator___Uptime_Gamma < uptime_limit)) {
-        params->m_Mean_Variance_Estimator___Uptime_Gamma =
-            (params->m_Mean_Variance_Estimator___Uptime_Gamma +
-             F16(VocAlgorithm_SAMPLING_INTERVAL));
+    if ((*uptime_gamma < uptime_limit)) {
+        *uptime_gamma = (*uptime_gamma + F16(VocAlgorithm_SAMPLING_INTERVAL));
     }
-    if ((params->m_Mean_Variance_Estimator___Uptime_Gating < uptime_limit)) {
-        params->m_Mean_Variance_Estimator___Uptime_Gating =
-            (params->m_Mean_Variance_Estimator___Uptime_Gating +
-             F16(VocAlgorithm_SAMPLING_INTERVAL));
+    if ((*uptime_gating < uptime_limit)) {
+        *uptime_gating =
+            (*uptime_gating + F16(VocAlgorithm_SAMPLING_INTERVAL));
     }
-    VocAlgorithm__mean_variance_estimator___sigmoid__set_parameters(
-        params, F16(1.), F16(VocAlgorithm_INIT_DURATION_MEAN),
-        F16(VocAlgorithm_INIT_TRANSITION_MEAN));
-    sigmoid_gamma_mean =
-        VocAlgorithm__mean_variance_estimator___sigmoid__process(
-            params, params->m_Mean_Variance_Estimator___Uptime_Gamma);
-    gamma_mean =
-        (params->m_Mean_Variance_Estimator___Gamma +
-         (fix16_mul((params->m_Mean_Variance_Estimator___Gamma_Initial_Mean -
-                     params->m_Mean_Variance_Estimator___Gamma),
-                    sigmoid_gamma_mean)));
+    sigmoid_gamma_mean = VocAlgorithm__sigmoid__compute(
+        F16(1.), F16(VocAlgorithm_INIT_DURATION_MEAN),
+        F16(VocAlgorithm_INIT_TRANSITION_MEAN), *uptime_gamma);
+    gamma_mean_ungated =
+        (gamma +
+         (fix16_mul((gamma_initial_mean - gamma), sigmoid_gamma_mean)));
     gating_threshold_mean =
         (F16(VocAlgorithm_GATING_THRESHOLD) +
-         (fix16_mul(
-             F16((VocAlgorithm_GATING_THRESHOLD_INITIAL -
-                  VocAlgorithm_GATING_THRESHOLD)),
-             VocAlgorithm__mean_variance_estimator___sigmoid__process(
-                 params, params->m_Mean_Variance_Estimator___Uptime_Gating))));
-    VocAlgorithm__mean_variance_estimator___sigmoid__set_parameters(
-        params, F16(1.), gating_threshold_mean,
-        F16(VocAlgorithm_GATING_THRESHOLD_TRANSITION));
-    sigmoid_gating_mean =
-        VocAlgorithm__mean_variance_estimator___sigmoid__process(
-            params, voc_index_from_prior);
-    params->m_Mean_Variance_Estimator__Gamma_Mean =
-        (fix16_mul(sigmoid_gating_mean, gamma_mean));
-    VocAlgorithm__mean_variance_estimator___sigmoid__set_parameters(
-        params, F16(1.), F16(VocAlgorithm_INIT_DURATION_VARIANCE),
-        F16(VocAlgorithm_INIT_TRANSITION_VARIANCE));
-    sigmoid_gamma_variance =
-        VocAlgorithm__mean_variance_estimator___sigmoid__process(
-            params, params->m_Mean_Variance_Estimator___Uptime_Gamma);
-    gamma_variance =
-        (params->m_Mean_Variance_Estimator___Gamma +
-         (fix16_mul(
-             (params->m_Mean_Variance_Estimator___Gamma_Initial_Variance -
-              params->m_Mean_Variance_Estimator___Gamma),
-             (sigmoid_gamma_variance - sigmoid_gamma_mean))));
+         (fix16_mul(F16((VocAlgorithm_GATING_THRESHOLD_INITIAL -
+                         VocAlgorithm_GATING_THRESHOLD)),
+                    VocAlgorithm__sigmoid__compute(
+                        F16(1.), F16(VocAlgorithm_INIT_DURATION_MEAN),
+                        F16(VocAlgorithm_INIT_TRANSITION_MEAN),
+                        *uptime_gating))));
+    sigmoid_gating_mean = VocAlgorithm__sigmoid__compute(
+        F16(1.), gating_threshold_mean,
+        F16(VocAlgorithm_GATING_THRESHOLD_TRANSITION), voc_index_from_prior);
+    *gamma_mean = (fix16_mul(sigmoid_gating_mean, gamma_mean_ungated));
+    sigmoid_gamma_variance = VocAlgorithm__sigmoid__compute(
+        F16(1.), F16(VocAlgorithm_INIT_DURATION_VARIANCE),
+        F16(VocAlgorithm_INIT_TRANSITION_VARIANCE), *uptime_gamma);
+    gamma_variance_ungated =
+        (gamma + (fix16_mul((gamma_initial_variance - gamma),
+                            (sigmoid_gamma_variance - sigmoid_gamma_mean))));
     gating_threshold_variance =
         (F16(VocAlgorithm_GATING_THRESHOLD) +
-         (fix16_mul(
-             F16((VocAlgorithm_GATING_THRESHOLD_INITIAL -
-                  VocAlgorithm_GATING_THRESHOLD)),
-             VocAlgorithm__mean_variance_estimator___sigmoid__process(
-                 params, params->m_Mean_Variance_Estimator___Uptime_Gating))));
-    VocAlgorithm__mean_variance_estimator___sigmoid__set_parameters(
-        params, F16(1.), gating_threshold_variance,
-        F16(VocAlgorithm_GATING_THRESHOLD_TRANSITION));
-    sigmoid_gating_variance =
-        VocAlgorithm__mean_variance_estimator___sigmoid__process(
-            params, voc_index_from_prior);
-    params->m_Mean_Variance_Estimator__Gamma_Variance =
-        (fix16_mul(sigmoid_gating_variance, gamma_variance));
-    params->m_Mean_Variance_Estimator___Gating_Duration_Minutes =
-        (params->m_Mean_Variance_Estimator___Gating_Duration_Minutes +
+         (fix16_mul(F16((VocAlgorithm_GATING_THRESHOLD_INITIAL -
+                         VocAlgorithm_GATING_THRESHOLD)),
+                    VocAlgorithm__sigmoid__compute(
+                        F16(1.), F16(VocAlgorithm_INIT_DURATION_VARIANCE),
+                        F16(VocAlgorithm_INIT_TRANSITION_VARIANCE),
+                        *uptime_gating))));
+    sigmoid_gating_variance = VocAlgorithm__sigmoid__compute(
+        F16(1.), gating_threshold_variance,
+        F16(VocAlgorithm_GATING_THRESHOLD_TRANSITION), voc_index_from_prior);
+    *gamma_variance =
+        (fix16_mul(sigmoid_gating_variance, gamma_variance_ungated));
+    *gating_duration_minutes =
+        (*gating_duration_minutes +
          (fix16_mul(F16((VocAlgorithm_SAMPLING_INTERVAL / 60.)),
                     ((fix16_mul((F16(1.) - sigmoid_gating_mean),
                                 F16((1. + VocAlgorithm_GATING_MAX_RATIO)))) -
                      F16(VocAlgorithm_GATING_MAX_RATIO)))));
-    if ((params->m_Mean_Variance_Estimator___Gating_Duration_Minutes <
-         F16(0.))) {
-        params->m_Mean_Variance_Estimator___Gating_Duration_Minutes = F16(0.);
+    if ((*gating_duration_minutes < F16(0.))) {
+        *gating_duration_minutes = F16(0.);
     }
-    if ((params->m_Mean_Variance_Estimator___Gating_Duration_Minutes >
-         params->m_Mean_Variance_Estimator__Gating_Max_Duration_Minutes)) {
-        params->m_Mean_Variance_Estimator___Uptime_Gating = F16(0.);
+    if ((*gating_duration_minutes > gating_max_duration_minutes)) {
+        *uptime_gating = F16(0.);
     }
 }
 
 static void VocAlgorithm__mean_variance_estimator__process(
     VocAlgorithmParams* params, fix16_t sraw, fix16_t voc_index_from_prior) {
 
+    VocAlgorithm__mean_variance_estimator__compute(
+        params->m_Mean_Variance_Estimator___Gamma,
+        params->m_Mean_Variance_Estimator___Gamma_Initial_Mean,
+        params->m_Mean_Variance_Estimator___Gamma_Initial_Variance,
+        params->m_Mean_Variance_Estimator__Gating_Max_Duration_Minutes,
+        params->m_Mean_Variance_Estimator___Initialized,
+        &params->m_Mean_Variance_Estimator___Mean,
+        &params->m_Mean_Variance_Estimator___Sraw_Offset,
+        &params->m_Mean_Variance_Estimator___Std,
+        &params->m_Mean_Variance_Estimator___Uptime_Gamma,
+        &params->m_Mean_Variance_Estimator___Uptime_Gating,
+        &params->m_Mean_Variance_Estimator___Gating_Duration_Minutes,
+        &params->m_Mean_Variance_Estimator__Gamma_Mean,
+        &params->m_Mean_Variance_Estimator__Gamma_Variance, sraw,
+        voc_index_from_prior);
+    params->m_Mean_Variance_Estimator___Initialized = true;
+}
+
+/* Shared by VocAlgorithm_process() and VocAlgorithm_process_batch(): the
+ * per-stream states are passed by pointer, the tuning-derived constants by
+ * value. */
+static void VocAlgorithm__mean_variance_estimator__compute(
+    fix16_t gamma, fix16_t gamma_initial_mean, fix16_t gamma_initial_variance,
+    fix16_t gating_max_duration_minutes, bool initialized, fix16_t* mean,
+    fix16_t* sraw_offset, fix16_t* std, fix16_t* uptime_gamma,
+    fix16_t* uptime_gating, fix16_t* gating_duration_minutes,
+    fix16_t* gamma_mean, fix16_t* gamma_variance, fix16_t sraw,
+    fix16_t voc_index_from_prior) {
+
     fix16_t delta_sgp;
     fix16_t c;
     fix16_t additional_scaling;
+    int32_t additional_scaling_shift; /* additional_scaling = 2^shift */
 
-    if ((params->m_Mean_Variance_Estimator___Initialized == false)) {
-        params->m_Mean_Variance_Estimator___Initialized = true;
-        params->m_Mean_Variance_Estimator___Sraw_Offset = sraw;
-        params->m_Mean_Variance_Estimator___Mean = F16(0.);
+    if ((initialized == false)) {
+        *sraw_offset = sraw;
+        *mean = F16(0.);
     } else {
-        if (((params->m_Mean_Variance_Estimator___Mean >= F16(100.)) ||
-             (params->m_Mean_Variance_Estimator___Mean <= F16(-100.)))) {
-            params->m_Mean_Variance_Estimator___Sraw_Offset =
-                (params->m_Mean_Variance_Estimator___Sraw_Offset +
-                 params->m_Mean_Variance_Estimator___Mean);
-            params->m_Mean_Variance_Estimator___Mean = F16(0.);
+        if (((*mean >= F16(100.)) || (*mean <= F16(-100.)))) {
+            *sraw_offset = (*sraw_offset + *mean);
+            *mean = F16(0.);
         }
-        sraw = (sraw - params->m_Mean_Variance_Estimator___Sraw_Offset);
+        sraw = (sraw - *sraw_offset);
         VocAlgorithm__mean_variance_estimator___calculate_gamma(
-            params, voc_index_from_prior);
-        delta_sgp = (fix16_div(
-            (sraw - params->m_Mean_Variance_Estimator___Mean),
-            F16(VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING)));
+            gamma, gamma_initial_mean, gamma_initial_variance,
+            gating_max_duration_minutes, uptime_gamma, uptime_gating,
+            gating_duration_minutes, gamma_mean, gamma_variance,
+            voc_index_from_prior);
+        delta_sgp = fix16_div_pow2(
+            (sraw - *mean),
+            VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING_SHIFT);
         if ((delta_sgp < F16(0.))) {
-            c = (params->m_Mean_Variance_Estimator___Std - delta_sgp);
+            c = (*std - delta_sgp);
         } else {
-            c = (params->m_Mean_Variance_Estimator___Std + delta_sgp);
+            c = (*std + delta_sgp);
         }
         additional_scaling = F16(1.);
+        additional_scaling_shift = 0;
         if ((c > F16(1440.))) {
             additional_scaling = F16(4.);
+            additional_scaling_shift = 2;
         }
-        params->m_Mean_Variance_Estimator___Std = (fix16_mul(
+        *std = (fix16_mul(
             fix16_sqrt((fix16_mul(
                 additional_scaling,
                 (F16(VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING) -
-                 params->m_Mean_Variance_Estimator__Gamma_Variance)))),
+                 *gamma_variance)))),
             fix16_sqrt((
                 (fix16_mul(
-                    params->m_Mean_Variance_Estimator___Std,
-                    (fix16_div(
-                        params->m_Mean_Variance_Estimator___Std,
-                        (fix16_mul(
-                            F16(VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING),
-                            additional_scaling)))))) +
-                (fix16_mul(
-                    (fix16_div(
-                        (fix16_mul(
-                            params->m_Mean_Variance_Estimator__Gamma_Variance,
-                            delta_sgp)),
-                        additional_scaling)),
-                    delta_sgp))))));
-        params->m_Mean_Variance_Estimator___Mean =
-            (params->m_Mean_Variance_Estimator___Mean +
-             (fix16_mul(params->m_Mean_Variance_Estimator__Gamma_Mean,
-                        delta_sgp)));
+                    *std,
+                    fix16_div_pow2(
+                        *std,
+                        (VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING_SHIFT +
+                         additional_scaling_shift)))) +
+                (fix16_mul(fix16_div_pow2((fix16_mul(*gamma_variance, delta_sgp)),
+                                          additional_scaling_shift),
+                           delta_sgp))))));
+        *mean = (*mean + (fix16_mul(*gamma_mean, delta_sgp)));
     }
 }
 
-static void VocAlgorithm__mean_variance_estimator___sigmoid__init(
-    VocAlgorithmParams* params) {
-
-    VocAlgorithm__mean_variance_estimator___sigmoid__set_parameters(
-        params, F16(0.), F16(0.), F16(0.));
-}
-
-static void VocAlgorithm__mean_variance_estimator___sigmoid__set_parameters(
-    VocAlgorithmParams* params, fix16_t L, fix16_t X0, fix16_t K) {
-
-    params->m_Mean_Variance_Estimator___Sigmoid__L = L;
-    params->m_Mean_Variance_Estimator___Sigmoid__K = K;
-    params->m_Mean_Variance_Estimator___Sigmoid__X0 = X0;
-}
-
-static fix16_t VocAlgorithm__mean_variance_estimator___sigmoid__process(
-    VocAlgorithmParams* params, fix16_t sample) {
+static fix16_t VocAlgorithm__sigmoid__compute(fix16_t L, fix16_t X0, fix16_t K,
+                                              fix16_t sample) {
 
     fix16_t x;
 
-    x = (fix16_mul(params->m_Mean_Variance_Estimator___Sigmoid__K,
-                   (sample - params->m_Mean_Variance_Estimator___Sigmoid__X0)));
+    x = (fix16_mul(K, (sample - X0)));
     if ((x < F16(-50.))) {
-        return params->m_Mean_Variance_Estimator___Sigmoid__L;
+        return L;
     } else if ((x > F16(50.))) {
         return F16(0.);
     } else {
-        return (fix16_div(params->m_Mean_Variance_Estimator___Sigmoid__L,
-                          (F16(1.) + fix16_exp(x))));
+        return (fix16_div(L, (F16(1.) + fix16_exp(x))));
     }
 }
 
@@ -696,8 +842,16 @@ static void VocAlgorithm__mox_model__set_parameters(VocAlgorithmParams* params,
 static fix16_t VocAlgorithm__mox_model__process(VocAlgorithmParams* params,
                                                 fix16_t sraw) {
 
-    return (fix16_mul((fix16_div((sraw - params->m_Mox_Model__Sraw_Mean),
-                                 (-(params->m_Mox_Model__Sraw_Std +
+    return VocAlgorithm__mox_model__compute(
+        params->m_Mox_Model__Sraw_Std, params->m_Mox_Model__Sraw_Mean, sraw);
+}
+
+static fix16_t VocAlgorithm__mox_model__compute(fix16_t sraw_std,
+                                                fix16_t sraw_mean,
+                                                fix16_t sraw) {
+
+    return (fix16_mul((fix16_div((sraw - sraw_mean),
+                                 (-(sraw_std +
                                     F16(VocAlgorithm_SRAW_STD_BONUS))))),
                       F16(VocAlgorithm_VOC_INDEX_GAIN)));
 }
@@ -712,13 +866,26 @@ VocAlgorithm__sigmoid_scaled__set_parameters(VocAlgorithmParams* params,
                                              fix16_t offset) {
 
     params->m_Sigmoid_Scaled__Offset = offset;
+    params->m_Sigmoid_Scaled__Shift =
+        (fix16_div((F16(VocAlgorithm_SIGMOID_L) - (fix16_mul(F16(5.), offset))),
+                   F16(4.)));
+    params->m_Sigmoid_Scaled__Offset_Scale =
+        (fix16_div(offset, F16(VocAlgorithm_VOC_INDEX_OFFSET_DEFAULT)));
 }
 
 static fix16_t VocAlgorithm__sigmoid_scaled__process(VocAlgorithmParams* params,
                                                      fix16_t sample) {
 
+    return VocAlgorithm__sigmoid_scaled__compute(
+        params->m_Sigmoid_Scaled__Shift, params->m_Sigmoid_Scaled__Offset_Scale,
+        sample);
+}
+
+static fix16_t VocAlgorithm__sigmoid_scaled__compute(fix16_t shift,
+                                                     fix16_t offset_scale,
+                                                     fix16_t sample) {
+
     fix16_t x;
-    fix16_t shift;
 
     x = (fix16_mul(F16(VocAlgorithm_SIGMOID_K),
                    (sample - F16(VocAlgorithm_SIGMOID_X0))));
@@ -728,19 +895,13 @@ static fix16_t VocAlgorithm__sigmoid_scaled__process(VocAlgorithmParams* params,
         return F16(0.);
     } else {
         if ((sample >= F16(0.))) {
-            shift = (fix16_div(
-                (F16(VocAlgorithm_SIGMOID_L) -
-                 (fix16_mul(F16(5.), params->m_Sigmoid_Scaled__Offset))),
-                F16(4.)));
             return ((fix16_div((F16(VocAlgorithm_SIGMOID_L) + shift),
                                (F16(1.) + fix16_exp(x)))) -
                     shift);
         } else {
-            return (fix16_mul(
-                (fix16_div(params->m_Sigmoid_Scaled__Offset,
-                           F16(VocAlgorithm_VOC_INDEX_OFFSET_DEFAULT))),
-                (fix16_div(F16(VocAlgorithm_SIGMOID_L),
-                           (F16(1.) + fix16_exp(x))))));
+            return (fix16_mul(offset_scale,
+                              (fix16_div(F16(VocAlgorithm_SIGMOID_L),
+                                         (F16(1.) + fix16_exp(x))))));
         }
     }
 }
@@ -766,27 +927,34 @@ static fix16_t
 VocAlgorithm__adaptive_lowpass__process(VocAlgorithmParams* params,
                                         fix16_t sample) {
 
+    sample = VocAlgorithm__adaptive_lowpass__compute(
+        params->m_Adaptive_Lowpass__A1, params->m_Adaptive_Lowpass__A2,
+        params->m_Adaptive_Lowpass___Initialized,
+        &params->m_Adaptive_Lowpass___X1, &params->m_Adaptive_Lowpass___X2,
+        &params->m_Adaptive_Lowpass___X3, sample);
+    params->m_Adaptive_Lowpass___Initialized = true;
+    return sample;
+}
+
+static fix16_t VocAlgorithm__adaptive_lowpass__compute(fix16_t a1, fix16_t a2,
+                                                       bool initialized,
+                                                       fix16_t* x1, fix16_t* x2,
+                                                       fix16_t* x3,
+                                                       fix16_t sample) {
+
     fix16_t abs_delta;
     fix16_t F1;
     fix16_t tau_a;
     fix16_t a3;
 
-    if ((params->m_Adaptive_Lowpass___Initialized == false)) {
-        params->m_Adaptive_Lowpass___X1 = sample;
-        params->m_Adaptive_Lowpass___X2 = sample;
-        params->m_Adaptive_Lowpass___X3 = sample;
-        params->m_Adaptive_Lowpass___Initialized = true;
+    if ((initialized == false)) {
+        *x1 = sample;
+        *x2 = sample;
+        *x3 = sample;
     }
-    params->m_Adaptive_Lowpass___X1 =
-        ((fix16_mul((F16(1.) - params->m_Adaptive_Lowpass__A1),
-                    params->m_Adaptive_Lowpass___X1)) +
-         (fix16_mul(params->m_Adaptive_Lowpass__A1, sample)));
-    params->m_Adaptive_Lowpass___X2 =
-        ((fix16_mul((F16(1.) - params->m_Adaptive_Lowpass__A2),
-                    params->m_Adaptive_Lowpass___X2)) +
-         (fix16_mul(params->m_Adaptive_Lowpass__A2, sample)));
-    abs_delta =
-        (params->m_Adaptive_Lowpass___X1 - params->m_Adaptive_Lowpass___X2);
+    *x1 = ((fix16_mul((F16(1.) - a1), *x1)) + (fix16_mul(a1, sample)));
+    *x2 = ((fix16_mul((F16(1.) - a2), *x2)) + (fix16_mul(a2, sample)));
+    abs_delta = (*x1 - *x2);
     if ((abs_delta < F16(0.))) {
         abs_delta = (-abs_delta);
     }
@@ -797,8 +965,225 @@ VocAlgorithm__adaptive_lowpass__process(VocAlgorithmParams* params,
          F16(VocAlgorithm_LP_TAU_FAST));
     a3 = (fix16_div(F16(VocAlgorithm_SAMPLING_INTERVAL),
                     (F16(VocAlgorithm_SAMPLING_INTERVAL) + tau_a)));
-    params->m_Adaptive_Lowpass___X3 =
-        ((fix16_mul((F16(1.) - a3), params->m_Adaptive_Lowpass___X3)) +
-         (fix16_mul(a3, sample)));
-    return params->m_Adaptive_Lowpass___X3;
+    *x3 = ((fix16_mul((F16(1.) - a3), *x3)) + (fix16_mul(a3, sample)));
+    return *x3;
+}
+
+static void VocAlgorithm__batch__init_instances(VocAlgorithmBatchParams* params);
+
+void VocAlgorithm_batch_init(VocAlgorithmBatchParams* params, int32_t* buffer,
+                             int32_t streams) {
+
+    params->mStreams = streams;
+    params->mUptime = &buffer[0 * streams];
+    params->mSraw = &buffer[1 * streams];
+    params->mVoc_Index = &buffer[2 * streams];
+    params->m_Mean_Variance_Estimator___Initialized = &buffer[3 * streams];
+    params->m_Mean_Variance_Estimator___Mean = &buffer[4 * streams];
+    params->m_Mean_Variance_Estimator___Sraw_Offset = &buffer[5 * streams];
+    params->m_Mean_Variance_Estimator___Std = &buffer[6 * streams];
+    params->m_Mean_Variance_Estimator___Uptime_Gamma = &buffer[7 * streams];
+    params->m_Mean_Variance_Estimator___Uptime_Gating = &buffer[8 * streams];
+    params->m_Mean_Variance_Estimator___Gating_Duration_Minutes =
+        &buffer[9 * streams];
+    params->m_Mox_Model__Sraw_Std = &buffer[10 * streams];
+    params->m_Mox_Model__Sraw_Mean = &buffer[11 * streams];
+    params->m_Adaptive_Lowpass___Initialized = &buffer[12 * streams];
+    params->m_Adaptive_Lowpass___X1 = &buffer[13 * streams];
+    params->m_Adaptive_Lowpass___X2 = &buffer[14 * streams];
+    params->m_Adaptive_Lowpass___X3 = &buffer[15 * streams];
+
+    params->mVoc_Index_Offset = F16(VocAlgorithm_VOC_INDEX_OFFSET_DEFAULT);
+    params->mTau_Mean_Variance_Hours =
+        F16(VocAlgorithm_TAU_MEAN_VARIANCE_HOURS);
+    params->mGating_Max_Duration_Minutes =
+        F16(VocAlgorithm_GATING_MAX_DURATION_MINUTES);
+    params->mSraw_Std_Initial = F16(VocAlgorithm_SRAW_STD_INITIAL);
+    for (int32_t i = 0; i < streams; i++) {
+        params->mUptime[i] = F16(0.);
+        params->mSraw[i] = F16(0.);
+        params->mVoc_Index[i] = 0;
+    }
+    VocAlgorithm__batch__init_instances(params);
+}
+
+static void
+VocAlgorithm__batch__init_instances(VocAlgorithmBatchParams* params) {
+
+    params->m_Mean_Variance_Estimator___Gamma =
+        (fix16_div(F16((VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING *
+                        (VocAlgorithm_SAMPLING_INTERVAL / 3600.))),
+                   (params->mTau_Mean_Variance_Hours +
+                    F16((VocAlgorithm_SAMPLING_INTERVAL / 3600.)))));
+    params->m_Mean_Variance_Estimator___Gamma_Initial_Mean =
+        F16(((VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING *
+              VocAlgorithm_SAMPLING_INTERVAL) /
+             (VocAlgorithm_TAU_INITIAL_MEAN + VocAlgorithm_SAMPLING_INTERVAL)));
+    params->m_Mean_Variance_Estimator___Gamma_Initial_Variance = F16(
+        ((VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING *
+          VocAlgorithm_SAMPLING_INTERVAL) /
+         (VocAlgorithm_TAU_INITIAL_VARIANCE + VocAlgorithm_SAMPLING_INTERVAL)));
+    params->m_Sigmoid_Scaled__Offset = params->mVoc_Index_Offset;
+    params->m_Sigmoid_Scaled__Shift =
+        (fix16_div((F16(VocAlgorithm_SIGMOID_L) -
+                    (fix16_mul(F16(5.), params->m_Sigmoid_Scaled__Offset))),
+                   F16(4.)));
+    params->m_Sigmoid_Scaled__Offset_Scale =
+        (fix16_div(params->m_Sigmoid_Scaled__Offset,
+                   F16(VocAlgorithm_VOC_INDEX_OFFSET_DEFAULT)));
+    params->m_Adaptive_Lowpass__A1 =
+        F16((VocAlgorithm_SAMPLING_INTERVAL /
+             (VocAlgorithm_LP_TAU_FAST + VocAlgorithm_SAMPLING_INTERVAL)));
+    params->m_Adaptive_Lowpass__A2 =
+        F16((VocAlgorithm_SAMPLING_INTERVAL /
+             (VocAlgorithm_LP_TAU_SLOW + VocAlgorithm_SAMPLING_INTERVAL)));
+
+    for (int32_t i = 0; i < params->mStreams; i++) {
+        params->m_Mean_Variance_Estimator___Initialized[i] = false;
+        params->m_Mean_Variance_Estimator___Mean[i] = F16(0.);
+        params->m_Mean_Variance_Estimator___Sraw_Offset[i] = F16(0.);
+        params->m_Mean_Variance_Estimator___Std[i] = params->mSraw_Std_Initial;
+        params->m_Mean_Variance_Estimator___Uptime_Gamma[i] = F16(0.);
+        params->m_Mean_Variance_Estimator___Uptime_Gating[i] = F16(0.);
+        params->m_Mean_Variance_Estimator___Gating_Duration_Minutes[i] =
+            F16(0.);
+        params->m_Mox_Model__Sraw_Std[i] = params->mSraw_Std_Initial;
+        params->m_Mox_Model__Sraw_Mean[i] = F16(0.);
+        params->m_Adaptive_Lowpass___Initialized[i] = false;
+    }
+}
+
+void VocAlgorithm_batch_get_states(VocAlgorithmBatchParams* params,
+                                   int32_t stream, int32_t* state0,
+                                   int32_t* state1) {
+
+    *state0 = (params->m_Mean_Variance_Estimator___Mean[stream] +
+               params->m_Mean_Variance_Estimator___Sraw_Offset[stream]);
+    *state1 = params->m_Mean_Variance_Estimator___Std[stream];
+    return;
+}
+
+void VocAlgorithm_batch_set_states(VocAlgorithmBatchParams* params,
+                                   int32_t stream, int32_t state0,
+                                   int32_t state1) {
+
+    params->m_Mean_Variance_Estimator___Mean[stream] = state0;
+    params->m_Mean_Variance_Estimator___Std[stream] = state1;
+    params->m_Mean_Variance_Estimator___Uptime_Gamma[stream] =
+        F16(VocAlgorithm_PERSISTENCE_UPTIME_GAMMA);
+    params->m_Mean_Variance_Estimator___Initialized[stream] = true;
+    params->mSraw[stream] = state0;
+}
+
+void VocAlgorithm_batch_set_tuning_parameters(
+    VocAlgorithmBatchParams* params, int32_t voc_index_offset,
+    int32_t learning_time_hours, int32_t gating_max_duration_minutes,
+    int32_t std_initial) {
+
+    params->mVoc_Index_Offset = (fix16_from_int(voc_index_offset));
+    params->mTau_Mean_Variance_Hours = (fix16_from_int(learning_time_hours));
+    params->mGating_Max_Duration_Minutes =
+        (fix16_from_int(gating_max_duration_minutes));
+    params->mSraw_Std_Initial = (fix16_from_int(std_initial));
+    VocAlgorithm__batch__init_instances(params);
+}
+
+void VocAlgorithm_process_batch(VocAlgorithmBatchParams* params,
+                                const int32_t* sraw, int32_t* voc_index) {
+
+    bool active[VocAlgorithm_BATCH_BLOCK_SIZE];
+    fix16_t sample[VocAlgorithm_BATCH_BLOCK_SIZE];
+
+    for (int32_t base = 0; base < params->mStreams;
+         base += VocAlgorithm_BATCH_BLOCK_SIZE) {
+        int32_t n = params->mStreams - base;
+        if (n > VocAlgorithm_BATCH_BLOCK_SIZE) {
+            n = VocAlgorithm_BATCH_BLOCK_SIZE;
+        }
+        fix16_t* uptime = &params->mUptime[base];
+        fix16_t* msraw = &params->mSraw[base];
+        fix16_t* index = &params->mVoc_Index[base];
+        fix16_t* x1 = &params->m_Adaptive_Lowpass___X1[base];
+        fix16_t* x2 = &params->m_Adaptive_Lowpass___X2[base];
+        fix16_t* x3 = &params->m_Adaptive_Lowpass___X3[base];
+        int32_t* lp_initialized = &params->m_Adaptive_Lowpass___Initialized[base];
+
+        /* Initial blackout and input clamping */
+        for (int32_t j = 0; j < n; j++) {
+            active[j] = !(uptime[j] <= F16(VocAlgorithm_INITIAL_BLACKOUT));
+            if (!active[j]) {
+                uptime[j] = (uptime[j] + F16(VocAlgorithm_SAMPLING_INTERVAL));
+                continue;
+            }
+            int32_t s = sraw[base + j];
+            if (((s > 0) && (s < 65000))) {
+                if ((s < 20001)) {
+                    s = 20001;
+                } else if ((s > 52767)) {
+                    s = 52767;
+                }
+                msraw[j] = (fix16_from_int((s - 20000)));
+            }
+        }
+
+        /* MOX model and scaled sigmoid */
+        for (int32_t j = 0; j < n; j++) {
+            if (!active[j]) {
+                continue;
+            }
+            sample[j] = VocAlgorithm__sigmoid_scaled__compute(
+                params->m_Sigmoid_Scaled__Shift,
+                params->m_Sigmoid_Scaled__Offset_Scale,
+                VocAlgorithm__mox_model__compute(
+                    params->m_Mox_Model__Sraw_Std[base + j],
+                    params->m_Mox_Model__Sraw_Mean[base + j], msraw[j]));
+        }
+
+        /* Adaptive lowpass */
+        for (int32_t j = 0; j < n; j++) {
+            if (!active[j]) {
+                continue;
+            }
+            index[j] = VocAlgorithm__adaptive_lowpass__compute(
+                params->m_Adaptive_Lowpass__A1, params->m_Adaptive_Lowpass__A2,
+                lp_initialized[j], &x1[j], &x2[j], &x3[j], sample[j]);
+            lp_initialized[j] = true;
+            if ((index[j] < F16(0.5))) {
+                index[j] = F16(0.5);
+            }
+        }
+
+        /* Mean/variance estimator and MOX model update */
+        for (int32_t j = 0; j < n; j++) {
+            if (!active[j] || !(msraw[j] > F16(0.))) {
+                continue;
+            }
+            int32_t i = base + j;
+            fix16_t gamma_mean;
+            fix16_t gamma_variance;
+            VocAlgorithm__mean_variance_estimator__compute(
+                params->m_Mean_Variance_Estimator___Gamma,
+                params->m_Mean_Variance_Estimator___Gamma_Initial_Mean,
+                params->m_Mean_Variance_Estimator___Gamma_Initial_Variance,
+                params->mGating_Max_Duration_Minutes,
+                params->m_Mean_Variance_Estimator___Initialized[i],
+                &params->m_Mean_Variance_Estimator___Mean[i],
+                &params->m_Mean_Variance_Estimator___Sraw_Offset[i],
+                &params->m_Mean_Variance_Estimator___Std[i],
+                &params->m_Mean_Variance_Estimator___Uptime_Gamma[i],
+                &params->m_Mean_Variance_Estimator___Uptime_Gating[i],
+                &params->m_Mean_Variance_Estimator___Gating_Duration_Minutes[i],
+                &gamma_mean, &gamma_variance, msraw[j], index[j]);
+            params->m_Mean_Variance_Estimator___Initialized[i] = true;
+            params->m_Mox_Model__Sraw_Std[i] =
+                params->m_Mean_Variance_Estimator___Std[i];
+            params->m_Mox_Model__Sraw_Mean[i] =
+                (params->m_Mean_Variance_Estimator___Mean[i] +
+                 params->m_Mean_Variance_Estimator___Sraw_Offset[i]);
+        }
+
+        for (int32_t j = 0; j < n; j++) {
+            voc_index[base + j] = (fix16_cast_to_int((index[j] + F16(0.5))));
+        }
+    }
 }
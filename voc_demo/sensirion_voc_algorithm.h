@@ -69,6 +69,8 @@ typedef int32_t fix16_t;
 #define VocAlgorithm_LP_ALPHA (-0.2)
 #define VocAlgorithm_PERSISTENCE_UPTIME_GAMMA ((3. * 3600.))
 #define VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING (64.)
+/* 2^6 = VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING */
+#define VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__GAMMA_SCALING_SHIFT (6)
 #define VocAlgorithm_MEAN_VARIANCE_ESTIMATOR__FIX16_MAX (32767.)
 
 /**
@@ -95,12 +97,11 @@ typedef struct {
   fix16_t m_Mean_Variance_Estimator___Uptime_Gamma;
   fix16_t m_Mean_Variance_Estimator___Uptime_Gating;
   fix16_t m_Mean_Variance_Estimator___Gating_Duration_Minutes;
-  fix16_t m_Mean_Variance_Estimator___Sigmoid__L;
-  fix16_t m_Mean_Variance_Estimator___Sigmoid__K;
-  fix16_t m_Mean_Variance_Estimator___Sigmoid__X0;
   fix16_t m_Mox_Model__Sraw_Std;
   fix16_t m_Mox_Model__Sraw_Mean;
   fix16_t m_Sigmoid_Scaled__Offset;
+  fix16_t m_Sigmoid_Scaled__Shift;
+  fix16_t m_Sigmoid_Scaled__Offset_Scale;
   fix16_t m_Adaptive_Lowpass__A1;
   fix16_t m_Adaptive_Lowpass__A2;
   bool m_Adaptive_Lowpass___Initialized;
@@ -179,4 +180,120 @@ void VocAlgorithm_set_tuning_parameters(VocAlgorithmParams *params,
 void VocAlgorithm_process(VocAlgorithmParams *params, int32_t sraw,
                           int32_t *voc_index);
 
+/**
+ * Number of streams processed per block by VocAlgorithm_process_batch().
+ * Per-stream flags for one block live on the stack.
+ */
+#define VocAlgorithm_BATCH_BLOCK_SIZE (64)
+
+/**
+ * Number of per-stream state arrays held by VocAlgorithmBatchParams.
+ */
+#define VocAlgorithm_BATCH_STATE_ARRAYS (16)
+
+/**
+ * Size in int32_t words of the buffer required by VocAlgorithm_batch_init()
+ * for a batch of n streams.
+ */
+#define VocAlgorithm_BATCH_BUFFER_WORDS(n)                                     \
+  ((n) * VocAlgorithm_BATCH_STATE_ARRAYS)
+
+/**
+ * Struct to hold the states of several VOC algorithm streams in
+ * struct-of-arrays form. All streams share one set of tuning parameters; every
+ * per-stream field points to an array of mStreams entries carved out of the
+ * buffer passed to VocAlgorithm_batch_init().
+ */
+typedef struct {
+  int32_t mStreams;
+  fix16_t mVoc_Index_Offset;
+  fix16_t mTau_Mean_Variance_Hours;
+  fix16_t mGating_Max_Duration_Minutes;
+  fix16_t mSraw_Std_Initial;
+  fix16_t m_Mean_Variance_Estimator___Gamma;
+  fix16_t m_Mean_Variance_Estimator___Gamma_Initial_Mean;
+  fix16_t m_Mean_Variance_Estimator___Gamma_Initial_Variance;
+  fix16_t m_Sigmoid_Scaled__Offset;
+  fix16_t m_Sigmoid_Scaled__Shift;
+  fix16_t m_Sigmoid_Scaled__Offset_Scale;
+  fix16_t m_Adaptive_Lowpass__A1;
+  fix16_t m_Adaptive_Lowpass__A2;
+  fix16_t *mUptime;
+  fix16_t *mSraw;
+  fix16_t *mVoc_Index;
+  int32_t *m_Mean_Variance_Estimator___Initialized;
+  fix16_t *m_Mean_Variance_Estimator___Mean;
+  fix16_t *m_Mean_Variance_Estimator___Sraw_Offset;
+  fix16_t *m_Mean_Variance_Estimator___Std;
+  fix16_t *m_Mean_Variance_Estimator___Uptime_Gamma;
+  fix16_t *m_Mean_Variance_Estimator___Uptime_Gating;
+  fix16_t *m_Mean_Variance_Estimator___Gating_Duration_Minutes;
+  fix16_t *m_Mox_Model__Sraw_Std;
+  fix16_t *m_Mox_Model__Sraw_Mean;
+  int32_t *m_Adaptive_Lowpass___Initialized;
+  fix16_t *m_Adaptive_Lowpass___X1;
+  fix16_t *m_Adaptive_Lowpass___X2;
+  fix16_t *m_Adaptive_Lowpass___X3;
+} VocAlgorithmBatchParams;
+
+/**
+ * Initialize a batch of VOC algorithm streams. Equivalent to calling
+ * VocAlgorithm_init() on every stream.
+ *
+ * @param params    Pointer to the VocAlgorithmBatchParams struct
+ * @param buffer    Storage for the per-stream states, at least
+ *                  VocAlgorithm_BATCH_BUFFER_WORDS(streams) words. Must stay
+ *                  valid as long as params is used.
+ * @param streams   Number of streams in the batch
+ */
+void VocAlgorithm_batch_init(VocAlgorithmBatchParams *params, int32_t *buffer,
+                             int32_t streams);
+
+/**
+ * Get current algorithm states of one stream of a batch. See
+ * VocAlgorithm_get_states().
+ * @param params    Pointer to the VocAlgorithmBatchParams struct
+ * @param stream    Index of the stream
+ * @param state0    State0 to be stored
+ * @param state1    State1 to be stored
+ */
+void VocAlgorithm_batch_get_states(VocAlgorithmBatchParams *params,
+                                   int32_t stream, int32_t *state0,
+                                   int32_t *state1);
+
+/**
+ * Restore previously retrieved states of one stream of a batch. See
+ * VocAlgorithm_set_states().
+ * @param params    Pointer to the VocAlgorithmBatchParams struct
+ * @param stream    Index of the stream
+ * @param state0    State0 to be restored
+ * @param state1    State1 to be restored
+ */
+void VocAlgorithm_batch_set_states(VocAlgorithmBatchParams *params,
+                                   int32_t stream, int32_t state0,
+                                   int32_t state1);
+
+/**
+ * Set parameters to customize the VOC algorithm for all streams of a batch and
+ * restart them. See VocAlgorithm_set_tuning_parameters() for the ranges.
+ */
+void VocAlgorithm_batch_set_tuning_parameters(
+    VocAlgorithmBatchParams *params, int32_t voc_index_offset,
+    int32_t learning_time_hours, int32_t gating_max_duration_minutes,
+    int32_t std_initial);
+
+/**
+ * Calculate the VOC index values of all streams of a batch. The result for
+ * every stream is bit-identical to VocAlgorithm_process() on a
+ * VocAlgorithmParams struct fed with the same samples. It is not faster than
+ * calling VocAlgorithm_process() per stream: the per-sample cost is dominated
+ * by fix16_div/exp/sqrt, whose data-dependent loops do not vectorize.
+ *
+ * @param params    Pointer to the VocAlgorithmBatchParams struct
+ * @param sraw      Raw values, one per stream
+ * @param voc_index Calculated VOC index values, one per stream
+ */
+void VocAlgorithm_process_batch(VocAlgorithmBatchParams *params,
+                                const int32_t *sraw, int32_t *voc_index);
+
 #endif /* VOCALGORITHM_H_ */
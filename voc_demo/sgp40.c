@@ -0,0 +1,114 @@
+#include "sgp40.h"          // SGP40 ドライバ
+#include "sensirion_word.h" // Sensirion I2C ワードプロトコル (CRC-8)
+
+// コマンドを送信してタイマーを起動する
+static bool sgp40_send(sgp40 *dev, size_t len, uint32_t delay_us, sgp40_state next)
+{
+    const sgp40_transport *t = dev->transport;
+
+    if (t->write(t->ctx, SGP40_ADDR, dev->command, len, false) != (int)len)
+    {
+        dev->state = SGP40_STATE_IDLE; // 送信失敗
+        return false;
+    }
+    dev->timer_expired = false;
+    dev->state = next;
+    t->start_timer(t->ctx, delay_us, dev); // 変換完了をアラームで通知してもらう
+    return true;
+}
+
+// 応答 (2 バイト + CRC) を読み出す
+static bool sgp40_read_word(sgp40 *dev, uint16_t *word)
+{
+    const sgp40_transport *t = dev->transport;
+    uint8_t rbuf[SENSIRION_WORD_SIZE]; // 受信バッファ
+
+    if (t->read(t->ctx, SGP40_ADDR, rbuf, sizeof rbuf, false) != sizeof rbuf)
+    {
+        return false;
+    }
+    if (sensirion_verify_words(rbuf, word, 1) != 0)
+    {
+        dev->crc_errors++; // 受信データが壊れている
+        return false;
+    }
+    return true;
+}
+
+void sgp40_init(sgp40 *dev, const sgp40_transport *transport)
+{
+    dev->transport = transport;
+    dev->state = SGP40_STATE_IDLE;
+    dev->timer_expired = false;
+    dev->crc_errors = 0;
+}
+
+bool sgp40_start_self_test(sgp40 *dev)
+{
+    if (dev->state != SGP40_STATE_IDLE)
+    {
+        return false;
+    }
+    dev->command[0] = 0x20; // Feature Set コマンド
+    dev->command[1] = 0x2F;
+    return sgp40_send(dev, 2, SGP40_SELF_TEST_DELAY_US, SGP40_STATE_FEATURE_SET);
+}
+
+bool sgp40_start_measure(sgp40 *dev, float temp, float humi)
+{
+    if (dev->state != SGP40_STATE_IDLE)
+    {
+        return false;
+    }
+
+    uint16_t params[2] = {
+        humi * 0xffff / 100,        // 湿度を 16bit 値に変換
+        (temp + 45) * 0xffff / 175, // 温度を 16bit 値に変換
+    };
+
+    dev->command[0] = 0x26;                          // 湿度補償付き raw データ測定コマンド (上位バイト)
+    dev->command[1] = 0x0f;                          // 湿度補償付き raw データ測定コマンド (下位バイト)
+    sensirion_put_words(dev->command + 2, params, 2); // 湿度・温度パラメータとそれぞれの CRC 値
+    return sgp40_send(dev, 8, SGP40_MEASURE_DELAY_US, SGP40_STATE_MEASURE_RAW);
+}
+
+sgp40_status sgp40_poll(sgp40 *dev, uint16_t *sraw)
+{
+    uint16_t word;
+
+    if (dev->state == SGP40_STATE_IDLE || !dev->timer_expired)
+    {
+        return SGP40_BUSY; // 変換中 (または何もしていない)
+    }
+
+    sgp40_state state = dev->state;
+    dev->state = SGP40_STATE_IDLE;
+    if (!sgp40_read_word(dev, &word))
+    {
+        return SGP40_ERROR; // 読み出し失敗
+    }
+
+    switch (state)
+    {
+    case SGP40_STATE_FEATURE_SET:
+        if (word != SGP40_FEATURE_SET)
+        {
+            return SGP40_ERROR; // Feature Set の応答が不正
+        }
+        dev->command[0] = 0x28; // 続けて Measure Test コマンドを送る
+        dev->command[1] = 0x0E;
+        return sgp40_send(dev, 2, SGP40_SELF_TEST_DELAY_US, SGP40_STATE_MEASURE_TEST) ? SGP40_BUSY : SGP40_ERROR;
+    case SGP40_STATE_MEASURE_TEST:
+        return (word == SGP40_TEST_OK) ? SGP40_READY : SGP40_ERROR;
+    case SGP40_STATE_MEASURE_RAW:
+        *sraw = word;
+        return SGP40_READY;
+    default:
+        return SGP40_ERROR;
+    }
+}
+
+void sgp40_timer_expired(sgp40 *dev)
+{
+    dev->timer_expired = true;
+}
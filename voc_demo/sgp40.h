@@ -0,0 +1,84 @@
+#ifndef SGP40_H
+#define SGP40_H
+
+#include <stdint.h>  // 固定幅整数型
+#include <stdbool.h> // bool 型
+#include <stddef.h>  // size_t
+
+// SGP40 ドライバ (ノンブロッキング)
+//
+// コマンドを送信したあと変換完了を sleep_ms() で待つ代わりに、タイマー (ハードウェアアラーム) を起動して
+// すぐに戻る。アラームが満了すると sgp40_timer_expired() が呼ばれ、次の sgp40_poll() で結果を読み出す。
+// 変換中 CPU は他のセンサーや表示の処理を行える。
+//
+// I2C とタイマーは sgp40_transport 経由で呼ぶので、Pico SDK なしのホスト環境でもモックで動かせる。
+
+#define SGP40_ADDR 0x59 // SGP40 センサーの I2C アドレス
+
+#define SGP40_SELF_TEST_DELAY_US (250 * 1000) // Feature Set / Measure Test の応答待ち時間 [us]
+#define SGP40_MEASURE_DELAY_US (31 * 1000)    // raw データ測定の変換時間 [us]
+
+#define SGP40_FEATURE_SET 0x3220 // Feature Set コマンドの期待応答
+#define SGP40_TEST_OK 0xD400     // Measure Test コマンドの期待応答
+
+typedef struct sgp40 sgp40;
+
+// I2C とタイマーへのアクセス手段
+typedef struct
+{
+    // I2C 書き込み / 読み出し。戻り値は転送バイト数、失敗時は負の値 (i2c_write_blocking と同じ)
+    int (*write)(void *ctx, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+    int (*read)(void *ctx, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+    // delay_us 後に sgp40_timer_expired(dev) を呼ぶタイマーを起動する
+    void (*start_timer)(void *ctx, uint32_t delay_us, sgp40 *dev);
+    void *ctx; // 上記関数に渡すコンテキスト
+} sgp40_transport;
+
+// ドライバの状態
+typedef enum
+{
+    SGP40_STATE_IDLE,         // 何もしていない (測定を開始できる)
+    SGP40_STATE_FEATURE_SET,  // Feature Set の応答待ち
+    SGP40_STATE_MEASURE_TEST, // Measure Test の応答待ち
+    SGP40_STATE_MEASURE_RAW,  // raw データ測定の変換待ち
+} sgp40_state;
+
+// sgp40_poll() の戻り値
+typedef enum
+{
+    SGP40_BUSY,  // 処理中 (または何もしていない)
+    SGP40_READY, // 初期化が完了した、または測定値が得られた
+    SGP40_ERROR, // 通信エラーまたはセルフテスト失敗
+} sgp40_status;
+
+struct sgp40
+{
+    const sgp40_transport *transport; // I2C とタイマー
+    sgp40_state state;                // 現在の状態
+    volatile bool timer_expired;      // アラームが満了したら true (割り込みから書き込まれる)
+    uint8_t command[8];               // 送信中のコマンド
+    uint32_t crc_errors;              // 応答の CRC エラーの回数
+};
+
+// ドライバを初期化する (I2C 通信はしない)
+void sgp40_init(sgp40 *dev, const sgp40_transport *transport);
+
+// セルフテスト (Feature Set → Measure Test) を開始する。成功すると sgp40_poll() が SGP40_READY を返す
+bool sgp40_start_self_test(sgp40 *dev);
+
+// 湿度補償付き raw データ測定を開始する (temp: 摂氏, humi: %)
+bool sgp40_start_measure(sgp40 *dev, float temp, float humi);
+
+// 状態を進める。測定完了時は *sraw に raw データを格納して SGP40_READY を返す
+sgp40_status sgp40_poll(sgp40 *dev, uint16_t *sraw);
+
+// タイマー満了時に呼ぶ (割り込みコンテキストから呼んでよい)
+void sgp40_timer_expired(sgp40 *dev);
+
+// 測定を開始できる状態なら true
+static inline bool sgp40_is_idle(const sgp40 *dev)
+{
+    return dev->state == SGP40_STATE_IDLE;
+}
+
+#endif // SGP40_H